@@ -2,6 +2,8 @@
 
 #include "ConfigurationManager.hpp"
 #include "EventBus.hpp"
+#include "AsyncFileIO.hpp"
+#include "FileWatchService.hpp"
 #include "IModule.hpp"
 #include "PluginManager.hpp"
 #include "ResourceManager.hpp"
@@ -95,6 +97,8 @@ protected:
     // Core systems
     std::unique_ptr<EventBus> m_eventBus;
     std::unique_ptr<ServiceLocator> m_serviceLocator;
+    std::unique_ptr<FileWatchService> m_fileWatchService;  // Outlives the subsystems subscribing to it
+    std::unique_ptr<AsyncFileIO> m_asyncFileIO;
     std::unique_ptr<ResourceManager> m_resourceManager;
     std::unique_ptr<ConfigurationManager> m_configManager;
     std::unique_ptr<ThreadPool> m_threadPool;
@@ -126,6 +130,8 @@ public:
         // Create core systems
         m_eventBus = std::make_unique<EventBus>();
         m_serviceLocator = std::make_unique<ServiceLocator>();
+        m_fileWatchService = std::make_unique<FileWatchService>();
+        m_asyncFileIO = std::make_unique<AsyncFileIO>();
         m_resourceManager = std::make_unique<ResourceManager>();
         m_configManager = std::make_unique<ConfigurationManager>();
         m_threadPool = std::make_unique<ThreadPool>(config.threadPoolSize);
@@ -145,6 +151,11 @@ public:
         if (m_initialized) {
             shutdown();
         }
+
+        // The singleton plugin manager outlives the watch service
+        m_pluginManager.setFileWatchService(nullptr);
+        m_configManager->stopFileWatching();
+        m_resourceManager->disableHotReload();
     }
 
     /**
@@ -191,6 +202,10 @@ public:
             std::shared_ptr<ResourceManager>(m_resourceManager.get(), [](ResourceManager*){}));
         m_serviceLocator->registerSingleton<ConfigurationManager>(
             std::shared_ptr<ConfigurationManager>(m_configManager.get(), [](ConfigurationManager*){}));
+        m_serviceLocator->registerSingleton<FileWatchService>(
+            std::shared_ptr<FileWatchService>(m_fileWatchService.get(), [](FileWatchService*){}));
+        m_serviceLocator->registerSingleton<AsyncFileIO>(
+            std::shared_ptr<AsyncFileIO>(m_asyncFileIO.get(), [](AsyncFileIO*){}));
 
         // Initialize plugin manager
         m_pluginManager.initialize(
@@ -201,6 +216,7 @@ public:
             m_threadPool.get(),
             m_configManager.get()
         );
+        m_pluginManager.setFileWatchService(m_fileWatchService.get());
 
         // Setup hot reload callbacks (avoids circular dependency)
         // TODO: Hot reload needs to be adapted for time-agnostic architecture
@@ -256,6 +272,7 @@ public:
 
         // Unload all plugins
         m_pluginManager.unloadAll();
+        m_pluginManager.setFileWatchService(nullptr);
 
         // Shutdown modules in reverse order
         for (auto it = m_modules.rbegin(); it != m_modules.rend(); ++it) {
@@ -347,6 +364,30 @@ public:
      */
     ServiceLocator* getServiceLocator() { return m_serviceLocator.get(); }
 
+    /**
+     * @brief Get file watch service
+     *
+     * The FileWatchService shares one watcher thread between plugin hot
+     * reload, configuration and resource reloading and modules.
+     *
+     * @return Pointer to the FileWatchService instance. Never null after construction.
+     *
+     * @see FileWatchService
+     */
+    FileWatchService* getFileWatchService() { return m_fileWatchService.get(); }
+
+    /**
+     * @brief Get asynchronous file I/O service
+     *
+     * The AsyncFileIO service completes file reads and writes on io_uring
+     * or an I/O thread pool, keeping blocking I/O off the main loop.
+     *
+     * @return Pointer to the AsyncFileIO instance. Never null after construction.
+     *
+     * @see AsyncFileIO
+     */
+    AsyncFileIO* getAsyncFileIO() { return m_asyncFileIO.get(); }
+
     /**
      * @brief Get resource manager
      *
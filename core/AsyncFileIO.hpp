@@ -0,0 +1,1135 @@
+/**
+ * @file AsyncFileIO.hpp
+ * @brief Asynchronous file I/O on io_uring, with a thread-pool fallback
+ *
+ * FileSystem, JsonParser::parseFile() and the log sinks block the calling
+ * thread until the kernel is done, which on a realtime loop means a missed
+ * frame whenever the disk is slow. AsyncFileIO accepts open, read, write,
+ * sync and close requests and completes them in the background, reporting
+ * the results through futures or callbacks.
+ *
+ * On Linux kernels that support it (5.6 and later), requests are queued on
+ * an io_uring submission ring; a batch of requests costs one system call
+ * and one completion thread reaps the results. Elsewhere, or when io_uring
+ * is unavailable (older kernels, seccomp filters), the requests run as
+ * blocking calls on a dedicated I/O thread pool. Application creates one
+ * instance and registers it in the ServiceLocator.
+ */
+
+#pragma once
+
+#include "FileSystem.hpp"
+#include "TempFile.hpp"
+#include "ThreadPool.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <cerrno>
+#include <condition_variable>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <exception>
+#include <functional>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <stdexcept>
+#include <string>
+#include <system_error>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#ifdef _WIN32
+#include <windows.h>
+#include <fcntl.h>
+#include <io.h>
+#include <sys/stat.h>
+#else
+#include <fcntl.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#if defined(__linux__) && defined(__has_include)
+#if __has_include(<linux/io_uring.h>)
+#include <linux/io_uring.h>
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#define MCF_HAS_IO_URING 1
+#endif
+#endif
+#endif
+
+namespace mcf {
+
+/**
+ * @brief Mechanism completing AsyncFileIO requests
+ */
+enum class AsyncIOBackend {
+    Auto,        ///< io_uring when the kernel supports it, the thread pool otherwise
+    IoUring,     ///< io_uring; the constructor throws if it is unavailable
+    ThreadPool   ///< Blocking calls on a dedicated I/O thread pool
+};
+
+/**
+ * @brief Operation of an AsyncIORequest
+ */
+enum class AsyncIOOperation {
+    Open,      ///< open(path, flags, mode)
+    Read,      ///< pread(fd, buffer, size, offset)
+    Write,     ///< pwrite(fd, buffer, size, offset)
+    Sync,      ///< fsync(fd)
+    DataSync,  ///< fdatasync(fd)
+    Close      ///< close(fd)
+};
+
+/**
+ * @brief Outcome of an asynchronous request
+ */
+struct AsyncIOResult {
+    int64_t value = 0;  ///< Bytes transferred (Read, Write), the new descriptor (Open), 0 otherwise
+    int error = 0;      ///< errno value of a failed request, 0 on success
+
+    /**
+     * @brief Check if the request succeeded
+     * @return true if error is 0
+     */
+    bool ok() const { return error == 0; }
+};
+
+/**
+ * @brief Receives the result of a request
+ */
+using AsyncIOCallback = std::function<void(const AsyncIOResult&)>;
+
+/**
+ * @brief One request for AsyncFileIO::submit()
+ *
+ * Reads and writes transfer at most 1 GB and, like pread() and pwrite(),
+ * may transfer fewer bytes than asked for.
+ */
+struct AsyncIORequest {
+    AsyncIOOperation operation = AsyncIOOperation::Read;
+    int fd = -1;                ///< File of Read, Write, Sync, DataSync and Close
+    std::string path;           ///< File to open
+    int flags = 0;              ///< open() flags; O_CLOEXEC is added
+    int mode = 0644;            ///< Permissions of a file created by Open
+    void* buffer = nullptr;     ///< Data to read into or write; must stay valid until completion
+    size_t size = 0;            ///< Bytes to transfer
+    uint64_t offset = 0;        ///< File offset of the transfer
+    AsyncIOCallback callback;   ///< Called with the result; may be empty
+};
+
+/**
+ * @brief Asynchronous file I/O service
+ *
+ * Callbacks run on the completion thread (io_uring) or on an I/O pool
+ * thread. They should return quickly; they may submit further requests
+ * (the whole-file helpers chain their steps this way) but must not call
+ * shutdown() or wait for the future of another request.
+ *
+ * The completion thread or pool starts with the first request, so an
+ * unused instance costs only the ring's memory.
+ *
+ * Usage:
+ * @code
+ * AsyncFileIO io;
+ * std::future<std::string> text = io.readFile("assets/level.json");
+ * // ... keep the frame going ...
+ * JsonValue level = JsonParser::parse(text.get());
+ *
+ * // Many reads, one system call
+ * std::vector<AsyncIORequest> batch;
+ * for (auto& chunk : chunks) {
+ *     batch.push_back({AsyncIOOperation::Read, fd, "", 0, 0, chunk.data, chunk.size, chunk.offset,
+ *                      [&](const AsyncIOResult& result) { onChunk(chunk, result); }});
+ * }
+ * io.submit(std::move(batch));
+ * @endcode
+ */
+class AsyncFileIO {
+private:
+    // Request travelling through the ring or the pool; freed after its callback ran
+    struct Pending {
+        AsyncIORequest request;
+    };
+
+    // Largest transfer of a single request
+    static constexpr size_t MaxTransferSize = size_t(1) << 30;
+
+    AsyncIOBackend m_backend = AsyncIOBackend::ThreadPool;
+    size_t m_threadCount;
+
+    // Requests in flight, shutdown and lazy start
+    mutable std::mutex m_mutex;
+    std::condition_variable m_completed;
+    size_t m_inFlight = 0;
+    size_t m_maxInFlight = SIZE_MAX;
+    bool m_started = false;
+    bool m_stopping = false;
+
+    std::unique_ptr<mcf::ThreadPool> m_pool;
+
+#ifdef MCF_HAS_IO_URING
+    // Memory shared with the kernel and the positions inside it
+    struct Ring {
+        int fd = -1;
+        void* sqMemory = MAP_FAILED;
+        size_t sqMemorySize = 0;
+        void* cqMemory = MAP_FAILED;
+        size_t cqMemorySize = 0;
+        io_uring_sqe* sqes = static_cast<io_uring_sqe*>(MAP_FAILED);
+        size_t sqesSize = 0;
+
+        unsigned* sqHead = nullptr;
+        unsigned* sqTail = nullptr;
+        unsigned* sqArray = nullptr;
+        unsigned sqMask = 0;
+        unsigned sqEntries = 0;
+
+        unsigned* cqHead = nullptr;
+        unsigned* cqTail = nullptr;
+        io_uring_cqe* cqes = nullptr;
+        unsigned cqMask = 0;
+        unsigned cqEntries = 0;
+    };
+
+    Ring m_ring;
+    std::mutex m_submitMutex;  // Serializes writers of the submission ring
+    // Orders request setup before completion handling; the kernel's own ordering is invisible to the C++ memory model
+    std::atomic<uint64_t> m_submissions{0};
+    std::thread m_completionThread;
+#endif
+
+public:
+    /**
+     * @brief Create the service
+     * @param backend Requested backend
+     * @param queueDepth Submission ring size (io_uring); also bounds the requests in flight
+     * @param threadCount Threads of the fallback pool
+     * @throws std::runtime_error if backend is IoUring and io_uring is unavailable
+     */
+    explicit AsyncFileIO(AsyncIOBackend backend = AsyncIOBackend::Auto, unsigned queueDepth = 256,
+                         size_t threadCount = 4)
+        : m_threadCount(std::max<size_t>(threadCount, 1)) {
+        if (backend != AsyncIOBackend::ThreadPool) {
+#ifdef MCF_HAS_IO_URING
+            if (setupRing(std::max(queueDepth, 8u))) {
+                m_backend = AsyncIOBackend::IoUring;
+                // Completions beyond the CQ size would have to be buffered by the kernel
+                m_maxInFlight = m_ring.cqEntries;
+            }
+#else
+            (void)queueDepth;
+#endif
+            if (backend == AsyncIOBackend::IoUring && m_backend != AsyncIOBackend::IoUring) {
+                throw std::runtime_error("io_uring is not available");
+            }
+        }
+    }
+
+    ~AsyncFileIO() {
+        shutdown();
+#ifdef MCF_HAS_IO_URING
+        teardownRing();
+#endif
+    }
+
+    // Non-copyable, non-movable: in-flight requests point back to the instance
+    AsyncFileIO(const AsyncFileIO&) = delete;
+    AsyncFileIO& operator=(const AsyncFileIO&) = delete;
+
+    /**
+     * @brief Get the backend in use
+     * @return AsyncIOBackend::IoUring or AsyncIOBackend::ThreadPool
+     */
+    AsyncIOBackend getBackend() const { return m_backend; }
+
+    /**
+     * @brief Check if io_uring can be used in this process
+     * @return true if a ring with the required operations can be created
+     */
+    static bool isIoUringAvailable() {
+#ifdef MCF_HAS_IO_URING
+        static const bool available = [] {
+            try {
+                AsyncFileIO probe(AsyncIOBackend::IoUring, 8);
+                return true;
+            } catch (const std::runtime_error&) {
+                return false;
+            }
+        }();
+        return available;
+#else
+        return false;
+#endif
+    }
+
+    /**
+     * @brief Get the number of requests not completed yet
+     * @return Requests submitted whose callback has not returned
+     */
+    size_t getPendingCount() const {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        return m_inFlight;
+    }
+
+    /**
+     * @brief Submit a batch of requests
+     * @param requests Requests, queued in order; with io_uring they are submitted with one system call
+     * @throws std::runtime_error after shutdown(), or std::system_error if io_uring rejects
+     *         the batch; rejected requests have completed with the error by then
+     *
+     * The requests run concurrently; chain dependent steps through the
+     * callbacks. Blocks while the ring is full of requests in flight,
+     * except when called from a callback.
+     */
+    void submit(std::vector<AsyncIORequest> requests) {
+        if (requests.empty()) {
+            return;
+        }
+        std::vector<std::unique_ptr<Pending>> batch;
+        batch.reserve(requests.size());
+        for (auto& request : requests) {
+            batch.push_back(std::make_unique<Pending>(Pending{std::move(request)}));
+        }
+
+        reserve(batch.size());
+#ifdef MCF_HAS_IO_URING
+        if (m_backend == AsyncIOBackend::IoUring) {
+            submitToRing(batch);
+            return;
+        }
+#endif
+        for (auto& pending : batch) {
+            Pending* raw = pending.release();
+            m_pool->submit([this, raw]() {
+                finish(raw, perform(raw->request));
+            });
+        }
+    }
+
+    /**
+     * @brief Submit a single request
+     * @param request Request to run
+     * @throws std::runtime_error after shutdown()
+     */
+    void submit(AsyncIORequest request) {
+        std::vector<AsyncIORequest> requests;
+        requests.push_back(std::move(request));
+        submit(std::move(requests));
+    }
+
+    /**
+     * @brief Open a file
+     * @param path File to open
+     * @param flags open() flags, e.g. O_RDONLY or O_WRONLY | O_CREAT | O_TRUNC
+     * @param mode Permissions of a created file
+     * @return Future of the result; value is the descriptor
+     */
+    std::future<AsyncIOResult> open(const std::string& path, int flags, int mode = 0644) {
+        AsyncIORequest request;
+        request.operation = AsyncIOOperation::Open;
+        request.path = path;
+        request.flags = flags;
+        request.mode = mode;
+        return submitForFuture(std::move(request));
+    }
+
+    /**
+     * @brief Read from a file at an offset
+     * @param fd Open file
+     * @param buffer Destination; must stay valid until the future is ready
+     * @param size Bytes to read
+     * @param offset File offset
+     * @return Future of the result; value is the number of bytes read (0 at end of file)
+     */
+    std::future<AsyncIOResult> read(int fd, void* buffer, size_t size, uint64_t offset) {
+        AsyncIORequest request;
+        request.operation = AsyncIOOperation::Read;
+        request.fd = fd;
+        request.buffer = buffer;
+        request.size = size;
+        request.offset = offset;
+        return submitForFuture(std::move(request));
+    }
+
+    /**
+     * @brief Write to a file at an offset
+     * @param fd Open file
+     * @param buffer Source; must stay valid until the future is ready
+     * @param size Bytes to write
+     * @param offset File offset
+     * @return Future of the result; value is the number of bytes written
+     */
+    std::future<AsyncIOResult> write(int fd, const void* buffer, size_t size, uint64_t offset) {
+        AsyncIORequest request;
+        request.operation = AsyncIOOperation::Write;
+        request.fd = fd;
+        request.buffer = const_cast<void*>(buffer);
+        request.size = size;
+        request.offset = offset;
+        return submitForFuture(std::move(request));
+    }
+
+    /**
+     * @brief Flush a file to the device
+     * @param fd Open file
+     * @param dataOnly Flush only the data and the metadata needed to read it (fdatasync)
+     * @return Future of the result
+     */
+    std::future<AsyncIOResult> sync(int fd, bool dataOnly = false) {
+        AsyncIORequest request;
+        request.operation = dataOnly ? AsyncIOOperation::DataSync : AsyncIOOperation::Sync;
+        request.fd = fd;
+        return submitForFuture(std::move(request));
+    }
+
+    /**
+     * @brief Close a file
+     * @param fd Open file
+     * @return Future of the result
+     */
+    std::future<AsyncIOResult> close(int fd) {
+        AsyncIORequest request;
+        request.operation = AsyncIOOperation::Close;
+        request.fd = fd;
+        return submitForFuture(std::move(request));
+    }
+
+    /**
+     * @brief Read a whole file
+     * @param path File to read
+     * @return Future of the contents; holds std::runtime_error if the file cannot be opened or read
+     *
+     * Files are read up to the size fstat() reports when opened; files that
+     * report no size, like those in /proc, are read until end of file.
+     */
+    std::future<std::string> readFile(const std::string& path) {
+        auto state = std::make_shared<ReadFileState>();
+        state->path = path;
+        std::future<std::string> future = state->promise.get_future();
+
+        AsyncIORequest request;
+        request.operation = AsyncIOOperation::Open;
+        request.path = path;
+        request.flags = O_RDONLY;
+        request.callback = [this, state](const AsyncIOResult& result) {
+            if (!result.ok()) {
+                state->fail();
+                return;
+            }
+            state->fd = static_cast<int>(result.value);
+            state->content.resize(fileSize(state->fd));
+            state->sizeKnown = !state->content.empty();
+            readNext(state);
+        };
+        submit(std::move(request));
+        return future;
+    }
+
+    /**
+     * @brief Write a whole file
+     * @param path File to create or replace
+     * @param content Data to write; owned by the request until it completes
+     * @param durability Persistence before the future becomes ready (see Durability)
+     * @return Future that is true if the file was written with the requested durability
+     */
+    std::future<bool> writeFile(const std::string& path, std::string content,
+                                Durability durability = Durability::None) {
+        auto state = std::make_shared<WriteFileState>();
+        state->path = path;
+        state->content = std::move(content);
+        state->durability = durability;
+        std::future<bool> future = state->promise.get_future();
+        openWriteTarget(state, 0);
+        return future;
+    }
+
+    /**
+     * @brief Wait for the requests in flight and stop the service
+     *
+     * Requests still running may submit their follow-up steps until all
+     * of them are done; requests submitted after shutdown() returned throw
+     * std::runtime_error. Must not be called from a callback.
+     */
+    void shutdown() {
+        {
+            std::unique_lock<std::mutex> lock(m_mutex);
+            m_stopping = true;
+            m_completed.wait(lock, [this] { return m_inFlight == 0; });
+            if (!m_started) {
+                return;
+            }
+            m_started = false;
+        }
+
+#ifdef MCF_HAS_IO_URING
+        if (m_completionThread.joinable()) {
+            wakeCompletionThread();
+            m_completionThread.join();
+        }
+#endif
+        if (m_pool) {
+            m_pool->shutdown(true);
+        }
+    }
+
+private:
+    // Whole-file read in progress
+    struct ReadFileState {
+        std::string path;
+        std::string content;
+        size_t length = 0;
+        bool sizeKnown = false;
+        int fd = -1;
+        std::promise<std::string> promise;
+
+        void fail() {
+            promise.set_exception(std::make_exception_ptr(std::runtime_error("Failed to read file: " + path)));
+        }
+    };
+
+    // Whole-file write in progress
+    struct WriteFileState {
+        std::string path;
+        std::string target;
+        std::string content;
+        size_t written = 0;
+        Durability durability = Durability::None;
+        int fd = -1;
+        std::promise<bool> promise;
+    };
+
+    std::future<AsyncIOResult> submitForFuture(AsyncIORequest request) {
+        auto promise = std::make_shared<std::promise<AsyncIOResult>>();
+        std::future<AsyncIOResult> future = promise->get_future();
+        request.callback = [promise](const AsyncIOResult& result) {
+            promise->set_value(result);
+        };
+        submit(std::move(request));
+        return future;
+    }
+
+    /**
+     * @brief Account for new requests, starting the backend with the first one
+     */
+    void reserve(size_t count) {
+        std::unique_lock<std::mutex> lock(m_mutex);
+        // While shutdown() drains, callbacks may still chain their next steps
+        if (m_stopping && m_inFlight == 0) {
+            throw std::runtime_error("AsyncFileIO is shut down");
+        }
+
+#ifdef MCF_HAS_IO_URING
+        // Callbacks never wait: the completion thread is the one freeing capacity
+        bool fromCallback = std::this_thread::get_id() == m_completionThread.get_id();
+#else
+        bool fromCallback = false;
+#endif
+        if (!fromCallback) {
+            m_completed.wait(lock, [&] { return m_inFlight == 0 || m_inFlight + count <= m_maxInFlight; });
+        }
+        m_inFlight += count;
+
+        if (!m_started) {
+            m_started = true;
+#ifdef MCF_HAS_IO_URING
+            if (m_backend == AsyncIOBackend::IoUring) {
+                m_completionThread = std::thread([this] { completionLoop(); });
+                return;
+            }
+#endif
+            m_pool = std::make_unique<mcf::ThreadPool>(m_threadCount);
+        }
+    }
+
+    /**
+     * @brief Run the callback of a completed request and release it
+     */
+    void finish(Pending* pending, const AsyncIOResult& result) {
+        if (pending->request.callback) {
+            try {
+                pending->request.callback(result);
+            } catch (...) {
+                // A throwing callback must not take the completion thread down
+            }
+        }
+        delete pending;
+
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_inFlight--;
+        m_completed.notify_all();
+    }
+
+    /**
+     * @brief Run a request as a blocking call (thread-pool backend)
+     */
+    static AsyncIOResult perform(const AsyncIORequest& request) {
+        AsyncIOResult result;
+        size_t size = std::min(request.size, MaxTransferSize);
+
+#ifdef _WIN32
+        HANDLE handle = request.fd >= 0 ? reinterpret_cast<HANDLE>(_get_osfhandle(request.fd)) : INVALID_HANDLE_VALUE;
+        OVERLAPPED position = {};
+        position.Offset = static_cast<DWORD>(request.offset);
+        position.OffsetHigh = static_cast<DWORD>(request.offset >> 32);
+        DWORD transferred = 0;
+
+        switch (request.operation) {
+            case AsyncIOOperation::Open:
+                result.value = _open(request.path.c_str(), request.flags | _O_BINARY | _O_NOINHERIT, request.mode);
+                break;
+            case AsyncIOOperation::Read:
+                if (!ReadFile(handle, request.buffer, static_cast<DWORD>(size), &transferred, &position) &&
+                    GetLastError() != ERROR_HANDLE_EOF) {
+                    result.error = EIO;
+                }
+                result.value = transferred;
+                return result;
+            case AsyncIOOperation::Write:
+                if (!WriteFile(handle, request.buffer, static_cast<DWORD>(size), &transferred, &position)) {
+                    result.error = EIO;
+                }
+                result.value = transferred;
+                return result;
+            case AsyncIOOperation::Sync:
+            case AsyncIOOperation::DataSync:
+                result.value = _commit(request.fd);
+                break;
+            case AsyncIOOperation::Close:
+                result.value = _close(request.fd);
+                break;
+        }
+#else
+        int64_t value = -1;
+        do {
+            switch (request.operation) {
+                case AsyncIOOperation::Open:
+                    value = ::open(request.path.c_str(), request.flags | O_CLOEXEC, request.mode);
+                    break;
+                case AsyncIOOperation::Read:
+                    value = ::pread(request.fd, request.buffer, size, static_cast<off_t>(request.offset));
+                    break;
+                case AsyncIOOperation::Write:
+                    value = ::pwrite(request.fd, request.buffer, size, static_cast<off_t>(request.offset));
+                    break;
+                case AsyncIOOperation::Sync:
+                    value = ::fsync(request.fd);
+                    break;
+                case AsyncIOOperation::DataSync:
+#ifdef __APPLE__
+                    value = ::fsync(request.fd);
+#else
+                    value = ::fdatasync(request.fd);
+#endif
+                    break;
+                case AsyncIOOperation::Close:
+                    // Never retried: the descriptor is released even when close() is interrupted
+                    value = ::close(request.fd);
+                    if (value < 0 && errno == EINTR) {
+                        value = 0;
+                    }
+                    break;
+            }
+        } while (value < 0 && errno == EINTR);
+        result.value = value;
+#endif
+        if (result.value < 0) {
+            result.error = errno;
+            result.value = 0;
+        }
+        return result;
+    }
+
+    /**
+     * @brief Size of an open file as reported by fstat(), 0 if unknown
+     */
+    static size_t fileSize(int fd) {
+#ifdef _WIN32
+        struct _stat64 st;
+        return (_fstat64(fd, &st) == 0 && st.st_size > 0) ? static_cast<size_t>(st.st_size) : 0;
+#else
+        struct stat st;
+        return (fstat(fd, &st) == 0 && S_ISREG(st.st_mode) && st.st_size > 0) ? static_cast<size_t>(st.st_size) : 0;
+#endif
+    }
+
+    /**
+     * @brief Read the next chunk of a whole-file read, or finish it
+     */
+    void readNext(const std::shared_ptr<ReadFileState>& state) {
+        if (state->length == state->content.size()) {
+            if (state->sizeKnown) {
+                closeThen(state->fd, [state](bool) {
+                    state->promise.set_value(std::move(state->content));
+                });
+                return;
+            }
+            state->content.resize(std::max<size_t>(state->content.size() * 2, 64 * 1024));
+        }
+
+        AsyncIORequest request;
+        request.operation = AsyncIOOperation::Read;
+        request.fd = state->fd;
+        request.buffer = &state->content[state->length];
+        request.size = state->content.size() - state->length;
+        request.offset = state->length;
+        request.callback = [this, state](const AsyncIOResult& result) {
+            if (!result.ok()) {
+                closeThen(state->fd, [state](bool) { state->fail(); });
+                return;
+            }
+            state->length += static_cast<size_t>(result.value);
+            if (result.value == 0) {
+                // End of file, possibly before the size fstat() reported
+                state->content.resize(state->length);
+                state->sizeKnown = true;
+            }
+            readNext(state);
+        };
+        submit(std::move(request));
+    }
+
+    /**
+     * @brief Open the file a whole-file write goes to
+     * @param attempt Temporary names already found taken (atomic writes)
+     *
+     * An atomic write creates a new temporary file (see TempFile) and
+     * retries with the next name if one is taken, so concurrent writers of
+     * the same path never share a temporary file.
+     */
+    void openWriteTarget(const std::shared_ptr<WriteFileState>& state, int attempt) {
+        bool atomic = state->durability == Durability::Atomic;
+        state->target = atomic ? TempFile::uniquePath(state->path) : state->path;
+
+        AsyncIORequest request;
+        request.operation = AsyncIOOperation::Open;
+        request.path = state->target;
+        request.flags = O_WRONLY | O_CREAT | (atomic ? O_EXCL : O_TRUNC);
+#ifndef _WIN32
+        // An atomic replacement keeps the permissions of the file it replaces
+        struct stat st;
+        if (atomic && stat(state->path.c_str(), &st) == 0) {
+            request.mode = static_cast<int>(st.st_mode & 07777);
+        }
+#endif
+        request.callback = [this, state, attempt](const AsyncIOResult& result) {
+            if (result.error == EEXIST && attempt + 1 < TempFile::MaxAttempts) {
+                openWriteTarget(state, attempt + 1);
+                return;
+            }
+            if (!result.ok()) {
+                state->promise.set_value(false);
+                return;
+            }
+            state->fd = static_cast<int>(result.value);
+            writeNext(state);
+        };
+        submit(std::move(request));
+    }
+
+    /**
+     * @brief Write the next chunk of a whole-file write, then sync, close and publish it
+     */
+    void writeNext(const std::shared_ptr<WriteFileState>& state) {
+        AsyncIORequest request;
+        request.fd = state->fd;
+
+        if (state->written < state->content.size()) {
+            request.operation = AsyncIOOperation::Write;
+            request.buffer = &state->content[state->written];
+            request.size = state->content.size() - state->written;
+            request.offset = state->written;
+            request.callback = [this, state](const AsyncIOResult& result) {
+                if (!result.ok() || result.value == 0) {
+                    abortWrite(state);
+                    return;
+                }
+                state->written += static_cast<size_t>(result.value);
+                writeNext(state);
+            };
+        } else if (state->durability != Durability::None) {
+            request.operation = state->durability == Durability::Atomic ? AsyncIOOperation::Sync
+                                                                        : AsyncIOOperation::DataSync;
+            request.callback = [this, state](const AsyncIOResult& result) {
+                if (!result.ok()) {
+                    abortWrite(state);
+                    return;
+                }
+                closeWrite(state);
+            };
+        } else {
+            closeWrite(state);
+            return;
+        }
+        submit(std::move(request));
+    }
+
+    void closeWrite(const std::shared_ptr<WriteFileState>& state) {
+        closeThen(state->fd, [this, state](bool closed) {
+            if (!closed) {
+                abortWrite(state, false);
+                return;
+            }
+            if (state->durability != Durability::Atomic) {
+                state->promise.set_value(true);
+                return;
+            }
+#ifdef _WIN32
+            bool renamed = MoveFileExA(state->target.c_str(), state->path.c_str(),
+                                       MOVEFILE_REPLACE_EXISTING | MOVEFILE_WRITE_THROUGH) != 0;
+            if (!renamed) {
+                std::remove(state->target.c_str());
+            }
+            state->promise.set_value(renamed);
+#else
+            if (std::rename(state->target.c_str(), state->path.c_str()) != 0) {
+                std::remove(state->target.c_str());
+                state->promise.set_value(false);
+                return;
+            }
+            syncParentDirectory(state);
+#endif
+        });
+    }
+
+#ifndef _WIN32
+    /**
+     * @brief Persist the rename of an atomic write: open, fsync and close the directory
+     */
+    void syncParentDirectory(const std::shared_ptr<WriteFileState>& state) {
+        AsyncIORequest request;
+        request.operation = AsyncIOOperation::Open;
+        request.path = Path::dirname(state->path);
+        request.flags = O_RDONLY | O_DIRECTORY;
+        request.callback = [this, state](const AsyncIOResult& result) {
+            if (!result.ok()) {
+                // The file is in place; only the directory entry's durability is unknown
+                state->promise.set_value(true);
+                return;
+            }
+            int directory = static_cast<int>(result.value);
+            AsyncIORequest sync;
+            sync.operation = AsyncIOOperation::Sync;
+            sync.fd = directory;
+            sync.callback = [this, state, directory](const AsyncIOResult&) {
+                closeThen(directory, [state](bool) { state->promise.set_value(true); });
+            };
+            submit(std::move(sync));
+        };
+        submit(std::move(request));
+    }
+#endif
+
+    void abortWrite(const std::shared_ptr<WriteFileState>& state, bool closeFile = true) {
+        auto cleanup = [state](bool) {
+            if (state->durability == Durability::Atomic) {
+                std::remove(state->target.c_str());
+            }
+            state->promise.set_value(false);
+        };
+        if (closeFile) {
+            closeThen(state->fd, cleanup);
+        } else {
+            cleanup(false);
+        }
+    }
+
+    void closeThen(int fd, std::function<void(bool)> next) {
+        AsyncIORequest request;
+        request.operation = AsyncIOOperation::Close;
+        request.fd = fd;
+        request.callback = [next = std::move(next)](const AsyncIOResult& result) {
+            next(result.ok());
+        };
+        submit(std::move(request));
+    }
+
+#ifdef MCF_HAS_IO_URING
+    static int ringSetup(unsigned entries, io_uring_params* params) {
+        return static_cast<int>(syscall(__NR_io_uring_setup, entries, params));
+    }
+
+    static int ringEnter(int fd, unsigned toSubmit, unsigned minComplete, unsigned flags) {
+        return static_cast<int>(syscall(__NR_io_uring_enter, fd, toSubmit, minComplete, flags, nullptr, 0));
+    }
+
+    /**
+     * @brief Create the ring and map its queues
+     * @return false if io_uring or one of the operations used here is unavailable
+     */
+    bool setupRing(unsigned entries) {
+        io_uring_params params;
+        std::memset(&params, 0, sizeof(params));
+        m_ring.fd = ringSetup(entries, &params);
+        if (m_ring.fd < 0) {
+            return false;
+        }
+
+        // The probe reports which opcodes this kernel implements (5.6 and later)
+        std::vector<uint64_t> storage((sizeof(io_uring_probe) + 256 * sizeof(io_uring_probe_op)) / sizeof(uint64_t) + 1);
+        auto* probe = reinterpret_cast<io_uring_probe*>(storage.data());
+        if (syscall(__NR_io_uring_register, m_ring.fd, IORING_REGISTER_PROBE, probe, 256) < 0) {
+            teardownRing();
+            return false;
+        }
+        for (int op : {IORING_OP_OPENAT, IORING_OP_READ, IORING_OP_WRITE, IORING_OP_FSYNC, IORING_OP_CLOSE}) {
+            if (op > probe->last_op || !(probe->ops[op].flags & IO_URING_OP_SUPPORTED)) {
+                teardownRing();
+                return false;
+            }
+        }
+
+        m_ring.sqMemorySize = params.sq_off.array + params.sq_entries * sizeof(unsigned);
+        m_ring.cqMemorySize = params.cq_off.cqes + params.cq_entries * sizeof(io_uring_cqe);
+        bool single = (params.features & IORING_FEAT_SINGLE_MMAP) != 0;
+        if (single) {
+            m_ring.sqMemorySize = m_ring.cqMemorySize = std::max(m_ring.sqMemorySize, m_ring.cqMemorySize);
+        }
+
+        m_ring.sqMemory = mmap(nullptr, m_ring.sqMemorySize, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE,
+                               m_ring.fd, IORING_OFF_SQ_RING);
+        if (m_ring.sqMemory == MAP_FAILED) {
+            teardownRing();
+            return false;
+        }
+        m_ring.cqMemory = single ? m_ring.sqMemory
+                                 : mmap(nullptr, m_ring.cqMemorySize, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE,
+                                        m_ring.fd, IORING_OFF_CQ_RING);
+        m_ring.sqesSize = params.sq_entries * sizeof(io_uring_sqe);
+        m_ring.sqes = static_cast<io_uring_sqe*>(mmap(nullptr, m_ring.sqesSize, PROT_READ | PROT_WRITE,
+                                                      MAP_SHARED | MAP_POPULATE, m_ring.fd, IORING_OFF_SQES));
+        if (m_ring.cqMemory == MAP_FAILED || m_ring.sqes == MAP_FAILED) {
+            teardownRing();
+            return false;
+        }
+
+        char* sq = static_cast<char*>(m_ring.sqMemory);
+        m_ring.sqHead = reinterpret_cast<unsigned*>(sq + params.sq_off.head);
+        m_ring.sqTail = reinterpret_cast<unsigned*>(sq + params.sq_off.tail);
+        m_ring.sqArray = reinterpret_cast<unsigned*>(sq + params.sq_off.array);
+        m_ring.sqMask = *reinterpret_cast<unsigned*>(sq + params.sq_off.ring_mask);
+        m_ring.sqEntries = params.sq_entries;
+
+        char* cq = static_cast<char*>(m_ring.cqMemory);
+        m_ring.cqHead = reinterpret_cast<unsigned*>(cq + params.cq_off.head);
+        m_ring.cqTail = reinterpret_cast<unsigned*>(cq + params.cq_off.tail);
+        m_ring.cqes = reinterpret_cast<io_uring_cqe*>(cq + params.cq_off.cqes);
+        m_ring.cqMask = *reinterpret_cast<unsigned*>(cq + params.cq_off.ring_mask);
+        m_ring.cqEntries = params.cq_entries;
+        return true;
+    }
+
+    void teardownRing() {
+        if (m_ring.sqes != MAP_FAILED) {
+            munmap(m_ring.sqes, m_ring.sqesSize);
+        }
+        if (m_ring.cqMemory != MAP_FAILED && m_ring.cqMemory != m_ring.sqMemory) {
+            munmap(m_ring.cqMemory, m_ring.cqMemorySize);
+        }
+        if (m_ring.sqMemory != MAP_FAILED) {
+            munmap(m_ring.sqMemory, m_ring.sqMemorySize);
+        }
+        if (m_ring.fd >= 0) {
+            ::close(m_ring.fd);
+        }
+        m_ring = Ring();
+    }
+
+    /**
+     * @brief Fill the next submission queue entry
+     * @param request Request to queue, or nullptr for a no-op
+     * @param userData Pending request reported with the completion (0 for the no-op)
+     * @return false if the submission queue is full
+     */
+    bool pushEntry(const AsyncIORequest* request, uint64_t userData) {
+        unsigned tail = *m_ring.sqTail;  // Only written by us, under m_submitMutex
+        unsigned head = __atomic_load_n(m_ring.sqHead, __ATOMIC_ACQUIRE);
+        if (tail - head >= m_ring.sqEntries) {
+            return false;
+        }
+
+        unsigned index = tail & m_ring.sqMask;
+        io_uring_sqe* sqe = &m_ring.sqes[index];
+        std::memset(sqe, 0, sizeof(*sqe));
+        sqe->user_data = userData;
+
+        if (!request) {
+            sqe->opcode = IORING_OP_NOP;
+            m_ring.sqArray[index] = index;
+            __atomic_store_n(m_ring.sqTail, tail + 1, __ATOMIC_RELEASE);
+            return true;
+        }
+
+        unsigned length = static_cast<unsigned>(std::min(request->size, MaxTransferSize));
+        switch (request->operation) {
+            case AsyncIOOperation::Open:
+                sqe->opcode = IORING_OP_OPENAT;
+                sqe->fd = AT_FDCWD;
+                sqe->addr = reinterpret_cast<uint64_t>(request->path.c_str());
+                sqe->len = static_cast<unsigned>(request->mode);
+                sqe->open_flags = static_cast<unsigned>(request->flags | O_CLOEXEC);
+                break;
+            case AsyncIOOperation::Read:
+            case AsyncIOOperation::Write:
+                sqe->opcode = request->operation == AsyncIOOperation::Read ? IORING_OP_READ : IORING_OP_WRITE;
+                sqe->fd = request->fd;
+                sqe->addr = reinterpret_cast<uint64_t>(request->buffer);
+                sqe->len = length;
+                sqe->off = request->offset;
+                break;
+            case AsyncIOOperation::Sync:
+            case AsyncIOOperation::DataSync:
+                sqe->opcode = IORING_OP_FSYNC;
+                sqe->fd = request->fd;
+                sqe->fsync_flags = request->operation == AsyncIOOperation::DataSync ? IORING_FSYNC_DATASYNC : 0;
+                break;
+            case AsyncIOOperation::Close:
+                sqe->opcode = IORING_OP_CLOSE;
+                sqe->fd = request->fd;
+                break;
+        }
+
+        m_ring.sqArray[index] = index;
+        __atomic_store_n(m_ring.sqTail, tail + 1, __ATOMIC_RELEASE);
+        return true;
+    }
+
+    /**
+     * @brief Hand queued entries to the kernel
+     * @throws std::system_error with the errno of a failed io_uring_enter()
+     */
+    void enterSubmitted(unsigned count) {
+        while (count > 0) {
+            int submitted = ringEnter(m_ring.fd, count, 0, 0);
+            if (submitted < 0) {
+                if (errno == EINTR || errno == EAGAIN || errno == EBUSY) {
+                    std::this_thread::yield();
+                    continue;
+                }
+                throw std::system_error(errno, std::generic_category(), "io_uring_enter failed");
+            }
+            count -= static_cast<unsigned>(submitted);
+        }
+    }
+
+    /**
+     * @brief Take back the queued entries the kernel has not consumed
+     * @return Their requests, still counted in flight
+     *
+     * Without SQPOLL the kernel only reads the submission queue inside
+     * io_uring_enter(), so after a failed call the entries between its head
+     * and our tail can be unqueued. Must be called while holding
+     * m_submitMutex.
+     */
+    std::vector<Pending*> withdrawQueued() {
+        unsigned head = __atomic_load_n(m_ring.sqHead, __ATOMIC_ACQUIRE);
+        unsigned tail = *m_ring.sqTail;
+        std::vector<Pending*> withdrawn;
+        for (unsigned i = head; i != tail; ++i) {
+            uint64_t userData = m_ring.sqes[m_ring.sqArray[i & m_ring.sqMask]].user_data;
+            if (userData != 0) {
+                withdrawn.push_back(reinterpret_cast<Pending*>(userData));
+            }
+        }
+        __atomic_store_n(m_ring.sqTail, head, __ATOMIC_RELEASE);
+        return withdrawn;
+    }
+
+    /**
+     * @brief Queue a batch and submit it with io_uring_enter()
+     * @throws std::system_error if the kernel rejects the submission
+     *
+     * Requests the kernel did not accept complete with the errno (callback,
+     * then finish()) before the error is rethrown, so they do not stay in
+     * flight and shutdown() does not wait for them forever.
+     */
+    void submitToRing(std::vector<std::unique_ptr<Pending>>& batch) {
+        std::vector<Pending*> rejected;
+        AsyncIOResult failure;
+        std::exception_ptr error;
+        {
+            std::lock_guard<std::mutex> lock(m_submitMutex);
+            unsigned queued = 0;
+            size_t next = 0;
+            try {
+                for (; next < batch.size(); ++next) {
+                    auto& pending = batch[next];
+                    while (!pushEntry(&pending->request, reinterpret_cast<uint64_t>(pending.get()))) {
+                        // Submission queue full: submitting frees its entries
+                        m_submissions.fetch_add(1, std::memory_order_release);
+                        enterSubmitted(queued);
+                        queued = 0;
+                    }
+                    pending.release();
+                    queued++;
+                }
+                m_submissions.fetch_add(1, std::memory_order_release);
+                enterSubmitted(queued);
+                return;
+            } catch (const std::system_error& e) {
+                failure.error = e.code().value();
+                error = std::current_exception();
+            }
+
+            rejected = withdrawQueued();
+            for (; next < batch.size(); ++next) {
+                rejected.push_back(batch[next].release());
+            }
+        }
+
+        // Callbacks may submit again, so complete them without m_submitMutex
+        for (Pending* pending : rejected) {
+            finish(pending, failure);
+        }
+        std::rethrow_exception(error);
+    }
+
+    void wakeCompletionThread() {
+        std::lock_guard<std::mutex> lock(m_submitMutex);
+        // No request is in flight, so the queue has room
+        pushEntry(nullptr, 0);
+        enterSubmitted(1);
+    }
+
+    void completionLoop() {
+        while (true) {
+            unsigned head = *m_ring.cqHead;  // Only written by this thread
+            unsigned tail = __atomic_load_n(m_ring.cqTail, __ATOMIC_ACQUIRE);
+
+            if (head == tail) {
+                {
+                    std::lock_guard<std::mutex> lock(m_mutex);
+                    if (m_stopping && m_inFlight == 0) {
+                        return;
+                    }
+                }
+                ringEnter(m_ring.fd, 0, 1, IORING_ENTER_GETEVENTS);
+                continue;
+            }
+
+            m_submissions.load(std::memory_order_acquire);
+            while (head != tail) {
+                io_uring_cqe* cqe = &m_ring.cqes[head & m_ring.cqMask];
+                uint64_t userData = cqe->user_data;
+                int res = cqe->res;
+                __atomic_store_n(m_ring.cqHead, ++head, __ATOMIC_RELEASE);
+
+                if (userData == 0) {
+                    continue;  // Wake-up from shutdown()
+                }
+                AsyncIOResult result;
+                if (res < 0) {
+                    result.error = -res;
+                } else {
+                    result.value = res;
+                }
+                finish(reinterpret_cast<Pending*>(userData), result);
+            }
+        }
+    }
+#endif
+};
+
+} // namespace mcf
@@ -0,0 +1,257 @@
+/**
+ * @file ConfigCache.hpp
+ * @brief Precompiled binary images of JSON configuration files
+ *
+ * Parsing a large configuration file on every start is wasted work when the
+ * file has not changed. ConfigCache stores the parsed document as a
+ * MessagePack image next to the source ("config.json" -> "config.json.mcfc")
+ * and uses it on later loads as long as the source still matches.
+ *
+ * An image records the source size, modification time and content hash plus
+ * a hash of its own payload. Any mismatch, truncation or decode error falls
+ * back to parsing the JSON source, which then rewrites the image.
+ */
+
+#pragma once
+
+#include "Hash.hpp"
+#include "JsonParser.hpp"
+#include "JsonValue.hpp"
+#include "MappedFile.hpp"
+#include "MsgPack.hpp"
+#include "TempFile.hpp"
+
+#include <cstdint>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <system_error>
+
+namespace mcf {
+
+/**
+ * @brief Binary image cache for JSON configuration files
+ *
+ * Usage:
+ * @code
+ * bool cached = false;
+ * JsonValue config = ConfigCache::parseFile("config/app.json", &cached);
+ * @endcode
+ */
+class ConfigCache {
+public:
+    /// Image format version; images of other versions are ignored
+    static constexpr uint32_t Version = 1;
+
+    /// Suffix appended to the source path to name its image
+    static constexpr const char* Extension = ".mcfc";
+
+    /**
+     * @brief Path of the image belonging to a source file
+     * @param source JSON source path
+     * @return Image path
+     */
+    static std::string imagePath(const std::string& source) {
+        return source + Extension;
+    }
+
+    /**
+     * @brief Parse a JSON file, using its binary image when it is current
+     * @param source JSON source path
+     * @param usedImage Set to true if the document was read from the image
+     * @return Parsed document
+     * @throws std::runtime_error if the source cannot be read or parsed
+     *
+     * The source is always read and hashed, so an image is never used for
+     * contents it was not built from. If the image is missing or stale the
+     * source is parsed and a new image is written; failing to write it (for
+     * example in a read-only directory) is not an error.
+     */
+    static JsonValue parseFile(const std::string& source, bool* usedImage = nullptr) {
+        if (usedImage) {
+            *usedImage = false;
+        }
+
+        int64_t mtime = modificationTime(source);
+        std::string content;
+        if (!readFile(source, content)) {
+            throw std::runtime_error("Failed to open file: " + source);
+        }
+
+        JsonValue value;
+        if (readImage(source, content, mtime, value)) {
+            if (usedImage) {
+                *usedImage = true;
+            }
+            return value;
+        }
+
+        value = JsonParser::parse(content);
+        writeImage(source, content, mtime, value);
+        return value;
+    }
+
+    /**
+     * @brief Read the image of a source if it matches the given contents
+     * @param source JSON source path
+     * @param content Current source contents
+     * @param mtime Current source modification time (see modificationTime())
+     * @param value Receives the document on success
+     * @return true if the image is current and valid
+     */
+    static bool readImage(const std::string& source, std::string_view content, int64_t mtime, JsonValue& value) {
+        // Images are only ever replaced by rename, so they are safe to map
+        MappedFile mapped;
+        try {
+            mapped = MappedFile(imagePath(source));
+        } catch (const std::runtime_error&) {
+            return false;
+        }
+        std::string_view image = mapped.view();
+        if (image.size() < sizeof(Header)) {
+            return false;
+        }
+
+        Header header;
+        std::memcpy(&header, image.data(), sizeof(Header));
+        std::string_view payload(image.data() + sizeof(Header), image.size() - sizeof(Header));
+        if (header.magic != Magic || header.version != Version ||
+            header.sourceSize != content.size() || header.sourceTime != mtime ||
+            header.payloadSize != payload.size() ||
+            header.sourceHash != hash(content) || header.payloadHash != hash(payload)) {
+            return false;
+        }
+
+        try {
+            MsgPackReader reader(payload);
+            value = reader.readValue();
+            return true;
+        } catch (const std::exception&) {
+            return false;
+        }
+    }
+
+    /**
+     * @brief Write the image of a parsed source
+     * @param source JSON source path
+     * @param content Source contents the document was parsed from
+     * @param mtime Source modification time read before the contents
+     * @param value Parsed document
+     * @return true if the image was written
+     *
+     * The image is written to a temporary file and renamed into place, so
+     * concurrent readers see either the old or the new image.
+     */
+    static bool writeImage(const std::string& source, std::string_view content, int64_t mtime, const JsonValue& value) {
+        MsgPackWriter writer;
+        writer.reserve(content.size() / 2 + 64);
+        writer.value(value);
+        std::string payload = writer.release();
+
+        Header header;
+        header.sourceSize = content.size();
+        header.sourceTime = mtime;
+        header.sourceHash = hash(content);
+        header.payloadSize = payload.size();
+        header.payloadHash = hash(payload);
+
+        std::string target = imagePath(source);
+        std::string temporary;
+        if (!TempFile::reserve(target, temporary)) {
+            return false;
+        }
+        {
+            std::ofstream file(temporary, std::ios::binary | std::ios::trunc);
+            if (!file.is_open()) {
+                std::error_code ignored;
+                std::filesystem::remove(temporary, ignored);
+                return false;
+            }
+            file.write(reinterpret_cast<const char*>(&header), sizeof(Header));
+            file.write(payload.data(), static_cast<std::streamsize>(payload.size()));
+            if (!file) {
+                file.close();
+                std::error_code ignored;
+                std::filesystem::remove(temporary, ignored);
+                return false;
+            }
+        }
+
+        std::error_code error;
+        std::filesystem::rename(temporary, target, error);
+        if (error) {
+            std::filesystem::remove(temporary, error);
+            return false;
+        }
+        return true;
+    }
+
+    /**
+     * @brief Remove the image of a source
+     * @param source JSON source path
+     * @return true if an image was removed
+     */
+    static bool invalidate(const std::string& source) {
+        std::error_code error;
+        return std::filesystem::remove(imagePath(source), error);
+    }
+
+    /**
+     * @brief Source modification time as stored in images
+     * @param path File path
+     * @return Ticks of the file clock, or 0 if unavailable
+     */
+    static int64_t modificationTime(const std::string& path) {
+        std::error_code error;
+        auto time = std::filesystem::last_write_time(path, error);
+        if (error) {
+            return 0;
+        }
+        return static_cast<int64_t>(time.time_since_epoch().count());
+    }
+
+    /**
+     * @brief 64-bit content hash used to validate images
+     * @param data Bytes to hash
+     * @return Hash value (see hashBytes())
+     */
+    static uint64_t hash(std::string_view data) {
+        return hashBytes(data);
+    }
+
+private:
+    // "MCFC" read as a native integer; images from the other byte order never match
+    static constexpr uint32_t Magic = 0x4346434du;
+
+    struct Header {
+        uint32_t magic = Magic;
+        uint32_t version = Version;
+        uint64_t sourceSize = 0;
+        int64_t sourceTime = 0;
+        uint64_t sourceHash = 0;
+        uint64_t payloadSize = 0;
+        uint64_t payloadHash = 0;
+    };
+
+    static bool readFile(const std::string& path, std::string& content) {
+        std::ifstream file(path, std::ios::binary);
+        if (!file.is_open()) {
+            return false;
+        }
+        file.seekg(0, std::ios::end);
+        std::streamoff size = file.tellg();
+        file.seekg(0, std::ios::beg);
+        content.clear();
+        if (size > 0) {
+            content.resize(static_cast<size_t>(size));
+            file.read(&content[0], size);
+            content.resize(static_cast<size_t>(file.gcount()));
+        }
+        return true;
+    }
+};
+
+} // namespace mcf
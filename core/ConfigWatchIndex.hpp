@@ -0,0 +1,204 @@
+#pragma once
+
+#include <algorithm>
+#include <cstdint>
+#include <limits>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace mcf {
+
+/**
+ * @brief Identifier of a configuration watch
+ */
+using ConfigWatchId = uint64_t;
+
+/**
+ * @brief Trie of configuration watch patterns
+ *
+ * Patterns are lists of key parts. In wildcard patterns "*" matches exactly
+ * one part and "**" matches any number of parts (including none); literal
+ * patterns match their parts only. Matching a changed path walks the parts
+ * of that path once instead of testing every registered watch.
+ *
+ * A watch matches a changed path when the pattern matches a prefix of the
+ * path (the change is at or below the watched value) or when the path ends
+ * inside the pattern (an ancestor of the watched value was replaced).
+ */
+class ConfigWatchIndex {
+private:
+    static constexpr uint32_t None = std::numeric_limits<uint32_t>::max();
+
+    struct Node {
+        std::unordered_map<std::string, uint32_t> children;
+        uint32_t star = None;      // "*"
+        uint32_t globstar = None;  // "**"
+        std::vector<ConfigWatchId> watches;
+    };
+
+    std::vector<Node> m_nodes{Node{}};
+    std::vector<uint32_t> m_free;  // Pruned nodes, reused before the vector grows
+
+    uint32_t find(uint32_t parent, const std::string& part, bool wildcards) const {
+        const Node& node = m_nodes[parent];
+        if (wildcards && part == "*") return node.star;
+        if (wildcards && part == "**") return node.globstar;
+        auto it = node.children.find(part);
+        return it != node.children.end() ? it->second : None;
+    }
+
+    uint32_t child(uint32_t parent, const std::string& part, bool wildcards) {
+        uint32_t next = find(parent, part, wildcards);
+        if (next != None) {
+            return next;
+        }
+
+        if (!m_free.empty()) {
+            next = m_free.back();
+            m_free.pop_back();
+        } else {
+            next = static_cast<uint32_t>(m_nodes.size());
+            m_nodes.emplace_back();
+        }
+        if (wildcards && part == "*") {
+            m_nodes[parent].star = next;
+        } else if (wildcards && part == "**") {
+            m_nodes[parent].globstar = next;
+        } else {
+            m_nodes[parent].children.emplace(part, next);
+        }
+        return next;
+    }
+
+    void unlink(uint32_t parent, const std::string& part, bool wildcards) {
+        if (wildcards && part == "*") {
+            m_nodes[parent].star = None;
+        } else if (wildcards && part == "**") {
+            m_nodes[parent].globstar = None;
+        } else {
+            m_nodes[parent].children.erase(part);
+        }
+    }
+
+    bool isEmpty(uint32_t node) const {
+        const Node& current = m_nodes[node];
+        return current.watches.empty() && current.children.empty() &&
+               current.star == None && current.globstar == None;
+    }
+
+    template<typename Callback>
+    void collectAll(uint32_t node, Callback& callback) const {
+        for (ConfigWatchId id : m_nodes[node].watches) {
+            callback(id, true);
+        }
+        for (const auto& entry : m_nodes[node].children) {
+            collectAll(entry.second, callback);
+        }
+        if (m_nodes[node].star != None) collectAll(m_nodes[node].star, callback);
+        if (m_nodes[node].globstar != None) collectAll(m_nodes[node].globstar, callback);
+    }
+
+    template<typename Callback>
+    void collect(uint32_t node, const std::vector<std::string>& path, size_t depth, Callback& callback) const {
+        const Node& current = m_nodes[node];
+        if (depth == path.size()) {
+            // The change replaced this node: everything watched here or below is affected
+            for (ConfigWatchId id : current.watches) {
+                callback(id, false);
+            }
+            for (const auto& entry : current.children) {
+                collectAll(entry.second, callback);
+            }
+            if (current.star != None) collectAll(current.star, callback);
+            if (current.globstar != None) collect(current.globstar, path, depth, callback);
+            return;
+        }
+
+        // Pattern consumed: the change is below the watched value
+        for (ConfigWatchId id : current.watches) {
+            callback(id, false);
+        }
+
+        auto it = current.children.find(path[depth]);
+        if (it != current.children.end()) {
+            collect(it->second, path, depth + 1, callback);
+        }
+        if (current.star != None) {
+            collect(current.star, path, depth + 1, callback);
+        }
+        if (current.globstar != None) {
+            for (size_t skip = depth; skip <= path.size(); ++skip) {
+                collect(current.globstar, path, skip, callback);
+            }
+        }
+    }
+
+public:
+    /**
+     * @brief Register a watch
+     * @param id Watch identifier
+     * @param parts Pattern parts
+     * @param wildcards Whether "*" and "**" parts are wildcards or literal keys
+     */
+    void add(ConfigWatchId id, const std::vector<std::string>& parts, bool wildcards) {
+        uint32_t node = 0;
+        for (const auto& part : parts) {
+            node = child(node, part, wildcards);
+        }
+        m_nodes[node].watches.push_back(id);
+    }
+
+    /**
+     * @brief Unregister a watch
+     * @param id Watch identifier
+     * @param parts Pattern parts it was added with
+     * @param wildcards Wildcard flag it was added with
+     * @return true if the watch was registered
+     */
+    bool remove(ConfigWatchId id, const std::vector<std::string>& parts, bool wildcards) {
+        std::vector<uint32_t> trail{0};
+        for (const auto& part : parts) {
+            uint32_t next = find(trail.back(), part, wildcards);
+            if (next == None) {
+                return false;
+            }
+            trail.push_back(next);
+        }
+        auto& watches = m_nodes[trail.back()].watches;
+        auto it = std::find(watches.begin(), watches.end(), id);
+        if (it == watches.end()) {
+            return false;
+        }
+        watches.erase(it);
+
+        // Prune the nodes this pattern no longer needs, deepest first
+        for (size_t depth = parts.size(); depth > 0 && isEmpty(trail[depth]); --depth) {
+            unlink(trail[depth - 1], parts[depth - 1], wildcards);
+            m_nodes[trail[depth]] = Node{};
+            m_free.push_back(trail[depth]);
+        }
+        return true;
+    }
+
+    /**
+     * @brief Number of trie nodes in use, including the root
+     */
+    size_t nodeCount() const {
+        return m_nodes.size() - m_free.size();
+    }
+
+    /**
+     * @brief Find the watches affected by a change
+     * @param path Parts of the changed path
+     * @param callback Called as callback(id, ancestorOnly) for every match; ancestorOnly
+     *        is true if only an ancestor of the watched value was replaced. A watch may
+     *        be reported more than once.
+     */
+    template<typename Callback>
+    void match(const std::vector<std::string>& path, Callback&& callback) const {
+        collect(0, path, 0, callback);
+    }
+};
+
+} // namespace mcf
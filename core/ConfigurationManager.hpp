@@ -1,16 +1,39 @@
 #pragma once
 
+#include "ConfigCache.hpp"
+#include "ConfigWatchIndex.hpp"
+#include "FileWatchService.hpp"
+#include "JsonBinding.hpp"
 #include "JsonParser.hpp"
+#include "JsonPatch.hpp"
 #include "JsonValue.hpp"
+#include "JsonWriter.hpp"
+#include "ThreadPool.hpp"
 
+#include <algorithm>
+#include <atomic>
+#include <cctype>
+#include <charconv>
+#include <chrono>
+#include <condition_variable>
+#include <cstdlib>
 #include <filesystem>
 #include <functional>
+#include <map>
 #include <memory>
 #include <mutex>
+#include <optional>
+#include <set>
 #include <string>
+#include <thread>
 #include <unordered_map>
+#include <utility>
 #include <vector>
 
+#ifndef _WIN32
+extern char** environ;
+#endif
+
 namespace mcf {
 
 /**
@@ -18,6 +41,265 @@ namespace mcf {
  */
 using ConfigChangeCallback = std::function<void(const std::string& key, const JsonValue& value)>;
 
+/**
+ * @brief Dot-notation configuration key split once into its parts
+ *
+ * Lookups through a compiled path skip the per-call key splitting and
+ * temporary strings of ConfigurationManager::get(const std::string&).
+ */
+class ConfigKeyPath {
+private:
+    std::string m_key;
+    std::vector<std::string> m_parts;
+
+public:
+    ConfigKeyPath() = default;
+
+    /**
+     * @brief Compile a key
+     * @param key Configuration key using dot notation (empty parts are skipped)
+     */
+    explicit ConfigKeyPath(std::string key) : m_key(std::move(key)) {
+        std::string current;
+        for (char c : m_key) {
+            if (c == '.') {
+                if (!current.empty()) {
+                    m_parts.push_back(std::move(current));
+                    current.clear();
+                }
+            } else {
+                current += c;
+            }
+        }
+        if (!current.empty()) {
+            m_parts.push_back(std::move(current));
+        }
+    }
+
+    /**
+     * @brief Get the original dot-notation key
+     * @return Key the path was compiled from
+     */
+    const std::string& key() const { return m_key; }
+
+    /**
+     * @brief Get the key parts
+     * @return Object keys from the root down to the value
+     */
+    const std::vector<std::string>& parts() const { return m_parts; }
+
+    /**
+     * @brief Resolve the path against a configuration tree
+     * @param root Configuration root
+     * @return Pointer to the value inside @p root, or nullptr if the path does not exist
+     */
+    const JsonValue* resolve(const JsonValue& root) const {
+        const JsonValue* current = &root;
+        for (const auto& part : m_parts) {
+            if (!current->isObject()) {
+                return nullptr;
+            }
+            const auto& object = current->asObject();
+            auto it = object.find(part);
+            if (it == object.end()) {
+                return nullptr;
+            }
+            current = &it->second;
+        }
+        return current;
+    }
+};
+
+/**
+ * @brief Immutable view of the whole configuration at one generation
+ *
+ * Snapshots are published by ConfigurationManager on every change and
+ * never modified afterwards, so reading any number of keys from one
+ * snapshot is consistent and needs no lock. Holding a snapshot keeps its
+ * tree alive; later changes build new trees that share unchanged subtrees.
+ */
+class ConfigSnapshot {
+private:
+    friend class ConfigurationManager;
+
+    struct Data {
+        JsonValue root;
+        uint64_t generation = 0;
+    };
+
+    std::shared_ptr<const Data> m_data;
+
+    explicit ConfigSnapshot(std::shared_ptr<const Data> data) : m_data(std::move(data)) {}
+
+public:
+    /**
+     * @brief Get the configuration root
+     * @return Root value (an object unless replaced by ConfigurationManager::set(""))
+     */
+    const JsonValue& root() const { return m_data->root; }
+
+    /**
+     * @brief Share the configuration root
+     * @return Pointer to the root that keeps this snapshot alive
+     */
+    std::shared_ptr<const JsonValue> share() const {
+        return std::shared_ptr<const JsonValue>(m_data, &m_data->root);
+    }
+
+    /**
+     * @brief Get the generation this snapshot was published at
+     * @return Value of ConfigurationManager::generation() for this tree
+     */
+    uint64_t generation() const { return m_data->generation; }
+
+    /**
+     * @brief Find a value by key without copying it
+     * @param key Configuration key using dot notation (empty parts are skipped)
+     * @return Pointer into the snapshot, or nullptr if not found
+     */
+    const JsonValue* find(const std::string& key) const {
+        const JsonValue* current = &m_data->root;
+        std::string part;
+        auto descend = [&]() {
+            if (!current->isObject()) return false;
+            const auto& object = current->asObject();
+            auto it = object.find(part);
+            if (it == object.end()) return false;
+            current = &it->second;
+            part.clear();
+            return true;
+        };
+
+        for (char c : key) {
+            if (c != '.') {
+                part += c;
+            } else if (!part.empty() && !descend()) {
+                return nullptr;
+            }
+        }
+        if (!part.empty() && !descend()) {
+            return nullptr;
+        }
+        return current;
+    }
+
+    /**
+     * @brief Find a value through a compiled key path without copying it
+     * @param path Key compiled once with ConfigKeyPath
+     * @return Pointer into the snapshot, or nullptr if not found
+     */
+    const JsonValue* find(const ConfigKeyPath& path) const {
+        return path.resolve(m_data->root);
+    }
+
+    /**
+     * @brief Get configuration value by key
+     * @param key Configuration key using dot notation
+     * @param defaultValue Default value to return if the key is not found
+     * @return The JsonValue at the specified key, or defaultValue if not found
+     */
+    JsonValue get(const std::string& key, const JsonValue& defaultValue = JsonValue()) const {
+        const JsonValue* value = find(key);
+        return value ? *value : defaultValue;
+    }
+
+    /**
+     * @brief Get configuration value through a compiled key path
+     * @param path Key compiled once with ConfigKeyPath
+     * @param defaultValue Default value to return if the key is not found
+     * @return The JsonValue at the specified path, or defaultValue if not found
+     */
+    JsonValue get(const ConfigKeyPath& path, const JsonValue& defaultValue = JsonValue()) const {
+        const JsonValue* value = find(path);
+        return value ? *value : defaultValue;
+    }
+
+    /**
+     * @brief Check if the snapshot has a non-null value for a key
+     * @param key Configuration key using dot notation
+     * @return true if the key exists and is not null
+     */
+    bool has(const std::string& key) const {
+        const JsonValue* value = find(key);
+        return value && !value->isNull();
+    }
+
+    /**
+     * @brief Get string value
+     * @param key Configuration key using dot notation
+     * @param defaultValue Default value to return if the key is not found or is not a string
+     * @return The string value at the specified key, or defaultValue
+     */
+    std::string getString(const std::string& key, const std::string& defaultValue = "") const {
+        const JsonValue* value = find(key);
+        return value ? value->asString(defaultValue) : defaultValue;
+    }
+
+    /**
+     * @brief Get integer value
+     * @param key Configuration key using dot notation
+     * @param defaultValue Default value to return if the key is not found or is not a number
+     * @return The integer value at the specified key, or defaultValue
+     */
+    int64_t getInt(const std::string& key, int64_t defaultValue = 0) const {
+        const JsonValue* value = find(key);
+        return value ? value->asInt(defaultValue) : defaultValue;
+    }
+
+    /**
+     * @brief Get float value
+     * @param key Configuration key using dot notation
+     * @param defaultValue Default value to return if the key is not found or is not a number
+     * @return The float value at the specified key, or defaultValue
+     */
+    double getFloat(const std::string& key, double defaultValue = 0.0) const {
+        const JsonValue* value = find(key);
+        return value ? value->asFloat(defaultValue) : defaultValue;
+    }
+
+    /**
+     * @brief Get boolean value
+     * @param key Configuration key using dot notation
+     * @param defaultValue Default value to return if the key is not found or is not a boolean
+     * @return The boolean value at the specified key, or defaultValue
+     */
+    bool getBool(const std::string& key, bool defaultValue = false) const {
+        const JsonValue* value = find(key);
+        return value ? value->asBool(defaultValue) : defaultValue;
+    }
+};
+
+/**
+ * @brief Changes delivered to a subtree watch
+ */
+struct ConfigChangeBatch {
+    std::string pattern;             ///< Pattern the watch was registered with
+    std::vector<std::string> paths;  ///< Changed keys (dot notation) matching the pattern, sorted
+    ConfigSnapshot snapshot;         ///< Configuration after the change
+};
+
+/**
+ * @brief Subtree watch callback type
+ */
+using ConfigBatchCallback = std::function<void(const ConfigChangeBatch& batch)>;
+
+template<typename T>
+class ConfigHandle;
+
+/**
+ * @brief Standard layer priorities (higher values take precedence)
+ *
+ * Any int is a valid priority; these document the intended order. The
+ * manager's own document (load()/save()/set()) is the Runtime layer.
+ */
+struct ConfigPriority {
+    static constexpr int Defaults = 0;
+    static constexpr int Base = 100;
+    static constexpr int Environment = 200;
+    static constexpr int EnvironmentVariables = 300;
+    static constexpr int Runtime = 1000;
+};
+
 /**
  * @brief Configuration manager for JSON-based application and plugin configuration
  *
@@ -26,38 +308,566 @@ using ConfigChangeCallback = std::function<void(const std::string& key, const Js
  * - Hierarchical configuration (sections)
  * - Type-safe value retrieval
  * - Configuration change notifications
- * - Thread-safe operations
- * - Hot-reload support
+ * - Thread-safe operations: readers load an immutable snapshot (RCU-style)
+ *   and never take the writer lock
+ * - Hot-reload support notifying only the keys that changed
+ * - JSON Patch (RFC 6902) application for incremental updates
+ * - Layered configuration: defaults, files and environment variables below
+ *   the runtime document, merged into one precomputed view
+ *
+ * Objects are merged key by key across layers; any other value (including
+ * arrays) from a higher layer replaces the lower layers' values. Reads go to
+ * the merged view and cost the same as reading a single document.
  */
 class ConfigurationManager {
 private:
-    // Root configuration
+    /**
+     * @brief Named configuration layer below or above the runtime document
+     */
+    struct Layer {
+        std::string name;
+        int priority = 0;
+        uint64_t sequence = 0;  // Later layers win priority ties
+        JsonValue document;
+        std::string path;       // Source file reloaded by reload(), if any
+    };
+
+    // Runtime document: loaded, saved and modified by set()/remove()/applyPatch()
+    JsonValue m_document;
+
+    // Other layers, ordered by ascending (priority, sequence)
+    std::vector<Layer> m_layers;
+    uint64_t m_layerSequence = 0;
+
+    // Merged view of m_document and m_layers (writers' working tree, guarded by m_mutex)
     JsonValue m_config;
 
+    // Last published snapshot of m_config; accessed with std::atomic_load/atomic_store
+    std::shared_ptr<const ConfigSnapshot::Data> m_snapshot;
+
     // Configuration file path
     std::string m_configPath;
 
-    // Change callbacks (key -> callback)
-    std::unordered_map<std::string, std::vector<ConfigChangeCallback>> m_callbacks;
+    /**
+     * @brief Registered key or subtree watch
+     */
+    struct WatchEntry {
+        std::string pattern;
+        std::vector<std::string> parts;
+        bool subtree = false;             // watchTree(): wildcards, batched delivery
+        ConfigChangeCallback onChange;    // watch()
+        ConfigBatchCallback onBatch;      // watchTree()
+    };
+
+    /**
+     * @brief Watches with their pattern index
+     *
+     * Notifications hold a reference while dispatching, so registration
+     * copies the registry only if one is in flight.
+     */
+    struct WatchRegistry {
+        ConfigWatchIndex index;
+        std::map<ConfigWatchId, WatchEntry> entries;  // Ordered by registration
+    };
+
+    std::shared_ptr<WatchRegistry> m_watches = std::make_shared<WatchRegistry>();
+    ConfigWatchId m_nextWatchId = 1;
 
-    // Thread safety
+    // Runs subtree watch callbacks if set
+    ThreadPool* m_notificationPool = nullptr;
+
+    // Serializes writers and guards the members above except m_snapshot
     mutable std::mutex m_mutex;
 
     // Dirty flag for auto-save
     bool m_dirty = false;
 
+    // Number of changes to m_document; save() clears m_dirty only if none happened while writing
+    uint64_t m_changeCount = 0;
+
+    // Background auto-save; guarded by m_saveMutex
+    std::mutex m_saveMutex;
+    std::condition_variable m_saveCondition;
+    std::thread m_saveThread;
+    std::chrono::milliseconds m_saveDelay{500};
+    std::chrono::steady_clock::time_point m_saveDeadline;
+    bool m_autoSave = false;
+    bool m_savePending = false;
+    bool m_saveStop = false;
+
+    // Serializes file writes of save() and the auto-saver
+    std::mutex m_writeMutex;
+
+    // Generation of m_snapshot; read lock-free by ConfigHandle
+    std::atomic<uint64_t> m_generation{0};
+
+    // Reload on file changes; guarded by m_fileWatchMutex
+    mutable std::mutex m_fileWatchMutex;
+    FileWatchService* m_fileWatchService = nullptr;
+    FileWatchOptions m_fileWatchOptions;
+    std::map<std::string, FileWatchId> m_fileWatches;  // Watched file -> subscription
+
+    // Modification time and size of the file written by the last save() (guarded by m_mutex),
+    // so that the file watch does not reload the manager's own writes
+    std::filesystem::file_time_type m_savedTime{};
+    uintmax_t m_savedSize = 0;
+
+    // Read files through ConfigCache images
+    std::atomic<bool> m_binaryCache{false};
+
     /**
-     * @brief Navigate to a nested value using dot notation
-     * @param key Configuration key using dot notation (e.g., "section.subsection.value")
-     * @param createPath If true, creates missing intermediate objects in the path
+     * @brief Parse a configuration file
+     * @param path JSON file path
+     * @return Parsed document
+     * @throws std::runtime_error if the file cannot be read or parsed
+     */
+    JsonValue parseFile(const std::string& path) const {
+        if (m_binaryCache.load(std::memory_order_relaxed)) {
+            return ConfigCache::parseFile(path);
+        }
+        return JsonParser::parseFile(path);
+    }
+
+    /**
+     * @brief Record a change to the runtime document
+     *
+     * Must be called while holding m_mutex.
+     */
+    void markDirty() {
+        m_dirty = true;
+        ++m_changeCount;
+
+        std::lock_guard<std::mutex> lock(m_saveMutex);
+        if (m_autoSave && !m_savePending) {
+            // The window starts at the first change, so a steady stream of writes still saves
+            m_savePending = true;
+            m_saveDeadline = std::chrono::steady_clock::now() + m_saveDelay;
+            m_saveCondition.notify_one();
+        }
+    }
+
+    /**
+     * @brief Auto-save thread: writes once per debounce window with pending changes
+     */
+    void saveLoop() {
+        std::unique_lock<std::mutex> lock(m_saveMutex);
+        while (true) {
+            m_saveCondition.wait(lock, [this] { return m_saveStop || m_savePending; });
+            if (m_saveStop) {
+                return;
+            }
+            if (m_saveCondition.wait_until(lock, m_saveDeadline, [this] { return m_saveStop; })) {
+                return;
+            }
+
+            m_savePending = false;
+            lock.unlock();
+            save();
+            lock.lock();
+        }
+    }
+
+    /**
+     * @brief Stop the auto-save thread
+     */
+    void stopAutoSave() {
+        {
+            std::lock_guard<std::mutex> lock(m_saveMutex);
+            m_autoSave = false;
+            m_savePending = false;
+            m_saveStop = true;
+            m_saveCondition.notify_one();
+        }
+        if (m_saveThread.joinable()) {
+            m_saveThread.join();
+        }
+        std::lock_guard<std::mutex> lock(m_saveMutex);
+        m_saveStop = false;
+    }
+
+    /**
+     * @brief Publish m_config as a new immutable snapshot
+     *
+     * The snapshot shares m_config's containers; the next write copies the
+     * containers on its path (copy-on-write) instead of touching the
+     * published tree. Must be called while holding m_mutex, after m_config
+     * was modified.
+     */
+    void publish() {
+        auto data = std::make_shared<ConfigSnapshot::Data>();
+        data->root = m_config;
+        data->generation = m_generation.load(std::memory_order_relaxed) + 1;
+        uint64_t generation = data->generation;
+
+        std::atomic_store_explicit(&m_snapshot, std::shared_ptr<const ConfigSnapshot::Data>(std::move(data)),
+                                   std::memory_order_release);
+        m_generation.store(generation, std::memory_order_release);
+    }
+
+    /**
+     * @brief Navigate to a nested value for in-place modification
+     * @param root Document to navigate
+     * @param parts Key parts (see splitKey())
+     * @param createPath If true, missing or non-object intermediate values are
+     *        replaced by objects and a missing last part is inserted as null
      * @return Pointer to the JsonValue at the specified path, or nullptr if not found
+     *
+     * Only the containers along the path are unshared (copy-on-write), so a
+     * write costs O(depth) map operations instead of copying the whole tree.
+     */
+    static JsonValue* navigate(JsonValue& root, const std::vector<std::string>& parts, bool createPath = false) {
+        if (!createPath) {
+            // Check first so a lookup miss does not unshare anything
+            const JsonValue* existing = &root;
+            for (const auto& part : parts) {
+                if (!existing->isObject()) return nullptr;
+                const auto& object = existing->asObject();
+                auto it = object.find(part);
+                if (it == object.end()) return nullptr;
+                existing = &it->second;
+            }
+        }
+
+        JsonValue* current = &root;
+        for (const auto& part : parts) {
+            if (!current->isObject()) {
+                *current = JsonValue(JsonObject());
+            }
+            JsonObject& object = current->asMutableObject();
+            current = createPath ? &object[part] : &object.find(part)->second;
+        }
+        return current;
+    }
+
+    /**
+     * @brief Remove a nested value
+     * @param root Document to modify
+     * @param parts Key parts (see splitKey())
+     * @return true if the value existed and was removed
+     */
+    static bool removePath(JsonValue& root, const std::vector<std::string>& parts) {
+        if (parts.empty()) {
+            return false;
+        }
+        JsonValue* parent = navigate(root, std::vector<std::string>(parts.begin(), parts.end() - 1));
+        if (!parent || !parent->has(parts.back())) {
+            return false;
+        }
+        parent->asMutableObject().erase(parts.back());
+        return true;
+    }
+
+    /**
+     * @brief Get the number of leading parts that address a value a write changes
+     * @param root Document before the write
+     * @param parts Key parts of the write
+     * @return Length of the shortest prefix whose value the write creates or replaces
+     *
+     * Writing below a missing key or a non-object creates or replaces that
+     * value, so the merged view must be recomputed from there.
+     */
+    static size_t changedDepth(const JsonValue& root, const std::vector<std::string>& parts) {
+        const JsonValue* current = &root;
+        for (size_t i = 0; i < parts.size(); ++i) {
+            if (!current->isObject()) {
+                return i;
+            }
+            const auto& object = current->asObject();
+            auto it = object.find(parts[i]);
+            if (it == object.end()) {
+                return i + 1;
+            }
+            current = &it->second;
+        }
+        return parts.size();
+    }
+
+    /**
+     * @brief Get the number of leading parts of a JSON Pointer that address object members
+     * @param root Document to walk
+     * @param tokens Path tokens
+     * @return Tokens before the first array index (arrays are merged as a whole)
+     */
+    static size_t objectDepth(const JsonValue& root, const std::vector<std::string>& tokens) {
+        const JsonValue* current = &root;
+        for (size_t i = 0; i < tokens.size(); ++i) {
+            if (current->isArray()) {
+                return i;
+            }
+            if (!current->isObject()) {
+                return tokens.size();
+            }
+            const auto& object = current->asObject();
+            auto it = object.find(tokens[i]);
+            if (it == object.end()) {
+                return tokens.size();
+            }
+            current = &it->second;
+        }
+        return tokens.size();
+    }
+
+    /**
+     * @brief Get all layer documents, highest precedence first
+     * @return Pointers to the documents of m_layers and m_document
+     */
+    std::vector<const JsonValue*> layerStack() const {
+        std::vector<const JsonValue*> stack;
+        stack.reserve(m_layers.size() + 1);
+        bool documentAdded = false;
+        for (auto it = m_layers.rbegin(); it != m_layers.rend(); ++it) {
+            if (!documentAdded && it->priority <= ConfigPriority::Runtime) {
+                stack.push_back(&m_document);  // Wins ties with Runtime-priority layers
+                documentAdded = true;
+            }
+            stack.push_back(&it->document);
+        }
+        if (!documentAdded) {
+            stack.push_back(&m_document);
+        }
+        return stack;
+    }
+
+    /**
+     * @brief Merge objects key by key
+     * @param objects Object values, highest precedence first
+     * @return Merged object; a single object is shared, not copied
+     */
+    static JsonValue mergeObjects(const std::vector<const JsonValue*>& objects) {
+        if (objects.size() == 1) {
+            return *objects.front();
+        }
+
+        JsonObject merged;
+        std::vector<const JsonValue*> candidates;
+        for (const JsonValue* object : objects) {
+            for (const auto& entry : object->asObject()) {
+                const std::string& key = entry.first;
+                if (merged.count(key)) {
+                    continue;
+                }
+
+                candidates.clear();
+                for (const JsonValue* source : objects) {
+                    auto it = source->asObject().find(key);
+                    if (it == source->asObject().end()) {
+                        continue;
+                    }
+                    if (!it->second.isObject()) {
+                        if (candidates.empty()) {
+                            merged.emplace(key, it->second);
+                        }
+                        break;  // Hides lower layers
+                    }
+                    candidates.push_back(&it->second);
+                }
+                if (!candidates.empty()) {
+                    merged.emplace(key, mergeObjects(candidates));
+                }
+            }
+        }
+        return JsonValue(std::move(merged));
+    }
+
+    /**
+     * @brief Compute the merged value at a path
+     * @param stack Layer documents, highest precedence first
+     * @param parts Object keys from the root
+     * @param out Receives the merged value
+     * @return false if no layer provides a value at the path
+     */
+    static bool mergeAt(const std::vector<const JsonValue*>& stack, const std::vector<std::string>& parts,
+                        JsonValue& out) {
+        std::vector<const JsonValue*> objects;
+        for (const JsonValue* layer : stack) {
+            const JsonValue* current = layer;
+            bool hidden = false;
+            for (const auto& part : parts) {
+                if (!current->isObject()) {
+                    hidden = true;  // A non-object above the path hides lower layers
+                    break;
+                }
+                auto it = current->asObject().find(part);
+                if (it == current->asObject().end()) {
+                    current = nullptr;
+                    break;
+                }
+                current = &it->second;
+            }
+            if (hidden) {
+                break;
+            }
+            if (!current) {
+                continue;
+            }
+            if (!current->isObject()) {
+                if (objects.empty()) {
+                    out = *current;
+                    return true;
+                }
+                break;
+            }
+            objects.push_back(current);
+        }
+
+        if (objects.empty()) {
+            return false;
+        }
+        out = mergeObjects(objects);
+        return true;
+    }
+
+    /**
+     * @brief Recompute the merged view below a path after a layer changed there
+     * @param parts Object keys of the changed value
+     *
+     * Only the subtree at @p parts is rebuilt; ancestors keep sharing their
+     * other children. Must be called while holding m_mutex.
+     */
+    void remerge(std::vector<std::string> parts) {
+        if (m_layers.empty()) {
+            m_config = m_document;
+            return;
+        }
+
+        // Recompute from the first ancestor missing in the merged view
+        const JsonValue* current = &m_config;
+        for (size_t i = 0; i < parts.size(); ++i) {
+            if (!current->isObject()) {
+                return;  // Hidden by a non-object in a higher layer
+            }
+            auto it = current->asObject().find(parts[i]);
+            if (it == current->asObject().end()) {
+                parts.resize(i + 1);
+                break;
+            }
+            current = &it->second;
+        }
+
+        JsonValue merged;
+        bool present = mergeAt(layerStack(), parts, merged);
+        if (parts.empty()) {
+            m_config = present ? merged : JsonValue(JsonObject());
+            return;
+        }
+
+        JsonValue* parent = navigate(m_config, std::vector<std::string>(parts.begin(), parts.end() - 1));
+        JsonObject& object = parent->asMutableObject();
+        if (present) {
+            object[parts.back()] = std::move(merged);
+        } else {
+            object.erase(parts.back());
+        }
+    }
+
+    /**
+     * @brief Recompute the merged view where a layer document changed
+     * @param before Layer document before the change
+     * @param after Layer document after the change
+     * @param patch Operations turning @p before into @p after
+     *
+     * Must be called while holding m_mutex, after the layer was updated.
      */
-    JsonValue* navigate(const std::string& key, bool createPath = false) {
-        if (key.empty()) {
-            return &m_config;
+    void remergePatch(const JsonValue& before, const JsonValue& after, const JsonPatch& patch) {
+        if (m_layers.empty()) {
+            m_config = m_document;
+            return;
+        }
+        for (const auto& operation : patch.operations()) {
+            for (const std::string* pointer : {&operation.path, &operation.from}) {
+                if (pointer == &operation.from && operation.op != JsonPatchOp::Move) {
+                    continue;
+                }
+                std::vector<std::string> tokens = JsonPointer::parse(*pointer);
+                tokens.resize(std::min(objectDepth(before, tokens), objectDepth(after, tokens)));
+                remerge(std::move(tokens));
+            }
         }
+    }
+
+    /**
+     * @brief Find a layer by name
+     * @param name Layer name
+     * @return Iterator into m_layers, or end()
+     */
+    std::vector<Layer>::iterator findLayer(const std::string& name) {
+        return std::find_if(m_layers.begin(), m_layers.end(),
+                            [&](const Layer& layer) { return layer.name == name; });
+    }
 
-        // Split key by dots
+    /**
+     * @brief Add or replace a layer and update the merged view
+     * @param name Layer name
+     * @param priority Layer priority
+     * @param document Layer contents
+     * @param path Source file, or empty
+     *
+     * Must be called while holding m_mutex.
+     */
+    void replaceLayer(const std::string& name, int priority, JsonValue document, const std::string& path) {
+        auto it = findLayer(name);
+        if (it != m_layers.end() && it->priority == priority) {
+            // Same position: recompute only what changed
+            JsonValue before = it->document;
+            it->document = std::move(document);
+            it->path = path;
+            remergePatch(before, it->document, JsonPatch::diff(before, it->document));
+            return;
+        }
+
+        if (it != m_layers.end()) {
+            m_layers.erase(it);
+        }
+        Layer layer{name, priority, ++m_layerSequence, std::move(document), path};
+        auto position = std::upper_bound(m_layers.begin(), m_layers.end(), layer,
+                                         [](const Layer& a, const Layer& b) { return a.priority < b.priority; });
+        m_layers.insert(position, std::move(layer));
+        remerge({});
+    }
+
+    /**
+     * @brief Convert an environment variable value to JSON
+     * @param text Variable value
+     * @return Boolean, null, integer, float, JSON container or string
+     */
+    static JsonValue parseEnvironmentValue(const std::string& text) {
+        if (text == "true") return JsonValue(true);
+        if (text == "false") return JsonValue(false);
+        if (text == "null") return JsonValue();
+
+        if (!text.empty()) {
+            const char* begin = text.data();
+            const char* end = begin + text.size();
+            const char* digits = (text.front() == '-') ? begin + 1 : begin;
+            if (digits < end && std::isdigit(static_cast<unsigned char>(*digits))) {
+                int64_t integer = 0;
+                auto intResult = std::from_chars(begin, end, integer);
+                if (intResult.ec == std::errc() && intResult.ptr == end) {
+                    return JsonValue(integer);
+                }
+                double number = 0.0;
+                auto floatResult = std::from_chars(begin, end, number);
+                if (floatResult.ec == std::errc() && floatResult.ptr == end) {
+                    return JsonValue(number);
+                }
+            }
+            if (text.front() == '{' || text.front() == '[') {
+                try {
+                    return JsonParser::parse(text);
+                } catch (const std::exception&) {
+                    // Not JSON after all: keep the string
+                }
+            }
+        }
+        return JsonValue(text);
+    }
+
+    /**
+     * @brief Split a dot-notation key into its parts (empty parts are skipped)
+     * @param key Configuration key
+     * @return Key parts
+     */
+    static std::vector<std::string> splitKey(const std::string& key) {
         std::vector<std::string> parts;
         std::string current;
         for (char c : key) {
@@ -73,57 +883,229 @@ private:
         if (!current.empty()) {
             parts.push_back(current);
         }
+        return parts;
+    }
 
-        // Navigate through the hierarchy
-        JsonValue* current_value = &m_config;
-        for (size_t i = 0; i < parts.size(); ++i) {
-            const auto& part = parts[i];
+    /**
+     * @brief Get the watch registry for modification
+     * @return Registry owned only by this manager
+     *
+     * Must be called while holding m_mutex.
+     */
+    WatchRegistry& mutableWatches() {
+        if (m_watches.use_count() > 1) {
+            m_watches = std::make_shared<WatchRegistry>(*m_watches);
+        }
+        return *m_watches;
+    }
 
-            if (!current_value->isObject()) {
-                if (createPath) {
-                    *current_value = JsonValue(JsonObject());
-                } else {
-                    return nullptr;
+    /**
+     * @brief Notify the watches a patch affected
+     * @param before Configuration before the patch
+     * @param after Configuration after the patch
+     * @param patch Operations turning @p before into @p after
+     *
+     * The changed paths are looked up in the watch index, so unaffected
+     * watches cost nothing. A key watch is notified once if a change touched
+     * it, something below it, or an enclosing value whose replacement
+     * changed its value. A subtree watch receives one batch with all of its
+     * changed paths, on the notification pool if one is set. Must be called
+     * without holding m_mutex.
+     */
+    void notifyPatch(const JsonValue& before, const ConfigSnapshot& after, const JsonPatch& patch) {
+        if (patch.empty()) {
+            return;
+        }
+
+        std::shared_ptr<const WatchRegistry> registry;
+        ThreadPool* pool = nullptr;
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            registry = m_watches;
+            pool = m_notificationPool;
+        }
+        if (registry->entries.empty()) {
+            return;
+        }
+
+        struct Hit {
+            bool confirmed = false;  // Changed at or below the watched value
+            std::vector<std::string> paths;
+        };
+        std::map<ConfigWatchId, Hit> hits;
+
+        for (const auto& operation : patch.operations()) {
+            for (const std::string* pointer : {&operation.path, &operation.from}) {
+                if (pointer == &operation.from && operation.op != JsonPatchOp::Move) {
+                    continue;
+                }
+                std::vector<std::string> tokens = JsonPointer::parse(*pointer);
+                std::string dotted;
+                for (const auto& token : tokens) {
+                    if (!dotted.empty()) dotted += '.';
+                    dotted += token;
                 }
+
+                // Keys below the changed path exist only if it held an object before or after
+                int container = -1;
+                auto hasChildren = [&]() {
+                    if (container < 0) {
+                        const JsonValue* oldValue = JsonPointer::resolve(before, tokens);
+                        const JsonValue* newValue = JsonPointer::resolve(after.root(), tokens);
+                        container = (oldValue && (oldValue->isObject() || oldValue->isArray())) ||
+                                    (newValue && (newValue->isObject() || newValue->isArray()));
+                    }
+                    return container == 1;
+                };
+
+                registry->index.match(tokens, [&](ConfigWatchId id, bool ancestorOnly) {
+                    if (ancestorOnly && !hasChildren()) {
+                        return;
+                    }
+                    Hit& hit = hits[id];
+                    hit.confirmed = hit.confirmed || !ancestorOnly;
+                    if (hit.paths.empty() || hit.paths.back() != dotted) {
+                        hit.paths.push_back(dotted);
+                    }
+                });
             }
+        }
 
-            // For non-const access, we need to handle this differently
-            // Since we're returning a pointer, we'll work with the internal structure
-            if (i == parts.size() - 1) {
-                // Last part - return reference to this value
-                if (!current_value->has(part) && createPath) {
-                    // We need to insert a new value, but we can't modify through const reference
-                    // This is a limitation of the current design
-                    return nullptr; // Will be handled by set method
+        for (auto& [id, hit] : hits) {
+            const WatchEntry& entry = registry->entries.at(id);
+            if (entry.subtree) {
+                std::sort(hit.paths.begin(), hit.paths.end());
+                hit.paths.erase(std::unique(hit.paths.begin(), hit.paths.end()), hit.paths.end());
+                ConfigChangeBatch batch{entry.pattern, std::move(hit.paths), after};
+                if (pool) {
+                    pool->submit([callback = entry.onBatch, batch = std::move(batch)]() { callback(batch); });
+                } else {
+                    entry.onBatch(batch);
                 }
+                continue;
             }
 
-            if (!current_value->has(part)) {
-                return nullptr;
+            const JsonValue* newValue = JsonPointer::resolve(after.root(), entry.parts);
+            if (!hit.confirmed) {
+                // Only an enclosing value changed; compare the watched value itself
+                const JsonValue* oldValue = JsonPointer::resolve(before, entry.parts);
+                if (!oldValue && !newValue) continue;
+                if (oldValue && newValue && JsonPatch::equals(*oldValue, *newValue)) continue;
             }
-
-            // Note: This is unsafe but necessary for the current architecture
-            // In a production system, consider redesigning to avoid const_cast
-            const JsonValue& next = (*current_value)[part];
-            current_value = const_cast<JsonValue*>(&next);
+            entry.onChange(entry.pattern, newValue ? *newValue : JsonValue());
         }
+    }
 
-        return current_value;
+    /**
+     * @brief Change the merged view and notify the watchers it affected
+     * @param apply Called while holding m_mutex; returns false if nothing changed
+     * @return Result of @p apply
+     *
+     * The configuration before and after the change is captured in the same
+     * critical section as the change and published once, so a concurrent
+     * writer never leaks into this change's notifications.
+     */
+    template<typename Apply>
+    bool changeAndNotify(Apply&& apply, const std::vector<std::vector<std::string>>* changed = nullptr) {
+        JsonValue before;
+        std::shared_ptr<const ConfigSnapshot::Data> after;
+        bool notify = false;
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            before = m_config;  // Shares the tree; the change copies only its paths
+            if (!apply()) {
+                return false;
+            }
+            publish();
+            after = std::atomic_load_explicit(&m_snapshot, std::memory_order_relaxed);
+            notify = !m_watches->entries.empty();
+        }
+        if (notify) {
+            JsonPatch patch = changed ? diffBelow(before, after->root, *changed) : JsonPatch::diff(before, after->root);
+            notifyPatch(before, ConfigSnapshot(after), patch);
+        }
+        return true;
     }
 
     /**
-     * @brief Notify callbacks of configuration change
-     * @param key Configuration key that changed
-     * @param value New value for the key
+     * @brief Diff the merged view only where a change wrote
+     * @param before Merged configuration before the change
+     * @param after Merged configuration after the change
+     * @param paths Key parts the change wrote or removed in its layer
+     * @return Operations turning @p before into @p after below @p paths; empty
+     *         if a higher-priority layer hides every written key
      */
-    void notifyChange(const std::string& key, const JsonValue& value) {
-        auto it = m_callbacks.find(key);
-        if (it != m_callbacks.end()) {
-            // Copy callbacks to prevent deadlock if callback modifies config
-            auto callbacks = it->second;
-            for (const auto& callback : callbacks) {
-                callback(key, value);
+    static JsonPatch diffBelow(const JsonValue& before, const JsonValue& after,
+                               std::vector<std::vector<std::string>> paths) {
+        auto member = [](const JsonValue* value, const std::string& key) -> const JsonValue* {
+            auto it = value->asObject().find(key);
+            return it == value->asObject().end() ? nullptr : &it->second;
+        };
+
+        // Stop where either tree has no object to descend into; that value is compared whole
+        for (auto& parts : paths) {
+            const JsonValue* oldValue = &before;
+            const JsonValue* newValue = &after;
+            size_t depth = 0;
+            while (depth < parts.size() && oldValue && newValue && oldValue->isObject() && newValue->isObject()) {
+                oldValue = member(oldValue, parts[depth]);
+                newValue = member(newValue, parts[depth]);
+                ++depth;
             }
+            parts.resize(depth);
+        }
+        std::sort(paths.begin(), paths.end());
+
+        JsonPatch patch;
+        const std::vector<std::string>* covered = nullptr;
+        for (const auto& parts : paths) {
+            if (covered && covered->size() <= parts.size() &&
+                std::equal(covered->begin(), covered->end(), parts.begin())) {
+                continue;  // Inside a subtree already diffed
+            }
+            covered = &parts;
+
+            const JsonValue* oldValue = JsonPointer::resolve(before, parts);
+            const JsonValue* newValue = JsonPointer::resolve(after, parts);
+            std::string pointer = JsonPointer::join(parts);
+            if (!oldValue && newValue) {
+                patch.add({JsonPatchOp::Add, pointer, "", *newValue});
+            } else if (oldValue && !newValue) {
+                patch.add({JsonPatchOp::Remove, pointer, "", JsonValue()});
+            } else if (oldValue && newValue) {
+                JsonPatch changes = JsonPatch::diff(*oldValue, *newValue);
+                for (JsonPatchOperation operation : changes.operations()) {
+                    operation.path.insert(0, pointer);
+                    patch.add(std::move(operation));
+                }
+            }
+        }
+        return patch;
+    }
+
+    /**
+     * @brief Replace the runtime document and update the merged view
+     * @param document New runtime document
+     * @param path File the document was loaded from
+     *
+     * Must be called while holding m_mutex; the caller publishes.
+     */
+    void replaceDocument(JsonValue document, const std::string& path) {
+        std::swap(m_document, document);
+        m_configPath = path;
+        remergePatch(document, m_document, m_layers.empty() ? JsonPatch() : JsonPatch::diff(document, m_document));
+    }
+
+    /**
+     * @brief Parse a configuration file
+     * @param path JSON file
+     * @return Document, or nothing if the file cannot be read or parsed
+     */
+    std::optional<JsonValue> tryParseFile(const std::string& path) const {
+        try {
+            return parseFile(path);
+        } catch (const std::exception&) {
+            return std::nullopt;
         }
     }
 
@@ -133,15 +1115,20 @@ public:
      *
      * Initializes the configuration manager with an empty JSON object.
      */
-    ConfigurationManager() : m_config(JsonObject()) {}
+    ConfigurationManager()
+        : m_document(JsonObject()),
+          m_config(m_document),
+          m_snapshot(std::make_shared<ConfigSnapshot::Data>(ConfigSnapshot::Data{m_config, 0})) {}
 
     /**
      * @brief Destructor
      *
-     * Automatically saves configuration to file if there are unsaved changes
-     * and a configuration path has been set.
+     * Stops auto-saving and saves configuration to file if there are unsaved
+     * changes and a configuration path has been set.
      */
     ~ConfigurationManager() {
+        stopFileWatching();
+        stopAutoSave();
         if (m_dirty && !m_configPath.empty()) {
             save(m_configPath);
         }
@@ -168,66 +1155,371 @@ public:
      * @brief Load configuration from JSON file
      * @param path Path to the JSON configuration file to load
      * @return true if the file was loaded successfully, false otherwise
+     *
+     * A file that cannot be read or parsed leaves the current configuration
+     * in place. Only the first load starts from an empty document instead,
+     * so save() still has a target.
      */
     bool load(const std::string& path) {
-        std::lock_guard<std::mutex> lock(m_mutex);
+        bool success = loadDocument(path);
+        refreshFileWatches();
+        return success;
+    }
 
-        try {
-            m_config = JsonParser::parseFile(path);
-            m_configPath = path;
+private:
+    /**
+     * @brief Replace the runtime document with a file's contents (see load())
+     */
+    bool loadDocument(const std::string& path) {
+        // Parse off to the side; readers keep using the current snapshot meanwhile
+        std::optional<JsonValue> loaded = tryParseFile(path);
+
+        std::lock_guard<std::mutex> lock(m_mutex);
+        if (loaded) {
+            replaceDocument(std::move(*loaded), path);
             m_dirty = false;
-            return true;
-        } catch (const std::exception&) {
-            // If file doesn't exist or is invalid, start with empty config
-            m_config = JsonValue(JsonObject());
-            m_configPath = path;
-            return false;
+        } else if (m_configPath.empty()) {
+            // First load of a missing or invalid file: start with empty config
+            replaceDocument(JsonValue(JsonObject()), path);
+        } else {
+            return false;  // Keep the current document
         }
+        publish();
+        return loaded.has_value();
     }
 
+public:
+
     /**
      * @brief Save configuration to JSON file
      * @param path Path to save the configuration file. If empty, uses the last loaded path
      * @return true if the file was saved successfully, false otherwise
+     *
+     * The file is replaced atomically (temporary file, fsync, rename), so a
+     * crash never leaves a truncated configuration behind. The manager mutex
+     * is held only to take a shared copy of the document.
      */
     bool save(const std::string& path = "") {
+        std::lock_guard<std::mutex> writeLock(m_writeMutex);
+
+        // Serialize a shared copy of the document; writers are not blocked meanwhile
+        std::string savePath;
+        JsonValue document;
+        uint64_t changeCount = 0;
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            savePath = path.empty() ? m_configPath : path;
+            if (savePath.empty()) {
+                return false;
+            }
+            document = m_document;
+            changeCount = m_changeCount;
+        }
+
+        try {
+            // Ensure directory exists
+            std::filesystem::path filePath(savePath);
+            if (filePath.has_parent_path()) {
+                std::filesystem::create_directories(filePath.parent_path());
+            }
+
+            if (!JsonWriter::writeFileAtomic(savePath, document, JsonWriter::Style::Pretty)) {
+                return false;
+            }
+        } catch (const std::filesystem::filesystem_error&) {
+            // Failed to create directory or write file (e.g., path is invalid, device file, or permission denied)
+            return false;
+        }
+
+        std::error_code error;
+        auto savedTime = std::filesystem::last_write_time(savePath, error);
+        auto savedSize = std::filesystem::file_size(savePath, error);
+
         std::lock_guard<std::mutex> lock(m_mutex);
+        m_savedTime = savedTime;
+        m_savedSize = error ? 0 : savedSize;
+        if (m_changeCount == changeCount) {
+            m_dirty = false;
+        }
+        if (!path.empty()) {
+            m_configPath = path;
+        }
+        return true;
+    }
 
-        std::string savePath = path.empty() ? m_configPath : path;
-        if (savePath.empty()) {
+    /**
+     * @brief Reload configuration from file
+     * @return true if the configuration was reloaded successfully, false if no path is set or reload failed
+     *
+     * Reloads the runtime document and every layer added with loadLayer().
+     * A file that cannot be read or parsed keeps its previous contents. All
+     * files are parsed first and swapped in as one change, so readers never
+     * see a half-reloaded configuration. The merged view is diffed against
+     * the old one and only callbacks of keys whose values changed are
+     * notified.
+     */
+    bool reload() {
+        std::string path;
+        std::vector<std::pair<std::string, std::string>> layerFiles;
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            path = m_configPath;
+            for (const auto& layer : m_layers) {
+                if (!layer.path.empty()) {
+                    layerFiles.emplace_back(layer.name, layer.path);
+                }
+            }
+        }
+        if (path.empty() && layerFiles.empty()) {
             return false;
         }
 
-        try {
-            // Ensure directory exists
-            std::filesystem::path filePath(savePath);
-            if (filePath.has_parent_path()) {
-                std::filesystem::create_directories(filePath.parent_path());
+        // Parse every file off to the side, then swap them in with one publish
+        bool success = true;
+        std::vector<std::pair<std::string, JsonValue>> layerDocuments;
+        for (const auto& [name, file] : layerFiles) {
+            if (auto document = tryParseFile(file)) {
+                layerDocuments.emplace_back(name, std::move(*document));
+            } else {
+                success = false;
+            }
+        }
+        std::optional<JsonValue> document;
+        if (!path.empty() && !(document = tryParseFile(path))) {
+            success = false;
+        }
+
+        changeAndNotify([&]() {
+            for (auto& [name, layer] : layerDocuments) {
+                auto it = findLayer(name);
+                if (it != m_layers.end()) {
+                    replaceLayer(name, it->priority, std::move(layer), it->path);
+                }
+            }
+            if (document) {
+                replaceDocument(std::move(*document), path);
+                m_dirty = false;
+            }
+            return !layerDocuments.empty() || document.has_value();
+        });
+        return success;
+    }
+
+    /**
+     * @brief Add or replace a named configuration layer
+     * @param name Layer name (e.g. "defaults", "production")
+     * @param priority Precedence; see ConfigPriority
+     * @param document Layer contents, usually an object
+     *
+     * Replacing a layer at the same priority recomputes only the merged
+     * subtrees that differ. Callbacks of keys whose merged values changed
+     * are notified.
+     */
+    void setLayer(const std::string& name, int priority, const JsonValue& document) {
+        changeAndNotify([&]() {
+            replaceLayer(name, priority, document, "");
+            return true;
+        });
+    }
+
+    /**
+     * @brief Add or replace a layer loaded from a JSON file
+     * @param name Layer name
+     * @param priority Precedence; see ConfigPriority
+     * @param path JSON file, reloaded by reload()
+     * @return true if the file was loaded; otherwise the layer is left unchanged
+     */
+    bool loadLayer(const std::string& name, int priority, const std::string& path) {
+        std::optional<JsonValue> document = tryParseFile(path);
+        if (!document) {
+            return false;
+        }
+
+        changeAndNotify([&]() {
+            replaceLayer(name, priority, std::move(*document), path);
+            return true;
+        });
+        refreshFileWatches();
+        return true;
+    }
+
+    /**
+     * @brief Add or replace a layer built from environment variables
+     * @param prefix Variable prefix; e.g. with "MCF_", MCF_NETWORK__PORT=81 sets network.port
+     * @param priority Precedence; see ConfigPriority
+     * @param name Layer name
+     * @return Number of variables in the layer
+     *
+     * Double underscores separate key parts. Each part matches an existing
+     * key of the merged configuration case-insensitively and is lowercased
+     * otherwise. Values are parsed as booleans, null, numbers or JSON
+     * arrays/objects where possible and kept as strings otherwise.
+     */
+    size_t loadEnvironment(const std::string& prefix = "MCF_",
+                           int priority = ConfigPriority::EnvironmentVariables,
+                           const std::string& name = "environment") {
+        std::vector<std::pair<std::string, std::string>> variables;
+#ifdef _WIN32
+        char** environment = _environ;
+#else
+        char** environment = environ;
+#endif
+        for (char** entry = environment; entry && *entry; ++entry) {
+            std::string variable(*entry);
+            size_t equals = variable.find('=');
+            if (equals == std::string::npos || equals <= prefix.size() || variable.compare(0, prefix.size(), prefix) != 0) {
+                continue;
+            }
+            variables.emplace_back(variable.substr(prefix.size(), equals - prefix.size()), variable.substr(equals + 1));
+        }
+
+        JsonValue layer(JsonObject{});
+        JsonValue merged = snapshot().root();
+        for (const auto& [variable, text] : variables) {
+            std::vector<std::string> parts;
+            const JsonValue* existing = &merged;
+            size_t start = 0;
+            while (start <= variable.size()) {
+                size_t separator = variable.find("__", start);
+                std::string part = variable.substr(start, separator == std::string::npos ? std::string::npos
+                                                                                            : separator - start);
+                std::string lower = part;
+                std::transform(lower.begin(), lower.end(), lower.begin(),
+                               [](unsigned char c) { return static_cast<char>(std::tolower(c)); });
+
+                std::string key = lower;
+                const JsonValue* next = nullptr;
+                if (existing && existing->isObject()) {
+                    for (const auto& [candidate, value] : existing->asObject()) {
+                        if (candidate.size() == lower.size() &&
+                            std::equal(candidate.begin(), candidate.end(), lower.begin(), [](char a, char b) {
+                                return std::tolower(static_cast<unsigned char>(a)) == b;
+                            })) {
+                            key = candidate;
+                            next = &value;
+                            break;
+                        }
+                    }
+                }
+                existing = next;
+                if (!key.empty()) {
+                    parts.push_back(std::move(key));
+                }
+
+                if (separator == std::string::npos) break;
+                start = separator + 2;
+            }
+            if (!parts.empty()) {
+                *navigate(layer, parts, true) = parseEnvironmentValue(text);
+            }
+        }
+
+        setLayer(name, priority, layer);
+        return variables.size();
+    }
+
+    /**
+     * @brief Remove a named layer
+     * @param name Layer name
+     * @return true if the layer existed
+     */
+    bool removeLayer(const std::string& name) {
+        bool removed = changeAndNotify([&]() {
+            auto it = findLayer(name);
+            if (it == m_layers.end()) {
+                return false;
+            }
+            JsonValue document = std::move(it->document);
+            m_layers.erase(it);
+            JsonValue empty(JsonObject{});
+            remergePatch(document, empty, JsonPatch::diff(document, empty));
+            return true;
+        });
+        if (!removed) {
+            return false;
+        }
+        refreshFileWatches();
+        return true;
+    }
+
+    /**
+     * @brief Get the contents of a named layer
+     * @param name Layer name
+     * @return Layer document, or null if there is no such layer
+     */
+    JsonValue getLayer(const std::string& name) const {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        for (const auto& layer : m_layers) {
+            if (layer.name == name) {
+                return layer.document;
+            }
+        }
+        return JsonValue();
+    }
+
+    /**
+     * @brief Get the names of all layers
+     * @return Names in ascending precedence (the runtime document is not included)
+     */
+    std::vector<std::string> getLayerNames() const {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        std::vector<std::string> names;
+        for (const auto& layer : m_layers) {
+            names.push_back(layer.name);
+        }
+        return names;
+    }
+
+    /**
+     * @brief Apply a JSON patch (e.g. received from another node) to the configuration
+     * @param patch Operations with JSON Pointer paths relative to the configuration root
+     * @return true if every operation applied; on failure the configuration is unchanged
+     *
+     * The patch applies to the runtime document (see diff()). Callbacks of
+     * keys whose merged values changed are notified after the patch is
+     * applied; keys a higher-priority layer overrides are not.
+     */
+    bool applyPatch(const JsonPatch& patch) {
+        std::vector<std::vector<std::string>> changed;
+        for (const auto& operation : patch.operations()) {
+            changed.push_back(JsonPointer::parse(operation.path));
+            if (operation.op == JsonPatchOp::Move) {
+                changed.push_back(JsonPointer::parse(operation.from));
             }
+        }
 
-            bool success = JsonParser::writeFile(savePath, m_config);
-            if (success) {
-                m_dirty = false;
-                if (!path.empty()) {
-                    m_configPath = path;
-                }
+        return changeAndNotify([&]() {
+            JsonValue document;
+            try {
+                document = patch.apply(m_document);
+            } catch (const std::exception&) {
+                return false;
             }
-            return success;
-        } catch (const std::filesystem::filesystem_error&) {
-            // Failed to create directory or write file (e.g., path is invalid, device file, or permission denied)
-            return false;
-        }
+            std::swap(m_document, document);
+            remergePatch(document, m_document, patch);
+            markDirty();
+            return true;
+        }, &changed);
     }
 
     /**
-     * @brief Reload configuration from file
-     * @return true if the configuration was reloaded successfully, false if no path is set or reload failed
+     * @brief Compute the patch turning the runtime document into another document
+     * @param target Desired configuration
+     * @return Operations to send to nodes holding the current configuration
+     *
+     * Without layers the runtime document is the whole configuration.
      */
-    bool reload() {
-        if (m_configPath.empty()) {
-            return false;
-        }
-        return load(m_configPath);
+    JsonPatch diff(const JsonValue& target) const {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        return JsonPatch::diff(m_document, target);
+    }
+
+    /**
+     * @brief Get the current configuration snapshot
+     * @return Immutable view for reading many keys consistently without locking
+     */
+    ConfigSnapshot snapshot() const {
+        return ConfigSnapshot(std::atomic_load_explicit(&m_snapshot, std::memory_order_acquire));
     }
 
     /**
@@ -237,110 +1529,95 @@ public:
      * @return The JsonValue at the specified key, or defaultValue if not found
      */
     JsonValue get(const std::string& key, const JsonValue& defaultValue = JsonValue()) const {
-        std::lock_guard<std::mutex> lock(m_mutex);
-
-        if (key.empty()) {
-            return m_config;
-        }
-
-        // Split key by dots and navigate
-        const JsonValue* current = &m_config;
-        std::string part;
-        for (char c : key) {
-            if (c == '.') {
-                if (!part.empty()) {
-                    if (!current->isObject() || !current->has(part)) {
-                        return defaultValue;
-                    }
-                    current = &(*current)[part];
-                    part.clear();
-                }
-            } else {
-                part += c;
-            }
-        }
+        return snapshot().get(key, defaultValue);
+    }
 
-        if (!part.empty()) {
-            if (!current->isObject() || !current->has(part)) {
-                return defaultValue;
-            }
-            return (*current)[part];
-        }
+    /**
+     * @brief Get configuration value through a compiled key path
+     * @param path Key compiled once with ConfigKeyPath
+     * @param defaultValue Default value to return if the key is not found
+     * @return The JsonValue at the specified path, or defaultValue if not found
+     */
+    JsonValue get(const ConfigKeyPath& path, const JsonValue& defaultValue = JsonValue()) const {
+        return snapshot().get(path, defaultValue);
+    }
 
-        return *current;
+    /**
+     * @brief Get the configuration generation
+     * @return Counter incremented by every load, set, remove, clear and applied patch
+     */
+    uint64_t generation() const {
+        return m_generation.load(std::memory_order_acquire);
     }
 
+    /**
+     * @brief Create a typed handle caching the decoded value of a key
+     * @tparam T Any type JsonBinding can decode (arithmetic, string, reflected structs, ...)
+     * @param key Configuration key using dot notation
+     * @param defaultValue Value returned while the key is missing or does not decode as T
+     * @return Handle whose reads only touch the configuration after it changed
+     *
+     * The handle must not outlive this manager.
+     */
+    template<typename T>
+    ConfigHandle<T> handle(const std::string& key, T defaultValue = T()) const;
+
     /**
      * @brief Set configuration value by key (dot notation supported)
      * @param key Configuration key using dot notation (e.g., "section.subsection.value")
      * @param value The value to set at the specified key
      */
     void set(const std::string& key, const JsonValue& value) {
-        std::lock_guard<std::mutex> lock(m_mutex);
+        std::vector<std::vector<std::string>> changed{splitKey(key)};
+        const std::vector<std::string>& parts = changed.front();
+        changeAndNotify([&]() {
+            size_t depth = m_layers.empty() ? 0 : changedDepth(m_document, parts);
+            *navigate(m_document, parts, true) = value;
+            remerge(std::vector<std::string>(parts.begin(), parts.begin() + static_cast<std::ptrdiff_t>(depth)));
+            markDirty();
+            return true;
+        }, &changed);
+    }
 
-        if (key.empty()) {
-            m_config = value;
-            m_dirty = true;
+    /**
+     * @brief Set many configuration values at once
+     * @param values Pairs of dot-notation keys and values, applied in order
+     *
+     * All writes happen under one lock and count as a single configuration
+     * change. Afterwards every watched key whose value changed (including
+     * parents and children of the written keys) is notified once, outside
+     * the lock, with its final value.
+     */
+    void setMany(const std::vector<std::pair<std::string, JsonValue>>& values) {
+        if (values.empty()) {
             return;
         }
 
-        // For simplicity, we'll rebuild the object structure
-        // Split key by dots
-        std::vector<std::string> parts;
-        std::string current;
-        for (char c : key) {
-            if (c == '.') {
-                if (!current.empty()) {
-                    parts.push_back(current);
-                    current.clear();
-                }
-            } else {
-                current += c;
-            }
-        }
-        if (!current.empty()) {
-            parts.push_back(current);
-        }
-
-        // Ensure root is an object
-        if (!m_config.isObject()) {
-            m_config = JsonValue(JsonObject());
+        std::vector<std::vector<std::string>> changed;
+        for (const auto& entry : values) {
+            changed.push_back(splitKey(entry.first));
         }
 
-        // Build path and set value
-        std::function<void(JsonValue&, size_t)> setRecursive = [&](JsonValue& node, size_t depth) {
-            if (depth == parts.size() - 1) {
-                // Last part - set the value
-                if (!node.isObject()) {
-                    node = JsonValue(JsonObject());
+        changeAndNotify([&]() {
+            std::vector<std::vector<std::string>> remerged;
+            for (size_t i = 0; i < values.size(); ++i) {
+                std::vector<std::string> parts = changed[i];
+                size_t depth = m_layers.empty() ? 0 : changedDepth(m_document, parts);
+                *navigate(m_document, parts, true) = values[i].second;
+                if (!m_layers.empty()) {
+                    parts.resize(depth);
+                    remerged.push_back(std::move(parts));
                 }
-                JsonObject obj = node.asObject();
-                obj[parts[depth]] = value;
-                node = JsonValue(obj);
-                return;
             }
-
-            // Intermediate part - ensure object exists
-            if (!node.isObject()) {
-                node = JsonValue(JsonObject());
+            for (auto& parts : remerged) {
+                remerge(std::move(parts));
             }
-
-            JsonObject obj = node.asObject();
-            if (!obj[parts[depth]].isObject()) {
-                obj[parts[depth]] = JsonValue(JsonObject());
+            if (m_layers.empty()) {
+                m_config = m_document;
             }
-
-            JsonValue child = obj[parts[depth]];
-            setRecursive(child, depth + 1);
-            obj[parts[depth]] = child;
-            node = JsonValue(obj);
-        };
-
-        setRecursive(m_config, 0);
-        m_dirty = true;
-
-        // Notify callbacks
-        notifyChange(key, value);
+            markDirty();
+            return true;
+        }, &changed);
     }
 
     /**
@@ -349,8 +1626,7 @@ public:
      * @return true if the key exists and is not null, false otherwise
      */
     bool has(const std::string& key) const {
-        // Don't lock here - get() already locks
-        return !get(key).isNull();
+        return snapshot().has(key);
     }
 
     /**
@@ -358,67 +1634,120 @@ public:
      * @param key Configuration key using dot notation (e.g., "section.subsection.value")
      */
     void remove(const std::string& key) {
+        std::vector<std::vector<std::string>> changed{splitKey(key)};
+        const std::vector<std::string>& parts = changed.front();
+        changeAndNotify([&]() {
+            if (!removePath(m_document, parts)) {
+                return false;
+            }
+            remerge(parts);
+            markDirty();
+            return true;
+        }, &changed);
+    }
+
+    /**
+     * @brief Register callback for configuration changes
+     * @param key Configuration key to watch for changes
+     * @param callback Function to call when the key's value changes
+     * @return Identifier for unwatch()
+     *
+     * The callback runs synchronously on the changing thread, after the
+     * change was published and without any lock held.
+     */
+    ConfigWatchId watch(const std::string& key, ConfigChangeCallback callback) {
         std::lock_guard<std::mutex> lock(m_mutex);
+        WatchEntry entry;
+        entry.pattern = key;
+        entry.parts = splitKey(key);
+        entry.onChange = std::move(callback);
 
-        // Similar to set, but removes the key
-        std::vector<std::string> parts;
-        std::string current;
-        for (char c : key) {
-            if (c == '.') {
-                if (!current.empty()) {
-                    parts.push_back(current);
-                    current.clear();
-                }
-            } else {
-                current += c;
-            }
-        }
-        if (!current.empty()) {
-            parts.push_back(current);
-        }
+        WatchRegistry& registry = mutableWatches();
+        ConfigWatchId id = m_nextWatchId++;
+        registry.index.add(id, entry.parts, false);
+        registry.entries.emplace(id, std::move(entry));
+        return id;
+    }
 
-        std::function<bool(JsonValue&, size_t)> removeRecursive = [&](JsonValue& node, size_t depth) -> bool {
-            if (!node.isObject()) return false;
+    /**
+     * @brief Register a callback for changes anywhere in matching subtrees
+     * @param pattern Dot-notation pattern: "*" matches one key part, "**" any
+     *        number of parts (e.g. "network", "network.*", "services.*.port", "**")
+     * @param callback Called once per change (set, setMany, reload, patch, ...)
+     *        with every changed path at, below or above a matching key
+     * @return Identifier for unwatch()
+     *
+     * Callbacks run after the change was published and without any lock held;
+     * on the notification pool if one is set, otherwise on the changing thread.
+     */
+    ConfigWatchId watchTree(const std::string& pattern, ConfigBatchCallback callback) {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        WatchEntry entry;
+        entry.pattern = pattern;
+        entry.parts = splitKey(pattern);
+        entry.subtree = true;
+        entry.onBatch = std::move(callback);
 
-            if (depth == parts.size() - 1) {
-                // Last part - remove the key
-                JsonObject obj = node.asObject();
-                auto it = obj.find(parts[depth]);
-                if (it != obj.end()) {
-                    obj.erase(it);
-                    node = JsonValue(obj);
-                    return true;
-                }
-                return false;
-            }
+        WatchRegistry& registry = mutableWatches();
+        ConfigWatchId id = m_nextWatchId++;
+        registry.index.add(id, entry.parts, true);
+        registry.entries.emplace(id, std::move(entry));
+        return id;
+    }
 
-            // Intermediate part
-            JsonObject obj = node.asObject();
-            auto it = obj.find(parts[depth]);
-            if (it != obj.end()) {
-                JsonValue child = it->second;
-                if (removeRecursive(child, depth + 1)) {
-                    obj[parts[depth]] = child;
-                    node = JsonValue(obj);
-                    return true;
-                }
-            }
+    /**
+     * @brief Remove a watch
+     * @param id Identifier returned by watch() or watchTree()
+     * @return true if the watch existed
+     */
+    bool unwatch(ConfigWatchId id) {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        if (!m_watches->entries.count(id)) {
             return false;
-        };
+        }
+        WatchRegistry& registry = mutableWatches();
+        auto it = registry.entries.find(id);
+        registry.index.remove(id, it->second.parts, it->second.subtree);
+        registry.entries.erase(it);
+        return true;
+    }
 
-        if (removeRecursive(m_config, 0)) {
-            m_dirty = true;
+    /**
+     * @brief Remove all callbacks registered with watch() for a key
+     * @param key Configuration key
+     */
+    void unwatch(const std::string& key) {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        WatchRegistry& registry = mutableWatches();
+        for (auto it = registry.entries.begin(); it != registry.entries.end();) {
+            if (!it->second.subtree && it->second.pattern == key) {
+                registry.index.remove(it->first, it->second.parts, false);
+                it = registry.entries.erase(it);
+            } else {
+                ++it;
+            }
         }
     }
 
     /**
-     * @brief Register callback for configuration changes
-     * @param key Configuration key to watch for changes
-     * @param callback Function to call when the key's value changes
+     * @brief Run subtree watch callbacks on a thread pool
+     * @param pool Pool that must outlive this manager, or nullptr to run them synchronously
      */
-    void watch(const std::string& key, ConfigChangeCallback callback) {
+    void setNotificationPool(ThreadPool* pool) {
         std::lock_guard<std::mutex> lock(m_mutex);
-        m_callbacks[key].push_back(callback);
+        m_notificationPool = pool;
+    }
+
+    /**
+     * @brief Load files through precompiled binary images
+     * @param enabled Whether load(), loadLayer() and reload() use ConfigCache
+     *
+     * When enabled, each parsed file gets a binary image next to it
+     * ("app.json.mcfc"). Later loads of an unchanged file decode the image
+     * instead of parsing JSON; any mismatch falls back to parsing.
+     */
+    void setBinaryCache(bool enabled) {
+        m_binaryCache.store(enabled, std::memory_order_relaxed);
     }
 
     /**
@@ -426,17 +1755,20 @@ public:
      * @return The entire configuration tree as a JsonValue object
      */
     JsonValue getAll() const {
-        std::lock_guard<std::mutex> lock(m_mutex);
-        return m_config;
+        return snapshot().root();
     }
 
     /**
-     * @brief Clear all configuration
+     * @brief Clear the runtime document (layers are kept)
      */
     void clear() {
-        std::lock_guard<std::mutex> lock(m_mutex);
-        m_config = JsonValue(JsonObject());
-        m_dirty = true;
+        changeAndNotify([&]() {
+            JsonValue document = std::move(m_document);
+            m_document = JsonValue(JsonObject());
+            remergePatch(document, m_document, m_layers.empty() ? JsonPatch() : JsonPatch::diff(document, m_document));
+            markDirty();
+            return true;
+        });
     }
 
     /**
@@ -446,7 +1778,7 @@ public:
      * @return The string value at the specified key, or defaultValue if not found
      */
     std::string getString(const std::string& key, const std::string& defaultValue = "") const {
-        return get(key).asString(defaultValue);
+        return snapshot().getString(key, defaultValue);
     }
 
     /**
@@ -456,7 +1788,7 @@ public:
      * @return The integer value at the specified key, or defaultValue if not found
      */
     int64_t getInt(const std::string& key, int64_t defaultValue = 0) const {
-        return get(key).asInt(defaultValue);
+        return snapshot().getInt(key, defaultValue);
     }
 
     /**
@@ -466,7 +1798,7 @@ public:
      * @return The float value at the specified key, or defaultValue if not found
      */
     double getFloat(const std::string& key, double defaultValue = 0.0) const {
-        return get(key).asFloat(defaultValue);
+        return snapshot().getFloat(key, defaultValue);
     }
 
     /**
@@ -476,7 +1808,7 @@ public:
      * @return The boolean value at the specified key, or defaultValue if not found
      */
     bool getBool(const std::string& key, bool defaultValue = false) const {
-        return get(key).asBool(defaultValue);
+        return snapshot().getBool(key, defaultValue);
     }
 
     /**
@@ -509,12 +1841,34 @@ public:
 
     /**
      * @brief Enable auto-save on modifications
-     * @param enabled Whether to enable auto-save (currently reserved for future use)
+     * @param enabled Whether to save changes in the background
+     * @param delay Debounce window: changes made within it of the first unsaved one are written together
+     *
+     * A background thread saves to the configured path (see load() and
+     * save()) once per window with unsaved changes. The document is
+     * serialized outside the manager mutex and written atomically, so
+     * set() and readers never wait for the disk. Disabling stops the thread;
+     * unsaved changes stay dirty and are still written by the destructor.
      */
-    void setAutoSave(bool enabled) {
-        // Auto-save is handled in destructor
-        // This method is for future extensions
-        (void)enabled;
+    void setAutoSave(bool enabled, std::chrono::milliseconds delay = std::chrono::milliseconds(500)) {
+        stopAutoSave();
+        if (!enabled) {
+            return;
+        }
+
+        bool dirty = false;
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            dirty = m_dirty;
+        }
+        std::lock_guard<std::mutex> lock(m_saveMutex);
+        m_saveDelay = delay;
+        m_autoSave = true;
+        if (dirty) {
+            m_savePending = true;
+            m_saveDeadline = std::chrono::steady_clock::now() + m_saveDelay;
+        }
+        m_saveThread = std::thread(&ConfigurationManager::saveLoop, this);
     }
 
     /**
@@ -525,6 +1879,263 @@ public:
         std::lock_guard<std::mutex> lock(m_mutex);
         return m_dirty;
     }
+
+    /**
+     * @brief Reload automatically when the configuration file or a layer file changes
+     * @param service Watch service; it must outlive the watch (stopFileWatching() or destruction)
+     * @param options Settle time and executor of the reload
+     *
+     * Files loaded later with load() or loadLayer() are watched as well.
+     * Each change runs reload(), which notifies the watchers of changed
+     * keys. Writes by save() and auto-save do not trigger a reload.
+     */
+    void startFileWatching(FileWatchService& service,
+                           FileWatchOptions options = FileWatchOptions{std::chrono::milliseconds(50), nullptr}) {
+        stopFileWatching();
+        {
+            std::lock_guard<std::mutex> lock(m_fileWatchMutex);
+            m_fileWatchService = &service;
+            m_fileWatchOptions = options;
+        }
+        refreshFileWatches();
+    }
+
+    /**
+     * @brief Stop reloading on file changes
+     *
+     * Waits for a reload that is already running.
+     */
+    void stopFileWatching() {
+        FileWatchService* service = nullptr;
+        std::map<std::string, FileWatchId> watches;
+        {
+            std::lock_guard<std::mutex> lock(m_fileWatchMutex);
+            std::swap(service, m_fileWatchService);
+            std::swap(watches, m_fileWatches);
+        }
+
+        // Wait without m_fileWatchMutex: the running reload may need it
+        for (const auto& [path, id] : watches) {
+            service->unwatch(id, true);
+        }
+    }
+
+    /**
+     * @brief Check if the configuration files are watched
+     * @return true after startFileWatching() until stopFileWatching()
+     */
+    bool isFileWatching() const {
+        std::lock_guard<std::mutex> lock(m_fileWatchMutex);
+        return m_fileWatchService != nullptr;
+    }
+
+private:
+    /**
+     * @brief Subscribe to the current configuration and layer files
+     *
+     * Stale subscriptions are removed after m_fileWatchMutex is released,
+     * so a reload running in a watch callback may call this as well.
+     */
+    void refreshFileWatches() {
+        FileWatchService* service = nullptr;
+        std::vector<FileWatchId> stale;
+        {
+            std::lock_guard<std::mutex> watchLock(m_fileWatchMutex);
+            service = m_fileWatchService;
+            if (!service) {
+                return;
+            }
+            updateFileWatches(stale);
+        }
+        for (FileWatchId id : stale) {
+            service->unwatch(id, true);
+        }
+    }
+
+    /**
+     * @brief Subscribe to new files and collect the subscriptions of files no longer used
+     * @param stale Receives the subscriptions to remove
+     *
+     * Must be called while holding m_fileWatchMutex.
+     */
+    void updateFileWatches(std::vector<FileWatchId>& stale) {
+
+        std::set<std::string> paths;
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            if (!m_configPath.empty()) {
+                paths.insert(m_configPath);
+            }
+            for (const auto& layer : m_layers) {
+                if (!layer.path.empty()) {
+                    paths.insert(layer.path);
+                }
+            }
+        }
+
+        for (auto it = m_fileWatches.begin(); it != m_fileWatches.end();) {
+            if (paths.count(it->first)) {
+                ++it;
+            } else {
+                stale.push_back(it->second);
+                it = m_fileWatches.erase(it);
+            }
+        }
+        for (const auto& path : paths) {
+            if (m_fileWatches.count(path)) {
+                continue;
+            }
+            m_fileWatches[path] = m_fileWatchService->watchFile(path, [this](const std::string& file, FileChangeType type) {
+                // A deleted file is reloaded once it is back (editors may delete and recreate)
+                if (type != FileChangeType::Deleted && !isOwnWrite(file)) {
+                    reload();
+                }
+            }, m_fileWatchOptions);
+        }
+    }
+
+    /**
+     * @brief Whether a file is exactly as the last save() left it
+     */
+    bool isOwnWrite(const std::string& file) {
+        std::error_code error;
+        auto time = std::filesystem::last_write_time(file, error);
+        if (error) {
+            return false;
+        }
+        auto size = std::filesystem::file_size(file, error);
+        std::lock_guard<std::mutex> lock(m_mutex);
+        return !error && file == m_configPath && time == m_savedTime && size == m_savedSize;
+    }
+};
+
+/**
+ * @brief Typed, cached view of one configuration key
+ *
+ * The key path is compiled once and the decoded value is cached together
+ * with the configuration generation it was read at. A read compares that
+ * generation with ConfigurationManager::generation() and only re-reads and
+ * re-decodes the value after the configuration changed; otherwise it is an
+ * atomic load (lock-free for arithmetic types, an atomic shared_ptr load
+ * for everything else).
+ *
+ * Copies share the cache. The manager must outlive its handles.
+ *
+ * @code
+ * ConfigHandle<int> maxConnections = config.handle<int>("network.max_connections", 100);
+ * if (active < maxConnections.get()) { ... }
+ * @endcode
+ */
+template<typename T>
+class ConfigHandle {
+private:
+    // Scalars up to 64 bits are cached in a lock-free std::atomic<T>
+    static constexpr bool IsAtomic = std::is_arithmetic_v<T> && sizeof(T) <= sizeof(uint64_t);
+
+    static constexpr uint64_t Stale = ~uint64_t(0);
+
+    using Storage = std::conditional_t<IsAtomic, std::atomic<T>, std::shared_ptr<const T>>;
+
+    struct State {
+        const ConfigurationManager* manager;
+        ConfigKeyPath path;
+        T defaultValue;
+        std::atomic<uint64_t> generation{Stale};
+        Storage value;
+        std::mutex refreshMutex;
+
+        State(const ConfigurationManager* manager, ConfigKeyPath path, T defaultValue)
+            : manager(manager), path(std::move(path)), defaultValue(std::move(defaultValue)) {}
+    };
+
+    std::shared_ptr<State> m_state;
+
+    void refresh(uint64_t generation) const {
+        std::lock_guard<std::mutex> lock(m_state->refreshMutex);
+        if (m_state->generation.load(std::memory_order_acquire) == generation) {
+            return;  // Another reader refreshed it first
+        }
+
+        // Label the value with the generation of the snapshot it was decoded from
+        ConfigSnapshot snapshot = m_state->manager->snapshot();
+        T decoded = decode(snapshot.find(m_state->path));
+        if constexpr (IsAtomic) {
+            m_state->value.store(decoded, std::memory_order_release);
+        } else {
+            std::atomic_store_explicit(&m_state->value,
+                                       std::shared_ptr<const T>(std::make_shared<T>(std::move(decoded))),
+                                       std::memory_order_release);
+        }
+        m_state->generation.store(snapshot.generation(), std::memory_order_release);
+    }
+
+    T decode(const JsonValue* json) const {
+        if (!json || json->isNull()) {
+            return m_state->defaultValue;
+        }
+        try {
+            // Start from the default so structs keep defaults for absent members
+            T value = m_state->defaultValue;
+            JsonBinding::fromValue(*json, value);
+            return value;
+        } catch (const std::exception&) {
+            return m_state->defaultValue;
+        }
+    }
+
+public:
+    /**
+     * @brief Create an unbound handle (see valid())
+     */
+    ConfigHandle() = default;
+
+    /**
+     * @brief Bind a handle to a key
+     * @param manager Configuration manager to read from
+     * @param key Configuration key using dot notation
+     * @param defaultValue Value returned while the key is missing or does not decode as T
+     */
+    ConfigHandle(const ConfigurationManager& manager, const std::string& key, T defaultValue = T())
+        : m_state(std::make_shared<State>(&manager, ConfigKeyPath(key), std::move(defaultValue))) {}
+
+    /**
+     * @brief Get the current value
+     * @return Decoded value, or the default if the key is missing or has the wrong type
+     */
+    T get() const {
+        uint64_t generation = m_state->manager->generation();
+        if (m_state->generation.load(std::memory_order_acquire) != generation) {
+            refresh(generation);
+        }
+        if constexpr (IsAtomic) {
+            return m_state->value.load(std::memory_order_acquire);
+        } else {
+            return *std::atomic_load_explicit(&m_state->value, std::memory_order_acquire);
+        }
+    }
+
+    /**
+     * @brief Get the current value
+     * @return Same as get()
+     */
+    T operator*() const { return get(); }
+
+    /**
+     * @brief Check whether the handle is bound to a key
+     * @return true if created through ConfigurationManager::handle() or the binding constructor
+     */
+    bool valid() const { return m_state != nullptr; }
+
+    /**
+     * @brief Get the watched key
+     * @return Dot-notation key
+     */
+    const std::string& key() const { return m_state->path.key(); }
 };
 
+template<typename T>
+ConfigHandle<T> ConfigurationManager::handle(const std::string& key, T defaultValue) const {
+    return ConfigHandle<T>(*this, key, std::move(defaultValue));
+}
+
 } // namespace mcf
@@ -1,25 +1,49 @@
 #pragma once
 
+#include "Glob.hpp"
+#include "MappedFile.hpp"
+#include "TempFile.hpp"
+#include "ThreadPool.hpp"
+
 #include <algorithm>
+#include <array>
+#include <atomic>
+#include <cerrno>
 #include <chrono>
+#include <condition_variable>
 #include <cstring>
 #include <fstream>
 #include <functional>
+#include <memory>
 #include <mutex>
+#include <set>
 #include <stdexcept>
 #include <string>
+#include <string_view>
+#include <utility>
 #include <vector>
 
 #ifdef _WIN32
 #include <windows.h>
 #include <direct.h>
+#include <fcntl.h>
+#include <io.h>
+#include <sys/stat.h>
 #define PATH_SEPARATOR '\\'
 #define PATH_SEPARATOR_STR "\\"
 #else
+#include <climits>
 #include <dirent.h>
+#include <fcntl.h>
 #include <sys/stat.h>
 #include <sys/types.h>
+#include <sys/uio.h>
 #include <unistd.h>
+#ifdef __linux__
+#include <linux/fs.h>
+#include <sys/ioctl.h>
+#include <sys/sendfile.h>
+#endif
 #define PATH_SEPARATOR '/'
 #define PATH_SEPARATOR_STR "/"
 #endif
@@ -53,6 +77,57 @@ struct FileInfo {
         , isHidden(false) {}
 };
 
+/**
+ * @brief Entry reported by FileSystem::walk() and FileSystem::glob()
+ */
+struct DirectoryEntry {
+    std::string path;          ///< Root joined with the relative path
+    std::string relativePath;  ///< Path below the walked root, '/'-separated
+    FileType type;             ///< Type from the directory listing; symlinks are reported as Symlink unless followed
+};
+
+/**
+ * @brief Receives walked entries; return false to stop the walk
+ */
+using DirectoryVisitor = std::function<bool(const DirectoryEntry&)>;
+
+/**
+ * @brief Options of FileSystem::walk() and FileSystem::glob()
+ */
+struct WalkOptions {
+    /// Descend into subdirectories
+    bool recursive = true;
+
+    /// Descend into symlinked directories (each directory is visited once)
+    bool followSymlinks = false;
+
+    /// Pool reading directories in parallel, or nullptr to walk on the calling thread
+    ThreadPool* pool = nullptr;
+};
+
+/**
+ * @brief How far a write is persisted before FileSystem returns
+ */
+enum class Durability {
+    None,    ///< Leave the data in the page cache; a crash may lose it
+    Data,    ///< Flush the file contents to the device (fdatasync) before returning
+    Atomic   ///< Write a unique temporary file (see TempFile), flush it and rename it over the target; readers and crashes see the old or the new file
+};
+
+/**
+ * @brief Options of FileSystem::writeBuffers() and the other write functions
+ */
+struct WriteOptions {
+    /// Append to the file instead of replacing it
+    bool append = false;
+
+    /// Persistence guarantee on success
+    Durability durability = Durability::None;
+
+    /// Reserve the final size before writing (fallocate), so large files are laid out in one piece
+    bool preallocate = true;
+};
+
 /**
  * @brief Path utility class for path manipulation
  */
@@ -184,7 +259,9 @@ public:
  * @brief File system operations manager
  *
  * Provides cross-platform file system operations with:
- * - Thread-safe operations
+ * - Thread-safe operations: queries and reads take no lock, writes lock only
+ *   their target path, so threads working on different files never wait
+ *   for each other
  * - File reading and writing
  * - Directory navigation
  * - Path manipulation
@@ -192,8 +269,404 @@ public:
  */
 class FileSystem {
 private:
+    // Serializes changes of the process working directory
     mutable std::mutex m_mutex;
 
+    // Writers of the same path share a lock so that whole-file writes do not interleave
+    static constexpr size_t PathLockCount = 32;
+    mutable std::array<std::mutex, PathLockCount> m_pathLocks;
+
+    /**
+     * @brief Lock stripe of a path (paths are compared as spelled)
+     */
+    std::mutex& pathLock(const std::string& path) const {
+        return m_pathLocks[std::hash<std::string>{}(path) % PathLockCount];
+    }
+
+    /**
+     * @brief Read a whole file into a string or byte vector
+     * @return false if the file cannot be opened or read
+     */
+    template<typename Container>
+    static bool readAllInternal(const std::string& path, Container& content) {
+#ifdef _WIN32
+        std::ifstream file(path, std::ios::binary);
+        if (!file.is_open()) {
+            return false;
+        }
+        file.seekg(0, std::ios::end);
+        content.resize(static_cast<size_t>(file.tellg()));
+        file.seekg(0, std::ios::beg);
+        file.read(reinterpret_cast<char*>(content.data()), content.size());
+        return file.good() || content.empty();
+#else
+        int fd = ::open(path.c_str(), O_RDONLY | O_CLOEXEC);
+        if (fd < 0) {
+            return false;
+        }
+
+        // Size the buffer from fstat(); the file may still grow, and files like /proc report 0
+        struct stat st;
+        content.resize((fstat(fd, &st) == 0 && st.st_size > 0) ? static_cast<size_t>(st.st_size) : 0);
+        size_t length = 0;
+        while (true) {
+            char probe[4096];
+            bool full = length == content.size();
+            char* target = full ? probe : reinterpret_cast<char*>(content.data()) + length;
+            size_t space = full ? sizeof(probe) : content.size() - length;
+
+            ssize_t count = ::read(fd, target, space);
+            if (count < 0) {
+                if (errno == EINTR) {
+                    continue;
+                }
+                ::close(fd);
+                return false;
+            }
+            if (count == 0) {
+                break;
+            }
+            if (full) {
+                // Only grow past the expected size once more data actually arrives
+                content.resize(std::max(content.size() * 2, length + static_cast<size_t>(count)));
+                std::memcpy(reinterpret_cast<char*>(content.data()) + length, probe, static_cast<size_t>(count));
+            }
+            length += static_cast<size_t>(count);
+        }
+        ::close(fd);
+        content.resize(length);
+        return true;
+#endif
+    }
+
+    // Writes of at least this size reserve their space up front
+    static constexpr size_t PreallocateMinimum = 1024 * 1024;
+
+#ifdef _WIN32
+    static int openWriteFd(const std::string& path, bool append) {
+        return _open(path.c_str(), _O_WRONLY | _O_CREAT | _O_BINARY | (append ? _O_APPEND : _O_TRUNC),
+                     _S_IREAD | _S_IWRITE);
+    }
+
+    static bool writeAllFd(int fd, const char* data, size_t size) {
+        while (size > 0) {
+            unsigned int chunk = static_cast<unsigned int>(std::min<size_t>(size, 1u << 30));
+            int written = _write(fd, data, chunk);
+            if (written <= 0) {
+                return false;
+            }
+            data += written;
+            size -= static_cast<size_t>(written);
+        }
+        return true;
+    }
+
+    static bool writeBuffersFd(int fd, const std::vector<std::string_view>& buffers) {
+        for (const auto& buffer : buffers) {
+            if (!writeAllFd(fd, buffer.data(), buffer.size())) {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    static bool syncFd(int fd, bool) {
+        return _commit(fd) == 0;
+    }
+
+    static bool closeFd(int fd) {
+        return _close(fd) == 0;
+    }
+
+    static bool replaceFile(const std::string& from, const std::string& to) {
+        return MoveFileExA(from.c_str(), to.c_str(), MOVEFILE_REPLACE_EXISTING | MOVEFILE_WRITE_THROUGH) != 0;
+    }
+
+    static void preallocate(int, size_t) {}
+
+    static void syncParentDirectory(const std::string&) {}
+
+    static bool copyFd(int source, int destination) {
+        std::vector<char> buffer(256 * 1024);
+        while (true) {
+            int count = _read(source, buffer.data(), static_cast<unsigned int>(buffer.size()));
+            if (count < 0) {
+                return false;
+            }
+            if (count == 0) {
+                return true;
+            }
+            if (!writeAllFd(destination, buffer.data(), static_cast<size_t>(count))) {
+                return false;
+            }
+        }
+    }
+#else
+    static int openWriteFd(const std::string& path, bool append) {
+        return ::open(path.c_str(), O_WRONLY | O_CREAT | O_CLOEXEC | (append ? O_APPEND : O_TRUNC), 0666);
+    }
+
+    /**
+     * @brief write() a whole range, continuing after short writes and signals
+     */
+    static bool writeAllFd(int fd, const char* data, size_t size) {
+        while (size > 0) {
+            ssize_t written = ::write(fd, data, size);
+            if (written < 0) {
+                if (errno == EINTR) {
+                    continue;
+                }
+                return false;
+            }
+            data += written;
+            size -= static_cast<size_t>(written);
+        }
+        return true;
+    }
+
+    /**
+     * @brief Gather-write buffers with writev(), up to IOV_MAX per call
+     */
+    static bool writeBuffersFd(int fd, const std::vector<std::string_view>& buffers) {
+#ifdef IOV_MAX
+        constexpr size_t BatchSize = IOV_MAX < 1024 ? IOV_MAX : 1024;
+#else
+        constexpr size_t BatchSize = 16;
+#endif
+        iovec batch[BatchSize];
+        size_t index = 0;
+        size_t offset = 0;  // Bytes of buffers[index] already written
+
+        while (true) {
+            size_t count = 0;
+            for (size_t i = index; i < buffers.size() && count < BatchSize; ++i) {
+                size_t skip = i == index ? offset : 0;
+                if (buffers[i].size() > skip) {
+                    batch[count].iov_base = const_cast<char*>(buffers[i].data() + skip);
+                    batch[count].iov_len = buffers[i].size() - skip;
+                    count++;
+                }
+            }
+            if (count == 0) {
+                return true;
+            }
+
+            ssize_t written = ::writev(fd, batch, static_cast<int>(count));
+            if (written < 0) {
+                if (errno == EINTR) {
+                    continue;
+                }
+                return false;
+            }
+
+            // Advance past the written bytes, which may end inside a buffer
+            size_t left = static_cast<size_t>(written);
+            while (index < buffers.size() && left >= buffers[index].size() - offset) {
+                left -= buffers[index].size() - offset;
+                offset = 0;
+                index++;
+            }
+            offset += left;
+        }
+    }
+
+    static bool syncFd(int fd, bool metadata) {
+#if defined(__APPLE__)
+        (void)metadata;
+        return ::fsync(fd) == 0;
+#else
+        return (metadata ? ::fsync(fd) : ::fdatasync(fd)) == 0;
+#endif
+    }
+
+    static bool closeFd(int fd) {
+        return ::close(fd) == 0;
+    }
+
+    static bool replaceFile(const std::string& from, const std::string& to) {
+        return ::rename(from.c_str(), to.c_str()) == 0;
+    }
+
+    /**
+     * @brief Reserve space for the bytes about to be written; a hint, failures are ignored
+     */
+    static void preallocate(int fd, size_t size) {
+#ifdef __linux__
+        struct stat st;
+        if (size >= PreallocateMinimum && fstat(fd, &st) == 0 && S_ISREG(st.st_mode)) {
+            // KEEP_SIZE: a failed write must not leave zeros past the written data
+            (void)::fallocate(fd, FALLOC_FL_KEEP_SIZE, st.st_size, static_cast<off_t>(size));
+        }
+#else
+        (void)fd;
+        (void)size;
+#endif
+    }
+
+    /**
+     * @brief Persist the directory entry of a file created or renamed in it
+     */
+    static void syncParentDirectory(const std::string& path) {
+        std::string parent = Path::dirname(path);
+        int fd = ::open(parent.c_str(), O_RDONLY | O_DIRECTORY | O_CLOEXEC);
+        if (fd >= 0) {
+            ::fsync(fd);
+            ::close(fd);
+        }
+    }
+
+    /**
+     * @brief Copy the rest of one file into another without passing through user space where possible
+     *
+     * Tries, in order: a reflink clone (shared extents on btrfs, XFS, ...),
+     * copy_file_range() (server-side copies on NFS/SMB, in-kernel elsewhere),
+     * sendfile(), and finally a read()/write() loop. Each step continues at
+     * the file offsets the previous one reached; the loop also picks up
+     * files that report no size, like those in /proc.
+     */
+    static bool copyFd(int source, int destination) {
+#ifdef __linux__
+        struct stat st;
+        if (fstat(source, &st) == 0 && S_ISREG(st.st_mode) && st.st_size > 0) {
+            size_t remaining = static_cast<size_t>(st.st_size);
+#ifdef FICLONE
+            off_t position = lseek(source, 0, SEEK_CUR);
+            if (position == 0 && ::ioctl(destination, FICLONE, source) == 0) {
+                // The clone does not move the file offsets
+                return lseek(destination, 0, SEEK_END) >= 0;
+            }
+#endif
+            while (remaining > 0) {
+                ssize_t copied = ::copy_file_range(source, nullptr, destination, nullptr, remaining, 0);
+                if (copied < 0 && errno == EINTR) {
+                    continue;
+                }
+                if (copied <= 0) {
+                    break;  // Unsupported here (EXDEV, EINVAL, ENOSYS, ...) or the file shrank
+                }
+                remaining -= static_cast<size_t>(copied);
+            }
+            while (remaining > 0) {
+                ssize_t copied = ::sendfile(destination, source, nullptr, remaining);
+                if (copied < 0 && errno == EINTR) {
+                    continue;
+                }
+                if (copied <= 0) {
+                    break;
+                }
+                remaining -= static_cast<size_t>(copied);
+            }
+        }
+#endif
+        std::vector<char> buffer(256 * 1024);
+        while (true) {
+            ssize_t count = ::read(source, buffer.data(), buffer.size());
+            if (count < 0) {
+                if (errno == EINTR) {
+                    continue;
+                }
+                return false;
+            }
+            if (count == 0) {
+                return true;
+            }
+            if (!writeAllFd(destination, buffer.data(), static_cast<size_t>(count))) {
+                return false;
+            }
+        }
+    }
+#endif
+
+    /**
+     * @brief Open the file a write goes to: the target, or its temporary file for atomic writes
+     * @param path Target path
+     * @param options Append and durability
+     * @param target Receives the path that was opened
+     * @return File descriptor, or -1
+     */
+    static int openWriteTarget(const std::string& path, const WriteOptions& options, std::string& target) {
+        if (options.durability != Durability::Atomic) {
+            target = path;
+            return openWriteFd(path, options.append);
+        }
+
+        int fd = TempFile::create(path, target);
+        if (fd < 0) {
+            return -1;
+        }
+
+#ifndef _WIN32
+        // Keep the permissions of the file being replaced
+        struct stat st;
+        if (stat(path.c_str(), &st) == 0) {
+            (void)fchmod(fd, st.st_mode & 07777);
+        }
+#endif
+        if (options.append) {
+            // Start from the current contents; a missing file appends to nothing
+#ifdef _WIN32
+            int existing = _open(path.c_str(), _O_RDONLY | _O_BINARY);
+#else
+            int existing = ::open(path.c_str(), O_RDONLY | O_CLOEXEC);
+#endif
+            bool copied = existing < 0 || copyFd(existing, fd);
+            if (existing >= 0) {
+                closeFd(existing);
+            }
+            if (!copied) {
+                closeFd(fd);
+                std::remove(target.c_str());
+                return -1;
+            }
+        }
+        return fd;
+    }
+
+    /**
+     * @brief Sync, close and (for atomic writes) publish a file opened by openWriteTarget()
+     * @return true if the data was written with the requested durability
+     */
+    static bool finishWrite(int fd, bool success, const std::string& path, const std::string& target,
+                            Durability durability) {
+        if (success && durability != Durability::None) {
+            success = syncFd(fd, durability == Durability::Atomic);
+        }
+        success = closeFd(fd) && success;
+
+        if (durability == Durability::Atomic) {
+            success = success && replaceFile(target, path);
+            if (!success) {
+                std::remove(target.c_str());
+                return false;
+            }
+            syncParentDirectory(path);
+        }
+        return success;
+    }
+
+    /**
+     * @brief Write buffers to a file; the caller holds the path lock
+     */
+    static bool writeBuffersInternal(const std::string& path, const std::vector<std::string_view>& buffers,
+                                     const WriteOptions& options) {
+        std::string target;
+        int fd = openWriteTarget(path, options, target);
+        if (fd < 0) {
+            return false;
+        }
+
+        if (options.preallocate) {
+            size_t total = 0;
+            for (const auto& buffer : buffers) {
+                total += buffer.size();
+            }
+            preallocate(fd, total);
+        }
+
+        bool success = writeBuffersFd(fd, buffers);
+        return finishWrite(fd, success, path, target, options.durability);
+    }
+
     /**
      * @brief Internal helper for checking existence without lock
      */
@@ -237,10 +710,11 @@ private:
             }
         }
 
+        // Another thread or process may have created it meanwhile
 #ifdef _WIN32
-        return CreateDirectoryA(path.c_str(), NULL) != 0;
+        return CreateDirectoryA(path.c_str(), NULL) != 0 || isDirectoryInternal(path);
 #else
-        return mkdir(path.c_str(), 0755) == 0;
+        return mkdir(path.c_str(), 0755) == 0 || isDirectoryInternal(path);
 #endif
     }
 
@@ -274,7 +748,13 @@ private:
             return true;
         }
 
-        if (isDirectoryInternal(path)) {
+#ifdef _WIN32
+        bool directory = isDirectoryInternal(path);
+#else
+        // Remove symlinks themselves, never the tree they point to
+        bool directory = entryType(path, DT_UNKNOWN, false) == FileType::Directory;
+#endif
+        if (directory) {
             auto entries = listDirectoryInternal(path, false);
             for (const auto& entry : entries) {
                 if (!removeAllInternal(entry)) {
@@ -330,7 +810,7 @@ private:
             std::string fullPath = path + "/" + name;
             results.push_back(fullPath);
 
-            if (recursive && entry->d_type == DT_DIR) {
+            if (recursive && entryType(fullPath, entry->d_type, false) == FileType::Directory) {
                 auto subResults = listDirectoryInternal(fullPath, true);
                 results.insert(results.end(), subResults.begin(), subResults.end());
             }
@@ -378,8 +858,6 @@ public:
      * @return True if the path exists, false otherwise
      */
     bool exists(const std::string& path) const {
-        std::lock_guard<std::mutex> lock(m_mutex);
-
 #ifdef _WIN32
         DWORD attrs = GetFileAttributesA(path.c_str());
         return (attrs != INVALID_FILE_ATTRIBUTES);
@@ -395,8 +873,6 @@ public:
      * @return True if the path is a directory, false otherwise
      */
     bool isDirectory(const std::string& path) const {
-        std::lock_guard<std::mutex> lock(m_mutex);
-
 #ifdef _WIN32
         DWORD attrs = GetFileAttributesA(path.c_str());
         return (attrs != INVALID_FILE_ATTRIBUTES) && (attrs & FILE_ATTRIBUTE_DIRECTORY);
@@ -412,8 +888,6 @@ public:
      * @return True if the path is a regular file, false otherwise
      */
     bool isFile(const std::string& path) const {
-        std::lock_guard<std::mutex> lock(m_mutex);
-
 #ifdef _WIN32
         DWORD attrs = GetFileAttributesA(path.c_str());
         return (attrs != INVALID_FILE_ATTRIBUTES) && !(attrs & FILE_ATTRIBUTE_DIRECTORY);
@@ -429,8 +903,6 @@ public:
      * @return Size of the file in bytes, or 0 if file doesn't exist or is a directory
      */
     size_t getFileSize(const std::string& path) const {
-        std::lock_guard<std::mutex> lock(m_mutex);
-
 #ifdef _WIN32
         WIN32_FILE_ATTRIBUTE_DATA fileInfo;
         if (GetFileAttributesExA(path.c_str(), GetFileExInfoStandard, &fileInfo)) {
@@ -455,8 +927,6 @@ public:
      * @return FileInfo structure containing file metadata
      */
     FileInfo getFileInfo(const std::string& path) const {
-        std::lock_guard<std::mutex> lock(m_mutex);
-
         FileInfo info;
         info.path = path;
         info.name = Path::basename(path);
@@ -502,7 +972,6 @@ public:
      * @return Vector of file paths
      */
     std::vector<std::string> listDirectory(const std::string& path, bool recursive = false) const {
-        std::lock_guard<std::mutex> lock(m_mutex);
         return listDirectoryInternal(path, recursive);
     }
 
@@ -531,7 +1000,6 @@ public:
      * @return true if successful
      */
     bool createDirectory(const std::string& path, bool createParents = false) {
-        std::lock_guard<std::mutex> lock(m_mutex);
         return createDirectoryInternal(path, createParents);
     }
 
@@ -541,7 +1009,6 @@ public:
      * @return True if successful, false otherwise
      */
     bool removeFile(const std::string& path) {
-        std::lock_guard<std::mutex> lock(m_mutex);
         return removeFileInternal(path);
     }
 
@@ -551,7 +1018,6 @@ public:
      * @return True if successful, false otherwise
      */
     bool removeDirectory(const std::string& path) {
-        std::lock_guard<std::mutex> lock(m_mutex);
         return removeDirectoryInternal(path);
     }
 
@@ -561,7 +1027,6 @@ public:
      * @return True if successful, false otherwise
      */
     bool removeAll(const std::string& path) {
-        std::lock_guard<std::mutex> lock(m_mutex);
         return removeAllInternal(path);
     }
 
@@ -569,24 +1034,76 @@ public:
      * @brief Copy a file
      * @param source Path to the source file
      * @param destination Path to the destination file
+     * @param durability Persistence of the copy before returning
      * @return True if successful, false otherwise
+     *
+     * The data is copied by the kernel where possible: as a reflink on file
+     * systems with shared extents, with copy_file_range() or sendfile() on
+     * Linux, and with CopyFileA() on Windows. Other systems and file types
+     * fall back to a read/write loop. The destination takes the permissions
+     * of the source when it is created.
      */
-    bool copyFile(const std::string& source, const std::string& destination) {
-        std::lock_guard<std::mutex> lock(m_mutex);
+    bool copyFile(const std::string& source, const std::string& destination,
+                  Durability durability = Durability::None) {
+        std::lock_guard<std::mutex> lock(pathLock(destination));
 
-        std::ifstream src(source, std::ios::binary);
-        if (!src.is_open()) {
+#ifdef _WIN32
+        std::string target = destination;
+        if (durability == Durability::Atomic) {
+            // Reserve a unique name, then let CopyFileA() overwrite it
+            if (!TempFile::reserve(destination, target)) {
+                return false;
+            }
+        }
+        if (!CopyFileA(source.c_str(), target.c_str(), FALSE)) {
+            if (durability == Durability::Atomic) {
+                std::remove(target.c_str());
+            }
             return false;
         }
-
-        std::ofstream dst(destination, std::ios::binary);
-        if (!dst.is_open()) {
+        if (durability == Durability::None) {
+            return true;
+        }
+        int fd = _open(target.c_str(), _O_WRONLY | _O_BINARY);
+        if (fd < 0) {
+            std::remove(target.c_str());
+            return false;
+        }
+        return finishWrite(fd, true, destination, target, durability);
+#else
+        int src = ::open(source.c_str(), O_RDONLY | O_CLOEXEC);
+        if (src < 0) {
+            return false;
+        }
+        struct stat st;
+        if (fstat(src, &st) != 0 || S_ISDIR(st.st_mode)) {
+            ::close(src);
             return false;
         }
 
-        dst << src.rdbuf();
+        std::string target = destination;
+        int dst = durability == Durability::Atomic
+                      ? TempFile::create(destination, target, static_cast<int>(st.st_mode & 07777))
+                      : ::open(target.c_str(), O_WRONLY | O_CREAT | O_CLOEXEC, st.st_mode & 07777);
+        struct stat dstStat;
+        bool sameFile = dst >= 0 && fstat(dst, &dstStat) == 0 &&
+                        dstStat.st_dev == st.st_dev && dstStat.st_ino == st.st_ino;
+        // Truncate only after making sure the destination is not the source itself
+        if (dst < 0 || sameFile || ftruncate(dst, 0) != 0) {
+            if (dst >= 0) {
+                ::close(dst);
+                if (durability == Durability::Atomic) {
+                    std::remove(target.c_str());
+                }
+            }
+            ::close(src);
+            return false;
+        }
 
-        return src.good() && dst.good();
+        bool success = copyFd(src, dst);
+        ::close(src);
+        return finishWrite(dst, success, destination, target, durability);
+#endif
     }
 
     /**
@@ -596,7 +1113,17 @@ public:
      * @return True if successful, false otherwise
      */
     bool move(const std::string& source, const std::string& destination) {
-        std::lock_guard<std::mutex> lock(m_mutex);
+        // Both paths change; take their stripes in address order (once if they share one)
+        std::mutex* first = &pathLock(source);
+        std::mutex* second = &pathLock(destination);
+        if (std::less<std::mutex*>()(second, first)) {
+            std::swap(first, second);
+        }
+        std::lock_guard<std::mutex> firstLock(*first);
+        std::unique_lock<std::mutex> secondLock(*second, std::defer_lock);
+        if (second != first) {
+            secondLock.lock();
+        }
 
 #ifdef _WIN32
         return MoveFileA(source.c_str(), destination.c_str()) != 0;
@@ -612,23 +1139,10 @@ public:
      * @throws std::runtime_error If file cannot be opened or read
      */
     std::string readFile(const std::string& path) const {
-        std::lock_guard<std::mutex> lock(m_mutex);
-
-        std::ifstream file(path, std::ios::binary);
-        if (!file.is_open()) {
-            throw std::runtime_error("Failed to open file: " + path);
-        }
-
         std::string content;
-        file.seekg(0, std::ios::end);
-        content.resize(file.tellg());
-        file.seekg(0, std::ios::beg);
-        file.read(&content[0], content.size());
-
-        if (!file.good()) {
+        if (!readAllInternal(path, content)) {
             throw std::runtime_error("Failed to read file: " + path);
         }
-
         return content;
     }
 
@@ -639,27 +1153,30 @@ public:
      * @throws std::runtime_error If file cannot be opened or read
      */
     std::vector<uint8_t> readBinary(const std::string& path) const {
-        std::lock_guard<std::mutex> lock(m_mutex);
-
-        std::ifstream file(path, std::ios::binary);
-        if (!file.is_open()) {
-            throw std::runtime_error("Failed to open file: " + path);
-        }
-
-        file.seekg(0, std::ios::end);
-        size_t size = file.tellg();
-        file.seekg(0, std::ios::beg);
-
-        std::vector<uint8_t> data(size);
-        file.read(reinterpret_cast<char*>(data.data()), size);
-
-        if (!file.good()) {
+        std::vector<uint8_t> data;
+        if (!readAllInternal(path, data)) {
             throw std::runtime_error("Failed to read file: " + path);
         }
-
         return data;
     }
 
+    /**
+     * @brief Map a file into memory instead of copying it
+     * @param path Path to the file to map
+     * @param mode Read-only or read-write access
+     * @param options Access pattern hint and pre-faulting
+     * @return Mapping whose view() or bytes() expose the contents
+     * @throws std::runtime_error If the file cannot be opened or mapped
+     *
+     * Unlike readFile(), nothing is copied and no lock is held while the
+     * contents are read. See MappedFile for the restrictions on files that
+     * are truncated while mapped.
+     */
+    MappedFile map(const std::string& path, MapMode mode = MapMode::ReadOnly,
+                   MapOptions options = MapOptions()) const {
+        return MappedFile(path, mode, options);
+    }
+
     /**
      * @brief Read file line by line
      * @param path Path to the file to read
@@ -667,8 +1184,6 @@ public:
      * @throws std::runtime_error If file cannot be opened
      */
     std::vector<std::string> readLines(const std::string& path) const {
-        std::lock_guard<std::mutex> lock(m_mutex);
-
         std::ifstream file(path);
         if (!file.is_open()) {
             throw std::runtime_error("Failed to open file: " + path);
@@ -688,22 +1203,23 @@ public:
      * @param path File path
      * @param content Content to write
      * @param append If true, append to file; otherwise overwrite
+     * @return True if successful, false otherwise
      */
     bool writeFile(const std::string& path, const std::string& content, bool append = false) {
-        std::lock_guard<std::mutex> lock(m_mutex);
-
-        auto mode = std::ios::binary;
-        if (append) {
-            mode |= std::ios::app;
-        }
-
-        std::ofstream file(path, mode);
-        if (!file.is_open()) {
-            return false;
-        }
+        WriteOptions options;
+        options.append = append;
+        return writeFile(path, content, options);
+    }
 
-        file.write(content.data(), content.size());
-        return file.good();
+    /**
+     * @brief Write string to file with explicit durability
+     * @param path File path
+     * @param content Content to write
+     * @param options Append, durability and preallocation
+     * @return True if the content was written with the requested durability
+     */
+    bool writeFile(const std::string& path, std::string_view content, const WriteOptions& options) {
+        return writeBuffers(path, {content}, options);
     }
 
     /**
@@ -714,20 +1230,21 @@ public:
      * @return True if successful, false otherwise
      */
     bool writeBinary(const std::string& path, const std::vector<uint8_t>& data, bool append = false) {
-        std::lock_guard<std::mutex> lock(m_mutex);
-
-        auto mode = std::ios::binary;
-        if (append) {
-            mode |= std::ios::app;
-        }
-
-        std::ofstream file(path, mode);
-        if (!file.is_open()) {
-            return false;
-        }
+        WriteOptions options;
+        options.append = append;
+        return writeBinary(path, data, options);
+    }
 
-        file.write(reinterpret_cast<const char*>(data.data()), data.size());
-        return file.good();
+    /**
+     * @brief Write binary data to file with explicit durability
+     * @param path Path to the file to write
+     * @param data Binary data to write
+     * @param options Append, durability and preallocation
+     * @return True if the data was written with the requested durability
+     */
+    bool writeBinary(const std::string& path, const std::vector<uint8_t>& data, const WriteOptions& options) {
+        return writeBuffers(path, {std::string_view(reinterpret_cast<const char*>(data.data()), data.size())},
+                            options);
     }
 
     /**
@@ -738,23 +1255,56 @@ public:
      * @return True if successful, false otherwise
      */
     bool writeLines(const std::string& path, const std::vector<std::string>& lines, bool append = false) {
-        std::lock_guard<std::mutex> lock(m_mutex);
-
-        auto mode = std::ios::out;
-        if (append) {
-            mode |= std::ios::app;
-        }
-
-        std::ofstream file(path, mode);
-        if (!file.is_open()) {
-            return false;
-        }
+        WriteOptions options;
+        options.append = append;
+        return writeLines(path, lines, options);
+    }
 
+    /**
+     * @brief Write lines to file with explicit durability
+     * @param path Path to the file to write
+     * @param lines Vector of strings to write, each followed by a line break
+     * @param options Append, durability and preallocation
+     * @return True if the lines were written with the requested durability
+     */
+    bool writeLines(const std::string& path, const std::vector<std::string>& lines, const WriteOptions& options) {
+#ifdef _WIN32
+        static constexpr std::string_view newline = "\r\n";
+#else
+        static constexpr std::string_view newline = "\n";
+#endif
+        std::vector<std::string_view> buffers;
+        buffers.reserve(lines.size() * 2);
         for (const auto& line : lines) {
-            file << line << '\n';
+            buffers.push_back(line);
+            buffers.push_back(newline);
         }
+        return writeBuffers(path, buffers, options);
+    }
 
-        return file.good();
+    /**
+     * @brief Write several buffers to a file in one pass
+     * @param path File path
+     * @param buffers Buffers written back to back; they are not copied
+     * @param options Append, durability and preallocation
+     * @return True if all buffers were written with the requested durability
+     *
+     * Buffers are handed to the kernel in batches with writev(), so a file
+     * assembled from a header, a body and a footer needs neither a
+     * concatenated copy nor a stream buffer. Writes of 1 MB and more reserve
+     * their space first when WriteOptions::preallocate is set.
+     *
+     * Usage:
+     * @code
+     * WriteOptions options;
+     * options.durability = Durability::Atomic;
+     * fs.writeBuffers("cache/atlas.bin", {header, pixels}, options);
+     * @endcode
+     */
+    bool writeBuffers(const std::string& path, const std::vector<std::string_view>& buffers,
+                      const WriteOptions& options = WriteOptions()) {
+        std::lock_guard<std::mutex> lock(pathLock(path));
+        return writeBuffersInternal(path, buffers, options);
     }
 
     /**
@@ -795,59 +1345,253 @@ public:
     }
 
     /**
-     * @brief Find files matching a pattern (simple wildcard matching)
+     * @brief Find files whose name matches a pattern
      * @param path Directory to search
-     * @param pattern Pattern to match (supports * and ? wildcards)
+     * @param pattern Pattern matched against file names (glob syntax, see Glob)
      * @param recursive If true, search recursively in subdirectories
      * @return Vector of file paths matching the pattern
      */
     std::vector<std::string> find(const std::string& path, const std::string& pattern, bool recursive = false) const {
-        auto files = listDirectory(path, recursive);
+        Glob glob(pattern);
         std::vector<std::string> results;
-
-        for (const auto& file : files) {
-            std::string filename = Path::basename(file);
-            if (matchPattern(filename, pattern)) {
-                results.push_back(file);
+        WalkOptions options;
+        options.recursive = recursive;
+        walk(path, [&](const DirectoryEntry& entry) {
+            if (glob.matches(Path::basename(entry.path))) {
+                results.push_back(entry.path);
             }
-        }
+            return true;
+        }, options);
+        return results;
+    }
+
+    /**
+     * @brief Visit the entries below a directory
+     * @param root Directory to walk
+     * @param visitor Called for each entry; return false to stop
+     * @param options Recursion, symlinks and thread pool
+     * @return false if the visitor stopped the walk
+     *
+     * Entry types come from the directory listing, so files are not
+     * stat()ed unless the file system does not report types. With a pool,
+     * directories are read in parallel by the pool and the calling thread;
+     * the visitor is never called concurrently, but entries arrive in no
+     * particular order. Unreadable directories are skipped.
+     */
+    bool walk(const std::string& root, const DirectoryVisitor& visitor, const WalkOptions& options = WalkOptions()) const {
+        return walkTree(root, nullptr, visitor, options);
+    }
+
+    /**
+     * @brief Visit the entries below a directory whose relative path matches a pattern
+     * @param root Directory to walk
+     * @param pattern Compiled pattern relative to @p root
+     * @param visitor Called for each matching file or directory; return false to stop
+     * @param options Recursion, symlinks and thread pool (see walk())
+     * @return false if the visitor stopped the walk
+     *
+     * Subdirectories that cannot contain matches (see Glob::mayMatchBelow())
+     * are not read at all.
+     */
+    bool glob(const std::string& root, const Glob& pattern, const DirectoryVisitor& visitor,
+              const WalkOptions& options = WalkOptions()) const {
+        return walkTree(root, &pattern, visitor, options);
+    }
 
+    /**
+     * @brief Collect the paths below a directory that match a pattern
+     * @param root Directory to walk
+     * @param pattern Glob pattern relative to @p root, e.g. "*.json" or "assets/{ui,world}/[a-z]*.png"
+     * @param options Recursion, symlinks and thread pool (see walk())
+     * @return Matching paths (root joined with the relative path), sorted
+     */
+    std::vector<std::string> glob(const std::string& root, const std::string& pattern,
+                                  const WalkOptions& options = WalkOptions()) const {
+        std::vector<std::string> results;
+        glob(root, Glob(pattern), [&](const DirectoryEntry& entry) {
+            results.push_back(entry.path);
+            return true;
+        }, options);
+        std::sort(results.begin(), results.end());
         return results;
     }
 
 private:
+#ifndef _WIN32
     /**
-     * @brief Simple wildcard pattern matching (supports *)
-     */
-    bool matchPattern(const std::string& str, const std::string& pattern) const {
-        size_t strPos = 0;
-        size_t patPos = 0;
-        size_t starPos = std::string::npos;
-        size_t matchPos = 0;
-
-        while (strPos < str.length()) {
-            if (patPos < pattern.length() &&
-                (pattern[patPos] == str[strPos] || pattern[patPos] == '?')) {
-                strPos++;
-                patPos++;
-            } else if (patPos < pattern.length() && pattern[patPos] == '*') {
-                starPos = patPos;
-                matchPos = strPos;
-                patPos++;
-            } else if (starPos != std::string::npos) {
-                patPos = starPos + 1;
-                matchPos++;
-                strPos = matchPos;
-            } else {
-                return false;
+     * @brief Type of a directory entry, falling back to lstat()/stat() when readdir() does not report it
+     */
+    static FileType entryType(const std::string& path, unsigned char type, bool followSymlinks) {
+        if (type == DT_UNKNOWN || (type == DT_LNK && followSymlinks)) {
+            struct stat st;
+            int result = followSymlinks ? stat(path.c_str(), &st) : lstat(path.c_str(), &st);
+            return result == 0 ? getFileType(st.st_mode) : FileType::Unknown;
+        }
+        switch (type) {
+            case DT_DIR: return FileType::Directory;
+            case DT_REG: return FileType::Regular;
+            case DT_LNK: return FileType::Symlink;
+            default: return FileType::Unknown;
+        }
+    }
+#endif
+
+    // Shared by the threads of one walk
+    struct WalkState {
+        const Glob* glob = nullptr;
+        WalkOptions options;
+
+        std::mutex mutex;
+        std::condition_variable changed;
+        std::vector<std::pair<std::string, std::string>> queue;  // Directories to read: path, relative path
+        size_t active = 0;                                       // Directories being read
+        std::atomic<bool> stopped{false};
+        std::set<std::pair<uint64_t, uint64_t>> visited;         // Device and inode, when following symlinks
+
+        std::mutex visitorMutex;
+        const DirectoryVisitor* visitor = nullptr;
+    };
+
+    /**
+     * @brief Walk a tree on the calling thread and, if given, the pool
+     */
+    bool walkTree(const std::string& root, const Glob* glob, const DirectoryVisitor& visitor,
+                  const WalkOptions& options) const {
+        auto state = std::make_shared<WalkState>();
+        state->glob = glob;
+        state->options = options;
+        state->visitor = &visitor;
+        state->queue.emplace_back(root, "");
+        if (options.followSymlinks) {
+            markVisited(*state, root);
+        }
+
+        // Pool workers that start after the walk has finished find the queue empty and return
+        if (options.pool) {
+            for (size_t i = 0; i < options.pool->getThreadCount(); ++i) {
+                try {
+                    options.pool->submit([state]() { walkWorker(*state); });
+                } catch (const std::runtime_error&) {
+                    break;  // Pool stopped: walk on the calling thread
+                }
             }
         }
+        walkWorker(*state);
+        return !state->stopped;
+    }
+
+    /**
+     * @brief Read queued directories until the walk is done or stopped
+     */
+    static void walkWorker(WalkState& state) {
+        while (true) {
+            std::pair<std::string, std::string> directory;
+            {
+                std::unique_lock<std::mutex> lock(state.mutex);
+                state.changed.wait(lock, [&] {
+                    return (!state.stopped && !state.queue.empty()) || state.active == 0;
+                });
+                if (state.stopped || state.queue.empty()) {
+                    state.changed.notify_all();
+                    return;
+                }
+                directory = std::move(state.queue.back());
+                state.queue.pop_back();
+                ++state.active;
+            }
+
+            std::vector<DirectoryEntry> entries;
+            std::vector<std::pair<std::string, std::string>> subdirectories;
+            readEntries(state, directory.first, directory.second, entries, subdirectories);
+
+            if (!entries.empty() && !state.stopped) {
+                std::lock_guard<std::mutex> lock(state.visitorMutex);
+                for (const auto& entry : entries) {
+                    if (state.stopped || !(*state.visitor)(entry)) {
+                        state.stopped = true;
+                        break;
+                    }
+                }
+            }
 
-        while (patPos < pattern.length() && pattern[patPos] == '*') {
-            patPos++;
+            std::lock_guard<std::mutex> lock(state.mutex);
+            // Reversed so that a single-threaded walk visits subdirectories in listing order
+            state.queue.insert(state.queue.end(), std::make_move_iterator(subdirectories.rbegin()),
+                               std::make_move_iterator(subdirectories.rend()));
+            --state.active;
+            state.changed.notify_all();
         }
+    }
+
+    /**
+     * @brief List one directory, filtering by the glob and collecting subdirectories to descend into
+     */
+    static void readEntries(WalkState& state, const std::string& path, const std::string& relative,
+                            std::vector<DirectoryEntry>& entries,
+                            std::vector<std::pair<std::string, std::string>>& subdirectories) {
+        auto add = [&](const std::string& name, FileType type) {
+            DirectoryEntry entry;
+            entry.path = Path::join(path, name);
+            entry.relativePath = relative.empty() ? name : relative + "/" + name;
+            entry.type = type;
+
+            if (type == FileType::Directory && state.options.recursive &&
+                (!state.glob || state.glob->mayMatchBelow(entry.relativePath)) &&
+                (!state.options.followSymlinks || markVisited(state, entry.path))) {
+                subdirectories.emplace_back(entry.path, entry.relativePath);
+            }
+            if (!state.glob || state.glob->matches(entry.relativePath)) {
+                entries.push_back(std::move(entry));
+            }
+        };
 
-        return patPos == pattern.length();
+#ifdef _WIN32
+        WIN32_FIND_DATAA findData;
+        HANDLE hFind = FindFirstFileA((path + "\\*").c_str(), &findData);
+        if (hFind == INVALID_HANDLE_VALUE) {
+            return;
+        }
+        do {
+            std::string name = findData.cFileName;
+            if (name != "." && name != "..") {
+                add(name, getFileType(findData.dwFileAttributes));
+            }
+        } while (!state.stopped && FindNextFileA(hFind, &findData));
+        FindClose(hFind);
+#else
+        DIR* dir = opendir(path.c_str());
+        if (!dir) {
+            return;
+        }
+        struct dirent* entry;
+        while (!state.stopped && (entry = readdir(dir)) != nullptr) {
+            const char* name = entry->d_name;
+            if (name[0] == '.' && (name[1] == '\0' || (name[1] == '.' && name[2] == '\0'))) {
+                continue;
+            }
+            add(name, entryType(Path::join(path, name), entry->d_type, state.options.followSymlinks));
+        }
+        closedir(dir);
+#endif
+    }
+
+    /**
+     * @brief Record a directory reached while following symlinks
+     * @return false if it was visited before
+     */
+    static bool markVisited(WalkState& state, const std::string& path) {
+#ifdef _WIN32
+        (void)state;
+        (void)path;
+        return true;
+#else
+        struct stat st;
+        if (stat(path.c_str(), &st) != 0) {
+            return false;
+        }
+        std::lock_guard<std::mutex> lock(state.mutex);
+        return state.visited.emplace(static_cast<uint64_t>(st.st_dev), static_cast<uint64_t>(st.st_ino)).second;
+#endif
     }
 };
 
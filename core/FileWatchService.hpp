@@ -0,0 +1,427 @@
+/**
+ * @file FileWatchService.hpp
+ * @brief Process-wide file watching shared by all subsystems
+ *
+ * Every FileWatcher runs its own thread and, with the inotify backend, owns
+ * an inotify descriptor. FileWatchService multiplexes any number of
+ * subscriptions onto a single FileWatcher, so plugin hot reload,
+ * configuration reload, resource reload and log rotation share one thread
+ * and one descriptor. Application creates one and registers it in the
+ * ServiceLocator.
+ */
+
+#pragma once
+
+#include "FileWatcher.hpp"
+#include "ThreadPool.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <filesystem>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <stdexcept>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace mcf {
+
+/**
+ * @brief Identifies a FileWatchService subscription
+ */
+using FileWatchId = uint64_t;
+
+/**
+ * @brief Options of a FileWatchService subscription
+ */
+struct FileWatchOptions {
+    /// Report a change once the file stayed unchanged this long (see FileWatcher::addWatch())
+    std::chrono::milliseconds settleTime{0};
+
+    /// Pool running the callback, or nullptr to run it on the watcher thread
+    ThreadPool* executor = nullptr;
+
+    /// FileWatchMode::Presence to be told only of creation, deletion and
+    /// replacement of a file (see FileWatcher::addWatch()); ignored for directories
+    FileWatchMode mode = FileWatchMode::Changes;
+};
+
+/**
+ * @brief Shared file watcher with per-subscriber callbacks
+ *
+ * Subscriptions to the same file or directory share one underlying watch.
+ * If subscribers ask for different settle times, the longest one applies
+ * to all of them; a file is watched in FileWatchMode::Presence only if
+ * every subscriber asks for it. Directory subscriptions are filtered by
+ * their own patterns. The watcher thread starts with the first subscription.
+ *
+ * Usage:
+ * @code
+ * auto service = serviceLocator->resolve<FileWatchService>();
+ * FileWatchId id = service->watchFile("config/app.json", [](const std::string& path, FileChangeType) {
+ *     reloadConfig(path);
+ * });
+ * service->unwatch(id);
+ * @endcode
+ */
+class FileWatchService {
+private:
+    // Shared with queued deliveries so that unwatch() can cancel them
+    struct Delivery {
+        std::recursive_mutex mutex;  // Held while the callback runs
+        std::atomic<bool> active{true};
+    };
+
+    struct Subscription {
+        FileWatchId id = 0;
+        FileChangeCallback callback;
+        FileWatchOptions options;
+        DirectoryWatchOptions filter;  // Directory subscriptions only
+        std::shared_ptr<Delivery> delivery = std::make_shared<Delivery>();
+    };
+
+    struct Target {
+        bool directory = false;
+        std::vector<Subscription> subscriptions;
+        std::chrono::milliseconds settleTime{0};      // Of the registered watch
+        FileWatchMode mode = FileWatchMode::Changes;  // File watches
+        DirectoryWatchOptions registered;             // Directory watches
+    };
+
+    // Change of an underlying watch, applied once m_mutex is released
+    struct Registration {
+        bool needed = false;
+        bool directory = false;
+        std::string path;
+        std::chrono::milliseconds settleTime{0};
+        FileWatchMode mode = FileWatchMode::Changes;
+        DirectoryWatchOptions options;
+    };
+
+    FileWatcher m_watcher;
+
+    // Watched path (file or directory) -> subscriptions; keys of files and directories are kept apart
+    std::map<std::pair<bool, std::string>, Target> m_targets;
+    std::map<FileWatchId, std::pair<bool, std::string>> m_ids;
+    FileWatchId m_nextId = 1;
+
+    mutable std::mutex m_mutex;
+
+    // Serializes registrations; adding a watch lists and hashes files, which must not block m_mutex
+    std::mutex m_registerMutex;
+
+public:
+    /**
+     * @brief Constructor
+     * @param pollInterval Poll interval of the shared watcher
+     * @param backend Change detection mechanism (see FileWatcher)
+     * @throws std::runtime_error if FileWatcherBackend::Inotify is requested but unavailable
+     */
+    explicit FileWatchService(std::chrono::milliseconds pollInterval = std::chrono::milliseconds(1000),
+                              FileWatcherBackend backend = FileWatcherBackend::Auto)
+        : m_watcher(pollInterval, backend) {}
+
+    ~FileWatchService() {
+        m_watcher.stop();
+    }
+
+    // Non-copyable
+    FileWatchService(const FileWatchService&) = delete;
+    FileWatchService& operator=(const FileWatchService&) = delete;
+
+    /**
+     * @brief Subscribe to changes of a file
+     * @param path File to watch; it does not have to exist yet
+     * @param callback Called with the path and kind of each change
+     * @param options Settle time and executor
+     * @return Subscription id for unwatch()
+     */
+    FileWatchId watchFile(const std::string& path, FileChangeCallback callback,
+                          FileWatchOptions options = FileWatchOptions()) {
+        Subscription subscription;
+        subscription.callback = std::move(callback);
+        subscription.options = options;
+        return subscribe(false, path, std::move(subscription));
+    }
+
+    /**
+     * @brief Subscribe to changes of the files in a directory tree
+     * @param directory Directory to watch (see FileWatcher::addDirectoryWatch())
+     * @param callback Called with the path and kind of each change
+     * @param filter Recursion and glob patterns of this subscriber; its settle time is ignored
+     * @param options Settle time and executor
+     * @return Subscription id for unwatch()
+     */
+    FileWatchId watchDirectory(const std::string& directory, FileChangeCallback callback,
+                               DirectoryWatchOptions filter = DirectoryWatchOptions(),
+                               FileWatchOptions options = FileWatchOptions()) {
+        Subscription subscription;
+        subscription.callback = std::move(callback);
+        subscription.options = options;
+        subscription.filter = std::move(filter);
+        return subscribe(true, directory.empty() ? "." : directory, std::move(subscription));
+    }
+
+    /**
+     * @brief Remove a subscription
+     * @param id Subscription id
+     * @param wait Also wait until a running callback of the subscription has returned
+     * @return true if the subscription existed
+     *
+     * Deliveries still queued on an executor are dropped. With @p wait,
+     * the callback is guaranteed not to run once this returns, so its owner
+     * may be destroyed; do not wait while holding a lock the callback takes.
+     * Callbacks may remove their own subscription.
+     */
+    bool unwatch(FileWatchId id, bool wait = false) {
+        std::shared_ptr<Delivery> delivery;
+        {
+            std::lock_guard<std::mutex> registering(m_registerMutex);
+            Registration registration;
+            {
+                std::lock_guard<std::mutex> lock(m_mutex);
+                auto key = m_ids.find(id);
+                if (key == m_ids.end()) {
+                    return false;
+                }
+                auto target = m_targets.find(key->second);
+                m_ids.erase(key);
+
+                auto& subscriptions = target->second.subscriptions;
+                auto subscription = std::find_if(subscriptions.begin(), subscriptions.end(),
+                                                 [id](const Subscription& s) { return s.id == id; });
+                delivery = subscription->delivery;
+                subscriptions.erase(subscription);
+                if (subscriptions.empty()) {
+                    if (target->second.directory) {
+                        m_watcher.removeDirectoryWatch(target->first.second);
+                    } else {
+                        m_watcher.removeWatch(target->first.second);
+                    }
+                    m_targets.erase(target);
+                } else {
+                    registration = planTarget(target->first.second, target->second, false);
+                }
+            }
+            registerWatch(registration);
+        }
+
+        delivery->active = false;
+        if (wait) {
+            std::lock_guard<std::recursive_mutex> running(delivery->mutex);
+        }
+        return true;
+    }
+
+    /**
+     * @brief Use a shorter poll interval if a subscriber needs one
+     * @param interval Requested interval; longer intervals than the current one are ignored
+     */
+    void requestPollInterval(std::chrono::milliseconds interval) {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        if (interval < m_watcher.getPollInterval()) {
+            m_watcher.setPollInterval(interval);
+        }
+    }
+
+    /**
+     * @brief Set the poll interval of the shared watcher
+     * @param interval Time between polls of files not covered by kernel notifications
+     */
+    void setPollInterval(std::chrono::milliseconds interval) {
+        m_watcher.setPollInterval(interval);
+    }
+
+    /**
+     * @brief Confirm modifications by content hash (see FileWatcher::setContentHashing())
+     * @param enabled true to hash watched files
+     */
+    void setContentHashing(bool enabled) {
+        m_watcher.setContentHashing(enabled);
+    }
+
+    /**
+     * @brief Get the number of subscriptions
+     * @return Active subscriptions
+     */
+    size_t getSubscriptionCount() const {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        return m_ids.size();
+    }
+
+    /**
+     * @brief Get the number of distinct watched files and directories
+     * @return Watches registered with the underlying FileWatcher
+     */
+    size_t getWatchCount() const {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        return m_targets.size();
+    }
+
+    /**
+     * @brief Get the active change detection mechanism
+     * @return FileWatcherBackend::Inotify or FileWatcherBackend::Polling
+     */
+    FileWatcherBackend backend() const {
+        return m_watcher.backend();
+    }
+
+private:
+    FileWatchId subscribe(bool directory, const std::string& path, Subscription subscription) {
+        std::lock_guard<std::mutex> registering(m_registerMutex);
+        FileWatchId id;
+        Registration registration;
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            id = m_nextId++;
+            subscription.id = id;
+
+            auto key = std::make_pair(directory, path);
+            auto inserted = m_targets.try_emplace(key);
+            Target& target = inserted.first->second;
+            target.directory = directory;
+            target.subscriptions.push_back(std::move(subscription));
+            m_ids[id] = key;
+
+            registration = planTarget(path, target, inserted.second);
+        }
+
+        registerWatch(registration);
+        m_watcher.start();
+        return id;
+    }
+
+    /**
+     * @brief Work out whether the underlying watch of a target must be (re)registered
+     * @param created Whether the target is new
+     * @return The registration for registerWatch(); not needed if nothing changed
+     *
+     * Must be called while holding m_registerMutex and m_mutex. An existing
+     * watch is replaced only if the merged settle time, mode or filters changed.
+     */
+    Registration planTarget(const std::string& path, Target& target, bool created) {
+        Registration registration;
+        registration.directory = target.directory;
+        registration.path = path;
+
+        std::chrono::milliseconds settleTime{0};
+        FileWatchMode mode = FileWatchMode::Presence;
+        for (const auto& subscription : target.subscriptions) {
+            settleTime = std::max(settleTime, subscription.options.settleTime);
+            if (subscription.options.mode == FileWatchMode::Changes) {
+                mode = FileWatchMode::Changes;
+            }
+        }
+
+        if (!target.directory) {
+            if (created || settleTime != target.settleTime || mode != target.mode) {
+                target.settleTime = settleTime;
+                target.mode = mode;
+                registration.needed = true;
+                registration.settleTime = settleTime;
+                registration.mode = mode;
+            }
+            return registration;
+        }
+
+        // One watch serves all subscribers: recursive if any is, and no filter if any has none
+        DirectoryWatchOptions merged;
+        merged.recursive = false;
+        merged.settleTime = settleTime;
+        bool unfiltered = false;
+        for (const auto& subscription : target.subscriptions) {
+            merged.recursive = merged.recursive || subscription.filter.recursive;
+            unfiltered = unfiltered || subscription.filter.patterns.empty();
+            merged.patterns.insert(merged.patterns.end(), subscription.filter.patterns.begin(),
+                                   subscription.filter.patterns.end());
+        }
+        if (unfiltered) {
+            merged.patterns.clear();
+        }
+        std::sort(merged.patterns.begin(), merged.patterns.end());
+        merged.patterns.erase(std::unique(merged.patterns.begin(), merged.patterns.end()), merged.patterns.end());
+
+        const DirectoryWatchOptions& current = target.registered;
+        if (created || merged.recursive != current.recursive || merged.patterns != current.patterns ||
+            merged.settleTime != current.settleTime) {
+            target.registered = merged;
+            registration.needed = true;
+            registration.options = std::move(merged);
+        }
+        return registration;
+    }
+
+    /**
+     * @brief Apply a registration from planTarget() to the watcher
+     *
+     * Must be called while holding m_registerMutex but not m_mutex: the
+     * watcher lists and hashes the watched files, and dispatched changes
+     * keep flowing meanwhile.
+     */
+    void registerWatch(Registration& registration) {
+        if (!registration.needed) {
+            return;
+        }
+        if (registration.directory) {
+            m_watcher.addDirectoryWatch(registration.path, dispatcher(true, registration.path),
+                                        std::move(registration.options));
+        } else {
+            m_watcher.addWatch(registration.path, dispatcher(false, registration.path), registration.settleTime,
+                               registration.mode);
+        }
+    }
+
+    /**
+     * @brief Callback registered with the watcher for one target
+     */
+    FileChangeCallback dispatcher(bool directory, const std::string& watched) {
+        return [this, directory, watched](const std::string& path, FileChangeType type) {
+            struct Pending {
+                FileChangeCallback callback;
+                ThreadPool* executor;
+                std::shared_ptr<Delivery> delivery;
+            };
+            std::vector<Pending> pending;
+            {
+                std::lock_guard<std::mutex> lock(m_mutex);
+                auto target = m_targets.find(std::make_pair(directory, watched));
+                if (target == m_targets.end()) {
+                    return;
+                }
+                std::filesystem::path relative;
+                if (directory) {
+                    relative = std::filesystem::path(path).lexically_relative(watched);
+                }
+                for (const auto& subscription : target->second.subscriptions) {
+                    if (!directory || subscription.filter.matches(relative)) {
+                        pending.push_back({subscription.callback, subscription.options.executor, subscription.delivery});
+                    }
+                }
+            }
+
+            for (auto& entry : pending) {
+                auto deliver = [callback = std::move(entry.callback), delivery = std::move(entry.delivery), path, type]() {
+                    std::lock_guard<std::recursive_mutex> running(delivery->mutex);
+                    if (delivery->active) {
+                        callback(path, type);
+                    }
+                };
+                if (entry.executor) {
+                    try {
+                        entry.executor->submit(deliver);
+                        continue;
+                    } catch (const std::runtime_error&) {
+                        // Pool already stopped: deliver on the watcher thread
+                    }
+                }
+                deliver();
+            }
+        };
+    }
+};
+
+} // namespace mcf
@@ -1,13 +1,35 @@
 #pragma once
 
+#include "Glob.hpp"
+#include "Hash.hpp"
+
+#include <algorithm>
 #include <atomic>
 #include <chrono>
+#include <climits>
+#include <condition_variable>
+#include <cstdint>
 #include <filesystem>
+#include <fstream>
 #include <functional>
 #include <map>
 #include <mutex>
+#include <stdexcept>
 #include <string>
+#include <string_view>
+#include <system_error>
 #include <thread>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#ifdef __linux__
+#include <cerrno>
+#include <poll.h>
+#include <sys/eventfd.h>
+#include <sys/inotify.h>
+#include <unistd.h>
+#endif
 
 namespace mcf {
 
@@ -25,23 +47,138 @@ enum class FileChangeType {
  */
 using FileChangeCallback = std::function<void(const std::string& path, FileChangeType changeType)>;
 
+/**
+ * @brief Mechanism used to detect file changes
+ */
+enum class FileWatcherBackend {
+    Auto,     ///< inotify where available, polling otherwise
+    Polling,  ///< Check every watched file each poll interval
+    Inotify   ///< Linux inotify; changes are delivered within milliseconds
+};
+
+/**
+ * @brief What a file watch reports
+ */
+enum class FileWatchMode {
+    Changes,  ///< Creation, deletion and every modification
+    Presence  ///< Only creation, deletion and replacement (e.g. log rotation); writes are not watched
+};
+
+/**
+ * @brief Options of a directory watch
+ */
+struct DirectoryWatchOptions {
+    /// Include subdirectories, including ones created later
+    bool recursive = true;
+
+    /// Glob filters (see matchGlob()); patterns without '/' match the file name,
+    /// others the path relative to the watched directory. Empty matches every file.
+    std::vector<std::string> patterns;
+
+    /// Report a change only once the file's size and modification time have
+    /// stayed the same for this long; bursts of writes become one event
+    std::chrono::milliseconds settleTime{0};
+
+    /**
+     * @brief Whether a file belongs to the watch
+     * @param relative Path relative to the watched directory
+     * @return true if recursion and patterns admit the file
+     */
+    bool matches(const std::filesystem::path& relative) const {
+        if (!recursive && relative.has_parent_path()) {
+            return false;
+        }
+        if (patterns.empty()) {
+            return true;
+        }
+
+        std::string path = relative.generic_string();
+        std::string name = relative.filename().string();
+        for (const auto& pattern : patterns) {
+            bool hasSeparator = pattern.find('/') != std::string::npos;
+            if (matchGlob(pattern, hasSeparator ? path : name)) {
+                return true;
+            }
+        }
+        return false;
+    }
+};
+
 /**
  * @brief Watches files for changes and triggers callbacks
  *
  * Thread-safe file system watcher that monitors files for modifications,
  * creation, and deletion. Used for hot reloading plugins.
+ *
+ * With the inotify backend the watcher thread sleeps until the kernel
+ * reports activity in the directory of a watched file, so it uses no CPU
+ * while idle. Watching the directory rather than the file itself also
+ * catches saves that write a temporary file and rename it over the
+ * original, which editors and build tools commonly do: such a save is
+ * reported as one Modified event. Files whose directory does not exist
+ * (yet) are polled until it can be watched.
+ *
+ * Whole directory trees can be watched with addDirectoryWatch(), and a
+ * settle time delays each report until the file has stopped changing, so
+ * files written in several steps (e.g. shared libraries produced by a
+ * linker) are reported once, complete.
+ *
+ * Polled files (all of them with the polling backend) are checked in
+ * small batches spread evenly over the poll interval, so large watch sets
+ * do not cause a burst of file system calls every interval.
  */
 class FileWatcher {
 private:
+    using Clock = std::chrono::steady_clock;
+
+    struct FileState {
+        bool exists = false;
+        std::filesystem::file_time_type lastModified{};
+        uintmax_t size = 0;
+
+        bool operator==(const FileState& other) const {
+            return exists == other.exists && lastModified == other.lastModified && size == other.size;
+        }
+    };
+
     struct WatchedFile {
-        std::filesystem::file_time_type lastModified;
-        bool exists;
+        FileState state;  // Last reported state
+        FileChangeCallback callback;
+        std::chrono::milliseconds settleTime{0};
+        FileWatchMode mode = FileWatchMode::Changes;
+
+        // Change waiting for the file to settle
+        bool pending = false;
+        bool pendingContent = false;
+        FileState observed;
+        Clock::time_point deadline;
+
+        bool polled = true;     // Not covered by a kernel watch
+        std::string directory;  // Watched directory (inotify)
+        std::string name;       // File name within the directory
+
+        // Content hash of the recorded state (content hashing)
+        bool hashKnown = false;
+        uint64_t hash = 0;
+    };
+
+    struct DirectoryWatch {
         FileChangeCallback callback;
+        DirectoryWatchOptions options;
+        std::filesystem::path root;                // Absolute, normalized
+        std::map<std::string, WatchedFile> files;  // Matching files seen so far
+        bool polled = true;                        // Not completely covered by kernel watches
     };
 
+    // A watched file: directory watch (empty for addWatch()) and reported path
+    using FileKey = std::pair<std::string, std::string>;
+
     // Watched files map
     std::map<std::string, WatchedFile> m_watchedFiles;
 
+    // Watched directory trees
+    std::map<std::string, DirectoryWatch> m_directoryWatches;
+
     // Thread safety
     mutable std::mutex m_mutex;
 
@@ -50,17 +187,91 @@ private:
     std::atomic<bool> m_running{false};
     std::chrono::milliseconds m_pollInterval{1000}; // 1 second default
 
+    FileWatcherBackend m_backend = FileWatcherBackend::Polling;
+
+    // Wakes the polling backend's thread
+    std::condition_variable m_wakeCondition;
+    bool m_wakeRequested = false;
+
+    // Polling round (watcher thread only; m_pollCursor is guarded by m_mutex)
+    FileKey m_pollCursor;  // Last file taken in this round
+    Clock::time_point m_roundStart;
+    size_t m_roundSize = 0;
+    size_t m_roundChecked = 0;
+    bool m_roundActive = false;
+
+    // Confirm modifications by comparing file contents
+    std::atomic<bool> m_contentHashing{false};
+
+    // Polling rounds are split into ticks of at least this length and batch size
+    static constexpr int64_t MinPollTickMs = 10;
+    static constexpr size_t MinPollBatch = 64;
+
+#ifdef __linux__
+    struct WatchedDirectory {
+        int descriptor = -1;
+        uint32_t events = 0;  // Watched events; only ever widened
+        std::map<std::string, std::vector<std::string>> files;  // File name -> watched paths
+        std::vector<std::string> trees;                          // Directory watches covering it
+    };
+
+    // Directory -> inotify watch; descriptor -> directory
+    std::map<std::string, WatchedDirectory> m_directories;
+    std::unordered_map<int, std::string> m_descriptors;
+
+    int m_inotifyFd = -1;
+    int m_wakeFd = -1;  // eventfd interrupting the blocking wait
+
+    static constexpr uint32_t DirectoryEvents =
+        IN_CREATE | IN_DELETE | IN_MODIFY | IN_CLOSE_WRITE | IN_ATTRIB |
+        IN_MOVED_FROM | IN_MOVED_TO | IN_DELETE_SELF | IN_MOVE_SELF | IN_ONLYDIR;
+
+    // Events that change file contents even if the timestamp does not move
+    static constexpr uint32_t ContentEvents = IN_CREATE | IN_MODIFY | IN_CLOSE_WRITE | IN_MOVED_TO;
+
+    // Events of FileWatchMode::Presence files: names appearing and disappearing, not writes
+    static constexpr uint32_t PresenceEvents = IN_CREATE | IN_DELETE | IN_MOVED_FROM | IN_MOVED_TO;
+    static constexpr uint32_t PresenceDirectoryEvents = PresenceEvents | IN_DELETE_SELF | IN_MOVE_SELF | IN_ONLYDIR;
+
+    // Events putting a new file in place of a FileWatchMode::Presence file
+    static constexpr uint32_t ReplaceEvents = IN_CREATE | IN_MOVED_TO;
+
+    // Related events (e.g. the steps of a save) arriving this close together are handled as one batch
+    static constexpr int SettleMs = 5;
+    static constexpr int MaxSettleMs = 50;
+#endif
+
 public:
     /**
      * @brief Constructor
      * @param pollInterval Interval between file checks in milliseconds
+     * @param backend Change detection mechanism
+     * @throws std::runtime_error if FileWatcherBackend::Inotify is requested but unavailable
      */
-    explicit FileWatcher(std::chrono::milliseconds pollInterval = std::chrono::milliseconds(1000))
+    explicit FileWatcher(std::chrono::milliseconds pollInterval = std::chrono::milliseconds(1000),
+                         FileWatcherBackend backend = FileWatcherBackend::Auto)
         : m_pollInterval(pollInterval) {
+#ifdef __linux__
+        if (backend != FileWatcherBackend::Polling) {
+            m_inotifyFd = inotify_init1(IN_NONBLOCK | IN_CLOEXEC);
+            m_wakeFd = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+            if (m_inotifyFd >= 0 && m_wakeFd >= 0) {
+                m_backend = FileWatcherBackend::Inotify;
+            } else {
+                closeDescriptors();
+            }
+        }
+#endif
+        if (backend == FileWatcherBackend::Inotify && m_backend != FileWatcherBackend::Inotify) {
+            throw std::runtime_error("inotify file watching is not available");
+        }
     }
 
     ~FileWatcher() {
         stop();
+#ifdef __linux__
+        closeDescriptors();
+#endif
     }
 
     // Non-copyable
@@ -91,6 +302,7 @@ public:
                 return;
             }
             m_running = false;
+            wake();
         }
 
         // Join thread outside of lock to avoid deadlock
@@ -103,29 +315,91 @@ public:
      * @brief Add a file to watch
      * @param path Path to the file
      * @param callback Function to call when file changes
+     * @param settleTime Report a change only once the file's size and
+     *        modification time have stayed the same for this long
+     * @param mode FileWatchMode::Presence to report only creation, deletion
+     *        and replacement of the file
      * @return true if successfully added
+     *
+     * A FileWatchMode::Presence watch does not ask the kernel for write
+     * events and never hashes the file, so a file written continuously
+     * (e.g. a log) does not wake the watcher. A file renamed over it or
+     * recreated after a deletion is reported as Created; with the polling
+     * backend only creation and deletion are seen.
      */
-    bool addWatch(const std::string& path, FileChangeCallback callback) {
+    bool addWatch(const std::string& path, FileChangeCallback callback,
+                  std::chrono::milliseconds settleTime = std::chrono::milliseconds(0),
+                  FileWatchMode mode = FileWatchMode::Changes) {
+        WatchedFile watchedFile;
+        watchedFile.callback = std::move(callback);
+        watchedFile.settleTime = settleTime;
+        watchedFile.mode = mode;
+        readState(path, watchedFile.state);
+        if (m_contentHashing && mode == FileWatchMode::Changes && watchedFile.state.exists) {
+            watchedFile.hashKnown = hashFile(path, watchedFile.hash);
+        }
+
         std::lock_guard<std::mutex> lock(m_mutex);
+        auto existing = m_watchedFiles.find(path);
+        if (existing != m_watchedFiles.end()) {
+            detach(path, existing->second);
+        }
+        WatchedFile& stored = m_watchedFiles[path] = std::move(watchedFile);
+        attach(path, stored);
+        wake();
+        return true;
+    }
 
+    /**
+     * @brief Watch all files in a directory tree
+     * @param directory Directory to watch; it does not have to exist yet
+     * @param callback Called with the path (directory joined with the
+     *        relative path) of every matching file that is created, modified
+     *        or deleted
+     * @param options Recursion, glob filters and settle time
+     * @return true if successfully added
+     *
+     * Files that exist when the watch is added are not reported until they change.
+     */
+    bool addDirectoryWatch(const std::string& directory, FileChangeCallback callback,
+                           DirectoryWatchOptions options = DirectoryWatchOptions()) {
         namespace fs = std::filesystem;
 
-        WatchedFile watchedFile;
-        watchedFile.callback = std::move(callback);
+        std::string key = directory.empty() ? "." : directory;
+        std::error_code error;
+        fs::path root = fs::absolute(key, error).lexically_normal();
+        if (error) {
+            return false;
+        }
+        if (!root.has_filename() && root.has_parent_path() && root != root.root_path()) {
+            root = root.parent_path();  // Trailing separator
+        }
 
-        try {
-            if (fs::exists(path)) {
-                watchedFile.lastModified = fs::last_write_time(path);
-                watchedFile.exists = true;
-            } else {
-                watchedFile.exists = false;
+        // Record the files that exist now; only later changes are reported
+        std::map<std::string, WatchedFile> files;
+        for (const auto& relative : listFiles(root, options)) {
+            WatchedFile file;
+            std::string path = (fs::path(key) / relative).string();
+            readState(path, file.state);
+            if (m_contentHashing && file.state.exists) {
+                file.hashKnown = hashFile(path, file.hash);
             }
-        } catch (const std::exception&) {
-            // File doesn't exist or can't be accessed
-            watchedFile.exists = false;
+            files.emplace(std::move(path), std::move(file));
         }
+        std::vector<std::string> directories = listTreeDirectories(root, options.recursive);
 
-        m_watchedFiles[path] = std::move(watchedFile);
+        std::lock_guard<std::mutex> lock(m_mutex);
+        if (m_directoryWatches.count(key)) {
+            detachTree(key);
+        }
+        DirectoryWatch& watch = m_directoryWatches[key];
+        watch.callback = std::move(callback);
+        watch.options = std::move(options);
+        watch.root = std::move(root);
+        watch.files = std::move(files);
+        watch.polled = true;
+        attachTree(key, directories);
+        wake();
         return true;
     }
 
@@ -135,7 +409,24 @@ public:
      */
     void removeWatch(const std::string& path) {
         std::lock_guard<std::mutex> lock(m_mutex);
-        m_watchedFiles.erase(path);
+        auto it = m_watchedFiles.find(path);
+        if (it != m_watchedFiles.end()) {
+            detach(path, it->second);
+            m_watchedFiles.erase(it);
+        }
+    }
+
+    /**
+     * @brief Remove a directory watch
+     * @param directory Directory as passed to addDirectoryWatch()
+     */
+    void removeDirectoryWatch(const std::string& directory) {
+        std::string key = directory.empty() ? "." : directory;
+        std::lock_guard<std::mutex> lock(m_mutex);
+        if (m_directoryWatches.count(key)) {
+            detachTree(key);
+            m_directoryWatches.erase(key);
+        }
     }
 
     /**
@@ -143,7 +434,14 @@ public:
      */
     void clearWatches() {
         std::lock_guard<std::mutex> lock(m_mutex);
+        for (auto& [path, watchedFile] : m_watchedFiles) {
+            detach(path, watchedFile);
+        }
         m_watchedFiles.clear();
+        for (const auto& entry : m_directoryWatches) {
+            detachTree(entry.first);
+        }
+        m_directoryWatches.clear();
     }
 
     /**
@@ -156,9 +454,19 @@ public:
         return m_watchedFiles.find(path) != m_watchedFiles.end();
     }
 
+    /**
+     * @brief Check if a directory is being watched
+     * @param directory Directory as passed to addDirectoryWatch()
+     * @return true if the directory is being watched
+     */
+    bool isWatchingDirectory(const std::string& directory) const {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        return m_directoryWatches.count(directory.empty() ? "." : directory) > 0;
+    }
+
     /**
      * @brief Get number of watched files
-     * @return Number of files currently being watched
+     * @return Number of files currently being watched with addWatch()
      */
     size_t getWatchCount() const {
         std::lock_guard<std::mutex> lock(m_mutex);
@@ -168,9 +476,45 @@ public:
     /**
      * @brief Set poll interval
      * @param interval Time between file checks in milliseconds
+     *
+     * With the inotify backend this only applies to files that are polled
+     * because their directory cannot be watched.
      */
     void setPollInterval(std::chrono::milliseconds interval) {
+        std::lock_guard<std::mutex> lock(m_mutex);
         m_pollInterval = interval;
+        wake();
+    }
+
+    /**
+     * @brief Get poll interval
+     * @return Time between file checks
+     */
+    std::chrono::milliseconds getPollInterval() const {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        return m_pollInterval;
+    }
+
+    /**
+     * @brief Confirm modifications by comparing file contents
+     * @param enabled true to hash watched files
+     *
+     * A modification is then reported only if the file's size or content
+     * hash changed, so touching a file or rewriting identical contents does
+     * not trigger reloads. Files are hashed when their watch is added and on
+     * every detected change; enable this before adding watches, as files
+     * added earlier report their first modification unconfirmed.
+     */
+    void setContentHashing(bool enabled) {
+        m_contentHashing = enabled;
+    }
+
+    /**
+     * @brief Check if content hashing is enabled
+     * @return true if modifications are confirmed by content hash
+     */
+    bool isContentHashing() const {
+        return m_contentHashing;
     }
 
     /**
@@ -181,97 +525,1049 @@ public:
         return m_running;
     }
 
+    /**
+     * @brief Get the active change detection mechanism
+     * @return FileWatcherBackend::Inotify or FileWatcherBackend::Polling
+     */
+    FileWatcherBackend backend() const {
+        return m_backend;
+    }
+
 private:
     /**
      * @brief Main watch loop (runs in separate thread)
      */
     void watchLoop() {
+        Clock::time_point nextPoll = Clock::now();
+        m_roundActive = false;
+
         while (m_running) {
-            checkFiles();
-            std::this_thread::sleep_for(m_pollInterval);
+            bool polling = false;
+            std::chrono::milliseconds interval;
+            {
+                std::lock_guard<std::mutex> lock(m_mutex);
+                interval = m_pollInterval;
+                polling = needsPolling();
+            }
+
+            if (polling && Clock::now() >= nextPoll) {
+                nextPoll = pollStep(interval);
+            }
+
+            Clock::time_point wakeAt = processDeadlines();
+            if (polling) {
+                wakeAt = std::min(wakeAt, nextPoll);
+            }
+            waitForEvents(wakeAt);
+        }
+    }
+
+    /**
+     * @brief Whether some watch is not covered by kernel notifications
+     *
+     * Must be called while holding m_mutex.
+     */
+    bool needsPolling() const {
+        if (m_backend == FileWatcherBackend::Polling) {
+            return true;
+        }
+        for (const auto& entry : m_watchedFiles) {
+            if (entry.second.polled) {
+                return true;
+            }
+        }
+        for (const auto& entry : m_directoryWatches) {
+            if (entry.second.polled) {
+                return true;
+            }
         }
+        return false;
     }
 
     /**
-     * @brief Check all watched files for changes
+     * @brief Check the next batch of polled files
+     * @param interval Poll interval
+     * @return When the next batch is due
+     *
+     * Every poll interval is one round over all polled files. The round is
+     * split into ticks of at least MinPollTickMs holding at least
+     * MinPollBatch files each, so tens of thousands of files are checked a
+     * slice at a time instead of in one burst. Each tick checks the files
+     * due by then; if checks fall behind (e.g. slow network file systems),
+     * later batches grow to finish the round.
      */
-    void checkFiles() {
+    Clock::time_point pollStep(std::chrono::milliseconds interval) {
+        interval = std::max(interval, std::chrono::milliseconds(1));
+        Clock::time_point now = Clock::now();
+
+        if (!m_roundActive) {
+            m_roundStart = now;
+            m_roundChecked = 0;
+            m_roundSize = startRound();
+            if (m_roundSize == 0) {
+                return now + interval;
+            }
+            m_roundActive = true;
+        }
+
+        size_t maxTicks = static_cast<size_t>(std::max<int64_t>(1, interval.count() / MinPollTickMs));
+        size_t ticks = std::clamp<size_t>(m_roundSize / MinPollBatch, 1, maxTicks);
+        auto tickLength = std::chrono::duration_cast<Clock::duration>(interval) / ticks;
+        size_t tick = std::min<size_t>(ticks - 1, static_cast<size_t>((now - m_roundStart) / tickLength));
+
+        // The last tick also takes files added during the round
+        size_t target = tick + 1 == ticks ? SIZE_MAX : (m_roundSize * (tick + 1) + ticks - 1) / ticks;
+        std::vector<FileKey> keys;
+        bool more = true;
+        if (target > m_roundChecked) {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            more = collectPolled(target - m_roundChecked, keys);
+        }
+        m_roundChecked += keys.size();
+
+        for (const auto& key : keys) {
+            checkFile(key, false);
+        }
+
+        if (!more) {
+            m_roundActive = false;
+            m_pollCursor = FileKey();
+            return std::max(m_roundStart + interval, Clock::now());
+        }
+        return m_roundStart + tickLength * (tick + 1);
+    }
+
+    /**
+     * @brief Prepare a polling round
+     * @return Number of polled files
+     *
+     * Polled directory trees are listed once per round to find new files.
+     */
+    size_t startRound() {
+        struct PolledTree {
+            std::string key;
+            std::filesystem::path root;
+            bool recursive = true;
+            std::vector<std::string> directories;
+        };
+
+        // List the directories of polled trees without holding the lock
+        std::vector<PolledTree> polled;
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            for (const auto& [key, watch] : m_directoryWatches) {
+                if (watch.polled) {
+                    polled.push_back({key, watch.root, watch.options.recursive, {}});
+                }
+            }
+        }
+        for (auto& tree : polled) {
+            tree.directories = listTreeDirectories(tree.root, tree.recursive);
+        }
+
+        std::vector<std::string> trees;
+        std::vector<std::string> attached;
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            for (const auto& tree : polled) {
+                auto watch = m_directoryWatches.find(tree.key);
+                if (watch != m_directoryWatches.end() && watch->second.polled) {
+                    (attachTree(tree.key, tree.directories) ? attached : trees).push_back(tree.key);
+                }
+            }
+        }
+
+        for (const auto& key : trees) {
+            scanTree(key);
+        }
+
+        // Trees now covered by kernel watches leave the rounds; report what changed while polled
+        std::vector<FileKey> keys;
+        for (const auto& key : attached) {
+            scanTree(key);
+            std::lock_guard<std::mutex> lock(m_mutex);
+            auto watch = m_directoryWatches.find(key);
+            if (watch != m_directoryWatches.end()) {
+                for (const auto& entry : watch->second.files) {
+                    keys.emplace_back(key, entry.first);
+                }
+            }
+        }
+        for (const auto& key : keys) {
+            checkFile(key, false);
+        }
+
+        std::lock_guard<std::mutex> lock(m_mutex);
+        size_t count = 0;
+        for (const auto& entry : m_watchedFiles) {
+            count += entry.second.polled ? 1 : 0;
+        }
+        for (const auto& entry : m_directoryWatches) {
+            count += entry.second.polled ? entry.second.files.size() : 0;
+        }
+        return count;
+    }
+
+    /**
+     * @brief Take the next polled files of the current round
+     * @param count Maximum number of files
+     * @param keys Receives the files
+     * @return false once the round has reached the last file
+     *
+     * Walks files of addWatch() first, then the files of polled directory
+     * watches, continuing after m_pollCursor; watches added or removed
+     * meanwhile are picked up or skipped. Must be called while holding m_mutex.
+     */
+    bool collectPolled(size_t count, std::vector<FileKey>& keys) {
+        if (m_pollCursor.first.empty()) {
+            auto it = m_watchedFiles.upper_bound(m_pollCursor.second);
+            for (; it != m_watchedFiles.end() && keys.size() < count; ++it) {
+                m_pollCursor.second = it->first;
+                if (it->second.polled) {
+                    // A polled file may become watchable once its directory exists
+                    attach(it->first, it->second);
+                    keys.emplace_back(std::string(), it->first);
+                }
+            }
+            if (it != m_watchedFiles.end()) {
+                return true;
+            }
+        }
+
+        bool resume = !m_pollCursor.first.empty();
+        auto tree = resume ? m_directoryWatches.lower_bound(m_pollCursor.first) : m_directoryWatches.begin();
+        resume = resume && tree != m_directoryWatches.end() && tree->first == m_pollCursor.first;
+        for (; tree != m_directoryWatches.end(); ++tree, resume = false) {
+            if (!tree->second.polled) {
+                continue;
+            }
+            auto& files = tree->second.files;
+            auto it = resume ? files.upper_bound(m_pollCursor.second) : files.begin();
+            for (; it != files.end() && keys.size() < count; ++it) {
+                m_pollCursor = FileKey(tree->first, it->first);
+                keys.emplace_back(tree->first, it->first);  // Includes files that disappeared
+            }
+            if (it != files.end()) {
+                return true;
+            }
+        }
+        return false;
+    }
+
+    /**
+     * @brief List a directory tree and record new matching files
+     * @param key Directory watch
+     */
+    void scanTree(const std::string& key) {
         namespace fs = std::filesystem;
 
-        // Copy watched files to avoid holding lock during callbacks
-        std::map<std::string, WatchedFile> filesCopy;
+        fs::path root;
+        DirectoryWatchOptions options;
         {
             std::lock_guard<std::mutex> lock(m_mutex);
-            filesCopy = m_watchedFiles;
+            auto watch = m_directoryWatches.find(key);
+            if (watch == m_directoryWatches.end()) {
+                return;
+            }
+            root = watch->second.root;
+            options = watch->second.options;
+        }
+
+        std::vector<fs::path> found = listFiles(root, options);
+
+        std::lock_guard<std::mutex> lock(m_mutex);
+        auto watch = m_directoryWatches.find(key);
+        if (watch == m_directoryWatches.end()) {
+            return;
+        }
+        for (const auto& relative : found) {
+            watch->second.files.try_emplace((fs::path(key) / relative).string());
+        }
+    }
+
+    /**
+     * @brief List the files of a directory tree that match a watch's filters
+     * @return Paths relative to @p root
+     */
+    static std::vector<std::filesystem::path> listFiles(const std::filesystem::path& root,
+                                                        const DirectoryWatchOptions& options) {
+        namespace fs = std::filesystem;
+
+        std::vector<fs::path> files;
+        std::error_code error;
+        auto visit = [&](const fs::directory_entry& entry) {
+            std::error_code ignored;
+            if (entry.is_regular_file(ignored)) {
+                fs::path relative = entry.path().lexically_relative(root);
+                if (options.matches(relative)) {
+                    files.push_back(std::move(relative));
+                }
+            }
+        };
+
+        if (options.recursive) {
+            fs::recursive_directory_iterator it(root, fs::directory_options::skip_permission_denied, error);
+            for (; !error && it != fs::recursive_directory_iterator(); it.increment(error)) {
+                visit(*it);
+            }
+        } else {
+            fs::directory_iterator it(root, error);
+            for (; !error && it != fs::directory_iterator(); it.increment(error)) {
+                visit(*it);
+            }
         }
+        return files;
+    }
 
-        // Check each file for changes
-        for (auto& [path, watchedFile] : filesCopy) {
-            try {
-                bool exists = fs::exists(path);
+    /**
+     * @brief List the directories of a tree that need kernel watches
+     * @param directory Absolute directory
+     * @param recursive Include its subdirectories (symbolic links are not followed)
+     * @return @p directory followed by its subdirectories; empty with the polling backend
+     *
+     * Walking a large tree takes a while, so this runs without holding
+     * m_mutex; attachTree() and watchTreeDirectories() only add the watches.
+     */
+    std::vector<std::string> listTreeDirectories(const std::filesystem::path& directory, bool recursive) const {
+        namespace fs = std::filesystem;
 
-                if (exists && !watchedFile.exists) {
-                    // File was created
-                    watchedFile.exists = true;
-                    watchedFile.lastModified = fs::last_write_time(path);
+        std::vector<std::string> directories;
+        if (m_backend != FileWatcherBackend::Inotify) {
+            return directories;
+        }
+        directories.push_back(directory.string());
+        if (recursive) {
+            std::error_code error;
+            fs::recursive_directory_iterator it(directory, fs::directory_options::skip_permission_denied, error);
+            for (; !error && it != fs::recursive_directory_iterator(); it.increment(error)) {
+                std::error_code ignored;
+                if (it->is_directory(ignored) && !it->is_symlink(ignored)) {
+                    directories.push_back(it->path().string());
+                }
+            }
+        }
+        return directories;
+    }
 
-                    if (watchedFile.callback) {
-                        watchedFile.callback(path, FileChangeType::Created);
+    /**
+     * @brief Read the current state of a file
+     * @return false if the file exists but could not be read (e.g. it is being replaced)
+     */
+    static bool readState(const std::string& path, FileState& state) {
+        namespace fs = std::filesystem;
+
+        state = FileState();
+        std::error_code error;
+        fs::file_status status = fs::status(path, error);
+        if (!fs::exists(status)) {
+            return true;
+        }
+
+        state.exists = true;
+        state.lastModified = fs::last_write_time(path, error);
+        if (error) {
+            return false;
+        }
+        if (fs::is_regular_file(status)) {
+            state.size = fs::file_size(path, error);
+            if (error) {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    /**
+     * @brief Find a watched file
+     *
+     * Must be called while holding m_mutex.
+     */
+    WatchedFile* findFile(const FileKey& key, FileChangeCallback** callback, std::chrono::milliseconds& settleTime) {
+        if (key.first.empty()) {
+            auto it = m_watchedFiles.find(key.second);
+            if (it == m_watchedFiles.end()) {
+                return nullptr;
+            }
+            *callback = &it->second.callback;
+            settleTime = it->second.settleTime;
+            return &it->second;
+        }
+
+        auto watch = m_directoryWatches.find(key.first);
+        if (watch == m_directoryWatches.end()) {
+            return nullptr;
+        }
+        auto it = watch->second.files.find(key.second);
+        if (it == watch->second.files.end()) {
+            return nullptr;
+        }
+        *callback = &watch->second.callback;
+        settleTime = watch->second.options.settleTime;
+        return &it->second;
+    }
+
+    /**
+     * @brief Hash the contents of a file
+     * @return false if the file cannot be read
+     */
+    static bool hashFile(const std::string& path, uint64_t& hash) {
+        std::ifstream file(path, std::ios::binary);
+        if (!file.is_open()) {
+            return false;
+        }
+        std::vector<char> buffer(64 * 1024);
+        hash = 0;
+        while (file) {
+            file.read(buffer.data(), static_cast<std::streamsize>(buffer.size()));
+            std::streamsize length = file.gcount();
+            if (length <= 0) {
+                break;
+            }
+            hash = hashBytes(std::string_view(buffer.data(), static_cast<size_t>(length)), hash);
+        }
+        return !file.bad();
+    }
+
+    /**
+     * @brief Compare a file with its recorded state and report the difference
+     * @param key Watched file
+     * @param contentChanged Report an existing file as modified even if its timestamp is unchanged
+     *
+     * Files with a settle time are reported only after their state has
+     * stayed the same for that long; every observed change restarts the wait.
+     * With content hashing, a modification whose size and content hash match
+     * the recorded ones (e.g. a touch) is recorded without being reported.
+     */
+    void checkFile(const FileKey& key, bool contentChanged) {
+        FileState current;
+        if (!readState(key.second, current)) {
+            return;  // File might be temporarily inaccessible
+        }
+
+        FileChangeType type = FileChangeType::Modified;
+        FileChangeCallback callback;
+        bool hashTried = false;
+        bool hashed = false;
+        uint64_t hash = 0;
+
+        std::unique_lock<std::mutex> lock(m_mutex);
+        while (true) {
+            FileChangeCallback* owner = nullptr;
+            std::chrono::milliseconds settleTime{0};
+            WatchedFile* watchedFile = findFile(key, &owner, settleTime);
+            if (!watchedFile) {
+                return;
+            }
+
+            // Presence watches compare existence only; their files are expected to be written
+            bool presence = watchedFile->mode == FileWatchMode::Presence;
+            auto same = [presence](const FileState& a, const FileState& b) {
+                return presence ? a.exists == b.exists : a == b;
+            };
+
+            bool content = contentChanged;
+            if (settleTime.count() > 0) {
+                Clock::time_point now = Clock::now();
+                if (!watchedFile->pending) {
+                    if (!contentChanged && same(current, watchedFile->state)) {
+                        return;
                     }
+                    watchedFile->pending = true;
+                    watchedFile->pendingContent = contentChanged;
+                    watchedFile->observed = current;
+                    watchedFile->deadline = now + settleTime;
+                    return;
+                }
+                if (contentChanged || !same(current, watchedFile->observed)) {
+                    // Still changing: wait for another quiet period
+                    watchedFile->pendingContent = watchedFile->pendingContent || contentChanged;
+                    watchedFile->observed = current;
+                    watchedFile->deadline = now + settleTime;
+                    return;
+                }
+                if (now < watchedFile->deadline) {
+                    return;
+                }
+                content = watchedFile->pendingContent;
+            }
 
-                    // Update stored state
-                    {
-                        std::lock_guard<std::mutex> lock(m_mutex);
-                        auto it = m_watchedFiles.find(path);
-                        if (it != m_watchedFiles.end()) {
-                            it->second.exists = true;
-                            it->second.lastModified = watchedFile.lastModified;
-                        }
+            const FileState& previous = watchedFile->state;
+            bool report = true;
+            if (current.exists && !previous.exists) {
+                type = FileChangeType::Created;
+            } else if (!current.exists && previous.exists) {
+                type = FileChangeType::Deleted;
+            } else if (current.exists && (content || !same(current, previous))) {
+                type = presence ? FileChangeType::Created : FileChangeType::Modified;  // Replaced
+            } else {
+                report = false;
+            }
+
+            if (report && current.exists && m_contentHashing && !presence && !hashTried) {
+                // Read the file without holding the lock, then decide again
+                hashTried = true;
+                lock.unlock();
+                hashed = hashFile(key.second, hash);
+                lock.lock();
+                continue;
+            }
+
+            if (report && type == FileChangeType::Modified && hashed && watchedFile->hashKnown &&
+                watchedFile->hash == hash && current.size == previous.size) {
+                report = false;  // Touched, not changed
+            }
+
+            // Update stored state
+            watchedFile->pending = false;
+            watchedFile->state = current;
+            if (hashTried || !current.exists) {
+                watchedFile->hashKnown = hashed;
+                watchedFile->hash = hash;
+            }
+            if (report) {
+                callback = *owner;
+            }
+            if (!key.first.empty() && !current.exists) {
+                m_directoryWatches[key.first].files.erase(key.second);
+            }
+            if (!report) {
+                return;
+            }
+            break;
+        }
+        lock.unlock();
+
+        // Invoke outside the lock so callbacks may change the watch list
+        if (callback) {
+            callback(key.second, type);
+        }
+    }
+
+    /**
+     * @brief Report files whose settle time has elapsed
+     * @return Time of the next settle deadline, or Clock::time_point::max()
+     */
+    Clock::time_point processDeadlines() {
+        std::vector<FileKey> due;
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            Clock::time_point now = Clock::now();
+            for (const auto& [path, watchedFile] : m_watchedFiles) {
+                if (watchedFile.pending && watchedFile.deadline <= now) {
+                    due.emplace_back(std::string(), path);
+                }
+            }
+            for (const auto& [key, watch] : m_directoryWatches) {
+                for (const auto& [path, watchedFile] : watch.files) {
+                    if (watchedFile.pending && watchedFile.deadline <= now) {
+                        due.emplace_back(key, path);
                     }
                 }
-                else if (!exists && watchedFile.exists) {
-                    // File was deleted
-                    watchedFile.exists = false;
+            }
+        }
+
+        for (const auto& key : due) {
+            checkFile(key, false);
+        }
+
+        Clock::time_point next = Clock::time_point::max();
+        std::lock_guard<std::mutex> lock(m_mutex);
+        for (const auto& entry : m_watchedFiles) {
+            if (entry.second.pending) {
+                next = std::min(next, entry.second.deadline);
+            }
+        }
+        for (const auto& entry : m_directoryWatches) {
+            for (const auto& file : entry.second.files) {
+                if (file.second.pending) {
+                    next = std::min(next, file.second.deadline);
+                }
+            }
+        }
+        return next;
+    }
+
+    /**
+     * @brief Wake the watcher thread
+     *
+     * Must be called while holding m_mutex.
+     */
+    void wake() {
+        m_wakeRequested = true;
+        m_wakeCondition.notify_all();
+#ifdef __linux__
+        if (m_wakeFd >= 0) {
+            uint64_t one = 1;
+            ssize_t written = ::write(m_wakeFd, &one, sizeof(one));
+            (void)written;  // EAGAIN: a wake-up is already pending
+        }
+#endif
+    }
+
+    /**
+     * @brief Sleep until file events arrive, wake() is called or @p wakeAt is reached
+     *
+     * Reported file events are handled before returning.
+     */
+    void waitForEvents(Clock::time_point wakeAt) {
+#ifdef __linux__
+        if (m_backend == FileWatcherBackend::Inotify) {
+            int timeout = -1;  // Sleep until the kernel or wake() reports something
+            if (wakeAt != Clock::time_point::max()) {
+                auto remaining = std::chrono::ceil<std::chrono::milliseconds>(wakeAt - Clock::now());
+                timeout = static_cast<int>(std::clamp<int64_t>(remaining.count(), 0, INT_MAX));
+            }
+
+            struct pollfd fds[2] = {{m_inotifyFd, POLLIN, 0}, {m_wakeFd, POLLIN, 0}};
+            int ready = ::poll(fds, 2, timeout);
+            if (ready <= 0 || !m_running) {
+                return;
+            }
+
+            if (fds[1].revents & POLLIN) {
+                uint64_t count;
+                ssize_t drained = ::read(m_wakeFd, &count, sizeof(count));
+                (void)drained;
+            }
+
+            if (fds[0].revents & POLLIN) {
+                std::map<FileKey, bool> changes;
+                readEvents(changes);
+
+                // Collect the rest of a burst so that multi-step saves are reported once
+                auto settleEnd = Clock::now() + std::chrono::milliseconds(MaxSettleMs);
+                struct pollfd inotifyFd = {m_inotifyFd, POLLIN, 0};
+                while (Clock::now() < settleEnd && ::poll(&inotifyFd, 1, SettleMs) > 0) {
+                    readEvents(changes);
+                }
+
+                for (const auto& [key, contentChanged] : changes) {
+                    checkFile(key, contentChanged);
+                }
+            }
+            return;
+        }
+#endif
+        std::unique_lock<std::mutex> lock(m_mutex);
+        auto woken = [this] { return !m_running || m_wakeRequested; };
+        if (wakeAt == Clock::time_point::max()) {
+            m_wakeCondition.wait(lock, woken);
+        } else {
+            m_wakeCondition.wait_until(lock, wakeAt, woken);
+        }
+        m_wakeRequested = false;
+    }
 
-                    if (watchedFile.callback) {
-                        watchedFile.callback(path, FileChangeType::Deleted);
+#ifdef __linux__
+    /**
+     * @brief Get the inotify watch of a directory, adding it or its events if needed
+     * @param directory Directory; set to the path the watch is known by
+     * @param events Events the caller needs (DirectoryEvents or PresenceDirectoryEvents)
+     * @return Directory entry, or nullptr if the directory cannot be watched
+     *
+     * Events are added to an existing watch (IN_MASK_ADD), never removed.
+     * Must be called while holding m_mutex.
+     */
+    WatchedDirectory* watchDirectory(std::string& directory, uint32_t events = DirectoryEvents) {
+        auto dir = m_directories.find(directory);
+        if (dir != m_directories.end() && (dir->second.events & events) == events) {
+            return &dir->second;
+        }
+
+        int descriptor = inotify_add_watch(m_inotifyFd, directory.c_str(), events | IN_MASK_ADD);
+        if (descriptor < 0) {
+            return nullptr;
+        }
+        // The same directory reached through another path shares the descriptor
+        auto known = m_descriptors.find(descriptor);
+        if (known != m_descriptors.end()) {
+            directory = known->second;
+            WatchedDirectory& shared = m_directories[directory];
+            shared.events |= events;
+            return &shared;
+        }
+        if (dir != m_directories.end()) {
+            // The path now leads to another directory (the watched one was renamed)
+            inotify_rm_watch(m_inotifyFd, descriptor);
+            return nullptr;
+        }
+        m_descriptors[descriptor] = directory;
+        WatchedDirectory& created = m_directories[directory];
+        created.descriptor = descriptor;
+        created.events = events;
+        return &created;
+    }
+
+    /**
+     * @brief Remove the inotify watch of a directory nothing refers to any more
+     *
+     * Must be called while holding m_mutex.
+     */
+    void releaseDirectory(std::map<std::string, WatchedDirectory>::iterator dir) {
+        if (dir->second.files.empty() && dir->second.trees.empty()) {
+            inotify_rm_watch(m_inotifyFd, dir->second.descriptor);
+            m_descriptors.erase(dir->second.descriptor);
+            m_directories.erase(dir);
+        }
+    }
+
+    /**
+     * @brief Cover a file by an inotify watch on its directory
+     * @return true if the file is now watched by the kernel
+     *
+     * Must be called while holding m_mutex.
+     */
+    bool attach(const std::string& path, WatchedFile& watchedFile) {
+        namespace fs = std::filesystem;
+
+        if (m_backend != FileWatcherBackend::Inotify || !watchedFile.polled) {
+            return !watchedFile.polled;
+        }
+
+        std::error_code error;
+        fs::path absolute = fs::absolute(path, error).lexically_normal();
+        if (error || !absolute.has_filename()) {
+            return false;
+        }
+        std::string directory = absolute.parent_path().string();
+        uint32_t events = watchedFile.mode == FileWatchMode::Presence ? PresenceDirectoryEvents : DirectoryEvents;
+        WatchedDirectory* dir = watchDirectory(directory, events);
+        if (!dir) {
+            return false;
+        }
+
+        watchedFile.polled = false;
+        watchedFile.directory = directory;
+        watchedFile.name = absolute.filename().string();
+        dir->files[watchedFile.name].push_back(path);
+        return true;
+    }
+
+    /**
+     * @brief Release the inotify watch covering a file
+     *
+     * Must be called while holding m_mutex.
+     */
+    void detach(const std::string& path, WatchedFile& watchedFile) {
+        if (watchedFile.polled) {
+            return;
+        }
+        watchedFile.polled = true;
+
+        auto dir = m_directories.find(watchedFile.directory);
+        if (dir == m_directories.end()) {
+            return;
+        }
+        auto files = dir->second.files.find(watchedFile.name);
+        if (files != dir->second.files.end()) {
+            auto& paths = files->second;
+            paths.erase(std::remove(paths.begin(), paths.end(), path), paths.end());
+            if (paths.empty()) {
+                dir->second.files.erase(files);
+            }
+        }
+        releaseDirectory(dir);
+    }
+
+    /**
+     * @brief Add inotify watches for directories of a tree
+     * @param key Directory watch
+     * @param directories Directories inside the watched tree, from listTreeDirectories()
+     * @return true if every directory is watched
+     *
+     * Must be called while holding m_mutex.
+     */
+    bool watchTreeDirectories(const std::string& key, std::vector<std::string> directories) {
+        if (directories.empty()) {
+            return false;
+        }
+
+        bool complete = true;
+        for (auto& path : directories) {
+            WatchedDirectory* dir = watchDirectory(path);
+            if (!dir) {
+                complete = false;
+                continue;
+            }
+            if (std::find(dir->trees.begin(), dir->trees.end(), key) == dir->trees.end()) {
+                dir->trees.push_back(key);
+            }
+        }
+        return complete;
+    }
+
+    /**
+     * @brief Cover a directory watch by inotify watches
+     * @param key Directory watch
+     * @param directories The tree's directories, listed by listTreeDirectories() without the lock
+     * @return true if the whole tree is now watched by the kernel
+     *
+     * Must be called while holding m_mutex.
+     */
+    bool attachTree(const std::string& key, const std::vector<std::string>& directories) {
+        DirectoryWatch& watch = m_directoryWatches[key];
+        if (m_backend != FileWatcherBackend::Inotify || !watch.polled) {
+            return !watch.polled;
+        }
+        watch.polled = !watchTreeDirectories(key, directories);
+        return !watch.polled;
+    }
+
+    /**
+     * @brief Release the inotify watches of a directory watch below (and including) a directory
+     * @param key Directory watch
+     * @param directory Absolute directory, or empty for the whole tree
+     *
+     * Must be called while holding m_mutex.
+     */
+    void detachTree(const std::string& key, const std::string& directory = std::string()) {
+        for (auto dir = m_directories.begin(); dir != m_directories.end();) {
+            auto next = std::next(dir);
+            const std::string& path = dir->first;
+            bool inside = directory.empty() || path == directory ||
+                          (path.size() > directory.size() && path.compare(0, directory.size(), directory) == 0 &&
+                           path[directory.size()] == '/');
+            auto& trees = dir->second.trees;
+            if (inside && std::find(trees.begin(), trees.end(), key) != trees.end()) {
+                trees.erase(std::remove(trees.begin(), trees.end(), key), trees.end());
+                releaseDirectory(dir);
+            }
+            dir = next;
+        }
+    }
+
+    /**
+     * @brief Queue every file of a directory watch below a directory for checking
+     *
+     * Must be called while holding m_mutex.
+     */
+    void markTreeFiles(const std::string& key, const std::filesystem::path& directory,
+                       std::map<FileKey, bool>& changes) {
+        namespace fs = std::filesystem;
+
+        DirectoryWatch& watch = m_directoryWatches[key];
+        fs::path relative = directory.lexically_relative(watch.root);
+        std::string prefix = relative == "." ? std::string() : (fs::path(key) / relative).string();
+        for (const auto& entry : watch.files) {
+            const std::string& path = entry.first;
+            if (prefix.empty() || (path.size() > prefix.size() && path.compare(0, prefix.size(), prefix) == 0 &&
+                                   (path[prefix.size()] == '/' || path[prefix.size()] == '\\'))) {
+                changes.emplace(FileKey(key, path), false);
+            }
+        }
+    }
+
+    /**
+     * @brief Forget a directory whose watch ended; its files are checked and, if needed, polled
+     * @param descriptor Watch descriptor
+     * @param changes Receives the affected files
+     *
+     * Must be called while holding m_mutex.
+     */
+    void dropDirectory(int descriptor, std::map<FileKey, bool>& changes) {
+        auto known = m_descriptors.find(descriptor);
+        if (known == m_descriptors.end()) {
+            return;
+        }
+        std::string directory = known->second;
+        auto dir = m_directories.find(directory);
+        if (dir != m_directories.end()) {
+            for (const auto& [name, paths] : dir->second.files) {
+                for (const auto& path : paths) {
+                    auto it = m_watchedFiles.find(path);
+                    if (it != m_watchedFiles.end()) {
+                        it->second.polled = true;
                     }
+                    changes.emplace(FileKey(std::string(), path), false);
+                }
+            }
+            for (const auto& key : dir->second.trees) {
+                auto watch = m_directoryWatches.find(key);
+                if (watch == m_directoryWatches.end()) {
+                    continue;
+                }
+                markTreeFiles(key, directory, changes);
+                if (watch->second.root == directory) {
+                    watch->second.polled = true;  // Root is gone: poll until it reappears
+                }
+            }
+            m_directories.erase(dir);
+        }
+        inotify_rm_watch(m_inotifyFd, descriptor);  // Already gone unless the directory was moved
+        m_descriptors.erase(known);
+
+        // A polled tree is re-attached as a whole later
+        for (auto& entry : m_directoryWatches) {
+            if (entry.second.polled) {
+                detachTree(entry.first);
+            }
+        }
+    }
+
+    /**
+     * @brief Read all queued inotify events
+     * @param changes Receives watched files with events, and whether their contents changed
+     */
+    void readEvents(std::map<FileKey, bool>& changes) {
+        namespace fs = std::filesystem;
+
+        alignas(struct inotify_event) char buffer[16384];
+        std::vector<std::pair<std::string, fs::path>> createdDirectories;
+        std::vector<std::pair<std::string, fs::path>> removedDirectories;
 
-                    // Update stored state
-                    {
-                        std::lock_guard<std::mutex> lock(m_mutex);
-                        auto it = m_watchedFiles.find(path);
-                        if (it != m_watchedFiles.end()) {
-                            it->second.exists = false;
+        while (true) {
+            ssize_t length = ::read(m_inotifyFd, buffer, sizeof(buffer));
+            if (length <= 0) {
+                if (length < 0 && errno == EINTR) {
+                    continue;
+                }
+                break;  // EAGAIN: queue drained
+            }
+
+            std::lock_guard<std::mutex> lock(m_mutex);
+            for (char* p = buffer; p < buffer + length;) {
+                auto* event = reinterpret_cast<struct inotify_event*>(p);
+                p += sizeof(struct inotify_event) + event->len;
+
+                if (event->mask & IN_Q_OVERFLOW) {
+                    // Events were lost: compare every kernel-watched file with its recorded state
+                    for (const auto& [path, watchedFile] : m_watchedFiles) {
+                        if (!watchedFile.polled) {
+                            changes.emplace(FileKey(std::string(), path), false);
                         }
                     }
+                    for (auto& entry : m_directoryWatches) {
+                        entry.second.polled = true;  // Rescan to find files created meanwhile
+                    }
+                    continue;
+                }
+                if (event->mask & (IN_DELETE_SELF | IN_MOVE_SELF | IN_IGNORED)) {
+                    dropDirectory(event->wd, changes);
+                    continue;
                 }
-                else if (exists && watchedFile.exists) {
-                    // Check for modification
-                    auto lastModified = fs::last_write_time(path);
-                    if (lastModified != watchedFile.lastModified) {
-                        watchedFile.lastModified = lastModified;
-
-                        if (watchedFile.callback) {
-                            watchedFile.callback(path, FileChangeType::Modified);
+                if (event->len == 0) {
+                    continue;
+                }
+
+                auto known = m_descriptors.find(event->wd);
+                if (known == m_descriptors.end()) {
+                    continue;
+                }
+                const std::string& directory = known->second;
+                const WatchedDirectory& dir = m_directories[directory];
+                bool content = (event->mask & ContentEvents) != 0;
+
+                auto files = dir.files.find(event->name);
+                if (files != dir.files.end()) {
+                    for (const auto& path : files->second) {
+                        auto watched = m_watchedFiles.find(path);
+                        bool presence = watched != m_watchedFiles.end() && watched->second.mode == FileWatchMode::Presence;
+                        if (presence && !(event->mask & PresenceEvents)) {
+                            continue;  // Written, not moved; the directory is watched for others
                         }
+                        bool& flag = changes[FileKey(std::string(), path)];
+                        flag = flag || (presence ? (event->mask & ReplaceEvents) != 0 : content);
+                    }
+                }
 
-                        // Update stored state
-                        {
-                            std::lock_guard<std::mutex> lock(m_mutex);
-                            auto it = m_watchedFiles.find(path);
-                            if (it != m_watchedFiles.end()) {
-                                it->second.lastModified = lastModified;
-                            }
+                fs::path child = fs::path(directory) / event->name;
+                for (const auto& key : dir.trees) {
+                    auto watch = m_directoryWatches.find(key);
+                    if (watch == m_directoryWatches.end()) {
+                        continue;
+                    }
+                    if (event->mask & IN_ISDIR) {
+                        if (!watch->second.options.recursive) {
+                            continue;
+                        }
+                        if (event->mask & (IN_CREATE | IN_MOVED_TO)) {
+                            createdDirectories.emplace_back(key, child);
+                        } else if (event->mask & (IN_DELETE | IN_MOVED_FROM)) {
+                            markTreeFiles(key, child, changes);
+                            removedDirectories.emplace_back(key, child);
                         }
+                        continue;
+                    }
+
+                    fs::path relative = child.lexically_relative(watch->second.root);
+                    if (!watch->second.options.matches(relative)) {
+                        continue;
                     }
+                    std::string path = (fs::path(key) / relative).string();
+                    watch->second.files.try_emplace(path);  // New files start as not existing
+                    bool& flag = changes[FileKey(key, path)];
+                    flag = flag || content;
                 }
             }
-            catch (const std::exception&) {
-                // Ignore errors (file might be temporarily inaccessible)
+
+            // A directory moved out of the tree keeps its kernel watches; stop following it
+            for (const auto& [key, directory] : removedDirectories) {
+                detachTree(key, directory.string());
             }
+            removedDirectories.clear();
         }
+
+        // Watch directories created inside trees and pick up files written into them already
+        for (const auto& [key, directory] : createdDirectories) {
+            std::vector<std::string> directories = listTreeDirectories(directory, true);
+            std::vector<fs::path> found;
+            DirectoryWatchOptions options;
+            fs::path root;
+            {
+                std::lock_guard<std::mutex> lock(m_mutex);
+                auto watch = m_directoryWatches.find(key);
+                if (watch == m_directoryWatches.end()) {
+                    continue;
+                }
+                if (!watchTreeDirectories(key, std::move(directories))) {
+                    watch->second.polled = true;
+                }
+                options = watch->second.options;
+                root = watch->second.root;
+            }
+
+            for (const auto& relative : listFiles(directory, options)) {
+                found.push_back((directory / relative).lexically_relative(root));
+            }
+
+            std::lock_guard<std::mutex> lock(m_mutex);
+            auto watch = m_directoryWatches.find(key);
+            if (watch == m_directoryWatches.end()) {
+                continue;
+            }
+            for (const auto& relative : found) {
+                std::string path = (fs::path(key) / relative).string();
+                watch->second.files.try_emplace(path);
+                changes[FileKey(key, path)] = true;
+            }
+        }
+    }
+
+    void closeDescriptors() {
+        if (m_inotifyFd >= 0) {
+            ::close(m_inotifyFd);
+            m_inotifyFd = -1;
+        }
+        if (m_wakeFd >= 0) {
+            ::close(m_wakeFd);
+            m_wakeFd = -1;
+        }
+    }
+#else
+    bool attach(const std::string&, WatchedFile&) {
+        return false;
+    }
+
+    void detach(const std::string&, WatchedFile&) {
+    }
+
+    bool attachTree(const std::string&, const std::vector<std::string>&) {
+        return false;
+    }
+
+    void detachTree(const std::string&) {
     }
+#endif
 };
 
 } // namespace mcf
@@ -0,0 +1,376 @@
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace mcf {
+
+namespace detail {
+
+/**
+ * @brief Match the rest of a path against the rest of a glob pattern
+ * @param p Offset in the pattern
+ * @param s Offset in the path
+ * @param memo Outcome of each (p, s) state tried so far: 0 unknown, 1 no match, 2 match;
+ *        empty for patterns without stars, which never backtrack
+ *
+ * Stars try every split point of the path. Each state is evaluated once, so
+ * patterns such as "*a*a*a*b" take polynomial rather than exponential time.
+ */
+inline bool matchGlobAt(std::string_view pattern, std::string_view path, size_t p, size_t s,
+                        std::vector<uint8_t>& memo) {
+    uint8_t* known = memo.empty() ? nullptr : &memo[p * (path.size() + 1) + s];
+    if (known && *known != 0) {
+        return *known == 2;
+    }
+
+    auto match = [&]() {
+        while (p < pattern.size()) {
+            char c = pattern[p];
+
+            if (c == '*') {
+                if (p + 1 < pattern.size() && pattern[p + 1] == '*') {
+                    p += 2;
+                    if (p < pattern.size() && pattern[p] == '/' && matchGlobAt(pattern, path, p + 1, s, memo)) {
+                        return true;
+                    }
+                    for (size_t i = s; i <= path.size(); ++i) {
+                        if (matchGlobAt(pattern, path, p, i, memo)) {
+                            return true;
+                        }
+                    }
+                    return false;
+                }
+
+                ++p;
+                for (size_t i = s;; ++i) {
+                    if (matchGlobAt(pattern, path, p, i, memo)) {
+                        return true;
+                    }
+                    if (i == path.size() || path[i] == '/') {
+                        return false;
+                    }
+                }
+            }
+
+            if (s == path.size()) {
+                return false;
+            }
+
+            if (c == '?') {
+                if (path[s] == '/') {
+                    return false;
+                }
+            } else if (c == '[' && pattern.find(']', p + 2) != std::string_view::npos) {
+                size_t end = pattern.find(']', p + 2);
+                size_t i = p + 1;
+                bool negate = pattern[i] == '!' || pattern[i] == '^';
+                if (negate) {
+                    ++i;
+                }
+                bool found = false;
+                for (; i < end; ++i) {
+                    if (i + 2 < end && pattern[i + 1] == '-') {
+                        found = found || (path[s] >= pattern[i] && path[s] <= pattern[i + 2]);
+                        i += 2;
+                    } else {
+                        found = found || path[s] == pattern[i];
+                    }
+                }
+                if (found == negate || path[s] == '/') {
+                    return false;
+                }
+                p = end;
+            } else if (c != path[s]) {
+                return false;
+            }
+
+            ++p;
+            ++s;
+        }
+
+        return s == path.size();
+    };
+
+    bool matched = match();
+    if (known) {
+        *known = matched ? 2 : 1;
+    }
+    return matched;
+}
+
+} // namespace detail
+
+/**
+ * @brief Match a path against a glob pattern
+ * @param pattern Glob pattern using '/' as separator
+ * @param path Path using '/' as separator
+ * @return true if the whole path matches
+ *
+ * Supported syntax:
+ * - `*` matches any characters except '/'
+ * - `**` matches any characters including '/'; when followed by '/' it may
+ *   also match zero directories, so "src", `**`, "*.cpp" joined by '/'
+ *   matches both "src/a.cpp" and "src/x/y/a.cpp"
+ * - `?` matches one character except '/'
+ * - `[abc]`, `[a-z]` and `[!abc]` match one character of (not of) a set
+ *
+ * Runs in O(pattern × path²) time at worst; patterns with stars use a
+ * memo of (pattern + 1) × (path + 1) bytes.
+ */
+inline bool matchGlob(std::string_view pattern, std::string_view path) {
+    std::vector<uint8_t> memo;
+    if (pattern.find('*') != std::string_view::npos) {
+        memo.resize((pattern.size() + 1) * (path.size() + 1));
+    }
+    return detail::matchGlobAt(pattern, path, 0, 0, memo);
+}
+
+/**
+ * @brief Compiled glob pattern for matching many paths
+ *
+ * Accepts the syntax of matchGlob() plus brace sets: `{png,jpg}` and
+ * `{a,b{1,2}}` expand into alternatives, and a path matches if any
+ * alternative does. Patterns are split into '/'-separated segments once, so
+ * literal segments are compared directly and `**` segments are handled
+ * without rescanning the path. mayMatchBelow() tells a directory walk
+ * whether a subtree can contain matches at all.
+ *
+ * Usage:
+ * @code
+ * Glob glob("textures/{ui,world}/[a-z]*.{png,jpg}");
+ * glob.matches("textures/ui/icon.png");  // true
+ * glob.mayMatchBelow("shaders");         // false: skip the directory
+ * @endcode
+ */
+class Glob {
+private:
+    enum class SegmentKind {
+        Literal,   // No wildcards: compared as a string
+        Wildcard,  // Matched with matchGlob() within one path segment
+        AnyDepth   // "**": zero or more whole segments
+    };
+
+    struct Segment {
+        SegmentKind kind;
+        std::string text;
+    };
+
+    struct Alternative {
+        std::vector<Segment> segments;
+        std::string pattern;     // Expanded pattern, for alternatives matched as a whole
+        bool wholePath = false;  // Contains "**" inside a segment such as "a**b"
+        size_t anyDepth = 0;     // Number of "**" segments
+    };
+
+    std::string m_pattern;
+    std::vector<Alternative> m_alternatives;
+
+public:
+    /**
+     * @brief Compile a pattern
+     * @param pattern Glob pattern using '/' as separator, relative to the walked directory
+     */
+    explicit Glob(std::string_view pattern = "") : m_pattern(pattern) {
+        std::vector<std::string> expanded;
+        expandBraces(std::string(pattern), expanded);
+        for (auto& text : expanded) {
+            m_alternatives.push_back(compile(std::move(text)));
+        }
+    }
+
+    /**
+     * @brief Get the source pattern
+     * @return Pattern given to the constructor
+     */
+    const std::string& pattern() const { return m_pattern; }
+
+    /**
+     * @brief Match a path
+     * @param path Path relative to the walked directory, using '/' as separator
+     * @return true if any alternative matches the whole path
+     */
+    bool matches(std::string_view path) const {
+        std::vector<std::string_view> parts = split(path);
+        for (const auto& alternative : m_alternatives) {
+            if (alternative.wholePath) {
+                if (matchGlob(alternative.pattern, path)) {
+                    return true;
+                }
+                continue;
+            }
+            // Several "**" segments backtrack over each other; remember split points that failed
+            std::vector<uint8_t> failed;
+            if (alternative.anyDepth > 1) {
+                failed.resize((alternative.segments.size() + 1) * (parts.size() + 1));
+            }
+            if (matchSegments(alternative.segments, 0, parts, 0, failed)) {
+                return true;
+            }
+        }
+        return false;
+    }
+
+    /**
+     * @brief Check if a directory can contain matching paths
+     * @param directory Directory relative to the walked directory ("" for the directory itself)
+     * @return false only if no path below @p directory can match, so the walk may skip it
+     */
+    bool mayMatchBelow(std::string_view directory) const {
+        std::vector<std::string_view> parts = split(directory);
+        for (const auto& alternative : m_alternatives) {
+            if (alternative.wholePath || matchPrefix(alternative.segments, 0, parts, 0)) {
+                return true;
+            }
+        }
+        return false;
+    }
+
+private:
+    static std::vector<std::string_view> split(std::string_view path) {
+        std::vector<std::string_view> parts;
+        size_t start = 0;
+        while (start <= path.size() && !path.empty()) {
+            size_t end = path.find('/', start);
+            if (end == std::string_view::npos) {
+                end = path.size();
+            }
+            if (end > start) {
+                parts.push_back(path.substr(start, end - start));
+            }
+            start = end + 1;
+        }
+        return parts;
+    }
+
+    /**
+     * @brief Expand the first brace set of a pattern, recursively
+     */
+    static void expandBraces(const std::string& pattern, std::vector<std::string>& out) {
+        size_t open = std::string::npos;
+        size_t close = std::string::npos;
+        std::vector<size_t> commas;
+        int depth = 0;
+        for (size_t i = 0; i < pattern.size(); ++i) {
+            char c = pattern[i];
+            if (c == '[') {
+                // Braces and commas inside a character class are literal
+                size_t end = pattern.find(']', i + 2);
+                if (end != std::string::npos) {
+                    i = end;
+                }
+            } else if (c == '{') {
+                if (depth++ == 0) {
+                    open = i;
+                    commas.clear();
+                }
+            } else if (c == ',' && depth == 1) {
+                commas.push_back(i);
+            } else if (c == '}' && depth > 0 && --depth == 0) {
+                close = i;
+                break;
+            }
+        }
+
+        if (close == std::string::npos) {
+            out.push_back(pattern);
+            return;
+        }
+
+        std::string prefix = pattern.substr(0, open);
+        std::string suffix = pattern.substr(close + 1);
+        size_t start = open + 1;
+        commas.push_back(close);
+        for (size_t comma : commas) {
+            expandBraces(prefix + pattern.substr(start, comma - start) + suffix, out);
+            start = comma + 1;
+        }
+    }
+
+    static Alternative compile(std::string pattern) {
+        Alternative alternative;
+        for (std::string_view part : split(pattern)) {
+            Segment segment;
+            if (part == "**") {
+                segment.kind = SegmentKind::AnyDepth;
+                ++alternative.anyDepth;
+            } else if (part.find_first_of("*?[") == std::string_view::npos) {
+                segment.kind = SegmentKind::Literal;
+            } else {
+                segment.kind = SegmentKind::Wildcard;
+                alternative.wholePath = alternative.wholePath || part.find("**") != std::string_view::npos;
+            }
+            segment.text = std::string(part);
+            alternative.segments.push_back(std::move(segment));
+        }
+        alternative.pattern = std::move(pattern);
+        return alternative;
+    }
+
+    static bool matchSegment(const Segment& segment, std::string_view part) {
+        return segment.kind == SegmentKind::Literal ? segment.text == part : matchGlob(segment.text, part);
+    }
+
+    /**
+     * @brief Match the parts from @p j on against the segments from @p i on
+     * @param failed States (i, j) known not to match, or empty to not record them
+     */
+    static bool matchSegments(const std::vector<Segment>& segments, size_t i,
+                              const std::vector<std::string_view>& parts, size_t j, std::vector<uint8_t>& failed) {
+        while (i < segments.size()) {
+            if (segments[i].kind == SegmentKind::AnyDepth) {
+                // Collapse consecutive "**" and try every split point
+                while (i < segments.size() && segments[i].kind == SegmentKind::AnyDepth) {
+                    ++i;
+                }
+                if (i == segments.size()) {
+                    return true;
+                }
+                for (size_t k = j; k < parts.size(); ++k) {
+                    uint8_t* known = failed.empty() ? nullptr : &failed[i * (parts.size() + 1) + k];
+                    if (known && *known) {
+                        continue;
+                    }
+                    if (matchSegments(segments, i, parts, k, failed)) {
+                        return true;
+                    }
+                    if (known) {
+                        *known = 1;
+                    }
+                }
+                return false;
+            }
+            if (j == parts.size() || !matchSegment(segments[i], parts[j])) {
+                return false;
+            }
+            ++i;
+            ++j;
+        }
+        return j == parts.size();
+    }
+
+    /**
+     * @brief Whether the directory parts can be a proper prefix of a match
+     */
+    static bool matchPrefix(const std::vector<Segment>& segments, size_t i,
+                            const std::vector<std::string_view>& parts, size_t j) {
+        while (j < parts.size()) {
+            if (i == segments.size()) {
+                return false;
+            }
+            if (segments[i].kind == SegmentKind::AnyDepth) {
+                return true;
+            }
+            if (!matchSegment(segments[i], parts[j])) {
+                return false;
+            }
+            ++i;
+            ++j;
+        }
+        return i < segments.size();
+    }
+};
+
+} // namespace mcf
@@ -0,0 +1,44 @@
+#pragma once
+
+#include <cstdint>
+#include <cstring>
+#include <string_view>
+
+namespace mcf {
+
+/**
+ * @brief Fast 64-bit hash of a byte range
+ * @param data Bytes to hash
+ * @param seed Previous hash when hashing data in chunks
+ * @return Hash value
+ *
+ * Consumes eight bytes per step; detects changes, not tampering. Chained
+ * hashes (`h = hashBytes(chunk, h)`) depend on how the data was split.
+ */
+inline uint64_t hashBytes(std::string_view data, uint64_t seed = 0) {
+    constexpr uint64_t K1 = 0x9e3779b97f4a7c15ull;
+    constexpr uint64_t K2 = 0xff51afd7ed558ccdull;
+    auto rotate = [](uint64_t value, int bits) { return (value << bits) | (value >> (64 - bits)); };
+
+    const char* p = data.data();
+    size_t size = data.size();
+
+    uint64_t h = (K1 ^ seed) ^ (size * K2);
+    while (size >= 8) {
+        uint64_t word;
+        std::memcpy(&word, p, 8);
+        h = rotate(h ^ (word * K2), 29) * K1;
+        p += 8;
+        size -= 8;
+    }
+    uint64_t tail = 0;
+    std::memcpy(&tail, p, size);
+    h = rotate(h ^ (tail * K2), 29) * K1;
+
+    h ^= h >> 33;
+    h *= K2;
+    h ^= h >> 33;
+    return h;
+}
+
+} // namespace mcf
@@ -68,6 +68,7 @@ public:
      *
      * Called before the plugin is unloaded during hot reload.
      * Override to save any state that should persist across reload.
+     * MsgPack::encode() gives a compact, lossless blob for JsonValue state.
      */
     virtual std::string serializeState() { return ""; }
 
@@ -0,0 +1,812 @@
+/**
+ * @file JsonBinding.hpp
+ * @brief Compile-time reflected binding between JSON and plain structs
+ *
+ * MCF_JSON_FIELDS lists the members of a struct once; JsonBinding then parses
+ * JSON text straight into the struct (no intermediate JsonValue tree), writes
+ * it through JsonWriter and converts to/from JsonValue. Member keys are
+ * matched through a perfect hash table computed at compile time, so each key
+ * costs one hash and one string comparison.
+ */
+
+#pragma once
+
+#include "JsonParser.hpp"
+#include "JsonScanner.hpp"
+#include "JsonValue.hpp"
+#include "JsonWriter.hpp"
+
+#include <array>
+#include <cstdint>
+#include <fstream>
+#include <iterator>
+#include <limits>
+#include <map>
+#include <optional>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <tuple>
+#include <type_traits>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+/**
+ * @brief Declare the JSON-visible members of a struct
+ *
+ * Place after the struct definition, in the same namespace. Members must be
+ * public; up to 48 members are supported.
+ *
+ * Supported member types: bool, integers, floating point, std::string,
+ * JsonValue, std::vector<T>, std::optional<T>, std::map/std::unordered_map
+ * with std::string keys, and other structs declared with MCF_JSON_FIELDS.
+ *
+ * @code
+ * struct NetworkConfig {
+ *     uint16_t port = 8080;
+ *     int maxConnections = 100;
+ *     std::vector<std::string> peers;
+ * };
+ * MCF_JSON_FIELDS(NetworkConfig, port, maxConnections, peers)
+ *
+ * auto config = mcf::JsonBinding::parse<NetworkConfig>(text);
+ * @endcode
+ */
+#define MCF_JSON_FIELDS(Type, ...)                                                  \
+    inline constexpr auto mcfJsonFields(const Type*) {                              \
+        return std::make_tuple(MCF_JSON_FOR_EACH(MCF_JSON_FIELD_ENTRY, Type, __VA_ARGS__)); \
+    }
+
+#define MCF_JSON_FIELD_ENTRY(Type, field) \
+    ::mcf::JsonField<Type, decltype(Type::field)>{#field, &Type::field}
+
+// Variadic for-each used by MCF_JSON_FIELDS (MCF_JSON_EXPAND keeps MSVC's
+// traditional preprocessor happy)
+#define MCF_JSON_EXPAND(x) x
+#define MCF_JSON_FE_1(m, t, x) m(t, x)
+#define MCF_JSON_FE_2(m, t, x, ...) m(t, x), MCF_JSON_EXPAND(MCF_JSON_FE_1(m, t, __VA_ARGS__))
+#define MCF_JSON_FE_3(m, t, x, ...) m(t, x), MCF_JSON_EXPAND(MCF_JSON_FE_2(m, t, __VA_ARGS__))
+#define MCF_JSON_FE_4(m, t, x, ...) m(t, x), MCF_JSON_EXPAND(MCF_JSON_FE_3(m, t, __VA_ARGS__))
+#define MCF_JSON_FE_5(m, t, x, ...) m(t, x), MCF_JSON_EXPAND(MCF_JSON_FE_4(m, t, __VA_ARGS__))
+#define MCF_JSON_FE_6(m, t, x, ...) m(t, x), MCF_JSON_EXPAND(MCF_JSON_FE_5(m, t, __VA_ARGS__))
+#define MCF_JSON_FE_7(m, t, x, ...) m(t, x), MCF_JSON_EXPAND(MCF_JSON_FE_6(m, t, __VA_ARGS__))
+#define MCF_JSON_FE_8(m, t, x, ...) m(t, x), MCF_JSON_EXPAND(MCF_JSON_FE_7(m, t, __VA_ARGS__))
+#define MCF_JSON_FE_9(m, t, x, ...) m(t, x), MCF_JSON_EXPAND(MCF_JSON_FE_8(m, t, __VA_ARGS__))
+#define MCF_JSON_FE_10(m, t, x, ...) m(t, x), MCF_JSON_EXPAND(MCF_JSON_FE_9(m, t, __VA_ARGS__))
+#define MCF_JSON_FE_11(m, t, x, ...) m(t, x), MCF_JSON_EXPAND(MCF_JSON_FE_10(m, t, __VA_ARGS__))
+#define MCF_JSON_FE_12(m, t, x, ...) m(t, x), MCF_JSON_EXPAND(MCF_JSON_FE_11(m, t, __VA_ARGS__))
+#define MCF_JSON_FE_13(m, t, x, ...) m(t, x), MCF_JSON_EXPAND(MCF_JSON_FE_12(m, t, __VA_ARGS__))
+#define MCF_JSON_FE_14(m, t, x, ...) m(t, x), MCF_JSON_EXPAND(MCF_JSON_FE_13(m, t, __VA_ARGS__))
+#define MCF_JSON_FE_15(m, t, x, ...) m(t, x), MCF_JSON_EXPAND(MCF_JSON_FE_14(m, t, __VA_ARGS__))
+#define MCF_JSON_FE_16(m, t, x, ...) m(t, x), MCF_JSON_EXPAND(MCF_JSON_FE_15(m, t, __VA_ARGS__))
+#define MCF_JSON_FE_17(m, t, x, ...) m(t, x), MCF_JSON_EXPAND(MCF_JSON_FE_16(m, t, __VA_ARGS__))
+#define MCF_JSON_FE_18(m, t, x, ...) m(t, x), MCF_JSON_EXPAND(MCF_JSON_FE_17(m, t, __VA_ARGS__))
+#define MCF_JSON_FE_19(m, t, x, ...) m(t, x), MCF_JSON_EXPAND(MCF_JSON_FE_18(m, t, __VA_ARGS__))
+#define MCF_JSON_FE_20(m, t, x, ...) m(t, x), MCF_JSON_EXPAND(MCF_JSON_FE_19(m, t, __VA_ARGS__))
+#define MCF_JSON_FE_21(m, t, x, ...) m(t, x), MCF_JSON_EXPAND(MCF_JSON_FE_20(m, t, __VA_ARGS__))
+#define MCF_JSON_FE_22(m, t, x, ...) m(t, x), MCF_JSON_EXPAND(MCF_JSON_FE_21(m, t, __VA_ARGS__))
+#define MCF_JSON_FE_23(m, t, x, ...) m(t, x), MCF_JSON_EXPAND(MCF_JSON_FE_22(m, t, __VA_ARGS__))
+#define MCF_JSON_FE_24(m, t, x, ...) m(t, x), MCF_JSON_EXPAND(MCF_JSON_FE_23(m, t, __VA_ARGS__))
+#define MCF_JSON_FE_25(m, t, x, ...) m(t, x), MCF_JSON_EXPAND(MCF_JSON_FE_24(m, t, __VA_ARGS__))
+#define MCF_JSON_FE_26(m, t, x, ...) m(t, x), MCF_JSON_EXPAND(MCF_JSON_FE_25(m, t, __VA_ARGS__))
+#define MCF_JSON_FE_27(m, t, x, ...) m(t, x), MCF_JSON_EXPAND(MCF_JSON_FE_26(m, t, __VA_ARGS__))
+#define MCF_JSON_FE_28(m, t, x, ...) m(t, x), MCF_JSON_EXPAND(MCF_JSON_FE_27(m, t, __VA_ARGS__))
+#define MCF_JSON_FE_29(m, t, x, ...) m(t, x), MCF_JSON_EXPAND(MCF_JSON_FE_28(m, t, __VA_ARGS__))
+#define MCF_JSON_FE_30(m, t, x, ...) m(t, x), MCF_JSON_EXPAND(MCF_JSON_FE_29(m, t, __VA_ARGS__))
+#define MCF_JSON_FE_31(m, t, x, ...) m(t, x), MCF_JSON_EXPAND(MCF_JSON_FE_30(m, t, __VA_ARGS__))
+#define MCF_JSON_FE_32(m, t, x, ...) m(t, x), MCF_JSON_EXPAND(MCF_JSON_FE_31(m, t, __VA_ARGS__))
+#define MCF_JSON_FE_33(m, t, x, ...) m(t, x), MCF_JSON_EXPAND(MCF_JSON_FE_32(m, t, __VA_ARGS__))
+#define MCF_JSON_FE_34(m, t, x, ...) m(t, x), MCF_JSON_EXPAND(MCF_JSON_FE_33(m, t, __VA_ARGS__))
+#define MCF_JSON_FE_35(m, t, x, ...) m(t, x), MCF_JSON_EXPAND(MCF_JSON_FE_34(m, t, __VA_ARGS__))
+#define MCF_JSON_FE_36(m, t, x, ...) m(t, x), MCF_JSON_EXPAND(MCF_JSON_FE_35(m, t, __VA_ARGS__))
+#define MCF_JSON_FE_37(m, t, x, ...) m(t, x), MCF_JSON_EXPAND(MCF_JSON_FE_36(m, t, __VA_ARGS__))
+#define MCF_JSON_FE_38(m, t, x, ...) m(t, x), MCF_JSON_EXPAND(MCF_JSON_FE_37(m, t, __VA_ARGS__))
+#define MCF_JSON_FE_39(m, t, x, ...) m(t, x), MCF_JSON_EXPAND(MCF_JSON_FE_38(m, t, __VA_ARGS__))
+#define MCF_JSON_FE_40(m, t, x, ...) m(t, x), MCF_JSON_EXPAND(MCF_JSON_FE_39(m, t, __VA_ARGS__))
+#define MCF_JSON_FE_41(m, t, x, ...) m(t, x), MCF_JSON_EXPAND(MCF_JSON_FE_40(m, t, __VA_ARGS__))
+#define MCF_JSON_FE_42(m, t, x, ...) m(t, x), MCF_JSON_EXPAND(MCF_JSON_FE_41(m, t, __VA_ARGS__))
+#define MCF_JSON_FE_43(m, t, x, ...) m(t, x), MCF_JSON_EXPAND(MCF_JSON_FE_42(m, t, __VA_ARGS__))
+#define MCF_JSON_FE_44(m, t, x, ...) m(t, x), MCF_JSON_EXPAND(MCF_JSON_FE_43(m, t, __VA_ARGS__))
+#define MCF_JSON_FE_45(m, t, x, ...) m(t, x), MCF_JSON_EXPAND(MCF_JSON_FE_44(m, t, __VA_ARGS__))
+#define MCF_JSON_FE_46(m, t, x, ...) m(t, x), MCF_JSON_EXPAND(MCF_JSON_FE_45(m, t, __VA_ARGS__))
+#define MCF_JSON_FE_47(m, t, x, ...) m(t, x), MCF_JSON_EXPAND(MCF_JSON_FE_46(m, t, __VA_ARGS__))
+#define MCF_JSON_FE_48(m, t, x, ...) m(t, x), MCF_JSON_EXPAND(MCF_JSON_FE_47(m, t, __VA_ARGS__))
+#define MCF_JSON_GET_FE( \
+    _1, _2, _3, _4, _5, _6, _7, _8, _9, _10, _11, _12, _13, _14, _15, _16, \
+    _17, _18, _19, _20, _21, _22, _23, _24, _25, _26, _27, _28, _29, _30, _31, _32, \
+    _33, _34, _35, _36, _37, _38, _39, _40, _41, _42, _43, _44, _45, _46, _47, _48, \
+    NAME, ...) NAME
+#define MCF_JSON_FOR_EACH(m, t, ...) \
+    MCF_JSON_EXPAND(MCF_JSON_GET_FE(__VA_ARGS__, \
+        MCF_JSON_FE_48, MCF_JSON_FE_47, MCF_JSON_FE_46, MCF_JSON_FE_45, MCF_JSON_FE_44, MCF_JSON_FE_43, \
+        MCF_JSON_FE_42, MCF_JSON_FE_41, MCF_JSON_FE_40, MCF_JSON_FE_39, MCF_JSON_FE_38, MCF_JSON_FE_37, \
+        MCF_JSON_FE_36, MCF_JSON_FE_35, MCF_JSON_FE_34, MCF_JSON_FE_33, MCF_JSON_FE_32, MCF_JSON_FE_31, \
+        MCF_JSON_FE_30, MCF_JSON_FE_29, MCF_JSON_FE_28, MCF_JSON_FE_27, MCF_JSON_FE_26, MCF_JSON_FE_25, \
+        MCF_JSON_FE_24, MCF_JSON_FE_23, MCF_JSON_FE_22, MCF_JSON_FE_21, MCF_JSON_FE_20, MCF_JSON_FE_19, \
+        MCF_JSON_FE_18, MCF_JSON_FE_17, MCF_JSON_FE_16, MCF_JSON_FE_15, MCF_JSON_FE_14, MCF_JSON_FE_13, \
+        MCF_JSON_FE_12, MCF_JSON_FE_11, MCF_JSON_FE_10, MCF_JSON_FE_9, MCF_JSON_FE_8, MCF_JSON_FE_7, \
+        MCF_JSON_FE_6, MCF_JSON_FE_5, MCF_JSON_FE_4, MCF_JSON_FE_3, MCF_JSON_FE_2, MCF_JSON_FE_1)(m, t, __VA_ARGS__))
+
+namespace mcf {
+
+/**
+ * @brief Name and member pointer of one reflected field
+ */
+template<typename Class, typename Member>
+struct JsonField {
+    std::string_view name;
+    Member Class::*member;
+};
+
+/**
+ * @brief Seeded FNV-1a hash used for compile-time key tables
+ */
+constexpr uint32_t jsonKeyHash(std::string_view key, uint32_t seed) {
+    uint32_t hash = 2166136261u ^ (seed * 0x9e3779b9u);
+    for (char c : key) {
+        hash ^= static_cast<uint8_t>(c);
+        hash *= 16777619u;
+    }
+    return hash ^ (hash >> 15);
+}
+
+/**
+ * @brief Collision-free key -> field index table
+ *
+ * Slot count is the next power of two at or above eight times the field
+ * count, and the seed is searched at compile time until no two names
+ * collide. The sparse table keeps that search short: a seed works with
+ * probability of about e^(-N/16) or better, so 48 fields need some 20 tries.
+ */
+template<size_t N>
+struct JsonKeyTable {
+    static constexpr size_t slotCount() {
+        size_t slots = 1;
+        while (slots < 8 * N) {
+            slots <<= 1;
+        }
+        return slots;
+    }
+
+    static constexpr size_t SlotCount = slotCount();
+
+    uint32_t seed = 0;
+    std::array<uint16_t, SlotCount> slots{};
+    std::array<std::string_view, N> names{};
+
+    /**
+     * @brief Find a field index
+     * @param key Member key
+     * @return Field index, or N if the key is not a field
+     */
+    constexpr size_t find(std::string_view key) const {
+        size_t slot = slots[jsonKeyHash(key, seed) & (SlotCount - 1)];
+        return (slot < N && names[slot] == key) ? slot : N;
+    }
+};
+
+/**
+ * @brief Build a perfect hash table for a set of field names
+ */
+template<size_t N>
+constexpr JsonKeyTable<N> makeJsonKeyTable(const std::array<std::string_view, N>& names) {
+    static_assert(N < std::numeric_limits<uint16_t>::max(), "Too many fields");
+
+    for (size_t i = 0; i < N; ++i) {
+        for (size_t j = i + 1; j < N; ++j) {
+            if (names[i] == names[j]) {
+                throw std::logic_error("Duplicate JSON field name");
+            }
+        }
+    }
+
+    JsonKeyTable<N> table;
+    table.names = names;
+    for (auto& slot : table.slots) {
+        slot = static_cast<uint16_t>(N);
+    }
+    for (uint32_t seed = 0;; ++seed) {
+        size_t placed = 0;
+        while (placed < N) {
+            size_t slot = jsonKeyHash(names[placed], seed) & (JsonKeyTable<N>::SlotCount - 1);
+            if (table.slots[slot] != N) {
+                break;
+            }
+            table.slots[slot] = static_cast<uint16_t>(placed++);
+        }
+        if (placed == N) {
+            table.seed = seed;
+            return table;
+        }
+        // Collision: clear only the slots this seed filled
+        for (size_t i = 0; i < placed; ++i) {
+            table.slots[jsonKeyHash(names[i], seed) & (JsonKeyTable<N>::SlotCount - 1)] = static_cast<uint16_t>(N);
+        }
+    }
+}
+
+/**
+ * @brief Extract field names from a reflected field tuple
+ */
+template<typename Tuple, size_t... Is>
+constexpr std::array<std::string_view, sizeof...(Is)> jsonFieldNames(const Tuple& fields,
+                                                                     std::index_sequence<Is...>) {
+    return {std::get<Is>(fields).name...};
+}
+
+/**
+ * @brief Check whether a type was declared with MCF_JSON_FIELDS
+ */
+template<typename T, typename = void>
+struct IsJsonReflected : std::false_type {};
+
+template<typename T>
+struct IsJsonReflected<T, std::void_t<decltype(mcfJsonFields(static_cast<const T*>(nullptr)))>>
+    : std::true_type {};
+
+/**
+ * @brief Compile-time field metadata of a reflected type
+ */
+template<typename T>
+struct JsonReflection {
+    static constexpr auto fields = mcfJsonFields(static_cast<const T*>(nullptr));
+    static constexpr size_t Count = std::tuple_size_v<std::remove_const_t<decltype(fields)>>;
+    static constexpr auto keys =
+        makeJsonKeyTable<Count>(jsonFieldNames(fields, std::make_index_sequence<Count>{}));
+};
+
+namespace detail {
+
+template<typename T> struct IsJsonVector : std::false_type {};
+template<typename T, typename A> struct IsJsonVector<std::vector<T, A>> : std::true_type {};
+
+template<typename T> struct IsJsonOptional : std::false_type {};
+template<typename T> struct IsJsonOptional<std::optional<T>> : std::true_type {};
+
+template<typename T> struct IsJsonStringMap : std::false_type {};
+template<typename V, typename C, typename A>
+struct IsJsonStringMap<std::map<std::string, V, C, A>> : std::true_type {};
+template<typename V, typename H, typename E, typename A>
+struct IsJsonStringMap<std::unordered_map<std::string, V, H, E, A>> : std::true_type {};
+
+template<typename T> struct JsonUnsupported : std::false_type {};
+
+/**
+ * @brief Check that an int64 fits in an integer field type
+ */
+template<typename V>
+bool fitsJsonInteger(int64_t value) {
+    if constexpr (std::is_signed_v<V>) {
+        if constexpr (sizeof(V) < sizeof(int64_t)) {
+            return value >= std::numeric_limits<V>::min() && value <= std::numeric_limits<V>::max();
+        } else {
+            return true;
+        }
+    } else {
+        if (value < 0) {
+            return false;
+        }
+        if constexpr (sizeof(V) < sizeof(int64_t)) {
+            return static_cast<uint64_t>(value) <= std::numeric_limits<V>::max();
+        } else {
+            return true;
+        }
+    }
+}
+
+} // namespace detail
+
+/**
+ * @brief Typed JSON parsing and serialization for reflected structs
+ *
+ * Parsing semantics:
+ * - Members missing from the input keep their current (default) values
+ * - Unknown members are skipped without being decoded
+ * - Type mismatches and out-of-range integers throw std::runtime_error
+ * - null is only accepted for std::optional and JsonValue members
+ */
+class JsonBinding {
+public:
+    /**
+     * @brief Parse JSON text into a new value
+     * @tparam T Reflected struct (or any supported member type)
+     * @throws std::runtime_error on malformed input or type mismatches
+     */
+    template<typename T>
+    static T parse(std::string_view json) {
+        T value{};
+        parse(json, value);
+        return value;
+    }
+
+    /**
+     * @brief Parse JSON text into an existing value
+     *
+     * Members absent from the input are left untouched.
+     */
+    template<typename T>
+    static void parse(std::string_view json, T& out) {
+        TextReader reader(json);
+        reader.readRoot(out);
+    }
+
+    /**
+     * @brief Parse a JSON file into a new value
+     * @throws std::runtime_error if the file cannot be read or parsed
+     */
+    template<typename T>
+    static T parseFile(const std::string& filename) {
+        std::ifstream file(filename, std::ios::binary);
+        if (!file.is_open()) {
+            throw std::runtime_error("Failed to open file: " + filename);
+        }
+        std::string content((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+        return parse<T>(content);
+    }
+
+    /**
+     * @brief Serialize a value to JSON text
+     */
+    template<typename T>
+    static std::string write(const T& value, JsonWriter::Style style = JsonWriter::Style::Compact) {
+        JsonWriter writer(style);
+        write(writer, value);
+        return writer.release();
+    }
+
+    /**
+     * @brief Serialize a value into an existing writer
+     */
+    template<typename T>
+    static void write(JsonWriter& writer, const T& value) {
+        using V = std::decay_t<T>;
+
+        if constexpr (std::is_same_v<V, bool>) {
+            writer.boolean(value);
+        } else if constexpr (std::is_integral_v<V>) {
+            if constexpr (std::is_unsigned_v<V> && sizeof(V) >= sizeof(int64_t)) {
+                if (value > static_cast<uint64_t>(std::numeric_limits<int64_t>::max())) {
+                    writer.number(static_cast<double>(value));
+                    return;
+                }
+            }
+            writer.integer(static_cast<int64_t>(value));
+        } else if constexpr (std::is_floating_point_v<V>) {
+            writer.number(static_cast<double>(value));
+        } else if constexpr (std::is_same_v<V, std::string>) {
+            writer.string(value);
+        } else if constexpr (std::is_same_v<V, JsonValue>) {
+            writer.value(value);
+        } else if constexpr (detail::IsJsonOptional<V>::value) {
+            if (value) {
+                write(writer, *value);
+            } else {
+                writer.null();
+            }
+        } else if constexpr (detail::IsJsonVector<V>::value) {
+            writer.startArray();
+            for (const auto& element : value) {
+                write(writer, element);
+            }
+            writer.endArray();
+        } else if constexpr (detail::IsJsonStringMap<V>::value) {
+            writer.startObject();
+            for (const auto& [key, member] : value) {
+                writer.key(key);
+                write(writer, member);
+            }
+            writer.endObject();
+        } else if constexpr (IsJsonReflected<V>::value) {
+            writer.startObject();
+            std::apply([&](const auto&... fields) {
+                ((writer.key(fields.name), write(writer, value.*(fields.member))), ...);
+            }, JsonReflection<V>::fields);
+            writer.endObject();
+        } else {
+            static_assert(detail::JsonUnsupported<V>::value, "Type is not JSON-bindable");
+        }
+    }
+
+    /**
+     * @brief Convert a JsonValue tree into a new value
+     * @throws std::runtime_error on type mismatches
+     */
+    template<typename T>
+    static T fromValue(const JsonValue& json) {
+        T value{};
+        fromValue(json, value);
+        return value;
+    }
+
+    /**
+     * @brief Convert a JsonValue tree into an existing value
+     *
+     * Members absent from the tree are left untouched.
+     */
+    template<typename T>
+    static void fromValue(const JsonValue& json, T& out) {
+        using V = std::decay_t<T>;
+
+        if constexpr (std::is_same_v<V, bool>) {
+            if (!json.isBool()) mismatch("boolean");
+            out = json.asBool();
+        } else if constexpr (std::is_integral_v<V>) {
+            if (!json.isInt()) mismatch("integer");
+            if (!detail::fitsJsonInteger<V>(json.asInt())) {
+                throw std::runtime_error("JSON binding error: Integer out of range");
+            }
+            out = static_cast<V>(json.asInt());
+        } else if constexpr (std::is_floating_point_v<V>) {
+            if (!json.isNumber()) mismatch("number");
+            out = static_cast<V>(json.asFloat());
+        } else if constexpr (std::is_same_v<V, std::string>) {
+            if (!json.isString()) mismatch("string");
+            out = json.asStringRef();
+        } else if constexpr (std::is_same_v<V, JsonValue>) {
+            out = json;
+        } else if constexpr (detail::IsJsonOptional<V>::value) {
+            if (json.isNull()) {
+                out.reset();
+            } else {
+                fromValue(json, out.emplace());
+            }
+        } else if constexpr (detail::IsJsonVector<V>::value) {
+            if (!json.isArray()) mismatch("array");
+            const auto& arr = json.asArray();
+            out.clear();
+            out.reserve(arr.size());
+            for (const auto& element : arr) {
+                out.emplace_back();
+                fromValue(element, out.back());
+            }
+        } else if constexpr (detail::IsJsonStringMap<V>::value) {
+            if (!json.isObject()) mismatch("object");
+            out.clear();
+            for (const auto& [key, member] : json.asObject()) {
+                fromValue(member, out[key]);
+            }
+        } else if constexpr (IsJsonReflected<V>::value) {
+            if (!json.isObject()) mismatch("object");
+            static constexpr auto setters = makeValueSetters<V>(std::make_index_sequence<JsonReflection<V>::Count>{});
+            for (const auto& [key, member] : json.asObject()) {
+                size_t index = JsonReflection<V>::keys.find(key);
+                if (index < JsonReflection<V>::Count) {
+                    setters[index](member, out);
+                }
+            }
+        } else {
+            static_assert(detail::JsonUnsupported<V>::value, "Type is not JSON-bindable");
+        }
+    }
+
+    /**
+     * @brief Convert a value into a JsonValue tree
+     */
+    template<typename T>
+    static JsonValue toValue(const T& value) {
+        using V = std::decay_t<T>;
+
+        if constexpr (std::is_same_v<V, bool>) {
+            return JsonValue(value);
+        } else if constexpr (std::is_integral_v<V>) {
+            if constexpr (std::is_unsigned_v<V> && sizeof(V) >= sizeof(int64_t)) {
+                if (value > static_cast<uint64_t>(std::numeric_limits<int64_t>::max())) {
+                    return JsonValue(static_cast<double>(value));
+                }
+            }
+            return JsonValue(static_cast<int64_t>(value));
+        } else if constexpr (std::is_floating_point_v<V>) {
+            return JsonValue(static_cast<double>(value));
+        } else if constexpr (std::is_same_v<V, std::string>) {
+            return JsonValue(value);
+        } else if constexpr (std::is_same_v<V, JsonValue>) {
+            return value;
+        } else if constexpr (detail::IsJsonOptional<V>::value) {
+            return value ? toValue(*value) : JsonValue(nullptr);
+        } else if constexpr (detail::IsJsonVector<V>::value) {
+            JsonArray arr;
+            arr.reserve(value.size());
+            for (const auto& element : value) {
+                arr.push_back(toValue(element));
+            }
+            return JsonValue(std::move(arr));
+        } else if constexpr (detail::IsJsonStringMap<V>::value) {
+            JsonObject obj;
+            for (const auto& [key, member] : value) {
+                obj.emplace(key, toValue(member));
+            }
+            return JsonValue(std::move(obj));
+        } else if constexpr (IsJsonReflected<V>::value) {
+            JsonObject obj;
+            std::apply([&](const auto&... fields) {
+                (obj.emplace(std::string(fields.name), toValue(value.*(fields.member))), ...);
+            }, JsonReflection<V>::fields);
+            return JsonValue(std::move(obj));
+        } else {
+            static_assert(detail::JsonUnsupported<V>::value, "Type is not JSON-bindable");
+        }
+    }
+
+private:
+    [[noreturn]] static void mismatch(const char* expected) {
+        throw std::runtime_error(std::string("JSON binding error: Expected ") + expected);
+    }
+
+    template<typename V, size_t I>
+    static void setField(const JsonValue& json, V& out) {
+        const auto& field = std::get<I>(JsonReflection<V>::fields);
+        fromValue(json, out.*(field.member));
+    }
+
+    template<typename V, size_t... Is>
+    static constexpr auto makeValueSetters(std::index_sequence<Is...>) {
+        using Setter = void (*)(const JsonValue&, V&);
+        return std::array<Setter, sizeof...(Is)>{&JsonBinding::setField<V, Is>...};
+    }
+
+    /**
+     * @brief Typed reader walking the JsonScanner structural index
+     */
+    class TextReader {
+    public:
+        explicit TextReader(std::string_view input) : m_input(input) {
+            try {
+                JsonScanner::index(input, m_index);
+            } catch (const std::exception& e) {
+                throw std::runtime_error(std::string("JSON parse error: ") + e.what());
+            }
+        }
+
+        template<typename V>
+        void readRoot(V& out) {
+            read(out, next());
+        }
+
+    private:
+        std::string_view m_input;
+        std::vector<uint32_t> m_index;
+        size_t m_next = 0;
+        std::string m_key;  ///< Scratch for keys containing escapes
+
+        [[noreturn]] void fail(const std::string& what, size_t pos) const {
+            throw std::runtime_error("JSON parse error: " + JsonScanner::formatError(m_input, what, pos));
+        }
+
+        char at(size_t pos) const {
+            return pos < m_input.size() ? m_input[pos] : '\0';
+        }
+
+        size_t next() {
+            return m_next < m_index.size() ? m_index[m_next++] : m_input.size();
+        }
+
+        void expectTerminator(size_t end) const {
+            if (!JsonScanner::isTerminator(at(end))) {
+                fail("Unexpected character '" + std::string(1, at(end)) + "'", end);
+            }
+        }
+
+        JsonNumber readNumber(size_t pos) {
+            char c = at(pos);
+            if (c != '-' && (c < '0' || c > '9')) {
+                fail("Expected number", pos);
+            }
+            JsonNumber number;
+            JsonScanResult res = JsonScanner::decodeNumber(m_input, pos, number);
+            if (res.error) {
+                fail(res.error, res.end);
+            }
+            expectTerminator(res.end);
+            return number;
+        }
+
+        void readLiteral(size_t pos, std::string_view literal) {
+            JsonScanResult res = JsonScanner::matchLiteral(m_input, pos, literal);
+            if (res.error) {
+                fail(std::string(res.error) + " (expected '" + std::string(literal) + "')", res.end);
+            }
+            expectTerminator(res.end);
+        }
+
+        void readString(size_t pos, std::string& out) {
+            if (at(pos) != '"') {
+                fail("Expected string", pos);
+            }
+            out.clear();
+            JsonScanResult res = JsonScanner::decodeString(m_input, pos, out);
+            if (res.error) {
+                fail(res.error, res.end);
+            }
+        }
+
+        /**
+         * @brief Read an object key, without copying when it has no escapes
+         */
+        std::string_view readKey(size_t pos) {
+            if (at(pos) != '"') {
+                fail("Expected '\"'", pos);
+            }
+            size_t stop = JsonScanner::findQuoteOrBackslash(m_input.data(), pos + 1, m_input.size());
+            if (stop < m_input.size() && m_input[stop] == '"') {
+                return m_input.substr(pos + 1, stop - pos - 1);
+            }
+            readString(pos, m_key);
+            return m_key;
+        }
+
+        /**
+         * @brief Skip a value, returning the offset one past its end
+         *
+         * Containers are skipped by walking the structural index only.
+         */
+        size_t skipValue(size_t pos) {
+            char c = at(pos);
+            if (c == '{' || c == '[') {
+                size_t depth = 1;
+                size_t p = pos;
+                while (depth > 0) {
+                    p = next();
+                    switch (at(p)) {
+                        case '{': case '[': ++depth; break;
+                        case '}': case ']': --depth; break;
+                        case '\0':
+                            if (p >= m_input.size()) fail("Unexpected end of input", p);
+                            break;
+                        default: break;
+                    }
+                }
+                return p + 1;
+            }
+            if (c == '"') {
+                size_t p = pos + 1;
+                while (true) {
+                    p = JsonScanner::findQuoteOrBackslash(m_input.data(), p, m_input.size());
+                    if (p >= m_input.size()) fail("Unterminated string", p);
+                    if (m_input[p] == '"') return p + 1;
+                    p += 2;
+                }
+            }
+            if (c == 't') { readLiteral(pos, "true"); return pos + 4; }
+            if (c == 'f') { readLiteral(pos, "false"); return pos + 5; }
+            if (c == 'n') { readLiteral(pos, "null"); return pos + 4; }
+            JsonNumber number;
+            JsonScanResult res = JsonScanner::decodeNumber(m_input, pos, number);
+            if (res.error) {
+                fail(pos >= m_input.size() ? "Unexpected end of input" : res.error, res.end);
+            }
+            expectTerminator(res.end);
+            return res.end;
+        }
+
+        template<typename Fn>
+        void readObject(size_t pos, Fn&& onMember) {
+            if (at(pos) != '{') {
+                fail("Expected object", pos);
+            }
+            size_t p = next();
+            if (at(p) == '}') {
+                return;
+            }
+            while (true) {
+                std::string_view key = readKey(p);
+                size_t colon = next();
+                if (at(colon) != ':') {
+                    fail("Expected ':'", colon);
+                }
+                onMember(key, next());
+
+                p = next();
+                if (at(p) == '}') {
+                    return;
+                }
+                if (at(p) != ',') {
+                    fail("Expected ',' or '}'", p);
+                }
+                p = next();
+            }
+        }
+
+        template<typename Fn>
+        void readArray(size_t pos, Fn&& onElement) {
+            if (at(pos) != '[') {
+                fail("Expected array", pos);
+            }
+            size_t p = next();
+            if (at(p) == ']') {
+                return;
+            }
+            while (true) {
+                onElement(p);
+
+                p = next();
+                if (at(p) == ']') {
+                    return;
+                }
+                if (at(p) != ',') {
+                    fail("Expected ',' or ']'", p);
+                }
+                p = next();
+            }
+        }
+
+        template<typename V, size_t I>
+        static void readField(TextReader& reader, V& out, size_t pos) {
+            const auto& field = std::get<I>(JsonReflection<V>::fields);
+            reader.read(out.*(field.member), pos);
+        }
+
+        template<typename V, size_t... Is>
+        static constexpr auto makeFieldReaders(std::index_sequence<Is...>) {
+            using Reader = void (*)(TextReader&, V&, size_t);
+            return std::array<Reader, sizeof...(Is)>{&TextReader::readField<V, Is>...};
+        }
+
+        template<typename V>
+        void read(V& out, size_t pos) {
+            if constexpr (std::is_same_v<V, bool>) {
+                char c = at(pos);
+                if (c == 't') {
+                    readLiteral(pos, "true");
+                    out = true;
+                } else if (c == 'f') {
+                    readLiteral(pos, "false");
+                    out = false;
+                } else {
+                    fail("Expected boolean", pos);
+                }
+            } else if constexpr (std::is_integral_v<V>) {
+                JsonNumber number = readNumber(pos);
+                if (number.isFloat) {
+                    fail("Expected integer", pos);
+                }
+                if (!detail::fitsJsonInteger<V>(number.intValue)) {
+                    fail("Integer out of range", pos);
+                }
+                out = static_cast<V>(number.intValue);
+            } else if constexpr (std::is_floating_point_v<V>) {
+                JsonNumber number = readNumber(pos);
+                out = static_cast<V>(number.isFloat ? number.floatValue
+                                                    : static_cast<double>(number.intValue));
+            } else if constexpr (std::is_same_v<V, std::string>) {
+                readString(pos, out);
+            } else if constexpr (std::is_same_v<V, JsonValue>) {
+                size_t end = skipValue(pos);
+                out = JsonParser::parse(m_input.substr(pos, end - pos));
+            } else if constexpr (detail::IsJsonOptional<V>::value) {
+                if (at(pos) == 'n') {
+                    readLiteral(pos, "null");
+                    out.reset();
+                } else {
+                    read(out.emplace(), pos);
+                }
+            } else if constexpr (detail::IsJsonVector<V>::value) {
+                out.clear();
+                readArray(pos, [&](size_t elementPos) {
+                    out.emplace_back();
+                    read(out.back(), elementPos);
+                });
+            } else if constexpr (detail::IsJsonStringMap<V>::value) {
+                out.clear();
+                readObject(pos, [&](std::string_view key, size_t valuePos) {
+                    read(out[std::string(key)], valuePos);
+                });
+            } else if constexpr (IsJsonReflected<V>::value) {
+                static constexpr auto readers =
+                    makeFieldReaders<V>(std::make_index_sequence<JsonReflection<V>::Count>{});
+                readObject(pos, [&](std::string_view key, size_t valuePos) {
+                    size_t index = JsonReflection<V>::keys.find(key);
+                    if (index < JsonReflection<V>::Count) {
+                        readers[index](*this, out, valuePos);
+                    } else {
+                        skipValue(valuePos);
+                    }
+                });
+            } else {
+                static_assert(detail::JsonUnsupported<V>::value, "Type is not JSON-bindable");
+            }
+        }
+    };
+};
+
+} // namespace mcf
@@ -0,0 +1,774 @@
+/**
+ * @file JsonDocument.hpp
+ * @brief Arena-allocated, read-only JSON document
+ *
+ * Alternative to the JsonValue tree for large or short-lived documents:
+ * every node, string and key lives in one arena owned by the document, so
+ * parsing performs a handful of large allocations and destruction is a
+ * matter of releasing those blocks. See JsonLazyDocument for inputs of
+ * which only a few fields are read.
+ */
+
+#pragma once
+
+#include "JsonScanner.hpp"
+#include "MappedFile.hpp"
+#include "JsonValue.hpp"
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <fstream>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <unordered_map>
+#include <vector>
+
+namespace mcf {
+
+/**
+ * @brief Bump allocator backing a JsonDocument
+ *
+ * Memory is carved sequentially out of large blocks and released all at
+ * once when the arena is destroyed or reset. Individual allocations are
+ * never freed.
+ */
+class JsonArena {
+private:
+    struct Block {
+        std::unique_ptr<char[]> data;
+        size_t size;
+    };
+
+    std::vector<Block> m_blocks;
+    char* m_cursor = nullptr;
+    char* m_end = nullptr;
+    size_t m_nextBlockSize;
+    size_t m_bytesUsed = 0;
+    size_t m_bytesReserved = 0;
+
+    static constexpr size_t MaxBlockSize = 16 * 1024 * 1024;
+
+    void grow(size_t minimum) {
+        size_t size = std::max(m_nextBlockSize, minimum);
+        m_blocks.push_back({std::unique_ptr<char[]>(new char[size]), size});
+        m_cursor = m_blocks.back().data.get();
+        m_end = m_cursor + size;
+        m_bytesReserved += size;
+        m_nextBlockSize = std::min(m_nextBlockSize * 2, MaxBlockSize);
+    }
+
+public:
+    /**
+     * @brief Constructor
+     * @param initialBlockSize Size of the first block in bytes
+     */
+    explicit JsonArena(size_t initialBlockSize = 64 * 1024)
+        : m_nextBlockSize(std::max<size_t>(initialBlockSize, 1024)) {}
+
+    JsonArena(JsonArena&&) noexcept = default;
+    JsonArena& operator=(JsonArena&&) noexcept = default;
+
+    // Non-copyable
+    JsonArena(const JsonArena&) = delete;
+    JsonArena& operator=(const JsonArena&) = delete;
+
+    /**
+     * @brief Allocate raw memory
+     * @param size Number of bytes
+     * @param alignment Required alignment (power of two)
+     * @return Pointer valid until the arena is reset or destroyed
+     */
+    void* allocate(size_t size, size_t alignment = alignof(std::max_align_t)) {
+        uintptr_t current = reinterpret_cast<uintptr_t>(m_cursor);
+        uintptr_t aligned = (current + alignment - 1) & ~(static_cast<uintptr_t>(alignment) - 1);
+        if (!m_cursor || aligned + size > reinterpret_cast<uintptr_t>(m_end)) {
+            grow(size + alignment);
+            current = reinterpret_cast<uintptr_t>(m_cursor);
+            aligned = (current + alignment - 1) & ~(static_cast<uintptr_t>(alignment) - 1);
+        }
+        m_cursor = reinterpret_cast<char*>(aligned + size);
+        m_bytesUsed += size;
+        return reinterpret_cast<void*>(aligned);
+    }
+
+    /**
+     * @brief Allocate an uninitialized array of trivially copyable objects
+     * @tparam T Element type
+     * @param count Number of elements
+     * @return Pointer to the first element
+     */
+    template<typename T>
+    T* allocateArray(size_t count) {
+        static_assert(std::is_trivially_copyable<T>::value, "Arena arrays must be trivially copyable");
+        if (count == 0) return nullptr;
+        return static_cast<T*>(allocate(sizeof(T) * count, alignof(T)));
+    }
+
+    /**
+     * @brief Copy a string into the arena
+     * @param str String to copy
+     * @return Pointer to the copy (not null-terminated)
+     */
+    const char* copyString(std::string_view str) {
+        if (str.empty()) return "";
+        char* dst = static_cast<char*>(allocate(str.size(), 1));
+        std::memcpy(dst, str.data(), str.size());
+        return dst;
+    }
+
+    /**
+     * @brief Release every block at once
+     */
+    void reset() {
+        m_blocks.clear();
+        m_cursor = nullptr;
+        m_end = nullptr;
+        m_bytesUsed = 0;
+        m_bytesReserved = 0;
+    }
+
+    /**
+     * @brief Get bytes handed out to callers
+     * @return Sum of allocation sizes
+     */
+    size_t bytesUsed() const { return m_bytesUsed; }
+
+    /**
+     * @brief Get bytes reserved from the system
+     * @return Sum of block sizes
+     */
+    size_t bytesReserved() const { return m_bytesReserved; }
+};
+
+struct JsonMember;
+
+/**
+ * @brief Compact, trivially copyable JSON node stored in a JsonArena
+ *
+ * Objects are flat arrays of JsonMember sorted by key (duplicate keys keep
+ * the last value, like JsonObject). Lookups scan linearly for small objects
+ * and binary-search larger ones.
+ */
+struct JsonNode {
+    /// Objects up to this many members are searched linearly
+    static constexpr uint32_t LinearSearchLimit = 8;
+
+    JsonType kind = JsonType::Null;
+    uint32_t length = 0;  ///< String length, element count or member count
+    union {
+        bool boolean;
+        int64_t integer;
+        double number;
+        const char* string;
+        const JsonNode* elements;
+        const JsonMember* members;
+    };
+
+    JsonNode() : integer(0) {}
+
+    /**
+     * @brief Get the type of this node
+     * @return The JsonType of this node
+     */
+    JsonType type() const { return kind; }
+
+    bool isNull() const { return kind == JsonType::Null; }
+    bool isBool() const { return kind == JsonType::Boolean; }
+    bool isInt() const { return kind == JsonType::Integer; }
+    bool isFloat() const { return kind == JsonType::Float; }
+    bool isNumber() const { return isInt() || isFloat(); }
+    bool isString() const { return kind == JsonType::String; }
+    bool isArray() const { return kind == JsonType::Array; }
+    bool isObject() const { return kind == JsonType::Object; }
+
+    /**
+     * @brief Get as boolean
+     * @param defaultValue Value to return if this is not a boolean
+     * @return The boolean value or defaultValue
+     */
+    bool asBool(bool defaultValue = false) const {
+        return isBool() ? boolean : defaultValue;
+    }
+
+    /**
+     * @brief Get as integer
+     * @param defaultValue Value to return if this is not a number
+     * @return The integer value (converted from float if needed) or defaultValue
+     */
+    int64_t asInt(int64_t defaultValue = 0) const {
+        if (isInt()) return integer;
+        if (isFloat()) return static_cast<int64_t>(number);
+        return defaultValue;
+    }
+
+    /**
+     * @brief Get as float
+     * @param defaultValue Value to return if this is not a number
+     * @return The float value (converted from int if needed) or defaultValue
+     */
+    double asFloat(double defaultValue = 0.0) const {
+        if (isFloat()) return number;
+        if (isInt()) return static_cast<double>(integer);
+        return defaultValue;
+    }
+
+    /**
+     * @brief Get as string view into the document arena
+     * @param defaultValue Value to return if this is not a string
+     * @return The string contents or defaultValue
+     */
+    std::string_view asString(std::string_view defaultValue = {}) const {
+        return isString() ? std::string_view(string, length) : defaultValue;
+    }
+
+    /**
+     * @brief Get array or object size
+     * @return Number of elements or members, 0 for other types
+     */
+    size_t size() const {
+        return (isArray() || isObject()) ? length : 0;
+    }
+
+    /**
+     * @brief Array elements
+     * @return Pointers delimiting the elements (empty for non-arrays)
+     */
+    const JsonNode* begin() const { return isArray() ? elements : nullptr; }
+    const JsonNode* end() const { return isArray() ? elements + length : nullptr; }
+
+    /**
+     * @brief Object members, sorted by key
+     * @return Pointers delimiting the members (empty for non-objects)
+     */
+    const JsonMember* membersBegin() const { return isObject() ? members : nullptr; }
+    const JsonMember* membersEnd() const;
+
+    /**
+     * @brief Find a member by key
+     * @param key Key to look up
+     * @return Pointer to the value, or nullptr if absent or not an object
+     */
+    const JsonNode* find(std::string_view key) const;
+
+    /**
+     * @brief Check if object has a key
+     * @param key The key to check for
+     * @return true if this is an object and contains the key
+     */
+    bool has(std::string_view key) const { return find(key) != nullptr; }
+
+    /**
+     * @brief Get member by key
+     * @param key The key to look up
+     * @return The member value, or a null node if not found
+     */
+    const JsonNode& operator[](std::string_view key) const {
+        const JsonNode* node = find(key);
+        return node ? *node : nullNode();
+    }
+
+    /**
+     * @brief Get element by index
+     * @param index Array index
+     * @return The element, or a null node if out of bounds or not an array
+     */
+    const JsonNode& operator[](size_t index) const {
+        if (!isArray() || index >= length) return nullNode();
+        return elements[index];
+    }
+
+    /**
+     * @brief Convert to a JsonValue tree
+     * @return Deep copy of this node as a JsonValue
+     */
+    JsonValue toJsonValue() const;
+
+    /**
+     * @brief Shared null node returned for missing lookups
+     * @return Reference to a static null node
+     */
+    static const JsonNode& nullNode() {
+        static const JsonNode null;
+        return null;
+    }
+};
+
+/**
+ * @brief Key/value pair of an arena object (key is interned in the arena)
+ */
+struct JsonMember {
+    const char* keyData;
+    uint32_t keyLength;
+    JsonNode value;
+
+    /**
+     * @brief Get the member key
+     * @return View of the interned key
+     */
+    std::string_view key() const { return std::string_view(keyData, keyLength); }
+};
+
+inline const JsonMember* JsonNode::membersEnd() const {
+    return isObject() ? members + length : nullptr;
+}
+
+inline const JsonNode* JsonNode::find(std::string_view key) const {
+    if (!isObject()) return nullptr;
+
+    if (length <= LinearSearchLimit) {
+        for (uint32_t i = 0; i < length; ++i) {
+            if (members[i].key() == key) return &members[i].value;
+        }
+        return nullptr;
+    }
+
+    const JsonMember* first = members;
+    const JsonMember* last = members + length;
+    auto it = std::lower_bound(first, last, key, [](const JsonMember& m, std::string_view k) {
+        return m.key() < k;
+    });
+    if (it != last && it->key() == key) return &it->value;
+    return nullptr;
+}
+
+inline JsonValue JsonNode::toJsonValue() const {
+    switch (kind) {
+        case JsonType::Null: return JsonValue(nullptr);
+        case JsonType::Boolean: return JsonValue(boolean);
+        case JsonType::Integer: return JsonValue(integer);
+        case JsonType::Float: return JsonValue(number);
+        case JsonType::String: return JsonValue(std::string(string, length));
+        case JsonType::Array: {
+            JsonArray arr;
+            arr.reserve(length);
+            for (const JsonNode& element : *this) {
+                arr.push_back(element.toJsonValue());
+            }
+            return JsonValue(std::move(arr));
+        }
+        case JsonType::Object: {
+            JsonObject obj;
+            for (const JsonMember* m = members; m != members + length; ++m) {
+                obj.emplace_hint(obj.end(), std::string(m->key()), m->value.toJsonValue());
+            }
+            return JsonValue(std::move(obj));
+        }
+    }
+    return JsonValue();
+}
+
+/**
+ * @brief Read-only JSON document whose nodes live in a single arena
+ *
+ * Features:
+ * - 16-byte nodes, no per-node heap allocation or reference counting
+ * - Object keys interned once per document
+ * - Flat member arrays with linear search for small objects and binary
+ *   search past JsonNode::LinearSearchLimit members
+ * - Whole-document release in a handful of frees
+ *
+ * Example:
+ * @code
+ * auto doc = JsonDocument::parse(text);
+ * int64_t port = doc.root()["network"]["port"].asInt(8080);
+ * @endcode
+ */
+class JsonDocument {
+private:
+    JsonArena m_arena;
+    const JsonNode* m_root = &JsonNode::nullNode();
+    size_t m_keyCount = 0;
+
+    /**
+     * @brief Stage-two builder writing nodes into the arena
+     */
+    class Builder {
+    public:
+        Builder(std::string_view input, JsonArena& arena)
+            : m_input(input), m_arena(arena) {}
+
+        const JsonNode* build() {
+            JsonScanner::index(m_input, m_index);
+            JsonNode* root = m_arena.allocateArray<JsonNode>(1);
+            *root = parseValue(nextStructural());
+            return root;
+        }
+
+        size_t keyCount() const { return m_keys.size(); }
+
+    private:
+        static constexpr size_t InsertionSortLimit = 32;
+
+        std::string_view m_input;
+        JsonArena& m_arena;
+        std::vector<uint32_t> m_index;
+        size_t m_next = 0;
+
+        // Scratch stacks shared by all nesting levels; a container's children
+        // sit on top of the stack until it closes and they are copied out
+        std::vector<JsonNode> m_elements;
+        std::vector<JsonMember> m_members;
+        std::string m_scratch;
+        std::unordered_map<std::string_view, const char*> m_keys;
+
+        [[noreturn]] void fail(const std::string& what, size_t pos) const {
+            throw std::runtime_error(JsonScanner::formatError(m_input, what, pos));
+        }
+
+        char at(size_t pos) const {
+            return pos < m_input.size() ? m_input[pos] : '\0';
+        }
+
+        size_t nextStructural() {
+            if (m_next < m_index.size()) return m_index[m_next++];
+            return m_input.size();
+        }
+
+        void expectTerminator(size_t end) const {
+            if (!JsonScanner::isTerminator(at(end))) {
+                fail("Unexpected character '" + std::string(1, at(end)) + "'", end);
+            }
+        }
+
+        std::string_view decodeString(size_t pos) {
+            m_scratch.clear();
+            JsonScanResult res = JsonScanner::decodeString(m_input, pos, m_scratch);
+            if (res.error) fail(res.error, res.end);
+            return m_scratch;
+        }
+
+        const char* internKey(std::string_view key) {
+            auto it = m_keys.find(key);
+            if (it != m_keys.end()) return it->second;
+            const char* stored = m_arena.copyString(key);
+            m_keys.emplace(std::string_view(stored, key.size()), stored);
+            return stored;
+        }
+
+        JsonNode parseValue(size_t pos) {
+            JsonNode node;
+            char c = at(pos);
+
+            switch (c) {
+                case '{': return parseObject();
+                case '[': return parseArray();
+                case '"': {
+                    std::string_view str = decodeString(pos);
+                    node.kind = JsonType::String;
+                    node.length = static_cast<uint32_t>(str.size());
+                    node.string = m_arena.copyString(str);
+                    return node;
+                }
+                case 't': case 'f': case 'n': {
+                    std::string_view literal = c == 't' ? "true" : (c == 'f' ? "false" : "null");
+                    JsonScanResult res = JsonScanner::matchLiteral(m_input, pos, literal);
+                    if (res.error) {
+                        fail(std::string(res.error) + " (expected '" + std::string(literal) + "')", res.end);
+                    }
+                    expectTerminator(res.end);
+                    if (c == 'n') return node;
+                    node.kind = JsonType::Boolean;
+                    node.boolean = (c == 't');
+                    return node;
+                }
+                case '-': case '0': case '1': case '2': case '3': case '4':
+                case '5': case '6': case '7': case '8': case '9': {
+                    JsonNumber number;
+                    JsonScanResult res = JsonScanner::decodeNumber(m_input, pos, number);
+                    if (res.error) fail(res.error, res.end);
+                    expectTerminator(res.end);
+                    if (number.isFloat) {
+                        node.kind = JsonType::Float;
+                        node.number = number.floatValue;
+                    } else {
+                        node.kind = JsonType::Integer;
+                        node.integer = number.intValue;
+                    }
+                    return node;
+                }
+                default:
+                    break;
+            }
+
+            if (pos >= m_input.size()) fail("Unexpected end of input", pos);
+            fail("Unexpected character '" + std::string(1, c) + "'", pos);
+        }
+
+        JsonNode parseArray() {
+            size_t base = m_elements.size();
+
+            size_t pos = nextStructural();
+            if (at(pos) != ']') {
+                while (true) {
+                    JsonNode element = parseValue(pos);
+                    m_elements.push_back(element);
+
+                    pos = nextStructural();
+                    if (at(pos) == ']') break;
+                    if (at(pos) != ',') fail("Expected ',' or ']'", pos);
+                    pos = nextStructural();
+                }
+            }
+
+            JsonNode node;
+            node.kind = JsonType::Array;
+            node.length = static_cast<uint32_t>(m_elements.size() - base);
+            JsonNode* elements = m_arena.allocateArray<JsonNode>(node.length);
+            if (node.length) {
+                std::memcpy(elements, m_elements.data() + base, node.length * sizeof(JsonNode));
+            }
+            node.elements = elements;
+            m_elements.resize(base);
+            return node;
+        }
+
+        JsonNode parseObject() {
+            size_t base = m_members.size();
+
+            size_t pos = nextStructural();
+            if (at(pos) != '}') {
+                while (true) {
+                    if (at(pos) != '"') fail("Expected '\"'", pos);
+                    std::string_view key = decodeString(pos);
+                    JsonMember member;
+                    member.keyData = internKey(key);
+                    member.keyLength = static_cast<uint32_t>(key.size());
+
+                    pos = nextStructural();
+                    if (at(pos) != ':') fail("Expected ':'", pos);
+
+                    member.value = parseValue(nextStructural());
+                    m_members.push_back(member);
+
+                    pos = nextStructural();
+                    if (at(pos) == '}') break;
+                    if (at(pos) != ',') fail("Expected ',' or '}'", pos);
+                    pos = nextStructural();
+                }
+            }
+
+            // Sort by key (stable, so the last duplicate stays last); small
+            // objects use an in-place insertion sort to avoid a temp buffer
+            auto first = m_members.begin() + static_cast<std::ptrdiff_t>(base);
+            auto byKey = [](const JsonMember& a, const JsonMember& b) { return a.key() < b.key(); };
+            if (m_members.size() - base <= InsertionSortLimit) {
+                for (auto it = first; it != m_members.end(); ++it) {
+                    JsonMember member = *it;
+                    auto hole = it;
+                    while (hole != first && byKey(member, *(hole - 1))) {
+                        *hole = *(hole - 1);
+                        --hole;
+                    }
+                    *hole = member;
+                }
+            } else {
+                std::stable_sort(first, m_members.end(), byKey);
+            }
+            size_t count = 0;
+            for (auto it = first; it != m_members.end(); ++it) {
+                auto next = it + 1;
+                if (next != m_members.end() && next->key() == it->key()) continue;
+                *(first + static_cast<std::ptrdiff_t>(count++)) = *it;
+            }
+
+            JsonNode node;
+            node.kind = JsonType::Object;
+            node.length = static_cast<uint32_t>(count);
+            JsonMember* members = m_arena.allocateArray<JsonMember>(count);
+            if (count) {
+                std::memcpy(members, m_members.data() + base, count * sizeof(JsonMember));
+            }
+            node.members = members;
+            m_members.resize(base);
+            return node;
+        }
+    };
+
+    /**
+     * @brief Copy a JsonValue tree into arena nodes
+     */
+    JsonNode copyFrom(const JsonValue& value, std::unordered_map<std::string_view, const char*>& keys) {
+        JsonNode node;
+        node.kind = value.type();
+        switch (value.type()) {
+            case JsonType::Null: break;
+            case JsonType::Boolean: node.boolean = value.asBool(); break;
+            case JsonType::Integer: node.integer = value.asInt(); break;
+            case JsonType::Float: node.number = value.asFloat(); break;
+            case JsonType::String: {
+                const std::string& str = value.asStringRef();
+                node.length = static_cast<uint32_t>(str.size());
+                node.string = m_arena.copyString(str);
+                break;
+            }
+            case JsonType::Array: {
+                const auto& arr = value.asArray();
+                JsonNode* elements = m_arena.allocateArray<JsonNode>(arr.size());
+                for (size_t i = 0; i < arr.size(); ++i) {
+                    elements[i] = copyFrom(arr[i], keys);
+                }
+                node.length = static_cast<uint32_t>(arr.size());
+                node.elements = elements;
+                break;
+            }
+            case JsonType::Object: {
+                const auto& obj = value.asObject();
+                JsonMember* members = m_arena.allocateArray<JsonMember>(obj.size());
+                size_t i = 0;
+                for (const auto& [key, child] : obj) {
+                    auto it = keys.find(key);
+                    const char* stored = nullptr;
+                    if (it != keys.end()) {
+                        stored = it->second;
+                    } else {
+                        stored = m_arena.copyString(key);
+                        keys.emplace(std::string_view(stored, key.size()), stored);
+                    }
+                    members[i].keyData = stored;
+                    members[i].keyLength = static_cast<uint32_t>(key.size());
+                    members[i].value = copyFrom(child, keys);
+                    ++i;
+                }
+                node.length = static_cast<uint32_t>(obj.size());
+                node.members = members;
+                break;
+            }
+        }
+        return node;
+    }
+
+public:
+    JsonDocument() = default;
+    JsonDocument(JsonDocument&&) noexcept = default;
+    JsonDocument& operator=(JsonDocument&&) noexcept = default;
+
+    // Non-copyable
+    JsonDocument(const JsonDocument&) = delete;
+    JsonDocument& operator=(const JsonDocument&) = delete;
+
+    /**
+     * @brief Parse JSON text into an arena document
+     * @param json JSON text (not referenced after parsing)
+     * @return The parsed document
+     * @throws std::runtime_error if parsing fails
+     */
+    static JsonDocument parse(std::string_view json) {
+        JsonDocument doc;
+        doc.m_arena = JsonArena(json.size() + 1024);
+
+        try {
+            Builder builder(json, doc.m_arena);
+            doc.m_root = builder.build();
+            doc.m_keyCount = builder.keyCount();
+        } catch (const std::exception& e) {
+            throw std::runtime_error(std::string("JSON parse error: ") + e.what());
+        }
+        return doc;
+    }
+
+    /**
+     * @brief Parse a JSON file into an arena document
+     * @param filename Path to the JSON file
+     * @return The parsed document
+     * @throws std::runtime_error if the file cannot be read or parsing fails
+     *
+     * The file is read into a buffer, as in JsonParser::parseFile().
+     */
+    static JsonDocument parseFile(const std::string& filename) {
+        std::ifstream file(filename, std::ios::binary);
+        if (!file.is_open()) {
+            throw std::runtime_error("Failed to open file: " + filename);
+        }
+
+        std::string content;
+        file.seekg(0, std::ios::end);
+        std::streamoff size = file.tellg();
+        file.seekg(0, std::ios::beg);
+        if (size > 0) {
+            content.resize(static_cast<size_t>(size));
+            file.read(&content[0], size);
+            content.resize(static_cast<size_t>(file.gcount()));
+        }
+        return parse(content);
+    }
+
+    /**
+     * @brief Parse a JSON file mapped into memory into an arena document
+     * @param filename Path to the JSON file
+     * @return The parsed document
+     * @throws std::runtime_error if the file cannot be read or parsing fails
+     *
+     * Large files are parsed from a mapping; the same restrictions as for
+     * JsonParser::parseMappedFile() apply.
+     */
+    static JsonDocument parseMappedFile(const std::string& filename) {
+        std::ifstream file(filename, std::ios::binary);
+        if (!file.is_open()) {
+            throw std::runtime_error("Failed to open file: " + filename);
+        }
+
+        file.seekg(0, std::ios::end);
+        std::streamoff size = file.tellg();
+        if (size < static_cast<std::streamoff>(MappedFile::MinimumMapSize)) {
+            file.close();
+            return parseFile(filename);  // Mapping small files costs more than copying them
+        }
+
+        // Parse in place; both passes read the whole file, so fetch it all
+        file.close();
+        MappedFile mapped(filename, MapMode::ReadOnly, MapOptions{MapAdvice::WillNeed, false});
+        return parse(mapped.view());
+    }
+
+    /**
+     * @brief Build an arena document from a JsonValue tree
+     * @param value Source tree
+     * @return Document holding a compact copy of @p value
+     */
+    static JsonDocument fromJsonValue(const JsonValue& value) {
+        JsonDocument doc;
+        std::unordered_map<std::string_view, const char*> keys;
+        JsonNode* root = doc.m_arena.allocateArray<JsonNode>(1);
+        *root = doc.copyFrom(value, keys);
+        doc.m_root = root;
+        doc.m_keyCount = keys.size();
+        return doc;
+    }
+
+    /**
+     * @brief Get the root node
+     * @return Reference to the root (a null node for empty documents)
+     */
+    const JsonNode& root() const { return *m_root; }
+
+    /**
+     * @brief Convert the whole document to a JsonValue tree
+     * @return Deep copy as JsonValue
+     */
+    JsonValue toJsonValue() const { return m_root->toJsonValue(); }
+
+    /**
+     * @brief Get memory reserved by the document arena
+     * @return Bytes reserved from the system
+     */
+    size_t memoryUsage() const { return m_arena.bytesReserved(); }
+
+    /**
+     * @brief Get memory actually used by nodes, strings and keys
+     * @return Bytes used within the arena
+     */
+    size_t memoryUsed() const { return m_arena.bytesUsed(); }
+
+    /**
+     * @brief Get number of distinct object keys
+     * @return Count of interned keys
+     */
+    size_t internedKeyCount() const { return m_keyCount; }
+};
+
+} // namespace mcf
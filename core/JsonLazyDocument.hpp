@@ -0,0 +1,595 @@
+/**
+ * @file JsonLazyDocument.hpp
+ * @brief On-demand JSON document decoding values only when accessed
+ *
+ * Lazy counterpart of JsonDocument for large inputs of which only a few
+ * fields are read: one pass validates the structure and records a compact
+ * tape of value offsets, and strings and numbers are decoded from the
+ * original text on access. Every tape entry knows where its value ends, so
+ * untouched subtrees are skipped with a single jump.
+ */
+
+#pragma once
+
+#include "JsonDocument.hpp"
+#include "JsonParser.hpp"
+#include "JsonScanner.hpp"
+#include "JsonValue.hpp"
+
+#include <cstdint>
+#include <fstream>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace mcf {
+
+/**
+ * @brief One entry of a lazy document's structure tape
+ *
+ * Scalars take one entry. Containers take an opening entry, their
+ * children, and a closing entry holding the closing bracket's offset and
+ * the child count. Object members occupy consecutive key and value entries.
+ */
+struct JsonTapeEntry {
+    uint32_t offset;  ///< Input offset of the value's first byte (closing bracket for closing entries)
+    uint32_t next;    ///< Tape index one past this value; child count for closing entries
+};
+
+/**
+ * @brief Input text and structure tape shared by all values of a document
+ */
+struct JsonLazyTape {
+    std::string storage;                ///< Owned input (empty when borrowed)
+    std::string_view input;             ///< Text the tape points into
+    std::vector<JsonTapeEntry> entries;
+
+    char at(size_t pos) const {
+        return pos < input.size() ? input[pos] : '\0';
+    }
+
+    [[noreturn]] void fail(const std::string& what, size_t pos) const {
+        throw std::runtime_error("JSON parse error: " + JsonScanner::formatError(input, what, pos));
+    }
+};
+
+struct JsonLazyMember;
+
+/**
+ * @brief Handle to a value of a JsonLazyDocument
+ *
+ * Cheap to copy (a pointer and an index) and valid as long as the owning
+ * document is alive. The type of a value is known from its first byte;
+ * scalars are decoded, and fully validated, by the as*() accessors, which
+ * throw std::runtime_error on malformed tokens. Missing lookups return a
+ * value for which exists() is false and which behaves like null.
+ */
+class JsonLazyValue {
+public:
+    /**
+     * @brief Iterator over array elements (one jump per element)
+     */
+    class ElementIterator {
+    public:
+        ElementIterator(const JsonLazyTape* tape, uint32_t index) : m_tape(tape), m_index(index) {}
+
+        JsonLazyValue operator*() const { return JsonLazyValue(m_tape, m_index); }
+        ElementIterator& operator++() {
+            m_index = m_tape->entries[m_index].next;
+            return *this;
+        }
+        bool operator==(const ElementIterator& other) const { return m_index == other.m_index; }
+        bool operator!=(const ElementIterator& other) const { return m_index != other.m_index; }
+
+    private:
+        const JsonLazyTape* m_tape;
+        uint32_t m_index;
+    };
+
+    /**
+     * @brief Iterator over object members in document order
+     */
+    class MemberIterator {
+    public:
+        MemberIterator(const JsonLazyTape* tape, uint32_t index) : m_tape(tape), m_index(index) {}
+
+        JsonLazyMember operator*() const;
+        MemberIterator& operator++() {
+            m_index = m_tape->entries[m_index + 1].next;
+            return *this;
+        }
+        bool operator==(const MemberIterator& other) const { return m_index == other.m_index; }
+        bool operator!=(const MemberIterator& other) const { return m_index != other.m_index; }
+
+    private:
+        const JsonLazyTape* m_tape;
+        uint32_t m_index;
+    };
+
+    JsonLazyValue() = default;
+    JsonLazyValue(const JsonLazyTape* tape, uint32_t index) : m_tape(tape), m_index(index) {}
+
+    /**
+     * @brief Check whether this handle refers to a value of the document
+     * @return false for the result of a missing lookup
+     */
+    bool exists() const { return m_tape != nullptr; }
+
+    /**
+     * @brief Get the type of this value
+     * @return The JsonType (numbers are decoded to tell integers from floats)
+     */
+    JsonType type() const {
+        switch (first()) {
+            case '{': return JsonType::Object;
+            case '[': return JsonType::Array;
+            case '"': return JsonType::String;
+            case 't': case 'f': return JsonType::Boolean;
+            case 'n': case '\0': return JsonType::Null;
+            default: return decodeNumber().isFloat ? JsonType::Float : JsonType::Integer;
+        }
+    }
+
+    bool isNull() const { return first() == 'n' || first() == '\0'; }
+    bool isBool() const { return first() == 't' || first() == 'f'; }
+    bool isInt() const { return type() == JsonType::Integer; }
+    bool isFloat() const { return type() == JsonType::Float; }
+    bool isNumber() const { return first() == '-' || (first() >= '0' && first() <= '9'); }
+    bool isString() const { return first() == '"'; }
+    bool isArray() const { return first() == '['; }
+    bool isObject() const { return first() == '{'; }
+
+    /**
+     * @brief Get as boolean
+     * @param defaultValue Value to return if this is not a boolean
+     * @return The boolean value or defaultValue
+     */
+    bool asBool(bool defaultValue = false) const {
+        if (!isBool()) return defaultValue;
+        bool value = first() == 't';
+        size_t pos = entry().offset;
+        JsonScanResult res = JsonScanner::matchLiteral(m_tape->input, pos, value ? "true" : "false");
+        if (res.error) m_tape->fail(res.error, res.end);
+        expectTerminator(res.end);
+        return value;
+    }
+
+    /**
+     * @brief Get as integer
+     * @param defaultValue Value to return if this is not a number
+     * @return The integer value (converted from float if needed) or defaultValue
+     */
+    int64_t asInt(int64_t defaultValue = 0) const {
+        if (!isNumber()) return defaultValue;
+        JsonNumber number = decodeNumber();
+        return number.isFloat ? static_cast<int64_t>(number.floatValue) : number.intValue;
+    }
+
+    /**
+     * @brief Get as float
+     * @param defaultValue Value to return if this is not a number
+     * @return The float value (converted from int if needed) or defaultValue
+     */
+    double asFloat(double defaultValue = 0.0) const {
+        if (!isNumber()) return defaultValue;
+        JsonNumber number = decodeNumber();
+        return number.isFloat ? number.floatValue : static_cast<double>(number.intValue);
+    }
+
+    /**
+     * @brief Decode as string
+     * @param defaultValue Value to return if this is not a string
+     * @return The decoded string or defaultValue
+     */
+    std::string asString(std::string_view defaultValue = {}) const {
+        if (!isString()) return std::string(defaultValue);
+        std::string out;
+        JsonScanResult res = JsonScanner::decodeString(m_tape->input, entry().offset, out);
+        if (res.error) m_tape->fail(res.error, res.end);
+        return out;
+    }
+
+    /**
+     * @brief Get array or object size
+     * @return Number of elements or members, 0 for other types
+     */
+    size_t size() const {
+        return (isArray() || isObject()) ? closing().next : 0;
+    }
+
+    /**
+     * @brief Array elements
+     * @return Iterators delimiting the elements (empty for non-arrays)
+     */
+    ElementIterator begin() const {
+        return isArray() ? ElementIterator(m_tape, m_index + 1) : ElementIterator(nullptr, 0);
+    }
+    ElementIterator end() const {
+        return isArray() ? ElementIterator(m_tape, entry().next - 1) : ElementIterator(nullptr, 0);
+    }
+
+    /**
+     * @brief Object members in document order
+     * @return Iterators delimiting the members (empty for non-objects)
+     */
+    MemberIterator membersBegin() const {
+        return isObject() ? MemberIterator(m_tape, m_index + 1) : MemberIterator(nullptr, 0);
+    }
+    MemberIterator membersEnd() const {
+        return isObject() ? MemberIterator(m_tape, entry().next - 1) : MemberIterator(nullptr, 0);
+    }
+
+    /**
+     * @brief Find a member by key
+     * @param key Key to look up
+     * @return The value (the last one for duplicate keys), or a missing value
+     *
+     * Compares keys in place and jumps over member values without touching
+     * them, so the cost is one step per member regardless of their size.
+     */
+    JsonLazyValue find(std::string_view key) const {
+        if (!isObject()) return JsonLazyValue();
+
+        const auto& entries = m_tape->entries;
+        JsonLazyValue found;
+        uint32_t stop = entry().next - 1;
+        for (uint32_t i = m_index + 1; i < stop; i = entries[i + 1].next) {
+            if (keyEquals(entries[i].offset, key)) {
+                found = JsonLazyValue(m_tape, i + 1);
+            }
+        }
+        return found;
+    }
+
+    /**
+     * @brief Check if object has a key
+     * @param key The key to check for
+     * @return true if this is an object and contains the key
+     */
+    bool has(std::string_view key) const { return find(key).exists(); }
+
+    /**
+     * @brief Get member by key
+     * @param key The key to look up
+     * @return The member value, or a missing value
+     */
+    JsonLazyValue operator[](std::string_view key) const { return find(key); }
+    JsonLazyValue operator[](const char* key) const { return find(key); }
+
+    /**
+     * @brief Get element by index
+     * @param index Array index
+     * @return The element, or a missing value if out of bounds or not an array
+     *
+     * Takes one jump per preceding element.
+     */
+    JsonLazyValue operator[](size_t index) const {
+        if (!isArray() || index >= size()) return JsonLazyValue();
+        uint32_t i = m_index + 1;
+        for (size_t skipped = 0; skipped < index; ++skipped) {
+            i = m_tape->entries[i].next;
+        }
+        return JsonLazyValue(m_tape, i);
+    }
+
+    /**
+     * @brief Get the JSON text of this value
+     * @return View into the document input (empty for missing values)
+     */
+    std::string_view rawJson() const {
+        if (!exists()) return {};
+        const JsonTapeEntry& e = entry();
+        std::string_view input = m_tape->input;
+
+        if (isArray() || isObject()) {
+            return input.substr(e.offset, closing().offset - e.offset + 1);
+        }
+
+        size_t pos = e.offset + 1;
+        if (isString()) {
+            while (true) {
+                pos = JsonScanner::findQuoteOrBackslash(input.data(), pos, input.size());
+                if (pos >= input.size()) m_tape->fail("Unterminated string", e.offset);
+                if (input[pos] == '"') break;
+                pos += 2;
+            }
+            return input.substr(e.offset, pos + 1 - e.offset);
+        }
+
+        while (!JsonScanner::isTerminator(m_tape->at(pos))) ++pos;
+        return input.substr(e.offset, pos - e.offset);
+    }
+
+    /**
+     * @brief Decode this value and everything below it into a JsonValue tree
+     * @return Deep copy as JsonValue (null for missing values)
+     * @throws std::runtime_error if the subtree contains a malformed token
+     */
+    JsonValue toJsonValue() const {
+        if (!exists()) return JsonValue();
+        return JsonParser::parse(rawJson());
+    }
+
+    /**
+     * @brief Decode this subtree into an arena document
+     * @return Document holding this value
+     * @throws std::runtime_error if the subtree contains a malformed token
+     */
+    JsonDocument toDocument() const {
+        if (!exists()) return JsonDocument();
+        return JsonDocument::parse(rawJson());
+    }
+
+private:
+    const JsonLazyTape* m_tape = nullptr;
+    uint32_t m_index = 0;
+
+    const JsonTapeEntry& entry() const { return m_tape->entries[m_index]; }
+
+    // Closing entry of a container
+    const JsonTapeEntry& closing() const { return m_tape->entries[entry().next - 1]; }
+
+    char first() const {
+        return m_tape ? m_tape->at(entry().offset) : '\0';
+    }
+
+    void expectTerminator(size_t end) const {
+        if (!JsonScanner::isTerminator(m_tape->at(end))) {
+            m_tape->fail("Unexpected character '" + std::string(1, m_tape->at(end)) + "'", end);
+        }
+    }
+
+    JsonNumber decodeNumber() const {
+        JsonNumber number;
+        JsonScanResult res = JsonScanner::decodeNumber(m_tape->input, entry().offset, number);
+        if (res.error) m_tape->fail(res.error, res.end);
+        expectTerminator(res.end);
+        return number;
+    }
+
+    bool keyEquals(uint32_t offset, std::string_view key) const {
+        std::string_view input = m_tape->input;
+        size_t start = offset + 1;
+        size_t stop = JsonScanner::findQuoteOrBackslash(input.data(), start, input.size());
+        if (stop < input.size() && input[stop] == '"') {
+            return input.substr(start, stop - start) == key;
+        }
+
+        // Escaped (or unterminated) key: decode it to compare
+        std::string decoded;
+        JsonScanResult res = JsonScanner::decodeString(input, offset, decoded);
+        if (res.error) m_tape->fail(res.error, res.end);
+        return decoded == key;
+    }
+};
+
+/**
+ * @brief Key/value pair of a lazy object
+ */
+struct JsonLazyMember {
+    JsonLazyValue key;    ///< String value holding the key (decode with asString())
+    JsonLazyValue value;
+};
+
+inline JsonLazyMember JsonLazyValue::MemberIterator::operator*() const {
+    return {JsonLazyValue(m_tape, m_index), JsonLazyValue(m_tape, m_index + 1)};
+}
+
+/**
+ * @brief JSON document indexed up front and decoded on demand
+ *
+ * Features:
+ * - Single structural pass over the SIMD index; brackets, commas, colons
+ *   and key positions are validated before parse() returns
+ * - 8 bytes of tape per value; no strings or numbers are decoded up front
+ * - Untouched subtrees skipped in O(1) via stored end positions
+ * - Subtrees can be materialized as JsonValue or JsonDocument on demand
+ *
+ * Scalar tokens are only checked for a valid first byte while indexing;
+ * their full validation happens when they are accessed. Use JsonDocument
+ * or JsonParser when the whole input has to be verified eagerly.
+ *
+ * Example:
+ * @code
+ * auto doc = JsonLazyDocument::parseFile("huge.json");
+ * int64_t port = doc.root()["network"]["port"].asInt(8080);
+ * @endcode
+ */
+class JsonLazyDocument {
+private:
+    std::unique_ptr<JsonLazyTape> m_tape;
+
+    /**
+     * @brief Builds the tape from the structural index
+     */
+    class TapeBuilder {
+    public:
+        TapeBuilder(JsonLazyTape& tape) : m_tape(tape) {}
+
+        void build() {
+            JsonScanner::index(m_tape.input, m_index);
+
+            // Every structural except ':' and ',' becomes exactly one entry
+            size_t separators = 0;
+            for (uint32_t pos : m_index) {
+                char c = m_tape.input[pos];
+                separators += (c == ':' || c == ',');
+            }
+            m_tape.entries.reserve(m_index.size() - separators + 1);
+
+            size_t pos = nextStructural();
+            while (true) {
+                // Parse the value starting at pos
+                char c = m_tape.at(pos);
+                if (c == '{' || c == '[') {
+                    m_stack.push_back(static_cast<uint32_t>(m_tape.entries.size()));
+                    m_stack.push_back(0);
+                    m_tape.entries.push_back({static_cast<uint32_t>(pos), 0});
+
+                    pos = nextStructural();
+                    if (m_tape.at(pos) == closer(c)) {
+                        closeContainer(pos);
+                    } else {
+                        if (c == '{') pos = parseKey(pos);
+                        continue;
+                    }
+                } else {
+                    addScalar(pos);
+                }
+
+                // Value complete: consume separators and closing brackets
+                while (!m_stack.empty()) {
+                    ++m_stack.back();
+                    pos = nextStructural();
+                    char open = m_tape.at(m_tape.entries[m_stack[m_stack.size() - 2]].offset);
+                    if (m_tape.at(pos) == ',') {
+                        pos = nextStructural();
+                        if (open == '{') pos = parseKey(pos);
+                        break;
+                    }
+                    if (m_tape.at(pos) != closer(open)) {
+                        m_tape.fail(open == '{' ? "Expected ',' or '}'" : "Expected ',' or ']'", pos);
+                    }
+                    closeContainer(pos);
+                }
+                if (m_stack.empty()) return;
+            }
+        }
+
+    private:
+        JsonLazyTape& m_tape;
+        std::vector<uint32_t> m_index;
+        std::vector<uint32_t> m_stack;  // (tape index, child count) of each open container
+        size_t m_next = 0;
+
+        static char closer(char open) { return open == '{' ? '}' : ']'; }
+
+        size_t nextStructural() {
+            if (m_next < m_index.size()) return m_index[m_next++];
+            return m_tape.input.size();
+        }
+
+        void addScalar(size_t pos) {
+            switch (m_tape.at(pos)) {
+                case '"': case 't': case 'f': case 'n': case '-':
+                case '0': case '1': case '2': case '3': case '4':
+                case '5': case '6': case '7': case '8': case '9':
+                    break;
+                default:
+                    if (pos >= m_tape.input.size()) m_tape.fail("Unexpected end of input", pos);
+                    m_tape.fail("Unexpected character '" + std::string(1, m_tape.at(pos)) + "'", pos);
+            }
+            uint32_t index = static_cast<uint32_t>(m_tape.entries.size());
+            m_tape.entries.push_back({static_cast<uint32_t>(pos), index + 1});
+        }
+
+        size_t parseKey(size_t pos) {
+            if (m_tape.at(pos) != '"') m_tape.fail("Expected '\"'", pos);
+            addScalar(pos);
+            pos = nextStructural();
+            if (m_tape.at(pos) != ':') m_tape.fail("Expected ':'", pos);
+            return nextStructural();
+        }
+
+        void closeContainer(size_t pos) {
+            uint32_t count = m_stack.back();
+            uint32_t open = m_stack[m_stack.size() - 2];
+            m_stack.resize(m_stack.size() - 2);
+            m_tape.entries.push_back({static_cast<uint32_t>(pos), count});
+            m_tape.entries[open].next = static_cast<uint32_t>(m_tape.entries.size());
+        }
+    };
+
+    void build() {
+        TapeBuilder builder(*m_tape);
+        builder.build();
+    }
+
+public:
+    JsonLazyDocument() = default;
+    JsonLazyDocument(JsonLazyDocument&&) noexcept = default;
+    JsonLazyDocument& operator=(JsonLazyDocument&&) noexcept = default;
+
+    // Non-copyable
+    JsonLazyDocument(const JsonLazyDocument&) = delete;
+    JsonLazyDocument& operator=(const JsonLazyDocument&) = delete;
+
+    /**
+     * @brief Index JSON text, taking ownership of it
+     * @param json JSON text
+     * @return The indexed document
+     * @throws std::runtime_error if the structure is invalid
+     */
+    static JsonLazyDocument parse(std::string json) {
+        JsonLazyDocument doc;
+        doc.m_tape = std::make_unique<JsonLazyTape>();
+        doc.m_tape->storage = std::move(json);
+        doc.m_tape->input = doc.m_tape->storage;
+        doc.build();
+        return doc;
+    }
+
+    /**
+     * @brief Index JSON text without copying it
+     * @param json JSON text; must outlive the document and all its values
+     * @return The indexed document
+     * @throws std::runtime_error if the structure is invalid
+     */
+    static JsonLazyDocument parseView(std::string_view json) {
+        JsonLazyDocument doc;
+        doc.m_tape = std::make_unique<JsonLazyTape>();
+        doc.m_tape->input = json;
+        doc.build();
+        return doc;
+    }
+
+    /**
+     * @brief Read and index a JSON file
+     * @param filename Path to the JSON file
+     * @return The indexed document
+     * @throws std::runtime_error if the file cannot be read or the structure is invalid
+     */
+    static JsonLazyDocument parseFile(const std::string& filename) {
+        std::ifstream file(filename, std::ios::binary);
+        if (!file.is_open()) {
+            throw std::runtime_error("Failed to open file: " + filename);
+        }
+
+        std::string content;
+        file.seekg(0, std::ios::end);
+        std::streamoff size = file.tellg();
+        file.seekg(0, std::ios::beg);
+        if (size > 0) {
+            content.resize(static_cast<size_t>(size));
+            file.read(&content[0], size);
+            content.resize(static_cast<size_t>(file.gcount()));
+        }
+        return parse(std::move(content));
+    }
+
+    /**
+     * @brief Get the root value
+     * @return Handle to the root (missing for default-constructed documents)
+     */
+    JsonLazyValue root() const {
+        return m_tape ? JsonLazyValue(m_tape.get(), 0) : JsonLazyValue();
+    }
+
+    /**
+     * @brief Get the number of values on the tape (object keys included)
+     * @return Tape entry count
+     */
+    size_t tapeSize() const { return m_tape ? m_tape->entries.size() : 0; }
+
+    /**
+     * @brief Get memory used by the tape (excluding the input text)
+     * @return Bytes reserved for tape entries
+     */
+    size_t memoryUsage() const {
+        return m_tape ? m_tape->entries.capacity() * sizeof(JsonTapeEntry) : 0;
+    }
+};
+
+} // namespace mcf
@@ -1,278 +1,207 @@
 #pragma once
 
+#include "JsonScanner.hpp"
+#include "MappedFile.hpp"
 #include "JsonValue.hpp"
+#include "JsonWriter.hpp"
 
-#include <cctype>
 #include <fstream>
-#include <sstream>
 #include <stdexcept>
 #include <string>
+#include <string_view>
+#include <vector>
 
 namespace mcf {
 
 /**
- * @brief Simple JSON parser
+ * @brief JSON parser
  *
- * Provides basic JSON parsing capabilities:
+ * Two-stage parser:
+ * - Stage one (JsonScanner) indexes structural characters 64 bytes at a time
+ * - Stage two walks the index and builds JsonValue trees, copying string runs
+ *   in bulk and decoding numbers with std::from_chars
+ *
+ * Provides:
  * - Parse from string
  * - Parse from file
  * - Support for all JSON types
- * - Error reporting with position
+ * - Error reporting with position (line/column computed only on error)
  */
 class JsonParser {
 private:
-    std::string m_input;
-    size_t m_pos = 0;
-    int m_line = 1;
-    int m_column = 1;
+    std::string_view m_input;
+    std::vector<uint32_t> m_index;
+    size_t m_next = 0;
 
     /**
-     * @brief Skip whitespace characters
+     * @brief Throw a parse error located at an input offset
      */
-    void skipWhitespace() {
-        while (m_pos < m_input.size()) {
-            char c = m_input[m_pos];
-            if (c == ' ' || c == '\t' || c == '\r') {
-                m_pos++;
-                m_column++;
-            } else if (c == '\n') {
-                m_pos++;
-                m_line++;
-                m_column = 1;
-            } else {
-                break;
-            }
-        }
+    [[noreturn]] void fail(const std::string& what, size_t pos) const {
+        throw std::runtime_error(JsonScanner::formatError(m_input, what, pos));
     }
 
     /**
-     * @brief Peek at current character without consuming
+     * @brief Character at an offset, '\0' past the end
      */
-    char peek() const {
-        if (m_pos >= m_input.size()) return '\0';
-        return m_input[m_pos];
+    char at(size_t pos) const {
+        return pos < m_input.size() ? m_input[pos] : '\0';
     }
 
     /**
-     * @brief Consume and return current character
+     * @brief Consume the next structural offset (input size at the end)
      */
-    char consume() {
-        if (m_pos >= m_input.size()) return '\0';
-        char c = m_input[m_pos++];
-        m_column++;
-        return c;
+    size_t nextStructural() {
+        if (m_next < m_index.size()) {
+            return m_index[m_next++];
+        }
+        return m_input.size();
     }
 
     /**
-     * @brief Expect and consume a specific character
+     * @brief Expect and consume a specific structural character
      */
     void expect(char expected) {
-        char c = consume();
-        if (c != expected) {
-            throw std::runtime_error("Expected '" + std::string(1, expected) +
-                "' at line " + std::to_string(m_line) +
-                ", column " + std::to_string(m_column));
+        size_t pos = nextStructural();
+        if (at(pos) != expected) {
+            fail("Expected '" + std::string(1, expected) + "'", pos);
         }
     }
 
     /**
-     * @brief Parse a JSON value
+     * @brief Check that a scalar ends on a delimiter
      */
-    JsonValue parseValue() {
-        skipWhitespace();
-        char c = peek();
-
-        if (c == '{') return parseObject();
-        if (c == '[') return parseArray();
-        if (c == '"') return parseString();
-        if (c == 't' || c == 'f') return parseBoolean();
-        if (c == 'n') return parseNull();
-        if (c == '-' || std::isdigit(c)) return parseNumber();
-
-        throw std::runtime_error("Unexpected character '" + std::string(1, c) +
-            "' at line " + std::to_string(m_line) +
-            ", column " + std::to_string(m_column));
+    void expectTerminator(size_t end) const {
+        if (!JsonScanner::isTerminator(at(end))) {
+            fail("Unexpected character '" + std::string(1, at(end)) + "'", end);
+        }
     }
 
     /**
-     * @brief Parse null value
+     * @brief Parse the JSON value starting at a structural offset
      */
-    JsonValue parseNull() {
-        expect('n');
-        expect('u');
-        expect('l');
-        expect('l');
-        return JsonValue(nullptr);
+    JsonValue parseValue(size_t pos) {
+        char c = at(pos);
+
+        switch (c) {
+            case '{': return parseObject();
+            case '[': return parseArray();
+            case '"': return JsonValue(parseString(pos));
+            case 't': parseLiteral(pos, "true"); return JsonValue(true);
+            case 'f': parseLiteral(pos, "false"); return JsonValue(false);
+            case 'n': parseLiteral(pos, "null"); return JsonValue(nullptr);
+            case '-': case '0': case '1': case '2': case '3': case '4':
+            case '5': case '6': case '7': case '8': case '9':
+                return parseNumber(pos);
+            default:
+                break;
+        }
+
+        if (pos >= m_input.size()) {
+            fail("Unexpected end of input", pos);
+        }
+        fail("Unexpected character '" + std::string(1, c) + "'", pos);
     }
 
     /**
-     * @brief Parse boolean value
+     * @brief Parse a literal (true, false, null)
      */
-    JsonValue parseBoolean() {
-        if (peek() == 't') {
-            expect('t');
-            expect('r');
-            expect('u');
-            expect('e');
-            return JsonValue(true);
-        } else {
-            expect('f');
-            expect('a');
-            expect('l');
-            expect('s');
-            expect('e');
-            return JsonValue(false);
+    void parseLiteral(size_t pos, std::string_view literal) {
+        JsonScanResult res = JsonScanner::matchLiteral(m_input, pos, literal);
+        if (res.error) {
+            fail(std::string(res.error) + " (expected '" + std::string(literal) + "')", res.end);
         }
+        expectTerminator(res.end);
     }
 
     /**
      * @brief Parse number (integer or float)
      */
-    JsonValue parseNumber() {
-        std::string numStr;
-        bool isFloat = false;
-
-        // Handle negative sign
-        if (peek() == '-') {
-            numStr += consume();
+    JsonValue parseNumber(size_t pos) {
+        JsonNumber number;
+        JsonScanResult res = JsonScanner::decodeNumber(m_input, pos, number);
+        if (res.error) {
+            fail(res.error, res.end);
         }
+        expectTerminator(res.end);
 
-        // Parse digits
-        while (std::isdigit(peek())) {
-            numStr += consume();
-        }
-
-        // Check for decimal point
-        if (peek() == '.') {
-            isFloat = true;
-            numStr += consume();
-            while (std::isdigit(peek())) {
-                numStr += consume();
-            }
-        }
-
-        // Check for exponent
-        if (peek() == 'e' || peek() == 'E') {
-            isFloat = true;
-            numStr += consume();
-            if (peek() == '+' || peek() == '-') {
-                numStr += consume();
-            }
-            while (std::isdigit(peek())) {
-                numStr += consume();
-            }
-        }
-
-        if (isFloat) {
-            return JsonValue(std::stod(numStr));
-        } else {
-            return JsonValue(static_cast<int64_t>(std::stoll(numStr)));
+        if (number.isFloat) {
+            return JsonValue(number.floatValue);
         }
+        return JsonValue(number.intValue);
     }
 
     /**
-     * @brief Parse string value
+     * @brief Parse string value starting at its opening quote
      */
-    JsonValue parseString() {
-        expect('"');
+    std::string parseString(size_t pos) {
         std::string str;
-
-        while (peek() != '"' && peek() != '\0') {
-            char c = consume();
-            if (c == '\\') {
-                char escaped = consume();
-                switch (escaped) {
-                    case '"': str += '"'; break;
-                    case '\\': str += '\\'; break;
-                    case '/': str += '/'; break;
-                    case 'b': str += '\b'; break;
-                    case 'f': str += '\f'; break;
-                    case 'n': str += '\n'; break;
-                    case 'r': str += '\r'; break;
-                    case 't': str += '\t'; break;
-                    default:
-                        throw std::runtime_error("Invalid escape sequence at line " +
-                            std::to_string(m_line) + ", column " + std::to_string(m_column));
-                }
-            } else {
-                str += c;
-            }
+        JsonScanResult res = JsonScanner::decodeString(m_input, pos, str);
+        if (res.error) {
+            fail(res.error, res.end);
         }
-
-        expect('"');
-        return JsonValue(str);
+        return str;
     }
 
     /**
-     * @brief Parse array value
+     * @brief Parse array value (opening bracket already consumed)
      */
     JsonValue parseArray() {
-        expect('[');
-        skipWhitespace();
-
         JsonArray arr;
 
-        if (peek() == ']') {
-            consume();
-            return JsonValue(arr);
+        size_t pos = nextStructural();
+        if (at(pos) == ']') {
+            return JsonValue(std::move(arr));
         }
 
         while (true) {
-            arr.push_back(parseValue());
-            skipWhitespace();
+            arr.push_back(parseValue(pos));
 
-            if (peek() == ']') {
-                consume();
+            pos = nextStructural();
+            if (at(pos) == ']') {
                 break;
             }
-
-            expect(',');
-            skipWhitespace();
+            if (at(pos) != ',') {
+                fail("Expected ',' or ']'", pos);
+            }
+            pos = nextStructural();
         }
 
-        return JsonValue(arr);
+        return JsonValue(std::move(arr));
     }
 
     /**
-     * @brief Parse object value
+     * @brief Parse object value (opening brace already consumed)
      */
     JsonValue parseObject() {
-        expect('{');
-        skipWhitespace();
-
         JsonObject obj;
 
-        if (peek() == '}') {
-            consume();
-            return JsonValue(obj);
+        size_t pos = nextStructural();
+        if (at(pos) == '}') {
+            return JsonValue(std::move(obj));
         }
 
         while (true) {
-            skipWhitespace();
-
-            // Parse key
-            JsonValue keyValue = parseString();
-            std::string key = keyValue.asString();
+            if (at(pos) != '"') {
+                fail("Expected '\"'", pos);
+            }
+            std::string key = parseString(pos);
 
-            skipWhitespace();
             expect(':');
-            skipWhitespace();
-
-            // Parse value
-            JsonValue value = parseValue();
-            obj[key] = value;
 
-            skipWhitespace();
+            JsonValue value = parseValue(nextStructural());
+            obj.insert_or_assign(std::move(key), std::move(value));
 
-            if (peek() == '}') {
-                consume();
+            pos = nextStructural();
+            if (at(pos) == '}') {
                 break;
             }
-
-            expect(',');
+            if (at(pos) != ',') {
+                fail("Expected ',' or '}'", pos);
+            }
+            pos = nextStructural();
         }
 
-        return JsonValue(obj);
+        return JsonValue(std::move(obj));
     }
 
 public:
@@ -282,15 +211,13 @@ public:
      * @return JsonValue containing the parsed JSON data
      * @throws std::runtime_error if parsing fails
      */
-    static JsonValue parse(const std::string& json) {
+    static JsonValue parse(std::string_view json) {
         JsonParser parser;
         parser.m_input = json;
-        parser.m_pos = 0;
-        parser.m_line = 1;
-        parser.m_column = 1;
 
         try {
-            return parser.parseValue();
+            JsonScanner::index(json, parser.m_index);
+            return parser.parseValue(parser.nextStructural());
         } catch (const std::exception& e) {
             throw std::runtime_error(std::string("JSON parse error: ") + e.what());
         }
@@ -301,32 +228,70 @@ public:
      * @param filename Path to the JSON file to parse
      * @return JsonValue containing the parsed JSON data
      * @throws std::runtime_error if file cannot be opened or parsing fails
+     *
+     * The file is read into a buffer, so it may be rewritten in place while
+     * it is parsed. Use parseMappedFile() for large files that are only
+     * replaced by rename.
      */
     static JsonValue parseFile(const std::string& filename) {
-        std::ifstream file(filename);
+        std::ifstream file(filename, std::ios::binary);
+        if (!file.is_open()) {
+            throw std::runtime_error("Failed to open file: " + filename);
+        }
+
+        std::string content;
+        file.seekg(0, std::ios::end);
+        std::streamoff size = file.tellg();
+        file.seekg(0, std::ios::beg);
+        if (size > 0) {
+            content.resize(static_cast<size_t>(size));
+            file.read(&content[0], size);
+            content.resize(static_cast<size_t>(file.gcount()));
+        }
+        return parse(content);
+    }
+
+    /**
+     * @brief Parse JSON from a file mapped into memory
+     * @param filename Path to the JSON file to parse
+     * @return JsonValue containing the parsed JSON data
+     * @throws std::runtime_error if file cannot be opened or parsing fails
+     *
+     * Files of MappedFile::MinimumMapSize and more are parsed from a
+     * read-only mapping instead of being copied into a buffer. The file must
+     * not be truncated meanwhile (see MappedFile): use this only for files
+     * that are replaced by rename, like those JsonWriter::writeFileAtomic()
+     * writes, or never written.
+     */
+    static JsonValue parseMappedFile(const std::string& filename) {
+        std::ifstream file(filename, std::ios::binary);
         if (!file.is_open()) {
             throw std::runtime_error("Failed to open file: " + filename);
         }
 
-        std::stringstream buffer;
-        buffer << file.rdbuf();
-        return parse(buffer.str());
+        file.seekg(0, std::ios::end);
+        std::streamoff size = file.tellg();
+        if (size < static_cast<std::streamoff>(MappedFile::MinimumMapSize)) {
+            file.close();
+            return parseFile(filename);  // Mapping small files costs more than copying them
+        }
+
+        // Parse in place; both passes read the whole file, so fetch it all
+        file.close();
+        MappedFile mapped(filename, MapMode::ReadOnly, MapOptions{MapAdvice::WillNeed, false});
+        return parse(mapped.view());
     }
 
     /**
      * @brief Write JSON to file
      * @param filename Path to the file where JSON will be written
      * @param value JsonValue to write to the file
-     * @return true if write succeeded, false if file cannot be opened
+     * @return true if write succeeded, false if file cannot be opened or written
+     *
+     * Writes pretty-printed, escaped JSON through JsonWriter.
      */
     static bool writeFile(const std::string& filename, const JsonValue& value) {
-        std::ofstream file(filename);
-        if (!file.is_open()) {
-            return false;
-        }
-
-        file << value.toString(0);
-        return true;
+        return JsonWriter::writeFile(filename, value, JsonWriter::Style::Pretty);
     }
 };
 
@@ -0,0 +1,630 @@
+/**
+ * @file JsonPatch.hpp
+ * @brief Structural JSON diff and RFC 6902 JSON Patch
+ *
+ * JsonPatch::diff() compares two JsonValue trees and produces the
+ * operations turning one into the other; JsonPatch::apply() replays them.
+ * Patches are small compared to full documents, so they are what config
+ * reloads use to find changed keys and what gets sent to remote nodes.
+ */
+
+#pragma once
+
+#include "JsonValue.hpp"
+
+#include <algorithm>
+#include <cstddef>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace mcf {
+
+/**
+ * @brief JSON Pointer (RFC 6901) helpers
+ */
+class JsonPointer {
+public:
+    /**
+     * @brief Escape a reference token ("~" -> "~0", "/" -> "~1")
+     * @param token Object key or array index
+     * @param out Receives the escaped token (appended)
+     */
+    static void appendToken(std::string_view token, std::string& out) {
+        for (char c : token) {
+            if (c == '~') {
+                out += "~0";
+            } else if (c == '/') {
+                out += "~1";
+            } else {
+                out += c;
+            }
+        }
+    }
+
+    /**
+     * @brief Split a pointer into unescaped reference tokens
+     * @param pointer JSON Pointer ("" is the whole document)
+     * @return Reference tokens
+     * @throws std::runtime_error if the pointer is malformed
+     */
+    static std::vector<std::string> parse(std::string_view pointer) {
+        std::vector<std::string> tokens;
+        if (pointer.empty()) {
+            return tokens;
+        }
+        if (pointer[0] != '/') {
+            throw std::runtime_error("JSON pointer must start with '/': " + std::string(pointer));
+        }
+
+        std::string token;
+        for (size_t i = 1; i <= pointer.size(); ++i) {
+            if (i == pointer.size() || pointer[i] == '/') {
+                tokens.push_back(std::move(token));
+                token.clear();
+            } else if (pointer[i] == '~') {
+                char next = i + 1 < pointer.size() ? pointer[i + 1] : '\0';
+                if (next != '0' && next != '1') {
+                    throw std::runtime_error("Invalid escape in JSON pointer: " + std::string(pointer));
+                }
+                token += next == '0' ? '~' : '/';
+                ++i;
+            } else {
+                token += pointer[i];
+            }
+        }
+        return tokens;
+    }
+
+    /**
+     * @brief Build a pointer from reference tokens
+     * @param tokens Unescaped tokens
+     * @return JSON Pointer
+     */
+    static std::string join(const std::vector<std::string>& tokens) {
+        std::string pointer;
+        for (const auto& token : tokens) {
+            pointer += '/';
+            appendToken(token, pointer);
+        }
+        return pointer;
+    }
+
+    /**
+     * @brief Parse an array index token
+     * @param token Decimal index without leading zeros
+     * @param index Receives the index
+     * @return false if the token is not a valid index
+     */
+    static bool parseIndex(const std::string& token, size_t& index) {
+        if (token.empty() || token.size() > 18 || (token.size() > 1 && token[0] == '0')) {
+            return false;
+        }
+        index = 0;
+        for (char c : token) {
+            if (c < '0' || c > '9') return false;
+            index = index * 10 + static_cast<size_t>(c - '0');
+        }
+        return true;
+    }
+
+    /**
+     * @brief Look up the value a pointer refers to
+     * @param root Document
+     * @param tokens Reference tokens
+     * @return Pointer to the value, or nullptr if it does not exist
+     */
+    static const JsonValue* resolve(const JsonValue& root, const std::vector<std::string>& tokens) {
+        const JsonValue* current = &root;
+        for (const auto& token : tokens) {
+            if (current->isObject()) {
+                const auto& obj = current->asObject();
+                auto it = obj.find(token);
+                if (it == obj.end()) return nullptr;
+                current = &it->second;
+            } else if (current->isArray()) {
+                size_t index = 0;
+                const auto& arr = current->asArray();
+                if (!parseIndex(token, index) || index >= arr.size()) return nullptr;
+                current = &arr[index];
+            } else {
+                return nullptr;
+            }
+        }
+        return current;
+    }
+};
+
+/**
+ * @brief JSON Patch operation kinds
+ */
+enum class JsonPatchOp {
+    Add,
+    Remove,
+    Replace,
+    Move,
+    Copy,
+    Test
+};
+
+/**
+ * @brief One JSON Patch operation
+ */
+struct JsonPatchOperation {
+    JsonPatchOp op = JsonPatchOp::Add;
+    std::string path;  ///< Target (JSON Pointer)
+    std::string from;  ///< Source for Move and Copy
+    JsonValue value;   ///< Value for Add, Replace and Test
+};
+
+/**
+ * @brief Sequence of JSON Patch operations
+ *
+ * Features:
+ * - diff() in time linear in document size: objects are merged in key
+ *   order, arrays trimmed of their common prefix and suffix so insertions
+ *   and deletions produce single operations, and subtrees still shared
+ *   between both trees are skipped without being visited
+ * - apply() copies only the containers on modified paths (each at most
+ *   once per patch) and leaves the input untouched, so a failing patch
+ *   never produces a half-applied document
+ * - Conversion to and from the RFC 6902 JSON representation
+ *
+ * Integers and floats compare as different types, so a diff preserves the
+ * number representation of the target document.
+ *
+ * Usage:
+ * @code
+ * JsonPatch patch = JsonPatch::diff(oldConfig, newConfig);
+ * for (const auto& op : patch.operations()) { ... }
+ * JsonValue updated = patch.apply(oldConfig);  // equals newConfig
+ * @endcode
+ */
+class JsonPatch {
+public:
+    JsonPatch() = default;
+
+    /**
+     * @brief Create a patch from operations
+     * @param operations Operations in application order
+     */
+    explicit JsonPatch(std::vector<JsonPatchOperation> operations)
+        : m_operations(std::move(operations)) {}
+
+    /**
+     * @brief Compute the operations turning one document into another
+     * @param from Source document
+     * @param to Target document
+     * @return Patch such that diff(from, to).apply(from) equals to
+     */
+    static JsonPatch diff(const JsonValue& from, const JsonValue& to) {
+        JsonPatch patch;
+        std::string path;
+        diffValues(from, to, path, patch.m_operations);
+        return patch;
+    }
+
+    /**
+     * @brief Apply the patch to a document
+     * @param document Input document (not modified)
+     * @return The patched document
+     * @throws std::runtime_error if an operation fails (missing path, failed test, ...)
+     */
+    JsonValue apply(const JsonValue& document) const {
+        Applier applier(document);
+        for (const auto& operation : m_operations) {
+            applier.apply(operation);
+        }
+        return applier.result();
+    }
+
+    /**
+     * @brief Deep structural equality
+     * @param a First value
+     * @param b Second value
+     * @return true if both have the same type and contents
+     */
+    static bool equals(const JsonValue& a, const JsonValue& b) {
+        if (a.type() != b.type()) return false;
+
+        switch (a.type()) {
+            case JsonType::Null: return true;
+            case JsonType::Boolean: return a.asBool() == b.asBool();
+            case JsonType::Integer: return a.asInt() == b.asInt();
+            case JsonType::Float: return a.asFloat() == b.asFloat();
+            case JsonType::String: return a.asStringRef() == b.asStringRef();
+            case JsonType::Array: {
+                const auto& x = a.asArray();
+                const auto& y = b.asArray();
+                if (&x == &y) return true;
+                if (x.size() != y.size()) return false;
+                for (size_t i = 0; i < x.size(); ++i) {
+                    if (!equals(x[i], y[i])) return false;
+                }
+                return true;
+            }
+            case JsonType::Object: {
+                const auto& x = a.asObject();
+                const auto& y = b.asObject();
+                if (&x == &y) return true;
+                if (x.size() != y.size()) return false;
+                for (auto i = x.begin(), j = y.begin(); i != x.end(); ++i, ++j) {
+                    if (i->first != j->first || !equals(i->second, j->second)) return false;
+                }
+                return true;
+            }
+        }
+        return false;
+    }
+
+    /**
+     * @brief Get the operations
+     */
+    const std::vector<JsonPatchOperation>& operations() const { return m_operations; }
+
+    /**
+     * @brief Append an operation
+     */
+    void add(JsonPatchOperation operation) { m_operations.push_back(std::move(operation)); }
+
+    /**
+     * @brief Check whether the patch has no operations
+     */
+    bool empty() const { return m_operations.empty(); }
+
+    /**
+     * @brief Get the number of operations
+     */
+    size_t size() const { return m_operations.size(); }
+
+    /**
+     * @brief Convert to the RFC 6902 JSON representation
+     * @return Array of operation objects
+     */
+    JsonValue toJson() const {
+        JsonArray ops;
+        ops.reserve(m_operations.size());
+        for (const auto& operation : m_operations) {
+            JsonObject obj;
+            obj["op"] = JsonValue(opName(operation.op));
+            obj["path"] = JsonValue(operation.path);
+            if (operation.op == JsonPatchOp::Move || operation.op == JsonPatchOp::Copy) {
+                obj["from"] = JsonValue(operation.from);
+            }
+            if (operation.op == JsonPatchOp::Add || operation.op == JsonPatchOp::Replace ||
+                operation.op == JsonPatchOp::Test) {
+                obj["value"] = operation.value;
+            }
+            ops.push_back(JsonValue(std::move(obj)));
+        }
+        return JsonValue(std::move(ops));
+    }
+
+    /**
+     * @brief Read a patch from its RFC 6902 JSON representation
+     * @param json Array of operation objects
+     * @return The patch
+     * @throws std::runtime_error if the representation is invalid
+     */
+    static JsonPatch fromJson(const JsonValue& json) {
+        if (!json.isArray()) {
+            throw std::runtime_error("JSON patch error: Expected an array of operations");
+        }
+
+        JsonPatch patch;
+        for (const auto& item : json.asArray()) {
+            if (!item.isObject() || !item["op"].isString() || !item["path"].isString()) {
+                throw std::runtime_error("JSON patch error: Operation needs string 'op' and 'path'");
+            }
+
+            JsonPatchOperation operation;
+            operation.op = parseOpName(item["op"].asStringRef());
+            operation.path = item["path"].asStringRef();
+            JsonPointer::parse(operation.path);
+
+            if (operation.op == JsonPatchOp::Move || operation.op == JsonPatchOp::Copy) {
+                if (!item["from"].isString()) {
+                    throw std::runtime_error("JSON patch error: '" + item["op"].asStringRef() +
+                                             "' needs a string 'from'");
+                }
+                operation.from = item["from"].asStringRef();
+                JsonPointer::parse(operation.from);
+            }
+            if (operation.op == JsonPatchOp::Add || operation.op == JsonPatchOp::Replace ||
+                operation.op == JsonPatchOp::Test) {
+                if (!item.has("value")) {
+                    throw std::runtime_error("JSON patch error: '" + item["op"].asStringRef() +
+                                             "' needs a 'value'");
+                }
+                operation.value = item["value"];
+            }
+            patch.m_operations.push_back(std::move(operation));
+        }
+        return patch;
+    }
+
+    /**
+     * @brief Get the JSON name of an operation kind
+     */
+    static const char* opName(JsonPatchOp op) {
+        switch (op) {
+            case JsonPatchOp::Add: return "add";
+            case JsonPatchOp::Remove: return "remove";
+            case JsonPatchOp::Replace: return "replace";
+            case JsonPatchOp::Move: return "move";
+            case JsonPatchOp::Copy: return "copy";
+            case JsonPatchOp::Test: return "test";
+        }
+        return "add";
+    }
+
+private:
+    std::vector<JsonPatchOperation> m_operations;
+
+    static JsonPatchOp parseOpName(const std::string& name) {
+        for (JsonPatchOp op : {JsonPatchOp::Add, JsonPatchOp::Remove, JsonPatchOp::Replace,
+                               JsonPatchOp::Move, JsonPatchOp::Copy, JsonPatchOp::Test}) {
+            if (name == opName(op)) return op;
+        }
+        throw std::runtime_error("JSON patch error: Unknown operation '" + name + "'");
+    }
+
+    static void emit(std::vector<JsonPatchOperation>& ops, JsonPatchOp op, const std::string& path,
+                     const JsonValue& value = JsonValue()) {
+        JsonPatchOperation operation;
+        operation.op = op;
+        operation.path = path;
+        operation.value = value;
+        ops.push_back(std::move(operation));
+    }
+
+    /**
+     * @brief Append "/<token>" to a path, returning the previous length
+     */
+    static size_t pushToken(std::string& path, std::string_view token) {
+        size_t length = path.size();
+        path += '/';
+        JsonPointer::appendToken(token, path);
+        return length;
+    }
+
+    static void diffValues(const JsonValue& a, const JsonValue& b, std::string& path,
+                           std::vector<JsonPatchOperation>& ops) {
+        if (a.type() != b.type()) {
+            emit(ops, JsonPatchOp::Replace, path, b);
+            return;
+        }
+
+        if (a.isObject()) {
+            diffObjects(a.asObject(), b.asObject(), path, ops);
+        } else if (a.isArray()) {
+            diffArrays(a.asArray(), b.asArray(), path, ops);
+        } else if (!equals(a, b)) {
+            emit(ops, JsonPatchOp::Replace, path, b);
+        }
+    }
+
+    static void diffObjects(const JsonObject& a, const JsonObject& b, std::string& path,
+                            std::vector<JsonPatchOperation>& ops) {
+        if (&a == &b) return;
+
+        // Both maps are sorted by key: one merge pass finds removed, added and common keys
+        auto i = a.begin();
+        auto j = b.begin();
+        while (i != a.end() || j != b.end()) {
+            bool onlyInA = j == b.end() || (i != a.end() && i->first < j->first);
+            bool onlyInB = i == a.end() || (j != b.end() && j->first < i->first);
+
+            if (onlyInA) {
+                size_t length = pushToken(path, i->first);
+                emit(ops, JsonPatchOp::Remove, path);
+                path.resize(length);
+                ++i;
+            } else if (onlyInB) {
+                size_t length = pushToken(path, j->first);
+                emit(ops, JsonPatchOp::Add, path, j->second);
+                path.resize(length);
+                ++j;
+            } else {
+                size_t length = pushToken(path, i->first);
+                diffValues(i->second, j->second, path, ops);
+                path.resize(length);
+                ++i;
+                ++j;
+            }
+        }
+    }
+
+    static void diffArrays(const JsonArray& a, const JsonArray& b, std::string& path,
+                           std::vector<JsonPatchOperation>& ops) {
+        if (&a == &b) return;
+
+        // Trim the common prefix and suffix so a single insertion or deletion
+        // does not turn into a replacement of every following element
+        size_t prefix = 0;
+        size_t shorter = std::min(a.size(), b.size());
+        while (prefix < shorter && equals(a[prefix], b[prefix])) ++prefix;
+        size_t suffix = 0;
+        while (suffix < shorter - prefix &&
+               equals(a[a.size() - 1 - suffix], b[b.size() - 1 - suffix])) {
+            ++suffix;
+        }
+
+        size_t middleA = a.size() - prefix - suffix;
+        size_t middleB = b.size() - prefix - suffix;
+        size_t overlap = std::min(middleA, middleB);
+
+        for (size_t k = 0; k < overlap; ++k) {
+            size_t length = pushToken(path, std::to_string(prefix + k));
+            diffValues(a[prefix + k], b[prefix + k], path, ops);
+            path.resize(length);
+        }
+        for (size_t k = overlap; k < middleB; ++k) {
+            size_t length = pushToken(path, std::to_string(prefix + k));
+            emit(ops, JsonPatchOp::Add, path, b[prefix + k]);
+            path.resize(length);
+        }
+        if (middleA > middleB) {
+            size_t length = pushToken(path, std::to_string(prefix + middleB));
+            for (size_t k = middleB; k < middleA; ++k) {
+                emit(ops, JsonPatchOp::Remove, path);
+            }
+            path.resize(length);
+        }
+    }
+
+    /**
+     * @brief Applies operations to a copy-on-write working tree
+     *
+     * Containers reachable from the input are shared until an operation
+     * modifies them; each is copied once and then mutated in place.
+     */
+    class Applier {
+    public:
+        explicit Applier(const JsonValue& document) : m_root(document) {}
+
+        JsonValue result() const { return m_root; }
+
+        void apply(const JsonPatchOperation& operation) {
+            std::vector<std::string> path = JsonPointer::parse(operation.path);
+
+            switch (operation.op) {
+                case JsonPatchOp::Add:
+                    add(path, operation.value, operation.path);
+                    break;
+                case JsonPatchOp::Remove:
+                    remove(path, operation.path);
+                    break;
+                case JsonPatchOp::Replace:
+                    replace(path, operation.value, operation.path);
+                    break;
+                case JsonPatchOp::Move: {
+                    std::vector<std::string> from = JsonPointer::parse(operation.from);
+                    if (from.size() < path.size() && std::equal(from.begin(), from.end(), path.begin())) {
+                        fail("Cannot move a value into itself", operation.path);
+                    }
+                    JsonValue value = get(from, operation.from);
+                    remove(from, operation.from);
+                    add(path, value, operation.path);
+                    break;
+                }
+                case JsonPatchOp::Copy:
+                    add(path, get(JsonPointer::parse(operation.from), operation.from), operation.path);
+                    break;
+                case JsonPatchOp::Test:
+                    if (!equals(get(path, operation.path), operation.value)) {
+                        fail("Test failed", operation.path);
+                    }
+                    break;
+            }
+        }
+
+    private:
+        JsonValue m_root;  // Shares unmodified subtrees with the input document
+
+        [[noreturn]] static void fail(const std::string& what, const std::string& path) {
+            throw std::runtime_error("JSON patch error: " + what + " at '" + path + "'");
+        }
+
+        /**
+         * @brief Walk to the container holding the last token, unsharing each level
+         */
+        JsonValue& parentOf(const std::vector<std::string>& path, const std::string& pointer) {
+            JsonValue* current = &m_root;
+            for (size_t i = 0; i + 1 < path.size(); ++i) {
+                if (current->isObject()) {
+                    JsonObject& obj = current->asMutableObject();
+                    auto it = obj.find(path[i]);
+                    if (it == obj.end()) fail("Path not found", pointer);
+                    current = &it->second;
+                } else if (current->isArray()) {
+                    JsonArray& arr = current->asMutableArray();
+                    size_t index = 0;
+                    if (!JsonPointer::parseIndex(path[i], index) || index >= arr.size()) {
+                        fail("Path not found", pointer);
+                    }
+                    current = &arr[index];
+                } else {
+                    fail("Path not found", pointer);
+                }
+            }
+            return *current;
+        }
+
+        JsonValue get(const std::vector<std::string>& path, const std::string& pointer) const {
+            const JsonValue* value = JsonPointer::resolve(m_root, path);
+            if (!value) fail("Path not found", pointer);
+            return *value;
+        }
+
+        void add(const std::vector<std::string>& path, const JsonValue& value, const std::string& pointer) {
+            if (path.empty()) {
+                m_root = value;
+                return;
+            }
+
+            JsonValue& parent = parentOf(path, pointer);
+            const std::string& last = path.back();
+            if (parent.isObject()) {
+                parent.asMutableObject()[last] = value;
+            } else if (parent.isArray()) {
+                JsonArray& arr = parent.asMutableArray();
+                size_t index = arr.size();
+                if (last != "-" && (!JsonPointer::parseIndex(last, index) || index > arr.size())) {
+                    fail("Array index out of range", pointer);
+                }
+                arr.insert(arr.begin() + static_cast<std::ptrdiff_t>(index), value);
+            } else {
+                fail("Parent is not a container", pointer);
+            }
+        }
+
+        void remove(const std::vector<std::string>& path, const std::string& pointer) {
+            if (path.empty()) fail("Cannot remove the document root", pointer);
+
+            JsonValue& parent = parentOf(path, pointer);
+            const std::string& last = path.back();
+            if (parent.isObject()) {
+                JsonObject& obj = parent.asMutableObject();
+                if (obj.erase(last) == 0) fail("Path not found", pointer);
+            } else if (parent.isArray()) {
+                JsonArray& arr = parent.asMutableArray();
+                size_t index = 0;
+                if (!JsonPointer::parseIndex(last, index) || index >= arr.size()) {
+                    fail("Array index out of range", pointer);
+                }
+                arr.erase(arr.begin() + static_cast<std::ptrdiff_t>(index));
+            } else {
+                fail("Path not found", pointer);
+            }
+        }
+
+        void replace(const std::vector<std::string>& path, const JsonValue& value, const std::string& pointer) {
+            if (path.empty()) {
+                m_root = value;
+                return;
+            }
+
+            JsonValue& parent = parentOf(path, pointer);
+            const std::string& last = path.back();
+            if (parent.isObject()) {
+                JsonObject& obj = parent.asMutableObject();
+                auto it = obj.find(last);
+                if (it == obj.end()) fail("Path not found", pointer);
+                it->second = value;
+            } else if (parent.isArray()) {
+                JsonArray& arr = parent.asMutableArray();
+                size_t index = 0;
+                if (!JsonPointer::parseIndex(last, index) || index >= arr.size()) {
+                    fail("Array index out of range", pointer);
+                }
+                arr[index] = value;
+            } else {
+                fail("Path not found", pointer);
+            }
+        }
+    };
+};
+
+} // namespace mcf
@@ -0,0 +1,622 @@
+/**
+ * @file JsonReader.hpp
+ * @brief Streaming (SAX-style) JSON reader
+ *
+ * Pushes parse events to a JsonHandler while consuming input incrementally,
+ * so documents far larger than memory can be processed from files, file
+ * descriptors or network chunks. Memory use is bounded by the nesting depth
+ * plus the longest single string or number token.
+ */
+
+#pragma once
+
+#include "JsonScanner.hpp"
+
+#include <algorithm>
+#include <cerrno>
+#include <cstdint>
+#include <cstring>
+#include <fstream>
+#include <istream>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#ifdef _WIN32
+#include <io.h>
+#else
+#include <unistd.h>
+#endif
+
+namespace mcf {
+
+/**
+ * @brief What the reader should do after a handler callback
+ */
+enum class JsonReadAction {
+    Continue,   ///< Keep parsing normally
+    SkipValue,  ///< Skip the value that was just started (or follows a key)
+    Stop        ///< Stop parsing; further input is ignored
+};
+
+/**
+ * @brief Receiver of JsonReader events
+ *
+ * All callbacks default to Continue so handlers only override what they need.
+ * String views passed to callbacks are only valid for the duration of the call.
+ *
+ * Skipping:
+ * - Returning SkipValue from onStartObject/onStartArray skips the rest of that
+ *   container; no events (including the matching end event) are emitted for it
+ * - Returning SkipValue from onKey skips the member's value entirely
+ */
+class JsonHandler {
+public:
+    virtual ~JsonHandler() = default;
+
+    virtual JsonReadAction onStartObject() { return JsonReadAction::Continue; }
+    virtual JsonReadAction onEndObject() { return JsonReadAction::Continue; }
+    virtual JsonReadAction onStartArray() { return JsonReadAction::Continue; }
+    virtual JsonReadAction onEndArray() { return JsonReadAction::Continue; }
+    virtual JsonReadAction onKey(std::string_view /*key*/) { return JsonReadAction::Continue; }
+    virtual JsonReadAction onString(std::string_view /*value*/) { return JsonReadAction::Continue; }
+    virtual JsonReadAction onInt(int64_t /*value*/) { return JsonReadAction::Continue; }
+    virtual JsonReadAction onFloat(double /*value*/) { return JsonReadAction::Continue; }
+    virtual JsonReadAction onBool(bool /*value*/) { return JsonReadAction::Continue; }
+    virtual JsonReadAction onNull() { return JsonReadAction::Continue; }
+};
+
+/**
+ * @brief Incremental push parser emitting JsonHandler events
+ *
+ * Input may be split at any byte; tokens crossing chunk boundaries are
+ * buffered until complete. Strings that fit inside one chunk and contain no
+ * escapes are passed to the handler without copying.
+ *
+ * Skipped subtrees are scanned for brackets and quotes only (no decoding, no
+ * callbacks) and are not validated.
+ *
+ * Usage:
+ * @code
+ * MyHandler handler;
+ * JsonReader reader(handler);
+ * while (receive(chunk)) reader.feed(chunk);
+ * reader.finish();
+ *
+ * JsonReader::readFile("huge.json", handler);
+ * @endcode
+ */
+class JsonReader {
+public:
+    /// Default chunk size used by readFile/readFd/readStream
+    static constexpr size_t DefaultBufferSize = 64 * 1024;
+
+    /// Default maximum nesting depth
+    static constexpr size_t DefaultMaxDepth = 1024;
+
+    /**
+     * @brief Create a reader bound to a handler
+     * @param handler Event receiver (must outlive the reader)
+     * @param maxDepth Maximum container nesting before input is rejected
+     */
+    explicit JsonReader(JsonHandler& handler, size_t maxDepth = DefaultMaxDepth)
+        : m_handler(handler), m_maxDepth(maxDepth) {}
+
+    /**
+     * @brief Consume the next chunk of input
+     * @param chunk Bytes following the previously fed input
+     * @throws std::runtime_error on malformed input
+     */
+    void feed(std::string_view chunk) {
+        const char* data = chunk.data();
+        size_t end = chunk.size();
+        size_t pos = 0;
+
+        while (pos < end && !m_stopped) {
+            if (m_skipDepth > 0) {
+                pos = skip(data, pos, end);
+                continue;
+            }
+
+            switch (m_token) {
+                case Token::String: pos = continueString(data, pos, end); continue;
+                case Token::Scalar: pos = continueScalar(data, pos, end); continue;
+                case Token::None: break;
+            }
+
+            char c = data[pos];
+            if (JsonScanner::isWhitespace(c)) {
+                ++pos;
+                continue;
+            }
+
+            m_tokenOffset = m_consumed + pos;
+            ++pos;
+
+            switch (m_state) {
+                case State::ValueOrArrayEnd:
+                    if (c == ']') {
+                        closeContainer(c);
+                        break;
+                    }
+                    [[fallthrough]];
+                case State::Value:
+                    beginValue(c);
+                    break;
+
+                case State::KeyOrObjectEnd:
+                    if (c == '}') {
+                        closeContainer(c);
+                        break;
+                    }
+                    [[fallthrough]];
+                case State::Key:
+                    if (c != '"') {
+                        fail("Expected '\"'");
+                    }
+                    beginString(true);
+                    break;
+
+                case State::Colon:
+                    if (c != ':') {
+                        fail("Expected ':'");
+                    }
+                    m_state = State::Value;
+                    break;
+
+                case State::CommaOrEnd:
+                    if (c == ',') {
+                        m_state = m_stack.back() == '{' ? State::Key : State::Value;
+                    } else if (c == '}' || c == ']') {
+                        closeContainer(c);
+                    } else {
+                        fail(m_stack.back() == '{' ? "Expected ',' or '}'" : "Expected ',' or ']'");
+                    }
+                    break;
+
+                case State::Done:
+                    fail("Unexpected data after root value");
+            }
+        }
+
+        m_consumed += end;
+    }
+
+    /**
+     * @brief Signal the end of input
+     * @throws std::runtime_error if the document is incomplete
+     */
+    void finish() {
+        if (m_stopped) {
+            return;
+        }
+        if (m_token == Token::Scalar) {
+            completeScalar();
+        }
+        m_tokenOffset = m_consumed;
+        if (m_token == Token::String) {
+            fail("Unterminated string");
+        }
+        if (m_state != State::Done) {
+            fail("Unexpected end of input");
+        }
+    }
+
+    /**
+     * @brief Reset the reader for a new document
+     */
+    void reset() {
+        m_stack.clear();
+        m_buffer.clear();
+        m_state = State::Value;
+        m_token = Token::None;
+        m_consumed = 0;
+        m_tokenOffset = 0;
+        m_skipDepth = 0;
+        m_skipInString = false;
+        m_skipEscape = false;
+        m_skipNext = false;
+        m_escape.clear();
+        m_stopped = false;
+    }
+
+    /**
+     * @brief Check whether a complete root value has been read
+     */
+    bool isComplete() const { return m_state == State::Done && m_token == Token::None; }
+
+    /**
+     * @brief Check whether the handler requested a stop
+     */
+    bool isStopped() const { return m_stopped; }
+
+    /**
+     * @brief Get the number of bytes fed so far
+     */
+    size_t bytesConsumed() const { return m_consumed; }
+
+    /**
+     * @brief Get the current container nesting depth
+     */
+    size_t depth() const { return m_stack.size(); }
+
+    /**
+     * @brief Stream a file through a handler
+     * @param filename Path to the JSON file
+     * @param handler Event receiver
+     * @param bufferSize Bytes read per chunk
+     * @throws std::runtime_error if the file cannot be read or parsing fails
+     */
+    static void readFile(const std::string& filename, JsonHandler& handler,
+                         size_t bufferSize = DefaultBufferSize) {
+        std::ifstream file(filename, std::ios::binary);
+        if (!file.is_open()) {
+            throw std::runtime_error("Failed to open file: " + filename);
+        }
+        readStream(file, handler, bufferSize);
+    }
+
+    /**
+     * @brief Stream an input stream through a handler
+     * @param in Stream to read until EOF
+     * @param handler Event receiver
+     * @param bufferSize Bytes read per chunk
+     * @throws std::runtime_error if parsing fails
+     */
+    static void readStream(std::istream& in, JsonHandler& handler,
+                           size_t bufferSize = DefaultBufferSize) {
+        JsonReader reader(handler);
+        std::vector<char> buffer(bufferSize > 0 ? bufferSize : DefaultBufferSize);
+
+        while (!reader.isStopped()) {
+            in.read(buffer.data(), static_cast<std::streamsize>(buffer.size()));
+            std::streamsize count = in.gcount();
+            if (count <= 0) {
+                break;
+            }
+            reader.feed(std::string_view(buffer.data(), static_cast<size_t>(count)));
+        }
+        reader.finish();
+    }
+
+    /**
+     * @brief Stream a file descriptor (file, pipe or socket) through a handler
+     * @param fd Open descriptor; read until end of file, not closed
+     * @param handler Event receiver
+     * @param bufferSize Bytes read per chunk
+     * @throws std::runtime_error on read errors or if parsing fails
+     */
+    static void readFd(int fd, JsonHandler& handler, size_t bufferSize = DefaultBufferSize) {
+        JsonReader reader(handler);
+        std::vector<char> buffer(bufferSize > 0 ? bufferSize : DefaultBufferSize);
+
+        while (!reader.isStopped()) {
+#ifdef _WIN32
+            int count = _read(fd, buffer.data(), static_cast<unsigned int>(buffer.size()));
+#else
+            ssize_t count = ::read(fd, buffer.data(), buffer.size());
+#endif
+            if (count < 0) {
+                if (errno == EINTR) {
+                    continue;
+                }
+                throw std::runtime_error(std::string("Failed to read JSON input: ") +
+                                         std::strerror(errno));
+            }
+            if (count == 0) {
+                break;
+            }
+            reader.feed(std::string_view(buffer.data(), static_cast<size_t>(count)));
+        }
+        reader.finish();
+    }
+
+private:
+    /**
+     * @brief What the next significant character may be
+     */
+    enum class State {
+        Value,           ///< Any value (root, after ':' or after ',' in an array)
+        ValueOrArrayEnd, ///< First element of an array or ']'
+        KeyOrObjectEnd,  ///< First key of an object or '}'
+        Key,             ///< Key after ',' in an object
+        Colon,           ///< ':' after a key
+        CommaOrEnd,      ///< ',' or the closing bracket after a value
+        Done             ///< Root value complete
+    };
+
+    /**
+     * @brief Token currently being accumulated across chunks
+     */
+    enum class Token {
+        None,
+        String,
+        Scalar  ///< Number or literal
+    };
+
+    JsonHandler& m_handler;
+    size_t m_maxDepth;
+
+    std::vector<char> m_stack;  ///< Open containers ('{' or '[')
+    std::string m_buffer;       ///< Partial token carried between chunks
+    State m_state = State::Value;
+    Token m_token = Token::None;
+    bool m_tokenIsKey = false;
+    std::string m_escape;       ///< Escape sequence split between chunks, from the backslash
+
+    size_t m_consumed = 0;     ///< Bytes fed before the current chunk
+    size_t m_tokenOffset = 0;  ///< Absolute offset of the current token (errors)
+
+    size_t m_skipDepth = 0;
+    bool m_skipInString = false;
+    bool m_skipEscape = false;
+    bool m_skipNext = false;   ///< Next value follows a key the handler skipped
+    bool m_stopped = false;
+
+    /**
+     * @brief Throw a parse error located at the current token
+     */
+    [[noreturn]] void fail(const std::string& what) const {
+        throw std::runtime_error("JSON parse error: " + what + " at offset " +
+                                 std::to_string(m_tokenOffset));
+    }
+
+    /**
+     * @brief Apply a handler result
+     * @return true if the current value should be skipped
+     */
+    bool apply(JsonReadAction action) {
+        if (action == JsonReadAction::Stop) {
+            m_stopped = true;
+        }
+        return action == JsonReadAction::SkipValue;
+    }
+
+    /**
+     * @brief Update the state once a value has been fully read or skipped
+     */
+    void endValue() {
+        m_skipNext = false;
+        m_state = m_stack.empty() ? State::Done : State::CommaOrEnd;
+    }
+
+    /**
+     * @brief Handle the first character of a value
+     */
+    void beginValue(char c) {
+        switch (c) {
+            case '{':
+            case '[': {
+                bool skip = m_skipNext ||
+                            apply(c == '{' ? m_handler.onStartObject() : m_handler.onStartArray());
+                if (skip) {
+                    m_skipDepth = 1;
+                    m_skipInString = false;
+                    m_skipEscape = false;
+                    return;
+                }
+                if (m_stack.size() >= m_maxDepth) {
+                    fail("Maximum nesting depth exceeded");
+                }
+                m_stack.push_back(c);
+                m_state = c == '{' ? State::KeyOrObjectEnd : State::ValueOrArrayEnd;
+                return;
+            }
+            case '"':
+                beginString(false);
+                return;
+            case '-': case '0': case '1': case '2': case '3': case '4':
+            case '5': case '6': case '7': case '8': case '9':
+            case 't': case 'f': case 'n':
+                m_token = Token::Scalar;
+                m_buffer.assign(1, c);
+                return;
+            default:
+                fail("Unexpected character '" + std::string(1, c) + "'");
+        }
+    }
+
+    /**
+     * @brief Close the innermost container
+     */
+    void closeContainer(char c) {
+        char open = c == '}' ? '{' : '[';
+        if (m_stack.empty() || m_stack.back() != open) {
+            fail("Unexpected '" + std::string(1, c) + "'");
+        }
+        m_stack.pop_back();
+        endValue();
+        apply(c == '}' ? m_handler.onEndObject() : m_handler.onEndArray());
+    }
+
+    /**
+     * @brief Start a string token (opening quote already consumed)
+     */
+    void beginString(bool isKey) {
+        m_token = Token::String;
+        m_tokenIsKey = isKey;
+        m_escape.clear();
+        m_buffer.clear();
+    }
+
+    /**
+     * @brief Continue a string token
+     * @return Offset after the consumed bytes
+     */
+    size_t continueString(const char* data, size_t pos, size_t end) {
+        if (!m_escape.empty()) {
+            // Finish the escape sequence the previous chunk ended in
+            size_t carried = m_escape.size();
+            size_t taken = std::min(end - pos, JsonScanner::MaxEscapeLength - carried);
+            m_escape.append(data + pos, taken);
+            JsonScanResult res = JsonScanner::decodeEscape(m_escape, 0, m_buffer);
+            if (res.error) {
+                if (res.end < m_escape.size()) {
+                    fail(res.error);
+                }
+                return pos + taken;  // Still incomplete: the chunk is used up
+            }
+            pos += res.end - carried;
+            m_escape.clear();
+        }
+
+        while (pos < end) {
+            size_t stop = JsonScanner::findQuoteOrBackslash(data, pos, end);
+
+            if (stop >= end) {
+                m_buffer.append(data + pos, end - pos);
+                return end;
+            }
+
+            if (data[stop] == '"') {
+                // Zero-copy when the whole string lies in this chunk
+                std::string_view value;
+                if (m_buffer.empty()) {
+                    value = std::string_view(data + pos, stop - pos);
+                } else {
+                    m_buffer.append(data + pos, stop - pos);
+                    value = m_buffer;
+                }
+                m_token = Token::None;
+                completeString(value);
+                return stop + 1;
+            }
+
+            m_buffer.append(data + pos, stop - pos);
+            JsonScanResult res = JsonScanner::decodeEscape(std::string_view(data, end), stop, m_buffer);
+            if (res.error) {
+                if (res.end < end) {
+                    fail(res.error);
+                }
+                m_escape.assign(data + stop, end - stop);  // Completed by the next chunk
+                return end;
+            }
+            pos = res.end;
+        }
+        return pos;
+    }
+
+    /**
+     * @brief Deliver a completed string
+     */
+    void completeString(std::string_view value) {
+        if (m_tokenIsKey) {
+            m_state = State::Colon;
+            m_skipNext = apply(m_handler.onKey(value));
+            return;
+        }
+        bool skipped = m_skipNext;
+        endValue();
+        if (!skipped) {
+            apply(m_handler.onString(value));
+        }
+    }
+
+    /**
+     * @brief Continue a number or literal token
+     * @return Offset after the consumed bytes
+     */
+    size_t continueScalar(const char* data, size_t pos, size_t end) {
+        size_t start = pos;
+        while (pos < end && !JsonScanner::isTerminator(data[pos])) {
+            ++pos;
+        }
+        m_buffer.append(data + start, pos - start);
+        if (pos < end) {
+            completeScalar();
+        }
+        return pos;
+    }
+
+    /**
+     * @brief Decode and deliver a completed number or literal
+     */
+    void completeScalar() {
+        m_token = Token::None;
+        bool skipped = m_skipNext;
+        JsonReadAction action = JsonReadAction::Continue;
+
+        switch (m_buffer[0]) {
+            case 't':
+            case 'f':
+            case 'n': {
+                const char* literal = m_buffer[0] == 't' ? "true" : m_buffer[0] == 'f' ? "false" : "null";
+                if (m_buffer != literal) {
+                    fail(std::string("Invalid literal (expected '") + literal + "')");
+                }
+                endValue();
+                if (!skipped) {
+                    action = m_buffer[0] == 'n' ? m_handler.onNull() : m_handler.onBool(m_buffer[0] == 't');
+                }
+                break;
+            }
+            default: {
+                JsonNumber number;
+                JsonScanResult res = JsonScanner::decodeNumber(m_buffer, 0, number);
+                if (res.error) {
+                    fail(res.error);
+                }
+                if (res.end != m_buffer.size()) {
+                    fail("Unexpected character '" + std::string(1, m_buffer[res.end]) + "'");
+                }
+                endValue();
+                if (!skipped) {
+                    action = number.isFloat ? m_handler.onFloat(number.floatValue)
+                                            : m_handler.onInt(number.intValue);
+                }
+                break;
+            }
+        }
+        apply(action);
+    }
+
+    /**
+     * @brief Skip bytes of a container the handler is not interested in
+     * @return Offset after the consumed bytes
+     */
+    size_t skip(const char* data, size_t pos, size_t end) {
+        while (pos < end) {
+            if (m_skipInString) {
+                if (m_skipEscape) {
+                    m_skipEscape = false;
+                    ++pos;
+                    continue;
+                }
+                size_t stop = JsonScanner::findQuoteOrBackslash(data, pos, end);
+                if (stop >= end) {
+                    return end;
+                }
+                if (data[stop] == '\\') {
+                    m_skipEscape = true;
+                } else {
+                    m_skipInString = false;
+                }
+                pos = stop + 1;
+                continue;
+            }
+
+            switch (data[pos++]) {
+                case '"':
+                    m_skipInString = true;
+                    break;
+                case '{':
+                case '[':
+                    ++m_skipDepth;
+                    break;
+                case '}':
+                case ']':
+                    if (--m_skipDepth == 0) {
+                        endValue();
+                        return pos;
+                    }
+                    break;
+                default:
+                    break;
+            }
+        }
+        return pos;
+    }
+};
+
+} // namespace mcf
@@ -0,0 +1,681 @@
+/**
+ * @file JsonScanner.hpp
+ * @brief SIMD structural scanner shared by the JSON readers
+ *
+ * Stage one of JSON parsing: classifies 64-byte blocks of input at a time
+ * (AVX2, SSE2 or a portable table-driven fallback) and produces the offsets
+ * of every structural character, string start and scalar start. Stage two
+ * (JsonParser and friends) walks that index instead of the raw bytes.
+ */
+
+#pragma once
+
+#include <array>
+#include <cerrno>
+#include <charconv>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <limits>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#if defined(__AVX2__)
+#include <immintrin.h>
+#define MCF_JSON_SIMD_AVX2 1
+#elif defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define MCF_JSON_SIMD_SSE2 1
+#endif
+
+#if defined(_MSC_VER) && !defined(__clang__)
+#include <intrin.h>
+#endif
+
+namespace mcf {
+
+/**
+ * @brief Character class bitmasks for one 64-byte block (bit i = byte i)
+ */
+struct JsonBlockMasks {
+    uint64_t whitespace = 0;  ///< Space, tab, line feed, carriage return
+    uint64_t op = 0;          ///< One of { } [ ] : ,
+    uint64_t quote = 0;       ///< Double quote (escaped or not)
+    uint64_t backslash = 0;   ///< Backslash
+};
+
+/**
+ * @brief Parsed JSON number
+ */
+struct JsonNumber {
+    bool isFloat = false;
+    int64_t intValue = 0;
+    double floatValue = 0.0;
+};
+
+/**
+ * @brief Result of a scanning helper
+ *
+ * On success @c error is nullptr and @c end is the offset one past the token.
+ * On failure @c error describes the problem and @c end is the offending offset.
+ */
+struct JsonScanResult {
+    size_t end = 0;
+    const char* error = nullptr;
+};
+
+/**
+ * @brief Byte classes used by the portable (non-SIMD) classifier
+ */
+enum JsonCharClass : uint8_t {
+    JsonClassWhitespace = 1,
+    JsonClassOp = 2,
+    JsonClassQuote = 4,
+    JsonClassBackslash = 8
+};
+
+/**
+ * @brief Build the 256-entry byte class table
+ * @return Table mapping each byte to its JsonCharClass bits
+ */
+constexpr std::array<uint8_t, 256> makeJsonClassTable() {
+    std::array<uint8_t, 256> table{};
+    table[' '] = table['\t'] = table['\n'] = table['\r'] = JsonClassWhitespace;
+    table['{'] = table['}'] = table['['] = table[']'] = table[':'] = table[','] = JsonClassOp;
+    table['"'] = JsonClassQuote;
+    table['\\'] = JsonClassBackslash;
+    return table;
+}
+
+/**
+ * @brief Stage-one structural scanner and token helpers
+ *
+ * Features:
+ * - 64 bytes classified per step with AVX2/SSE2, portable fallback otherwise
+ * - Branchless escape and in-string tracking across block boundaries
+ * - Bulk string decoding (runs copied with a single append)
+ * - Number decoding through std::from_chars
+ * - Line/column computed on demand for error messages only
+ */
+class JsonScanner {
+public:
+    static constexpr size_t BlockSize = 64;
+
+    /**
+     * @brief Carry state between consecutive blocks
+     *
+     * Lets callers index input that arrives in chunks (each chunk a multiple
+     * of BlockSize except the last).
+     */
+    struct State {
+        uint64_t prevEscaped = 0;   ///< 1 if the next block starts with an escaped byte
+        uint64_t prevInString = 0;  ///< All ones if the previous block ended inside a string
+        uint64_t prevScalar = 0;    ///< 1 if the previous block ended with a non-quote scalar byte
+
+        /**
+         * @brief Check whether the scanned input so far ended inside a string
+         * @return true if a string is still open
+         */
+        bool inString() const { return prevInString != 0; }
+    };
+
+    /**
+     * @brief Name of the compiled-in classification backend
+     * @return "avx2", "sse2" or "scalar"
+     */
+    static const char* backend() {
+#if defined(MCF_JSON_SIMD_AVX2)
+        return "avx2";
+#elif defined(MCF_JSON_SIMD_SSE2)
+        return "sse2";
+#else
+        return "scalar";
+#endif
+    }
+
+    /**
+     * @brief Classify one 64-byte block
+     * @param block Pointer to at least BlockSize readable bytes
+     * @return Character class bitmasks for the block
+     */
+    static JsonBlockMasks classify(const char* block) {
+        JsonBlockMasks masks;
+#if defined(MCF_JSON_SIMD_AVX2)
+        for (size_t k = 0; k < BlockSize; k += 32) {
+            __m256i v = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(block + k));
+            // '[' | 0x20 == '{' and ']' | 0x20 == '}', so one OR folds both bracket kinds
+            __m256i folded = _mm256_or_si256(v, _mm256_set1_epi8(0x20));
+            __m256i ws = _mm256_or_si256(
+                _mm256_or_si256(_mm256_cmpeq_epi8(v, _mm256_set1_epi8(' ')),
+                                _mm256_cmpeq_epi8(v, _mm256_set1_epi8('\t'))),
+                _mm256_or_si256(_mm256_cmpeq_epi8(v, _mm256_set1_epi8('\n')),
+                                _mm256_cmpeq_epi8(v, _mm256_set1_epi8('\r'))));
+            __m256i op = _mm256_or_si256(
+                _mm256_or_si256(_mm256_cmpeq_epi8(folded, _mm256_set1_epi8('{')),
+                                _mm256_cmpeq_epi8(folded, _mm256_set1_epi8('}'))),
+                _mm256_or_si256(_mm256_cmpeq_epi8(v, _mm256_set1_epi8(':')),
+                                _mm256_cmpeq_epi8(v, _mm256_set1_epi8(','))));
+            __m256i quote = _mm256_cmpeq_epi8(v, _mm256_set1_epi8('"'));
+            __m256i backslash = _mm256_cmpeq_epi8(v, _mm256_set1_epi8('\\'));
+            masks.whitespace |= static_cast<uint64_t>(static_cast<uint32_t>(_mm256_movemask_epi8(ws))) << k;
+            masks.op |= static_cast<uint64_t>(static_cast<uint32_t>(_mm256_movemask_epi8(op))) << k;
+            masks.quote |= static_cast<uint64_t>(static_cast<uint32_t>(_mm256_movemask_epi8(quote))) << k;
+            masks.backslash |= static_cast<uint64_t>(static_cast<uint32_t>(_mm256_movemask_epi8(backslash))) << k;
+        }
+#elif defined(MCF_JSON_SIMD_SSE2)
+        for (size_t k = 0; k < BlockSize; k += 16) {
+            __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(block + k));
+            __m128i folded = _mm_or_si128(v, _mm_set1_epi8(0x20));
+            __m128i ws = _mm_or_si128(
+                _mm_or_si128(_mm_cmpeq_epi8(v, _mm_set1_epi8(' ')),
+                             _mm_cmpeq_epi8(v, _mm_set1_epi8('\t'))),
+                _mm_or_si128(_mm_cmpeq_epi8(v, _mm_set1_epi8('\n')),
+                             _mm_cmpeq_epi8(v, _mm_set1_epi8('\r'))));
+            __m128i op = _mm_or_si128(
+                _mm_or_si128(_mm_cmpeq_epi8(folded, _mm_set1_epi8('{')),
+                             _mm_cmpeq_epi8(folded, _mm_set1_epi8('}'))),
+                _mm_or_si128(_mm_cmpeq_epi8(v, _mm_set1_epi8(':')),
+                             _mm_cmpeq_epi8(v, _mm_set1_epi8(','))));
+            __m128i quote = _mm_cmpeq_epi8(v, _mm_set1_epi8('"'));
+            __m128i backslash = _mm_cmpeq_epi8(v, _mm_set1_epi8('\\'));
+            masks.whitespace |= static_cast<uint64_t>(static_cast<uint16_t>(_mm_movemask_epi8(ws))) << k;
+            masks.op |= static_cast<uint64_t>(static_cast<uint16_t>(_mm_movemask_epi8(op))) << k;
+            masks.quote |= static_cast<uint64_t>(static_cast<uint16_t>(_mm_movemask_epi8(quote))) << k;
+            masks.backslash |= static_cast<uint64_t>(static_cast<uint16_t>(_mm_movemask_epi8(backslash))) << k;
+        }
+#else
+        static constexpr auto table = makeJsonClassTable();
+        for (size_t i = 0; i < BlockSize; ++i) {
+            uint8_t cls = table[static_cast<unsigned char>(block[i])];
+            uint64_t bit = uint64_t(1) << i;
+            if (cls & JsonClassWhitespace) masks.whitespace |= bit;
+            if (cls & JsonClassOp) masks.op |= bit;
+            if (cls & JsonClassQuote) masks.quote |= bit;
+            if (cls & JsonClassBackslash) masks.backslash |= bit;
+        }
+#endif
+        return masks;
+    }
+
+    /**
+     * @brief Compute the structural bitmask of one block and advance the carry state
+     * @param block Pointer to BlockSize readable bytes
+     * @param state Carry state from the previous block (updated)
+     * @return Bitmask of structural positions within the block
+     */
+    static uint64_t structuralBits(const char* block, State& state) {
+        JsonBlockMasks masks = classify(block);
+
+        uint64_t escaped = findEscaped(masks.backslash, state.prevEscaped);
+        uint64_t quote = masks.quote & ~escaped;
+
+        // Bits from an opening quote (inclusive) up to the closing quote (exclusive)
+        uint64_t inString = prefixXor(quote) ^ state.prevInString;
+        state.prevInString = 0 - (inString >> 63);
+        uint64_t stringTail = inString ^ quote;
+
+        // A scalar starts wherever a non-space, non-operator byte does not
+        // continue a previous scalar; that catches numbers, literals and quotes
+        uint64_t scalar = ~(masks.op | masks.whitespace);
+        uint64_t nonQuoteScalar = scalar & ~quote;
+        uint64_t followsNonQuoteScalar = (nonQuoteScalar << 1) | state.prevScalar;
+        state.prevScalar = nonQuoteScalar >> 63;
+
+        return (masks.op | (scalar & ~followsNonQuoteScalar)) & ~stringTail;
+    }
+
+    /**
+     * @brief Build the structural index of a whole document
+     * @param input JSON text
+     * @param out Receives the offsets of structural characters, in order
+     * @throws std::runtime_error if the input is too large for 32-bit offsets
+     */
+    static void index(std::string_view input, std::vector<uint32_t>& out) {
+        if (input.size() >= std::numeric_limits<uint32_t>::max()) {
+            throw std::runtime_error("JSON input exceeds 4 GiB; use a streaming reader");
+        }
+
+        out.clear();
+        out.reserve(input.size() / 6 + 16);
+
+        State state;
+        const char* data = input.data();
+        size_t fullBlocks = input.size() - input.size() % BlockSize;
+
+        for (size_t base = 0; base < fullBlocks; base += BlockSize) {
+            appendPositions(structuralBits(data + base, state), base, out);
+        }
+
+        if (fullBlocks < input.size()) {
+            char tail[BlockSize];
+            std::memset(tail, ' ', BlockSize);
+            std::memcpy(tail, data + fullBlocks, input.size() - fullBlocks);
+            appendPositions(structuralBits(tail, state), fullBlocks, out);
+        }
+    }
+
+    /**
+     * @brief Append the offsets of all set bits of a block mask
+     * @param bits Structural bitmask
+     * @param base Offset of the block within the input
+     * @param out Output index
+     */
+    static void appendPositions(uint64_t bits, size_t base, std::vector<uint32_t>& out) {
+        while (bits) {
+            out.push_back(static_cast<uint32_t>(base + trailingZeros(bits)));
+            bits &= bits - 1;
+        }
+    }
+
+    /**
+     * @brief Find the next double quote or backslash
+     * @param data Input buffer
+     * @param pos Offset to start from
+     * @param end Offset one past the last readable byte
+     * @return Offset of the match, or @p end if none
+     */
+    static size_t findQuoteOrBackslash(const char* data, size_t pos, size_t end) {
+#if defined(MCF_JSON_SIMD_AVX2)
+        const __m256i quote = _mm256_set1_epi8('"');
+        const __m256i backslash = _mm256_set1_epi8('\\');
+        while (pos + 32 <= end) {
+            __m256i v = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(data + pos));
+            uint32_t mask = static_cast<uint32_t>(_mm256_movemask_epi8(
+                _mm256_or_si256(_mm256_cmpeq_epi8(v, quote), _mm256_cmpeq_epi8(v, backslash))));
+            if (mask) {
+                return pos + trailingZeros(mask);
+            }
+            pos += 32;
+        }
+#elif defined(MCF_JSON_SIMD_SSE2)
+        const __m128i quote = _mm_set1_epi8('"');
+        const __m128i backslash = _mm_set1_epi8('\\');
+        while (pos + 16 <= end) {
+            __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(data + pos));
+            uint32_t mask = static_cast<uint32_t>(_mm_movemask_epi8(
+                _mm_or_si128(_mm_cmpeq_epi8(v, quote), _mm_cmpeq_epi8(v, backslash))));
+            if (mask) {
+                return pos + trailingZeros(mask);
+            }
+            pos += 16;
+        }
+#endif
+        while (pos < end && data[pos] != '"' && data[pos] != '\\') {
+            ++pos;
+        }
+        return pos;
+    }
+
+    /**
+     * @brief Decode a string token
+     * @param input JSON text
+     * @param pos Offset of the opening quote
+     * @param out Receives the decoded string (appended)
+     * @return Offset one past the closing quote, or the error position
+     */
+    static JsonScanResult decodeString(std::string_view input, size_t pos, std::string& out) {
+        const char* data = input.data();
+        size_t end = input.size();
+        size_t cursor = pos + 1;
+
+        while (true) {
+            size_t stop = findQuoteOrBackslash(data, cursor, end);
+            out.append(data + cursor, stop - cursor);
+
+            if (stop >= end) {
+                return {stop, "Unterminated string"};
+            }
+            if (data[stop] == '"') {
+                return {stop + 1, nullptr};
+            }
+
+            JsonScanResult escape = decodeEscape(input, stop, out);
+            if (escape.error) {
+                return escape;
+            }
+            cursor = escape.end;
+        }
+    }
+
+    /// Longest escape sequence: a surrogate pair such as \\uD83D\\uDE00
+    static constexpr size_t MaxEscapeLength = 12;
+
+    /**
+     * @brief Decode an escape sequence
+     * @param input JSON text
+     * @param pos Offset of the backslash
+     * @param out Receives the denoted character, UTF-8 encoded (appended)
+     * @return Offset one past the sequence, or the error position; the error
+     *         position is input.size() if the input ends inside the sequence
+     *
+     * A \\uXXXX escape of a UTF-16 high surrogate must be followed by one of
+     * a low surrogate; the pair decodes to one code point. Lone surrogates
+     * are invalid, as they have no UTF-8 encoding.
+     */
+    static JsonScanResult decodeEscape(std::string_view input, size_t pos, std::string& out) {
+        size_t end = input.size();
+        if (pos + 1 >= end) {
+            return {end, "Unterminated string"};
+        }
+        switch (input[pos + 1]) {
+            case '"': out += '"'; return {pos + 2, nullptr};
+            case '\\': out += '\\'; return {pos + 2, nullptr};
+            case '/': out += '/'; return {pos + 2, nullptr};
+            case 'b': out += '\b'; return {pos + 2, nullptr};
+            case 'f': out += '\f'; return {pos + 2, nullptr};
+            case 'n': out += '\n'; return {pos + 2, nullptr};
+            case 'r': out += '\r'; return {pos + 2, nullptr};
+            case 't': out += '\t'; return {pos + 2, nullptr};
+            case 'u': break;
+            default: return {pos + 1, "Invalid escape sequence"};
+        }
+
+        uint32_t code = 0;
+        JsonScanResult res = decodeHex4(input, pos + 2, code);
+        if (res.error) {
+            return res;
+        }
+        size_t next = res.end;
+        if (code >= 0xDC00 && code <= 0xDFFF) {
+            return {pos + 2, "Invalid escape sequence"};
+        }
+        if (code >= 0xD800 && code <= 0xDBFF) {
+            if (next >= end || (input[next] == '\\' && next + 1 >= end)) {
+                return {end, "Unterminated string"};
+            }
+            if (input[next] != '\\' || input[next + 1] != 'u') {
+                return {next, "Invalid escape sequence"};
+            }
+            uint32_t low = 0;
+            res = decodeHex4(input, next + 2, low);
+            if (res.error) {
+                return res;
+            }
+            if (low < 0xDC00 || low > 0xDFFF) {
+                return {next + 2, "Invalid escape sequence"};
+            }
+            code = 0x10000 + ((code - 0xD800) << 10) + (low - 0xDC00);
+            next = res.end;
+        }
+        appendUtf8(code, out);
+        return {next, nullptr};
+    }
+
+    /**
+     * @brief Decode a number token
+     * @param input JSON text
+     * @param pos Offset of the first character ('-' or digit)
+     * @param out Receives the decoded number
+     * @return Offset one past the number, or the error position
+     *
+     * Integers that do not fit in int64_t are returned as floats.
+     */
+    static JsonScanResult decodeNumber(std::string_view input, size_t pos, JsonNumber& out) {
+        const char* data = input.data();
+        size_t end = input.size();
+        size_t cursor = pos;
+
+        if (cursor < end && data[cursor] == '-') {
+            ++cursor;
+        }
+        if (cursor >= end || !isDigit(data[cursor])) {
+            return {cursor, "Invalid number"};
+        }
+        while (cursor < end && isDigit(data[cursor])) {
+            ++cursor;
+        }
+
+        bool isFloat = false;
+        if (cursor < end && data[cursor] == '.') {
+            isFloat = true;
+            ++cursor;
+            if (cursor >= end || !isDigit(data[cursor])) {
+                return {cursor, "Invalid number: expected digit after '.'"};
+            }
+            while (cursor < end && isDigit(data[cursor])) {
+                ++cursor;
+            }
+        }
+        if (cursor < end && (data[cursor] == 'e' || data[cursor] == 'E')) {
+            isFloat = true;
+            ++cursor;
+            if (cursor < end && (data[cursor] == '+' || data[cursor] == '-')) {
+                ++cursor;
+            }
+            if (cursor >= end || !isDigit(data[cursor])) {
+                return {cursor, "Invalid number: expected digit in exponent"};
+            }
+            while (cursor < end && isDigit(data[cursor])) {
+                ++cursor;
+            }
+        }
+
+        if (!isFloat) {
+            int64_t value = 0;
+            auto res = std::from_chars(data + pos, data + cursor, value);
+            if (res.ec == std::errc()) {
+                out.isFloat = false;
+                out.intValue = value;
+                return {cursor, nullptr};
+            }
+            // Out of int64 range: fall through to a float
+        }
+
+        double value = 0.0;
+        if (!parseDouble(data + pos, data + cursor, value)) {
+            return {pos, "Number out of range"};
+        }
+        out.isFloat = true;
+        out.floatValue = value;
+        return {cursor, nullptr};
+    }
+
+    /**
+     * @brief Check a literal token (true, false, null)
+     * @param input JSON text
+     * @param pos Offset of the first character
+     * @param literal Expected literal
+     * @return Offset one past the literal, or the error position
+     */
+    static JsonScanResult matchLiteral(std::string_view input, size_t pos, std::string_view literal) {
+        if (input.compare(pos, literal.size(), literal) != 0) {
+            return {pos, "Invalid literal"};
+        }
+        return {pos + literal.size(), nullptr};
+    }
+
+    /**
+     * @brief Check whether a character may follow a scalar token
+     * @param c Character after the token ('\0' at end of input)
+     * @return true for whitespace, operators or end of input
+     */
+    static bool isTerminator(char c) {
+        switch (c) {
+            case '\0': case ' ': case '\t': case '\n': case '\r':
+            case ',': case ':': case ']': case '}': case '[': case '{':
+                return true;
+            default:
+                return false;
+        }
+    }
+
+    /**
+     * @brief Check whether a character is JSON whitespace
+     * @param c Character to test
+     * @return true for space, tab, line feed or carriage return
+     */
+    static bool isWhitespace(char c) {
+        return c == ' ' || c == '\t' || c == '\n' || c == '\r';
+    }
+
+    /**
+     * @brief Compute the 1-based line and column of an offset
+     * @param input JSON text
+     * @param pos Offset within (or at the end of) the input
+     * @param line Receives the line number
+     * @param column Receives the column number
+     *
+     * Only called when reporting errors, so the hot path never tracks lines.
+     */
+    static void lineColumn(std::string_view input, size_t pos, int& line, int& column) {
+        if (pos > input.size()) pos = input.size();
+        line = 1;
+        size_t lineStart = 0;
+        const char* data = input.data();
+        const char* cursor = data;
+        const char* stop = data + pos;
+        while (cursor < stop) {
+            const void* nl = std::memchr(cursor, '\n', static_cast<size_t>(stop - cursor));
+            if (!nl) break;
+            ++line;
+            cursor = static_cast<const char*>(nl) + 1;
+            lineStart = static_cast<size_t>(cursor - data);
+        }
+        column = static_cast<int>(pos - lineStart) + 1;
+    }
+
+    /**
+     * @brief Format an error message with line and column
+     * @param input JSON text
+     * @param what Error description
+     * @param pos Offset of the error
+     * @return "<what> at line L, column C"
+     */
+    static std::string formatError(std::string_view input, const std::string& what, size_t pos) {
+        int line = 1;
+        int column = 1;
+        lineColumn(input, pos, line, column);
+        return what + " at line " + std::to_string(line) + ", column " + std::to_string(column);
+    }
+
+    /**
+     * @brief Count trailing zero bits
+     * @param bits Non-zero value
+     * @return Index of the lowest set bit
+     */
+    static int trailingZeros(uint64_t bits) {
+#if defined(_MSC_VER) && !defined(__clang__)
+        unsigned long index;
+        _BitScanForward64(&index, bits);
+        return static_cast<int>(index);
+#else
+        return __builtin_ctzll(bits);
+#endif
+    }
+
+    /**
+     * @brief Inclusive prefix XOR (bit i = XOR of bits 0..i)
+     * @param bits Input mask
+     * @return Prefix XOR of the mask
+     */
+    static uint64_t prefixXor(uint64_t bits) {
+        bits ^= bits << 1;
+        bits ^= bits << 2;
+        bits ^= bits << 4;
+        bits ^= bits << 8;
+        bits ^= bits << 16;
+        bits ^= bits << 32;
+        return bits;
+    }
+
+    /**
+     * @brief Find bytes escaped by an odd-length run of backslashes
+     * @param backslash Backslash mask of the block
+     * @param prevEscaped Carry from the previous block (updated)
+     * @return Mask of escaped bytes
+     */
+    static uint64_t findEscaped(uint64_t backslash, uint64_t& prevEscaped) {
+        backslash &= ~prevEscaped;
+        uint64_t followsEscape = (backslash << 1) | prevEscaped;
+
+        // Sequences starting on odd bits are cleared by the carry of the add,
+        // which leaves an alternating pattern we can flip for the even ones
+        const uint64_t evenBits = 0x5555555555555555ULL;
+        uint64_t oddSequenceStarts = backslash & ~evenBits & ~followsEscape;
+        uint64_t sequencesStartingOnEvenBits = oddSequenceStarts + backslash;
+        prevEscaped = sequencesStartingOnEvenBits < oddSequenceStarts ? 1 : 0;
+        uint64_t invertMask = sequencesStartingOnEvenBits << 1;
+
+        return (evenBits ^ invertMask) & followsEscape;
+    }
+
+private:
+    static bool isDigit(char c) {
+        return c >= '0' && c <= '9';
+    }
+
+    /**
+     * @brief Decode the four hex digits of a \\uXXXX escape
+     * @param pos Offset of the first digit
+     */
+    static JsonScanResult decodeHex4(std::string_view input, size_t pos, uint32_t& code) {
+        code = 0;
+        for (size_t i = pos; i < pos + 4; ++i) {
+            if (i >= input.size()) {
+                return {input.size(), "Unterminated string"};
+            }
+            char c = input[i];
+            uint32_t digit;
+            if (c >= '0' && c <= '9') {
+                digit = static_cast<uint32_t>(c - '0');
+            } else if (c >= 'a' && c <= 'f') {
+                digit = static_cast<uint32_t>(c - 'a' + 10);
+            } else if (c >= 'A' && c <= 'F') {
+                digit = static_cast<uint32_t>(c - 'A' + 10);
+            } else {
+                return {i, "Invalid escape sequence"};
+            }
+            code = (code << 4) | digit;
+        }
+        return {pos + 4, nullptr};
+    }
+
+    /**
+     * @brief Append a code point encoded as UTF-8
+     */
+    static void appendUtf8(uint32_t code, std::string& out) {
+        if (code < 0x80) {
+            out += static_cast<char>(code);
+        } else if (code < 0x800) {
+            out += static_cast<char>(0xC0 | (code >> 6));
+            out += static_cast<char>(0x80 | (code & 0x3F));
+        } else if (code < 0x10000) {
+            out += static_cast<char>(0xE0 | (code >> 12));
+            out += static_cast<char>(0x80 | ((code >> 6) & 0x3F));
+            out += static_cast<char>(0x80 | (code & 0x3F));
+        } else {
+            out += static_cast<char>(0xF0 | (code >> 18));
+            out += static_cast<char>(0x80 | ((code >> 12) & 0x3F));
+            out += static_cast<char>(0x80 | ((code >> 6) & 0x3F));
+            out += static_cast<char>(0x80 | (code & 0x3F));
+        }
+    }
+
+    static bool parseDouble(const char* begin, const char* end, double& value) {
+#if defined(__cpp_lib_to_chars) && __cpp_lib_to_chars >= 201611L
+        auto res = std::from_chars(begin, end, value);
+        return res.ec == std::errc() && res.ptr == end;
+#else
+        // Numbers are short; strtod needs a terminated copy
+        char buffer[64];
+        std::string heap;
+        size_t len = static_cast<size_t>(end - begin);
+        const char* text = buffer;
+        if (len < sizeof(buffer)) {
+            std::memcpy(buffer, begin, len);
+            buffer[len] = '\0';
+        } else {
+            heap.assign(begin, end);
+            text = heap.c_str();
+        }
+        char* parsedEnd = nullptr;
+        errno = 0;
+        value = std::strtod(text, &parsedEnd);
+        return errno != ERANGE && parsedEnd == text + len;
+#endif
+    }
+};
+
+} // namespace mcf
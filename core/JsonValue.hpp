@@ -98,6 +98,12 @@ public:
      */
     JsonValue(const std::string& value) : m_value(value) {}
 
+    /**
+     * @brief Construct a string JSON value by taking ownership of a std::string
+     * @param value String value to move in
+     */
+    JsonValue(std::string&& value) : m_value(std::move(value)) {}
+
     /**
      * @brief Construct a string JSON value from C-string
      * @param value C-style string to store
@@ -110,12 +116,24 @@ public:
      */
     JsonValue(const JsonArray& value) : m_value(std::make_shared<JsonArray>(value)) {}
 
+    /**
+     * @brief Construct an array JSON value by taking ownership of an array
+     * @param value JSON array to move in
+     */
+    JsonValue(JsonArray&& value) : m_value(std::make_shared<JsonArray>(std::move(value))) {}
+
     /**
      * @brief Construct an object JSON value
      * @param value JSON object to store
      */
     JsonValue(const JsonObject& value) : m_value(std::make_shared<JsonObject>(value)) {}
 
+    /**
+     * @brief Construct an object JSON value by taking ownership of an object
+     * @param value JSON object to move in
+     */
+    JsonValue(JsonObject&& value) : m_value(std::make_shared<JsonObject>(std::move(value))) {}
+
     /**
      * @brief Get the type of this JSON value
      * @return The JsonType of this value
@@ -214,6 +232,16 @@ public:
         return defaultValue;
     }
 
+    /**
+     * @brief Get a reference to the stored string without copying
+     * @return Reference to the string value, or to an empty string if not a string
+     */
+    const std::string& asStringRef() const {
+        if (isString()) return std::get<std::string>(m_value);
+        static const std::string empty;
+        return empty;
+    }
+
     /**
      * @brief Get as array
      * @return Reference to the underlying JsonArray
@@ -238,6 +266,46 @@ public:
         return *std::get<std::shared_ptr<JsonObject>>(m_value);
     }
 
+    /**
+     * @brief Get as array for in-place modification
+     * @return Reference to an array owned only by this value
+     * @throws std::runtime_error if this value is not an array
+     *
+     * Copies of a JsonValue share their containers. If the array is shared,
+     * it is first replaced by a shallow copy (copy-on-write), so other copies
+     * never observe the modification. The reference is invalidated by copying
+     * this value.
+     */
+    JsonArray& asMutableArray() {
+        if (!isArray()) {
+            throw std::runtime_error("JsonValue is not an array");
+        }
+        auto& array = std::get<std::shared_ptr<JsonArray>>(m_value);
+        if (array.use_count() > 1) {
+            array = std::make_shared<JsonArray>(*array);
+        }
+        return *array;
+    }
+
+    /**
+     * @brief Get as object for in-place modification
+     * @return Reference to an object owned only by this value
+     * @throws std::runtime_error if this value is not an object
+     *
+     * Copy-on-write like asMutableArray(): a shared object is shallow-copied
+     * first, so only the path being modified is ever copied.
+     */
+    JsonObject& asMutableObject() {
+        if (!isObject()) {
+            throw std::runtime_error("JsonValue is not an object");
+        }
+        auto& object = std::get<std::shared_ptr<JsonObject>>(m_value);
+        if (object.use_count() > 1) {
+            object = std::make_shared<JsonObject>(*object);
+        }
+        return *object;
+    }
+
     /**
      * @brief Get array or object size
      * @return Number of elements in array or object, 0 for other types
@@ -0,0 +1,615 @@
+/**
+ * @file JsonWriter.hpp
+ * @brief Buffered JSON serializer
+ *
+ * Serializes into a single growable buffer, optionally streaming it to a
+ * file descriptor once a threshold is reached. Numbers are formatted with
+ * std::to_chars (shortest round-trip representation for doubles) and strings
+ * are escaped through a lookup table, copying unescaped runs in bulk.
+ */
+
+#pragma once
+
+#include "JsonValue.hpp"
+#include "TempFile.hpp"
+
+#include <array>
+#include <cerrno>
+#include <charconv>
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <filesystem>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <system_error>
+#include <vector>
+
+#ifdef _WIN32
+#include <fcntl.h>
+#include <io.h>
+#include <sys/stat.h>
+#else
+#include <fcntl.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace mcf {
+
+/**
+ * @brief Build the 256-entry string escape table
+ * @return Table mapping each byte to the character written after a backslash,
+ *         or 0 if the byte is copied verbatim
+ *
+ * Control characters without a short escape map to 'u' and are written as
+ * \\u00XX, since JSON does not allow them raw inside strings.
+ */
+constexpr std::array<char, 256> makeJsonEscapeTable() {
+    std::array<char, 256> table{};
+    for (int c = 0; c < 0x20; ++c) {
+        table[c] = 'u';
+    }
+    table['"'] = '"';
+    table['\\'] = '\\';
+    table['\b'] = 'b';
+    table['\f'] = 'f';
+    table['\n'] = 'n';
+    table['\r'] = 'r';
+    table['\t'] = 't';
+    return table;
+}
+
+/**
+ * @brief Streaming JSON writer
+ *
+ * Features:
+ * - Compact or pretty (indented) output
+ * - One output buffer reused for the whole document
+ * - Optional direct output to a file descriptor, flushed in large writes
+ * - Integers and doubles formatted with std::to_chars; non-finite doubles
+ *   are written as null
+ *
+ * Usage:
+ * @code
+ * JsonWriter writer(JsonWriter::Style::Pretty);
+ * writer.startObject();
+ * writer.key("port").integer(8080);
+ * writer.key("hosts").startArray().string("a").string("b").endArray();
+ * writer.endObject();
+ * std::string json = writer.release();
+ *
+ * std::string compact = JsonWriter::write(value);
+ * @endcode
+ */
+class JsonWriter {
+public:
+    /**
+     * @brief Output layout
+     */
+    enum class Style {
+        Compact,  ///< No whitespace
+        Pretty    ///< One member/element per line, indented
+    };
+
+    /// Buffered bytes that trigger a write when streaming to a descriptor
+    static constexpr size_t FlushThreshold = 64 * 1024;
+
+    /**
+     * @brief Create a writer serializing into its internal buffer
+     * @param style Output layout
+     * @param indentWidth Spaces per nesting level in pretty mode
+     */
+    explicit JsonWriter(Style style = Style::Compact, int indentWidth = 2)
+        : m_style(style), m_indentWidth(indentWidth) {}
+
+    /**
+     * @brief Create a writer streaming to a file descriptor
+     * @param fd Open, writable descriptor (not closed by the writer)
+     * @param style Output layout
+     * @param indentWidth Spaces per nesting level in pretty mode
+     */
+    JsonWriter(int fd, Style style, int indentWidth = 2)
+        : m_fd(fd), m_style(style), m_indentWidth(indentWidth) {
+        m_buffer.reserve(FlushThreshold + FlushThreshold / 4);
+    }
+
+    /**
+     * @brief Flush remaining output to the descriptor (errors are ignored)
+     *
+     * Call flush() explicitly to observe write errors.
+     */
+    ~JsonWriter() {
+        if (m_fd >= 0) {
+            try {
+                flush();
+            } catch (...) {
+            }
+        }
+    }
+
+    JsonWriter(const JsonWriter&) = delete;
+    JsonWriter& operator=(const JsonWriter&) = delete;
+
+    /**
+     * @brief Begin an object
+     */
+    JsonWriter& startObject() {
+        beforeValue();
+        m_buffer += '{';
+        m_hasElements.push_back(false);
+        return *this;
+    }
+
+    /**
+     * @brief End the innermost object
+     */
+    JsonWriter& endObject() {
+        return endContainer('}');
+    }
+
+    /**
+     * @brief Begin an array
+     */
+    JsonWriter& startArray() {
+        beforeValue();
+        m_buffer += '[';
+        m_hasElements.push_back(false);
+        return *this;
+    }
+
+    /**
+     * @brief End the innermost array
+     */
+    JsonWriter& endArray() {
+        return endContainer(']');
+    }
+
+    /**
+     * @brief Write an object member key; the next call writes its value
+     */
+    JsonWriter& key(std::string_view name) {
+        beforeElement();
+        m_buffer += '"';
+        escape(name, m_buffer);
+        m_buffer += m_style == Style::Pretty ? "\": " : "\":";
+        m_afterKey = true;
+        return *this;
+    }
+
+    /**
+     * @brief Write a string value
+     */
+    JsonWriter& string(std::string_view value) {
+        beforeValue();
+        m_buffer += '"';
+        escape(value, m_buffer);
+        m_buffer += '"';
+        return afterScalar();
+    }
+
+    /**
+     * @brief Write an integer value
+     */
+    JsonWriter& integer(int64_t value) {
+        beforeValue();
+        char text[24];
+        auto res = std::to_chars(text, text + sizeof(text), value);
+        m_buffer.append(text, static_cast<size_t>(res.ptr - text));
+        return afterScalar();
+    }
+
+    /**
+     * @brief Write a floating-point value in its shortest round-trip form
+     *
+     * Integral values keep a ".0" suffix so they read back as floats.
+     */
+    JsonWriter& number(double value) {
+        beforeValue();
+        if (!std::isfinite(value)) {
+            m_buffer += "null";
+            return afterScalar();
+        }
+        char text[32];
+        size_t length = formatShortest(value, text, sizeof(text));
+        m_buffer.append(text, length);
+        if (std::memchr(text, '.', length) == nullptr && std::memchr(text, 'e', length) == nullptr) {
+            m_buffer += ".0";
+        }
+        return afterScalar();
+    }
+
+    /**
+     * @brief Write a floating-point value with a fixed number of decimals
+     * @param value Value to write
+     * @param precision Digits after the decimal point
+     */
+    JsonWriter& number(double value, int precision) {
+        beforeValue();
+        if (!std::isfinite(value)) {
+            m_buffer += "null";
+            return afterScalar();
+        }
+        char text[128];
+        size_t length = formatFixed(value, precision, text, sizeof(text));
+        m_buffer.append(text, length);
+        return afterScalar();
+    }
+
+    /**
+     * @brief Write a boolean value
+     */
+    JsonWriter& boolean(bool value) {
+        beforeValue();
+        m_buffer += value ? "true" : "false";
+        return afterScalar();
+    }
+
+    /**
+     * @brief Write null
+     */
+    JsonWriter& null() {
+        beforeValue();
+        m_buffer += "null";
+        return afterScalar();
+    }
+
+    /**
+     * @brief Write a complete JsonValue tree
+     */
+    JsonWriter& value(const JsonValue& value) {
+        switch (value.type()) {
+            case JsonType::Null: return null();
+            case JsonType::Boolean: return boolean(value.asBool());
+            case JsonType::Integer: return integer(value.asInt());
+            case JsonType::Float: return number(value.asFloat());
+            case JsonType::String: return string(value.asStringRef());
+            case JsonType::Array:
+                startArray();
+                for (const auto& element : value.asArray()) {
+                    this->value(element);
+                }
+                return endArray();
+            case JsonType::Object:
+                startObject();
+                for (const auto& [name, member] : value.asObject()) {
+                    key(name);
+                    this->value(member);
+                }
+                return endObject();
+        }
+        return *this;
+    }
+
+    /**
+     * @brief Append text verbatim, without separators or escaping
+     * @param text Text to append (e.g. a record delimiter or pre-serialized JSON)
+     */
+    JsonWriter& raw(std::string_view text) {
+        m_buffer.append(text);
+        return afterScalar();
+    }
+
+    /**
+     * @brief Get the buffered output
+     */
+    const std::string& str() const { return m_buffer; }
+
+    /**
+     * @brief Take the buffered output, leaving the writer empty
+     */
+    std::string release() {
+        std::string out = std::move(m_buffer);
+        clear();
+        return out;
+    }
+
+    /**
+     * @brief Discard buffered output and nesting state
+     */
+    void clear() {
+        m_buffer.clear();
+        m_hasElements.clear();
+        m_afterKey = false;
+    }
+
+    /**
+     * @brief Reserve buffer capacity for the expected output size
+     */
+    void reserve(size_t bytes) { m_buffer.reserve(bytes); }
+
+    /**
+     * @brief Get the current nesting depth
+     */
+    size_t depth() const { return m_hasElements.size(); }
+
+    /**
+     * @brief Write buffered output to the descriptor
+     * @throws std::runtime_error if the write fails
+     *
+     * No-op for buffer-only writers.
+     */
+    void flush() {
+        if (m_fd < 0 || m_buffer.empty()) {
+            return;
+        }
+
+        const char* data = m_buffer.data();
+        size_t remaining = m_buffer.size();
+        while (remaining > 0) {
+#ifdef _WIN32
+            int written = _write(m_fd, data, static_cast<unsigned int>(remaining));
+#else
+            ssize_t written = ::write(m_fd, data, remaining);
+#endif
+            if (written < 0) {
+                if (errno == EINTR) {
+                    continue;
+                }
+                throw std::runtime_error(std::string("Failed to write JSON output: ") +
+                                         std::strerror(errno));
+            }
+            data += written;
+            remaining -= static_cast<size_t>(written);
+        }
+        m_buffer.clear();
+    }
+
+    /**
+     * @brief Serialize a value to a string
+     * @param value Value to serialize
+     * @param style Output layout
+     * @param indentWidth Spaces per nesting level in pretty mode
+     * @return JSON text
+     */
+    static std::string write(const JsonValue& value, Style style = Style::Compact, int indentWidth = 2) {
+        JsonWriter writer(style, indentWidth);
+        writer.value(value);
+        return writer.release();
+    }
+
+    /**
+     * @brief Serialize a value directly to a file
+     * @param filename Path to the file (created or truncated)
+     * @param value Value to serialize
+     * @param style Output layout
+     * @return true if the whole document was written
+     */
+    static bool writeFile(const std::string& filename, const JsonValue& value,
+                          Style style = Style::Pretty) {
+        int fd = openFile(filename);
+        if (fd < 0) {
+            return false;
+        }
+
+        bool success = writeTo(fd, value, style);
+#ifdef _WIN32
+        success = _close(fd) == 0 && success;
+#else
+        success = ::close(fd) == 0 && success;
+#endif
+        return success;
+    }
+
+    /**
+     * @brief Serialize a value to a file, replacing it atomically
+     * @param filename Path to the file (created or replaced)
+     * @param value Value to serialize
+     * @param style Output layout
+     * @return true if the file now holds the whole document
+     *
+     * Writes a uniquely named temporary file next to the target (see
+     * TempFile), flushes it to disk and renames it over the target, so
+     * readers and crashes see either the old or the new file. On failure
+     * the target is left untouched. A replaced file keeps its permissions,
+     * and a symbolic link keeps pointing to the file, which is replaced.
+     */
+    static bool writeFileAtomic(const std::string& filename, const JsonValue& value,
+                                Style style = Style::Pretty) {
+        std::string path = filename;
+        std::error_code error;
+        if (std::filesystem::is_symlink(filename, error)) {
+            std::filesystem::path resolved = std::filesystem::canonical(filename, error);
+            if (!error) {
+                path = resolved.string();
+            }
+        }
+
+        std::string temporary;
+        int fd = TempFile::create(path, temporary, 0644);
+        if (fd < 0) {
+            return false;
+        }
+#ifndef _WIN32
+        // Keep the permissions of the file being replaced
+        struct stat st;
+        if (::stat(path.c_str(), &st) == 0) {
+            (void)fchmod(fd, st.st_mode & 07777);
+        }
+#endif
+
+        bool success = writeTo(fd, value, style);
+#ifdef _WIN32
+        success = success && _commit(fd) == 0;
+        success = _close(fd) == 0 && success;
+#else
+        success = success && ::fsync(fd) == 0;
+        success = ::close(fd) == 0 && success;
+#endif
+
+        if (success) {
+            std::filesystem::rename(temporary, path, error);
+            success = !error;
+        }
+        if (!success) {
+            std::filesystem::remove(temporary, error);
+            return false;
+        }
+
+#ifndef _WIN32
+        // Persist the directory entry of the rename as well
+        std::filesystem::path parent = std::filesystem::path(path).parent_path();
+        int dirFd = ::open(parent.empty() ? "." : parent.c_str(), O_RDONLY | O_DIRECTORY | O_CLOEXEC);
+        if (dirFd >= 0) {
+            ::fsync(dirFd);
+            ::close(dirFd);
+        }
+#endif
+        return true;
+    }
+
+    /**
+     * @brief Append the escaped form of a string (without quotes)
+     * @param in Raw string
+     * @param out String to append to
+     */
+    static void escape(std::string_view in, std::string& out) {
+        static constexpr auto table = makeJsonEscapeTable();
+
+        const char* data = in.data();
+        size_t size = in.size();
+        size_t runStart = 0;
+        for (size_t i = 0; i < size; ++i) {
+            char escaped = table[static_cast<unsigned char>(data[i])];
+            if (escaped == 0) {
+                continue;
+            }
+            out.append(data + runStart, i - runStart);
+            out += '\\';
+            out += escaped;
+            if (escaped == 'u') {
+                static constexpr char hex[] = "0123456789abcdef";
+                unsigned char c = static_cast<unsigned char>(data[i]);
+                out += "00";
+                out += hex[c >> 4];
+                out += hex[c & 0x0F];
+            }
+            runStart = i + 1;
+        }
+        out.append(data + runStart, size - runStart);
+    }
+
+private:
+    static int openFile(const std::string& filename) {
+#ifdef _WIN32
+        return _open(filename.c_str(), _O_WRONLY | _O_CREAT | _O_TRUNC | _O_BINARY,
+                     _S_IREAD | _S_IWRITE);
+#else
+        return ::open(filename.c_str(), O_WRONLY | O_CREAT | O_TRUNC | O_CLOEXEC, 0644);
+#endif
+    }
+
+    static bool writeTo(int fd, const JsonValue& value, Style style) {
+        try {
+            JsonWriter writer(fd, style);
+            writer.value(value);
+            if (style == Style::Pretty) {
+                writer.m_buffer += '\n';
+            }
+            writer.flush();
+            return true;
+        } catch (const std::exception&) {
+            return false;
+        }
+    }
+
+    std::string m_buffer;
+    std::vector<bool> m_hasElements;  ///< One entry per open container
+    bool m_afterKey = false;
+    int m_fd = -1;
+    Style m_style;
+    int m_indentWidth;
+
+    /**
+     * @brief Start a new line at the current depth (pretty mode)
+     */
+    void newline() {
+        m_buffer += '\n';
+        m_buffer.append(m_hasElements.size() * static_cast<size_t>(m_indentWidth), ' ');
+    }
+
+    /**
+     * @brief Emit the separator before an array element or object key
+     */
+    void beforeElement() {
+        if (m_hasElements.empty()) {
+            return;
+        }
+        if (m_hasElements.back()) {
+            m_buffer += ',';
+        }
+        m_hasElements.back() = true;
+        if (m_style == Style::Pretty) {
+            newline();
+        }
+    }
+
+    /**
+     * @brief Emit whatever must precede a value
+     */
+    void beforeValue() {
+        if (m_afterKey) {
+            m_afterKey = false;
+            return;
+        }
+        beforeElement();
+    }
+
+    /**
+     * @brief Stream the buffer out once it is large enough
+     */
+    JsonWriter& afterScalar() {
+        if (m_fd >= 0 && m_buffer.size() >= FlushThreshold) {
+            flush();
+        }
+        return *this;
+    }
+
+    JsonWriter& endContainer(char close) {
+        bool hadElements = !m_hasElements.empty() && m_hasElements.back();
+        if (!m_hasElements.empty()) {
+            m_hasElements.pop_back();
+        }
+        if (hadElements && m_style == Style::Pretty) {
+            newline();
+        }
+        m_buffer += close;
+        return afterScalar();
+    }
+
+    static size_t formatShortest(double value, char* text, size_t capacity) {
+#if defined(__cpp_lib_to_chars) && __cpp_lib_to_chars >= 201611L
+        auto res = std::to_chars(text, text + capacity, value);
+        return static_cast<size_t>(res.ptr - text);
+#else
+        // Try the shorter precision first and keep it only if it round-trips
+        int length = std::snprintf(text, capacity, "%.15g", value);
+        if (std::strtod(text, nullptr) != value) {
+            length = std::snprintf(text, capacity, "%.17g", value);
+        }
+        return static_cast<size_t>(length);
+#endif
+    }
+
+    static size_t formatFixed(double value, int precision, char* text, size_t capacity) {
+#if defined(__cpp_lib_to_chars) && __cpp_lib_to_chars >= 201611L
+        auto res = std::to_chars(text, text + capacity, value, std::chars_format::fixed, precision);
+        if (res.ec == std::errc()) {
+            return static_cast<size_t>(res.ptr - text);
+        }
+        // Too long for the buffer (huge magnitude): use the shortest form
+        return formatShortest(value, text, capacity);
+#else
+        int length = std::snprintf(text, capacity, "%.*f", precision, value);
+        if (length < 0 || static_cast<size_t>(length) >= capacity) {
+            return formatShortest(value, text, capacity);
+        }
+        return static_cast<size_t>(length);
+#endif
+    }
+};
+
+} // namespace mcf
@@ -443,6 +443,31 @@ public:
             m_file.flush();
         }
     }
+
+    /**
+     * @brief Close the file and open it again by path, appending
+     *
+     * Used after an external tool (e.g. logrotate) moved or deleted the
+     * file, so that logging continues in a fresh file at the same path.
+     * @return true if the file is open afterwards
+     */
+    bool reopen() {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        if (m_file.is_open()) {
+            m_file.close();
+        }
+        m_file.clear();
+        m_file.open(m_filepath, std::ios::out | std::ios::app);
+        return m_file.is_open();
+    }
+
+    /**
+     * @brief Get the path of the log file
+     * @return Path given to the constructor
+     */
+    const std::string& getFilePath() const {
+        return m_filepath;
+    }
 };
 
 /**
@@ -608,6 +633,15 @@ public:
         m_sinks.clear();
     }
 
+    /**
+     * @brief Get the sinks of this logger
+     * @return Copy of the registered sinks
+     */
+    std::vector<std::shared_ptr<LogSink>> getSinks() const {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        return m_sinks;
+    }
+
     /**
      * @brief Set the minimum log level for this logger
      * @param level New minimum log level
@@ -0,0 +1,349 @@
+/**
+ * @file MappedFile.hpp
+ * @brief Read-only and read-write memory mapping of whole files
+ *
+ * A MappedFile exposes the contents of a file as a std::string_view or a
+ * byte range without copying them into a buffer: pages are read in by the
+ * kernel when first touched and shared with the page cache.
+ *
+ * The file must not be truncated while it is mapped; touching pages past
+ * the new end raises SIGBUS on POSIX systems. Map files that are replaced
+ * by rename (as JsonWriter::writeFileAtomic() does) or not written at all,
+ * and read files that other programs rewrite in place.
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <cstdint>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <utility>
+
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace mcf {
+
+/**
+ * @brief Access mode of a mapping
+ */
+enum class MapMode {
+    ReadOnly,   ///< Pages are read-only and private
+    ReadWrite   ///< Writes go to the file; the size is fixed
+};
+
+/**
+ * @brief Expected access pattern, passed to madvise()
+ */
+enum class MapAdvice {
+    Normal,      ///< No special treatment
+    Sequential,  ///< Read ahead aggressively, drop pages behind
+    Random,      ///< Do not read ahead
+    WillNeed,    ///< Start reading the range in now
+    DontNeed     ///< The range will not be accessed soon
+};
+
+/**
+ * @brief Options of MappedFile
+ */
+struct MapOptions {
+    /// Access pattern of the whole mapping
+    MapAdvice advice = MapAdvice::Normal;
+
+    /// Read all pages in while mapping (MAP_POPULATE), so that later accesses do not fault
+    bool populate = false;
+};
+
+/**
+ * @brief RAII memory mapping of a file
+ *
+ * Movable, not copyable. An empty file maps to an empty view.
+ *
+ * Usage:
+ * @code
+ * MappedFile file("data/large.json", MapMode::ReadOnly, {MapAdvice::Sequential});
+ * JsonValue value = JsonParser::parse(file.view());
+ * @endcode
+ */
+class MappedFile {
+private:
+    std::string m_path;
+    MapMode m_mode = MapMode::ReadOnly;
+    char* m_data = nullptr;
+    size_t m_size = 0;
+    bool m_open = false;
+
+#ifdef _WIN32
+    HANDLE m_file = INVALID_HANDLE_VALUE;
+    HANDLE m_mapping = nullptr;
+#endif
+
+public:
+    /// Files from this size on are cheaper to map than to read into a buffer
+    static constexpr size_t MinimumMapSize = 256 * 1024;
+
+    /**
+     * @brief Construct an unmapped object
+     */
+    MappedFile() = default;
+
+    /**
+     * @brief Map a file
+     * @param path File to map; it must exist and be a regular file
+     * @param mode Read-only or read-write access
+     * @param options Access pattern and pre-faulting
+     * @throws std::runtime_error if the file cannot be opened or mapped
+     */
+    explicit MappedFile(const std::string& path, MapMode mode = MapMode::ReadOnly,
+                        MapOptions options = MapOptions())
+        : m_path(path), m_mode(mode) {
+        bool writable = mode == MapMode::ReadWrite;
+
+#ifdef _WIN32
+        m_file = CreateFileA(path.c_str(), writable ? (GENERIC_READ | GENERIC_WRITE) : GENERIC_READ,
+                             FILE_SHARE_READ | FILE_SHARE_WRITE | FILE_SHARE_DELETE, nullptr,
+                             OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+        if (m_file == INVALID_HANDLE_VALUE) {
+            throw std::runtime_error("Failed to open file: " + path);
+        }
+
+        LARGE_INTEGER size;
+        if (!GetFileSizeEx(m_file, &size)) {
+            close();
+            throw std::runtime_error("Failed to read file size: " + path);
+        }
+        m_size = static_cast<size_t>(size.QuadPart);
+
+        if (m_size > 0) {
+            m_mapping = CreateFileMappingA(m_file, nullptr, writable ? PAGE_READWRITE : PAGE_READONLY, 0, 0, nullptr);
+            void* view = m_mapping ? MapViewOfFile(m_mapping, writable ? FILE_MAP_WRITE : FILE_MAP_READ, 0, 0, 0) : nullptr;
+            if (!view) {
+                close();
+                throw std::runtime_error("Failed to map file: " + path);
+            }
+            m_data = static_cast<char*>(view);
+        }
+        (void)options;
+#else
+        int fd = ::open(path.c_str(), (writable ? O_RDWR : O_RDONLY) | O_CLOEXEC);
+        if (fd < 0) {
+            throw std::runtime_error("Failed to open file: " + path);
+        }
+
+        struct stat st;
+        if (fstat(fd, &st) != 0 || !S_ISREG(st.st_mode)) {
+            ::close(fd);
+            throw std::runtime_error("Not a regular file: " + path);
+        }
+        m_size = static_cast<size_t>(st.st_size);
+
+        if (m_size > 0) {
+            int flags = writable ? MAP_SHARED : MAP_PRIVATE;
+#ifdef MAP_POPULATE
+            if (options.populate) {
+                flags |= MAP_POPULATE;
+            }
+#endif
+            void* view = mmap(nullptr, m_size, writable ? (PROT_READ | PROT_WRITE) : PROT_READ, flags, fd, 0);
+            if (view == MAP_FAILED) {
+                ::close(fd);
+                m_size = 0;
+                throw std::runtime_error("Failed to map file: " + path);
+            }
+            m_data = static_cast<char*>(view);
+        }
+        // The mapping keeps the file referenced
+        ::close(fd);
+#endif
+
+        m_open = true;
+        if (options.advice != MapAdvice::Normal) {
+            advise(options.advice);
+        }
+    }
+
+    ~MappedFile() {
+        close();
+    }
+
+    // Non-copyable
+    MappedFile(const MappedFile&) = delete;
+    MappedFile& operator=(const MappedFile&) = delete;
+
+    MappedFile(MappedFile&& other) noexcept {
+        swap(other);
+    }
+
+    MappedFile& operator=(MappedFile&& other) noexcept {
+        if (this != &other) {
+            close();
+            swap(other);
+        }
+        return *this;
+    }
+
+    /**
+     * @brief Unmap the file
+     *
+     * Changes of a read-write mapping reach the file eventually; call
+     * flush() first to write them out now.
+     */
+    void close() {
+#ifdef _WIN32
+        if (m_data) {
+            UnmapViewOfFile(m_data);
+        }
+        if (m_mapping) {
+            CloseHandle(m_mapping);
+            m_mapping = nullptr;
+        }
+        if (m_file != INVALID_HANDLE_VALUE) {
+            CloseHandle(m_file);
+            m_file = INVALID_HANDLE_VALUE;
+        }
+#else
+        if (m_data) {
+            munmap(m_data, m_size);
+        }
+#endif
+        m_data = nullptr;
+        m_size = 0;
+        m_open = false;
+    }
+
+    /**
+     * @brief Check if a file is mapped
+     * @return true between successful construction and close()
+     */
+    bool isOpen() const { return m_open; }
+
+    /**
+     * @brief Get the mapped contents
+     * @return Pointer to the first byte, or nullptr for an empty or closed mapping
+     */
+    const char* data() const { return m_data; }
+
+    /**
+     * @brief Get the mapped contents for writing
+     * @return Pointer to the first byte, or nullptr for an empty or closed mapping
+     * @throws std::runtime_error if the mapping is read-only
+     */
+    char* writableData() {
+        if (m_mode != MapMode::ReadWrite) {
+            throw std::runtime_error("File is mapped read-only: " + m_path);
+        }
+        return m_data;
+    }
+
+    /**
+     * @brief Get the mapped contents as bytes
+     * @return Pointer to the first byte, or nullptr for an empty or closed mapping
+     */
+    const uint8_t* bytes() const { return reinterpret_cast<const uint8_t*>(m_data); }
+
+    /**
+     * @brief Get the mapped size
+     * @return File size in bytes at the time it was mapped
+     */
+    size_t size() const { return m_size; }
+
+    /**
+     * @brief Check if the mapping is empty
+     * @return true for empty files and closed mappings
+     */
+    bool empty() const { return m_size == 0; }
+
+    /**
+     * @brief View the contents as characters
+     * @return View valid until the mapping is closed, moved from or destroyed
+     */
+    std::string_view view() const { return std::string_view(m_data, m_size); }
+
+    /**
+     * @brief Get the mapped path
+     * @return Path given to the constructor
+     */
+    const std::string& path() const { return m_path; }
+
+    /**
+     * @brief Get the access mode
+     * @return Mode given to the constructor
+     */
+    MapMode mode() const { return m_mode; }
+
+    /**
+     * @brief Tell the kernel how a range will be accessed
+     * @param advice Expected access pattern
+     * @param offset Start of the range
+     * @param length Length of the range; clamped to the end of the mapping
+     * @return true if the hint was accepted (always true on Windows, where hints are ignored)
+     */
+    bool advise(MapAdvice advice, size_t offset = 0, size_t length = SIZE_MAX) {
+        if (!m_data || offset >= m_size) {
+            return m_open;
+        }
+        length = std::min(length, m_size - offset);
+
+#ifdef _WIN32
+        (void)advice;
+        return true;
+#else
+        // madvise() wants a page-aligned start
+        size_t page = static_cast<size_t>(sysconf(_SC_PAGESIZE));
+        size_t aligned = offset - offset % page;
+        return madvise(m_data + aligned, length + (offset - aligned), toAdvice(advice)) == 0;
+#endif
+    }
+
+    /**
+     * @brief Write changes of a read-write mapping to the file
+     * @param wait Block until the data is written; otherwise only schedule the write-back
+     * @return true on success; read-only and empty mappings have nothing to flush
+     */
+    bool flush(bool wait = true) {
+        if (!m_data || m_mode != MapMode::ReadWrite) {
+            return m_open;
+        }
+#ifdef _WIN32
+        return FlushViewOfFile(m_data, 0) && (!wait || FlushFileBuffers(m_file));
+#else
+        return msync(m_data, m_size, wait ? MS_SYNC : MS_ASYNC) == 0;
+#endif
+    }
+
+private:
+    void swap(MappedFile& other) noexcept {
+        std::swap(m_path, other.m_path);
+        std::swap(m_mode, other.m_mode);
+        std::swap(m_data, other.m_data);
+        std::swap(m_size, other.m_size);
+        std::swap(m_open, other.m_open);
+#ifdef _WIN32
+        std::swap(m_file, other.m_file);
+        std::swap(m_mapping, other.m_mapping);
+#endif
+    }
+
+#ifndef _WIN32
+    static int toAdvice(MapAdvice advice) {
+        switch (advice) {
+            case MapAdvice::Sequential: return MADV_SEQUENTIAL;
+            case MapAdvice::Random: return MADV_RANDOM;
+            case MapAdvice::WillNeed: return MADV_WILLNEED;
+            case MapAdvice::DontNeed: return MADV_DONTNEED;
+            case MapAdvice::Normal:
+            default: return MADV_NORMAL;
+        }
+    }
+#endif
+};
+
+} // namespace mcf
@@ -0,0 +1,598 @@
+/**
+ * @file MsgPack.hpp
+ * @brief MessagePack binary encoding for JsonValue
+ *
+ * Compact, lossless binary form of JSON data for state transfer, caches and
+ * network payloads. Integers keep their exact value, floats stay floats
+ * (stored as float32 when that is exact) and object member order follows
+ * JsonObject ordering.
+ *
+ * Format reference: https://github.com/msgpack/msgpack/blob/master/spec.md
+ */
+
+#pragma once
+
+#include "JsonReader.hpp"
+#include "JsonValue.hpp"
+
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <limits>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+
+namespace mcf {
+
+/**
+ * @brief Streaming MessagePack encoder
+ *
+ * Mirrors the JsonWriter API, except that container sizes must be known when
+ * a container starts (the format stores element counts up front).
+ *
+ * Usage:
+ * @code
+ * MsgPackWriter writer;
+ * writer.startObject(2);
+ * writer.key("id").integer(42);
+ * writer.key("tags").startArray(1).string("a");
+ * std::string bytes = writer.release();
+ * @endcode
+ */
+class MsgPackWriter {
+public:
+    MsgPackWriter() = default;
+
+    /**
+     * @brief Begin an object with a known number of members
+     */
+    MsgPackWriter& startObject(size_t members) {
+        writeHeader(members, 0x80, 0xde, 0xdf, 16);
+        return *this;
+    }
+
+    /**
+     * @brief Begin an array with a known number of elements
+     */
+    MsgPackWriter& startArray(size_t elements) {
+        writeHeader(elements, 0x90, 0xdc, 0xdd, 16);
+        return *this;
+    }
+
+    /**
+     * @brief Write an object member key
+     */
+    MsgPackWriter& key(std::string_view name) {
+        return string(name);
+    }
+
+    /**
+     * @brief Write a string value
+     */
+    MsgPackWriter& string(std::string_view value) {
+        if (value.size() < 32) {
+            m_buffer += static_cast<char>(0xa0 | value.size());
+        } else if (value.size() <= 0xff) {
+            m_buffer += static_cast<char>(0xd9);
+            appendBigEndian(value.size(), 1);
+        } else {
+            writeHeader(value.size(), 0, 0xda, 0xdb, 0);
+        }
+        m_buffer.append(value.data(), value.size());
+        return *this;
+    }
+
+    /**
+     * @brief Write an integer value using the smallest encoding
+     */
+    MsgPackWriter& integer(int64_t value) {
+        if (value >= 0) {
+            uint64_t u = static_cast<uint64_t>(value);
+            if (u < 0x80) {
+                m_buffer += static_cast<char>(u);
+            } else if (u <= 0xff) {
+                m_buffer += static_cast<char>(0xcc);
+                appendBigEndian(u, 1);
+            } else if (u <= 0xffff) {
+                m_buffer += static_cast<char>(0xcd);
+                appendBigEndian(u, 2);
+            } else if (u <= 0xffffffffULL) {
+                m_buffer += static_cast<char>(0xce);
+                appendBigEndian(u, 4);
+            } else {
+                m_buffer += static_cast<char>(0xcf);
+                appendBigEndian(u, 8);
+            }
+        } else if (value >= -32) {
+            m_buffer += static_cast<char>(static_cast<uint8_t>(value));
+        } else if (value >= std::numeric_limits<int8_t>::min()) {
+            m_buffer += static_cast<char>(0xd0);
+            appendBigEndian(static_cast<uint64_t>(value), 1);
+        } else if (value >= std::numeric_limits<int16_t>::min()) {
+            m_buffer += static_cast<char>(0xd1);
+            appendBigEndian(static_cast<uint64_t>(value), 2);
+        } else if (value >= std::numeric_limits<int32_t>::min()) {
+            m_buffer += static_cast<char>(0xd2);
+            appendBigEndian(static_cast<uint64_t>(value), 4);
+        } else {
+            m_buffer += static_cast<char>(0xd3);
+            appendBigEndian(static_cast<uint64_t>(value), 8);
+        }
+        return *this;
+    }
+
+    /**
+     * @brief Write a floating-point value (float32 when exact, float64 otherwise)
+     */
+    MsgPackWriter& number(double value) {
+        float narrow = static_cast<float>(value);
+        if (static_cast<double>(narrow) == value) {
+            uint32_t bits;
+            std::memcpy(&bits, &narrow, sizeof(bits));
+            m_buffer += static_cast<char>(0xca);
+            appendBigEndian(bits, 4);
+        } else {
+            uint64_t bits;
+            std::memcpy(&bits, &value, sizeof(bits));
+            m_buffer += static_cast<char>(0xcb);
+            appendBigEndian(bits, 8);
+        }
+        return *this;
+    }
+
+    /**
+     * @brief Write a boolean value
+     */
+    MsgPackWriter& boolean(bool value) {
+        m_buffer += static_cast<char>(value ? 0xc3 : 0xc2);
+        return *this;
+    }
+
+    /**
+     * @brief Write nil
+     */
+    MsgPackWriter& null() {
+        m_buffer += static_cast<char>(0xc0);
+        return *this;
+    }
+
+    /**
+     * @brief Write a complete JsonValue tree
+     */
+    MsgPackWriter& value(const JsonValue& value) {
+        switch (value.type()) {
+            case JsonType::Null: return null();
+            case JsonType::Boolean: return boolean(value.asBool());
+            case JsonType::Integer: return integer(value.asInt());
+            case JsonType::Float: return number(value.asFloat());
+            case JsonType::String: return string(value.asStringRef());
+            case JsonType::Array: {
+                const auto& arr = value.asArray();
+                startArray(arr.size());
+                for (const auto& element : arr) {
+                    this->value(element);
+                }
+                return *this;
+            }
+            case JsonType::Object: {
+                const auto& obj = value.asObject();
+                startObject(obj.size());
+                for (const auto& [name, member] : obj) {
+                    key(name);
+                    this->value(member);
+                }
+                return *this;
+            }
+        }
+        return *this;
+    }
+
+    /**
+     * @brief Get the encoded bytes
+     */
+    const std::string& str() const { return m_buffer; }
+
+    /**
+     * @brief Take the encoded bytes, leaving the writer empty
+     */
+    std::string release() { return std::move(m_buffer); }
+
+    /**
+     * @brief Discard encoded bytes
+     */
+    void clear() { m_buffer.clear(); }
+
+    /**
+     * @brief Reserve buffer capacity
+     */
+    void reserve(size_t bytes) { m_buffer.reserve(bytes); }
+
+private:
+    std::string m_buffer;
+
+    void appendBigEndian(uint64_t value, int bytes) {
+        for (int shift = (bytes - 1) * 8; shift >= 0; shift -= 8) {
+            m_buffer += static_cast<char>((value >> shift) & 0xff);
+        }
+    }
+
+    /**
+     * @brief Write a fix/16-bit/32-bit length header
+     * @param fixLimit Largest length stored in the fix form (0 for none)
+     */
+    void writeHeader(size_t length, uint8_t fixTag, uint8_t tag16, uint8_t tag32, size_t fixLimit) {
+        if (length < fixLimit) {
+            m_buffer += static_cast<char>(fixTag | length);
+        } else if (length <= 0xffff) {
+            m_buffer += static_cast<char>(tag16);
+            appendBigEndian(length, 2);
+        } else if (length <= 0xffffffffULL) {
+            m_buffer += static_cast<char>(tag32);
+            appendBigEndian(length, 4);
+        } else {
+            throw std::runtime_error("MessagePack encode error: length exceeds 32 bits");
+        }
+    }
+};
+
+/**
+ * @brief One decoded MessagePack token
+ */
+struct MsgPackToken {
+    JsonType type = JsonType::Null;
+    bool boolean = false;
+    int64_t integer = 0;
+    double number = 0.0;
+    std::string_view string;  ///< Points into the input buffer
+    uint32_t count = 0;       ///< Elements (array) or members (object)
+};
+
+/**
+ * @brief Pull decoder over a MessagePack buffer
+ *
+ * Decodes tokens without copying (strings are views into the input) and can
+ * replay values as JsonHandler events, so the same handler works for JSON
+ * text (JsonReader) and binary input. Several values may be stored back to
+ * back; read them one at a time until atEnd().
+ *
+ * Binary (bin 8/16/32) values decode as strings; unsigned integers above
+ * INT64_MAX decode as floats. Extension types are rejected.
+ */
+class MsgPackReader {
+public:
+    /// Default maximum nesting depth for event and tree decoding
+    static constexpr size_t DefaultMaxDepth = 1024;
+
+    /**
+     * @brief Create a reader over encoded bytes
+     * @param data Encoded input (must outlive the reader)
+     */
+    explicit MsgPackReader(std::string_view data) : m_data(data) {}
+
+    /**
+     * @brief Decode the next token
+     * @param token Receives the token
+     * @throws std::runtime_error on truncated or unsupported input
+     */
+    void next(MsgPackToken& token) {
+        uint8_t tag = readByte();
+        token.type = JsonType::Null;
+
+        if (tag < 0x80) {
+            setInteger(token, tag);
+        } else if (tag >= 0xe0) {
+            setInteger(token, static_cast<int8_t>(tag));
+        } else if ((tag & 0xf0) == 0x80) {
+            setContainer(token, JsonType::Object, tag & 0x0f);
+        } else if ((tag & 0xf0) == 0x90) {
+            setContainer(token, JsonType::Array, tag & 0x0f);
+        } else if ((tag & 0xe0) == 0xa0) {
+            setString(token, tag & 0x1f);
+        } else {
+            switch (tag) {
+                case 0xc0: token.type = JsonType::Null; break;
+                case 0xc2: token.type = JsonType::Boolean; token.boolean = false; break;
+                case 0xc3: token.type = JsonType::Boolean; token.boolean = true; break;
+                case 0xc4: case 0xd9: setString(token, readBigEndian(1)); break;
+                case 0xc5: case 0xda: setString(token, readBigEndian(2)); break;
+                case 0xc6: case 0xdb: setString(token, readBigEndian(4)); break;
+                case 0xca: {
+                    uint32_t bits = static_cast<uint32_t>(readBigEndian(4));
+                    float value;
+                    std::memcpy(&value, &bits, sizeof(value));
+                    setFloat(token, value);
+                    break;
+                }
+                case 0xcb: {
+                    uint64_t bits = readBigEndian(8);
+                    double value;
+                    std::memcpy(&value, &bits, sizeof(value));
+                    setFloat(token, value);
+                    break;
+                }
+                case 0xcc: setInteger(token, static_cast<int64_t>(readBigEndian(1))); break;
+                case 0xcd: setInteger(token, static_cast<int64_t>(readBigEndian(2))); break;
+                case 0xce: setInteger(token, static_cast<int64_t>(readBigEndian(4))); break;
+                case 0xcf: {
+                    uint64_t value = readBigEndian(8);
+                    if (value > static_cast<uint64_t>(std::numeric_limits<int64_t>::max())) {
+                        setFloat(token, static_cast<double>(value));
+                    } else {
+                        setInteger(token, static_cast<int64_t>(value));
+                    }
+                    break;
+                }
+                case 0xd0: setInteger(token, static_cast<int8_t>(readBigEndian(1))); break;
+                case 0xd1: setInteger(token, static_cast<int16_t>(readBigEndian(2))); break;
+                case 0xd2: setInteger(token, static_cast<int32_t>(readBigEndian(4))); break;
+                case 0xd3: setInteger(token, static_cast<int64_t>(readBigEndian(8))); break;
+                case 0xdc: setContainer(token, JsonType::Array, readBigEndian(2)); break;
+                case 0xdd: setContainer(token, JsonType::Array, readBigEndian(4)); break;
+                case 0xde: setContainer(token, JsonType::Object, readBigEndian(2)); break;
+                case 0xdf: setContainer(token, JsonType::Object, readBigEndian(4)); break;
+                default:
+                    fail("Unsupported type 0x" + hex(tag), m_pos - 1);
+            }
+        }
+    }
+
+    /**
+     * @brief Skip one complete value without decoding its contents
+     */
+    void skip() {
+        MsgPackToken token;
+        uint64_t pending = 1;
+        while (pending > 0) {
+            next(token);
+            --pending;
+            if (token.type == JsonType::Array) {
+                pending += token.count;
+            } else if (token.type == JsonType::Object) {
+                pending += 2ULL * token.count;
+            }
+        }
+    }
+
+    /**
+     * @brief Decode one value, emitting JsonHandler events
+     * @param handler Event receiver (SkipValue and Stop are honoured)
+     * @param maxDepth Maximum container nesting
+     * @return false if the handler requested a stop
+     * @throws std::runtime_error on malformed input
+     */
+    bool read(JsonHandler& handler, size_t maxDepth = DefaultMaxDepth) {
+        m_stopped = false;
+        readValue(handler, 0, maxDepth, false);
+        return !m_stopped;
+    }
+
+    /**
+     * @brief Decode one value into a JsonValue tree
+     * @param maxDepth Maximum container nesting
+     * @throws std::runtime_error on malformed input
+     */
+    JsonValue readValue(size_t maxDepth = DefaultMaxDepth) {
+        return buildValue(0, maxDepth);
+    }
+
+    /**
+     * @brief Check whether all input has been consumed
+     */
+    bool atEnd() const { return m_pos >= m_data.size(); }
+
+    /**
+     * @brief Get the current byte offset
+     */
+    size_t position() const { return m_pos; }
+
+private:
+    std::string_view m_data;
+    size_t m_pos = 0;
+    bool m_stopped = false;
+
+    [[noreturn]] static void fail(const std::string& what, size_t pos) {
+        throw std::runtime_error("MessagePack decode error: " + what + " at offset " +
+                                 std::to_string(pos));
+    }
+
+    static std::string hex(uint8_t value) {
+        const char digits[] = "0123456789abcdef";
+        return std::string{digits[value >> 4], digits[value & 0x0f]};
+    }
+
+    void require(size_t bytes) const {
+        if (m_data.size() - m_pos < bytes) {
+            fail("Unexpected end of input", m_data.size());
+        }
+    }
+
+    uint8_t readByte() {
+        require(1);
+        return static_cast<uint8_t>(m_data[m_pos++]);
+    }
+
+    uint64_t readBigEndian(int bytes) {
+        require(static_cast<size_t>(bytes));
+        uint64_t value = 0;
+        for (int i = 0; i < bytes; ++i) {
+            value = (value << 8) | static_cast<uint8_t>(m_data[m_pos++]);
+        }
+        return value;
+    }
+
+    static void setInteger(MsgPackToken& token, int64_t value) {
+        token.type = JsonType::Integer;
+        token.integer = value;
+    }
+
+    static void setFloat(MsgPackToken& token, double value) {
+        token.type = JsonType::Float;
+        token.number = value;
+    }
+
+    void setString(MsgPackToken& token, uint64_t length) {
+        require(static_cast<size_t>(length));
+        token.type = JsonType::String;
+        token.string = m_data.substr(m_pos, static_cast<size_t>(length));
+        m_pos += static_cast<size_t>(length);
+    }
+
+    static void setContainer(MsgPackToken& token, JsonType type, uint64_t count) {
+        token.type = type;
+        token.count = static_cast<uint32_t>(count);
+    }
+
+    /**
+     * @brief Upper bound for reserving space for @p count children
+     *
+     * Every encoded value takes at least one byte, so a hostile count cannot
+     * trigger a huge allocation.
+     */
+    size_t reserveHint(uint32_t count) const {
+        return std::min<size_t>(count, m_data.size() - m_pos);
+    }
+
+    std::string_view readKey(MsgPackToken& token) {
+        size_t pos = m_pos;
+        next(token);
+        if (token.type != JsonType::String) {
+            fail("Object key is not a string", pos);
+        }
+        return token.string;
+    }
+
+    JsonValue buildValue(size_t depth, size_t maxDepth) {
+        MsgPackToken token;
+        size_t pos = m_pos;
+        next(token);
+
+        switch (token.type) {
+            case JsonType::Null: return JsonValue(nullptr);
+            case JsonType::Boolean: return JsonValue(token.boolean);
+            case JsonType::Integer: return JsonValue(token.integer);
+            case JsonType::Float: return JsonValue(token.number);
+            case JsonType::String: return JsonValue(std::string(token.string));
+            case JsonType::Array: {
+                if (depth >= maxDepth) {
+                    fail("Maximum nesting depth exceeded", pos);
+                }
+                JsonArray arr;
+                arr.reserve(reserveHint(token.count));
+                for (uint32_t i = 0; i < token.count; ++i) {
+                    arr.push_back(buildValue(depth + 1, maxDepth));
+                }
+                return JsonValue(std::move(arr));
+            }
+            case JsonType::Object: {
+                if (depth >= maxDepth) {
+                    fail("Maximum nesting depth exceeded", pos);
+                }
+                JsonObject obj;
+                for (uint32_t i = 0, count = token.count; i < count; ++i) {
+                    std::string key(readKey(token));
+                    // Members written from a JsonObject arrive sorted, so the end hint is usually exact
+                    obj.insert_or_assign(obj.end(), std::move(key), buildValue(depth + 1, maxDepth));
+                }
+                return JsonValue(std::move(obj));
+            }
+        }
+        return JsonValue();
+    }
+
+    /**
+     * @brief Apply a handler result
+     * @return true if the current value should be skipped
+     */
+    bool apply(JsonReadAction action) {
+        if (action == JsonReadAction::Stop) {
+            m_stopped = true;
+        }
+        return action == JsonReadAction::SkipValue;
+    }
+
+    void readValue(JsonHandler& handler, size_t depth, size_t maxDepth, bool skipped) {
+        if (skipped) {
+            skip();
+            return;
+        }
+
+        MsgPackToken token;
+        size_t pos = m_pos;
+        next(token);
+
+        switch (token.type) {
+            case JsonType::Null: apply(handler.onNull()); return;
+            case JsonType::Boolean: apply(handler.onBool(token.boolean)); return;
+            case JsonType::Integer: apply(handler.onInt(token.integer)); return;
+            case JsonType::Float: apply(handler.onFloat(token.number)); return;
+            case JsonType::String: apply(handler.onString(token.string)); return;
+            case JsonType::Array:
+            case JsonType::Object:
+                break;
+        }
+
+        bool isObject = token.type == JsonType::Object;
+        uint64_t remaining = isObject ? 2ULL * token.count : token.count;
+        if (apply(isObject ? handler.onStartObject() : handler.onStartArray())) {
+            // Skip the children that follow the header
+            for (uint64_t i = 0; i < remaining; ++i) {
+                skip();
+            }
+            return;
+        }
+        if (depth >= maxDepth) {
+            fail("Maximum nesting depth exceeded", pos);
+        }
+
+        for (uint32_t i = 0; i < token.count && !m_stopped; ++i) {
+            bool skipChild = false;
+            if (isObject) {
+                MsgPackToken keyToken;
+                skipChild = apply(handler.onKey(readKey(keyToken)));
+                if (m_stopped) {
+                    return;
+                }
+            }
+            readValue(handler, depth + 1, maxDepth, skipChild);
+        }
+        if (!m_stopped) {
+            apply(isObject ? handler.onEndObject() : handler.onEndArray());
+        }
+    }
+};
+
+/**
+ * @brief One-shot MessagePack conversions for JsonValue
+ */
+class MsgPack {
+public:
+    /**
+     * @brief Encode a value
+     * @param value Value to encode
+     * @return Encoded bytes
+     */
+    static std::string encode(const JsonValue& value) {
+        MsgPackWriter writer;
+        writer.value(value);
+        return writer.release();
+    }
+
+    /**
+     * @brief Decode a single value
+     * @param data Encoded bytes (exactly one value)
+     * @return Decoded value
+     * @throws std::runtime_error if the input is malformed or has trailing bytes
+     */
+    static JsonValue decode(std::string_view data) {
+        MsgPackReader reader(data);
+        JsonValue value = reader.readValue();
+        if (!reader.atEnd()) {
+            throw std::runtime_error("MessagePack decode error: Trailing data at offset " +
+                                     std::to_string(reader.position()));
+        }
+        return value;
+    }
+};
+
+} // namespace mcf
@@ -0,0 +1,463 @@
+/**
+ * @file Ndjson.hpp
+ * @brief Newline-delimited JSON (NDJSON) reader and writer
+ *
+ * NDJSON holds one JSON document per line; metric exports and event dumps
+ * use it so files can be appended to and processed record by record. The
+ * reader cuts its input into line-aligned batches that are parsed in
+ * parallel on a ThreadPool and delivered in file order; the writer batches
+ * serialized records into large writes.
+ */
+
+#pragma once
+
+#include "JsonParser.hpp"
+#include "JsonValue.hpp"
+#include "JsonWriter.hpp"
+#include "ThreadPool.hpp"
+
+#include <algorithm>
+#include <deque>
+#include <fstream>
+#include <functional>
+#include <future>
+#include <istream>
+#include <ostream>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace mcf {
+
+/**
+ * @brief Batching and read-ahead limits of an NdjsonReader
+ */
+struct NdjsonReadOptions {
+    size_t batchBytes = 256 * 1024;  ///< Target input bytes per batch (cut at a line end)
+    size_t maxInFlight = 0;          ///< Batches read ahead; 0 = two per pool thread
+};
+
+/**
+ * @brief Ordered, parallel NDJSON reader
+ *
+ * Features:
+ * - Reads a memory buffer (e.g. a mapped file) in place or a std::istream
+ *   chunk by chunk
+ * - Line-aligned batches parsed concurrently on a ThreadPool, records
+ *   delivered in input order
+ * - Bounded memory: at most maxInFlight batches are read ahead
+ * - Blank lines (including "\r\n" endings) are skipped
+ *
+ * A malformed line throws std::runtime_error from next() once all records
+ * before it have been delivered; the message names the 1-based line.
+ *
+ * Usage:
+ * @code
+ * std::ifstream in("events.ndjson", std::ios::binary);
+ * NdjsonReader reader(in, &pool);
+ * JsonValue record;
+ * while (reader.next(record)) {
+ *     handle(record);
+ * }
+ * @endcode
+ */
+class NdjsonReader {
+public:
+    using Options = NdjsonReadOptions;
+
+    /**
+     * @brief Callback receiving each record; return false to stop reading
+     */
+    using RecordCallback = std::function<bool(JsonValue& record)>;
+
+    /**
+     * @brief Read records from a stream
+     * @param in Input stream (must outlive the reader)
+     * @param pool Thread pool to parse on, or nullptr to parse on the caller's thread
+     * @param options Batching and read-ahead limits
+     */
+    NdjsonReader(std::istream& in, ThreadPool* pool = nullptr, Options options = Options())
+        : m_stream(&in), m_pool(pool), m_options(options) {
+        init();
+    }
+
+    /**
+     * @brief Read records from a buffer in place
+     * @param data NDJSON text (must outlive the reader)
+     * @param pool Thread pool to parse on, or nullptr to parse on the caller's thread
+     * @param options Batching and read-ahead limits
+     */
+    NdjsonReader(std::string_view data, ThreadPool* pool = nullptr, Options options = Options())
+        : m_data(data), m_pool(pool), m_options(options) {
+        init();
+    }
+
+    /**
+     * @brief Wait for batches still being parsed (they may reference the input)
+     */
+    ~NdjsonReader() {
+        for (auto& pending : m_pending) {
+            if (pending.valid()) pending.wait();
+        }
+    }
+
+    NdjsonReader(const NdjsonReader&) = delete;
+    NdjsonReader& operator=(const NdjsonReader&) = delete;
+
+    /**
+     * @brief Get the next record in input order
+     * @param record Receives the record
+     * @return false once the input is exhausted
+     * @throws std::runtime_error if a line is not valid JSON
+     */
+    bool next(JsonValue& record) {
+        while (m_index >= m_current.records.size()) {
+            if (!m_current.error.empty()) {
+                std::string error = "NDJSON error on line " +
+                                    std::to_string(m_lineBase + m_current.errorLine + 1) + ": " +
+                                    m_current.error;
+                m_current.error.clear();
+                throw std::runtime_error(error);
+            }
+
+            m_lineBase += m_current.lineCount;
+            m_current = BatchResult();
+            m_index = 0;
+
+            fill();
+            if (m_pending.empty()) {
+                return false;
+            }
+            m_current = m_pending.front().get();
+            m_pending.pop_front();
+        }
+
+        m_line = m_lineBase + m_current.lines[m_index] + 1;
+        record = std::move(m_current.records[m_index++]);
+        return true;
+    }
+
+    /**
+     * @brief Get the 1-based line of the last record returned by next()
+     */
+    size_t lineNumber() const { return m_line; }
+
+    /**
+     * @brief Read every record of a stream
+     * @param in Input stream
+     * @param callback Receives each record; return false to stop
+     * @param pool Thread pool to parse on, or nullptr
+     * @param options Batching and read-ahead limits
+     * @return Number of records delivered
+     * @throws std::runtime_error if a line is not valid JSON
+     */
+    static size_t forEach(std::istream& in, const RecordCallback& callback,
+                          ThreadPool* pool = nullptr, Options options = Options()) {
+        NdjsonReader reader(in, pool, options);
+        return reader.drain(callback);
+    }
+
+    /**
+     * @brief Read every record of a buffer
+     * @param data NDJSON text
+     * @param callback Receives each record; return false to stop
+     * @param pool Thread pool to parse on, or nullptr
+     * @param options Batching and read-ahead limits
+     * @return Number of records delivered
+     * @throws std::runtime_error if a line is not valid JSON
+     */
+    static size_t forEach(std::string_view data, const RecordCallback& callback,
+                          ThreadPool* pool = nullptr, Options options = Options()) {
+        NdjsonReader reader(data, pool, options);
+        return reader.drain(callback);
+    }
+
+    /**
+     * @brief Read every record of a file
+     * @param filename Path to the NDJSON file
+     * @param callback Receives each record; return false to stop
+     * @param pool Thread pool to parse on, or nullptr
+     * @param options Batching and read-ahead limits
+     * @return Number of records delivered
+     * @throws std::runtime_error if the file cannot be opened or a line is not valid JSON
+     */
+    static size_t readFile(const std::string& filename, const RecordCallback& callback,
+                           ThreadPool* pool = nullptr, Options options = Options()) {
+        std::ifstream file(filename, std::ios::binary);
+        if (!file.is_open()) {
+            throw std::runtime_error("Failed to open file: " + filename);
+        }
+        return forEach(file, callback, pool, options);
+    }
+
+private:
+    /**
+     * @brief Line-aligned slice of the input
+     */
+    struct Batch {
+        std::string owned;          ///< Copied stream input
+        std::string_view borrowed;  ///< Slice of an in-place buffer
+
+        std::string_view text() const { return owned.empty() ? borrowed : std::string_view(owned); }
+    };
+
+    /**
+     * @brief Parsed records of one batch (line numbers relative to the batch)
+     */
+    struct BatchResult {
+        std::vector<JsonValue> records;
+        std::vector<size_t> lines;
+        size_t lineCount = 0;
+        std::string error;
+        size_t errorLine = 0;
+    };
+
+    std::istream* m_stream = nullptr;
+    std::string_view m_data;
+    size_t m_offset = 0;
+    std::string m_carry;  // Partial last line of the previous stream chunk
+    ThreadPool* m_pool;
+    Options m_options;
+
+    std::deque<std::future<BatchResult>> m_pending;
+    BatchResult m_current;
+    size_t m_index = 0;
+    size_t m_lineBase = 0;
+    size_t m_line = 0;
+
+    void init() {
+        m_options.batchBytes = std::max<size_t>(m_options.batchBytes, 1);
+        if (m_options.maxInFlight == 0) {
+            m_options.maxInFlight = m_pool ? m_pool->getThreadCount() * 2 : 1;
+        }
+    }
+
+    size_t drain(const RecordCallback& callback) {
+        size_t count = 0;
+        JsonValue record;
+        while (next(record)) {
+            ++count;
+            if (!callback(record)) break;
+        }
+        return count;
+    }
+
+    /**
+     * @brief Read ahead until maxInFlight batches are pending or input ends
+     */
+    void fill() {
+        while (m_pending.size() < m_options.maxInFlight) {
+            Batch batch;
+            if (!readBatch(batch)) {
+                return;
+            }
+
+            if (m_pool) {
+                m_pending.push_back(m_pool->submit([batch = std::move(batch)]() {
+                    return parseBatch(batch.text());
+                }));
+            } else {
+                std::promise<BatchResult> parsed;
+                parsed.set_value(parseBatch(batch.text()));
+                m_pending.push_back(parsed.get_future());
+            }
+        }
+    }
+
+    /**
+     * @brief Cut the next batch, ending at a line boundary
+     * @return false at end of input
+     */
+    bool readBatch(Batch& batch) {
+        if (!m_stream) {
+            if (m_offset >= m_data.size()) {
+                return false;
+            }
+            size_t target = std::min(m_offset + m_options.batchBytes, m_data.size());
+            size_t newline = target < m_data.size() ? m_data.find('\n', target - 1) : std::string_view::npos;
+            size_t end = newline == std::string_view::npos ? m_data.size() : newline + 1;
+            batch.borrowed = m_data.substr(m_offset, end - m_offset);
+            m_offset = end;
+            return true;
+        }
+
+        std::string& text = batch.owned;
+        text = std::move(m_carry);
+        m_carry.clear();
+
+        // Lines longer than a batch keep reading until their newline
+        while (true) {
+            size_t start = text.size();
+            text.resize(start + m_options.batchBytes);
+            m_stream->read(&text[start], static_cast<std::streamsize>(m_options.batchBytes));
+            text.resize(start + static_cast<size_t>(m_stream->gcount()));
+
+            if (text.size() == start) {
+                break;  // End of stream
+            }
+            size_t newline = text.rfind('\n');
+            if (newline != std::string::npos && newline >= start) {
+                m_carry.assign(text, newline + 1, std::string::npos);
+                text.resize(newline + 1);
+                break;
+            }
+        }
+        return !text.empty();
+    }
+
+    /**
+     * @brief Parse every line of a batch (runs on pool threads)
+     */
+    static BatchResult parseBatch(std::string_view text) {
+        BatchResult result;
+        size_t pos = 0;
+        size_t line = 0;
+
+        while (pos < text.size()) {
+            size_t newline = text.find('\n', pos);
+            size_t end = newline == std::string_view::npos ? text.size() : newline;
+            std::string_view content = text.substr(pos, end - pos);
+
+            if (content.find_first_not_of(" \t\r") != std::string_view::npos) {
+                try {
+                    result.records.push_back(JsonParser::parse(content));
+                    result.lines.push_back(line);
+                } catch (const std::exception& e) {
+                    result.error = e.what();
+                    result.errorLine = line;
+                    return result;
+                }
+            }
+
+            if (newline == std::string_view::npos) {
+                break;
+            }
+            ++line;
+            pos = newline + 1;
+        }
+
+        result.lineCount = line;
+        return result;
+    }
+};
+
+/**
+ * @brief Batched NDJSON writer
+ *
+ * Records are serialized compactly into one buffer and written out once it
+ * reaches batchBytes, so output costs one write per batch rather than per
+ * record. Records can be whole JsonValues or built with the JsonWriter
+ * streaming API (or JsonBinding::write) followed by endRecord().
+ *
+ * Usage:
+ * @code
+ * std::ofstream out("metrics.ndjson", std::ios::binary);
+ * NdjsonWriter writer(out);
+ * writer.write(record);
+ * writer.json().startObject().key("id").integer(7).endObject();
+ * writer.endRecord();
+ * writer.flush();
+ * @endcode
+ */
+class NdjsonWriter {
+public:
+    /// Default buffered bytes that trigger a write
+    static constexpr size_t DefaultBatchBytes = 64 * 1024;
+
+    /**
+     * @brief Write records to a stream
+     * @param out Output stream (must outlive the writer)
+     * @param batchBytes Buffered bytes that trigger a write
+     */
+    explicit NdjsonWriter(std::ostream& out, size_t batchBytes = DefaultBatchBytes)
+        : m_out(&out), m_batchBytes(batchBytes) {
+        m_writer.reserve(batchBytes + batchBytes / 4);
+    }
+
+    /**
+     * @brief Write records to a file descriptor
+     * @param fd Open, writable descriptor (not closed by the writer)
+     *
+     * The descriptor is written whenever JsonWriter::FlushThreshold bytes are buffered.
+     */
+    explicit NdjsonWriter(int fd)
+        : m_writer(fd, JsonWriter::Style::Compact) {}
+
+    /**
+     * @brief Write out remaining records (errors are ignored)
+     *
+     * Call flush() explicitly to observe write errors.
+     */
+    ~NdjsonWriter() {
+        try {
+            flush();
+        } catch (...) {
+        }
+    }
+
+    NdjsonWriter(const NdjsonWriter&) = delete;
+    NdjsonWriter& operator=(const NdjsonWriter&) = delete;
+
+    /**
+     * @brief Append one record
+     * @param record Value written on its own line
+     */
+    void write(const JsonValue& record) {
+        m_writer.value(record);
+        endRecord();
+    }
+
+    /**
+     * @brief Access the underlying writer to build a record in place
+     * @return Compact writer; call endRecord() once the value is complete
+     */
+    JsonWriter& json() { return m_writer; }
+
+    /**
+     * @brief Terminate the record built through json()
+     * @throws std::runtime_error if the record is still open
+     */
+    void endRecord() {
+        if (m_writer.depth() != 0) {
+            throw std::runtime_error("NDJSON record ended inside an open container");
+        }
+        m_writer.raw("\n");
+        ++m_records;
+        if (m_out && m_writer.str().size() >= m_batchBytes) {
+            flush();
+        }
+    }
+
+    /**
+     * @brief Write buffered records to the output
+     * @throws std::runtime_error if the write fails
+     */
+    void flush() {
+        if (!m_out) {
+            m_writer.flush();
+            return;
+        }
+        if (m_writer.str().empty()) {
+            return;
+        }
+        m_out->write(m_writer.str().data(), static_cast<std::streamsize>(m_writer.str().size()));
+        m_writer.clear();
+        if (!*m_out) {
+            throw std::runtime_error("Failed to write NDJSON output");
+        }
+    }
+
+    /**
+     * @brief Get the number of records written (including buffered ones)
+     */
+    size_t recordCount() const { return m_records; }
+
+private:
+    JsonWriter m_writer;
+    std::ostream* m_out = nullptr;
+    size_t m_batchBytes = DefaultBatchBytes;
+    size_t m_records = 0;
+};
+
+} // namespace mcf
@@ -2,7 +2,7 @@
 
 #include "DependencyResolver.hpp"
 #include "EventBus.hpp"
-#include "FileWatcher.hpp"
+#include "FileWatchService.hpp"
 #include "IPlugin.hpp"
 #include "Logger.hpp"
 #include "PluginContext.hpp"
@@ -53,9 +53,12 @@ private:
     ConfigurationManager* m_configManager = nullptr;
 
     // Hot reload support
-    std::unique_ptr<FileWatcher> m_fileWatcher;
+    std::unique_ptr<FileWatchService> m_ownWatchService;  // Created by enableHotReload() without a shared service
+    FileWatchService* m_watchService = nullptr;            // Set while hot reload is enabled or a service was given
     bool m_hotReloadEnabled = false;
+    std::chrono::milliseconds m_hotReloadSettleTime{200};
     std::map<std::string, std::string> m_pluginPaths;  // plugin name -> file path
+    std::map<std::string, FileWatchId> m_pluginWatches; // plugin name -> hot reload subscription
     std::map<std::string, std::string> m_pluginStates; // plugin name -> serialized state
 
     // Application control (avoid circular dependency)
@@ -73,8 +76,7 @@ private:
 
     // Private constructor for singleton
     PluginManager()
-        : m_fileWatcher(std::make_unique<FileWatcher>())
-        , m_logger(LoggerRegistry::instance().getLogger("PluginManager"))
+        : m_logger(LoggerRegistry::instance().getLogger("PluginManager"))
     {}
 
 public:
@@ -174,9 +176,7 @@ public:
 
             // Setup file watching if hot reload is enabled
             if (m_hotReloadEnabled) {
-                m_fileWatcher->addWatch(path, [this](const std::string& p, FileChangeType ct) {
-                    onPluginFileChanged(p, ct);
-                });
+                watchPlugin(name);
             }
 
             // Resolve dependencies and update load order
@@ -291,6 +291,7 @@ public:
 
         // Remove from maps
         m_plugins.erase(it);
+        unwatchPlugin(name);
         m_resolver.removePlugin(name);
 
         // Update load order
@@ -317,6 +318,11 @@ public:
         m_plugins.clear();
         m_loadOrder.clear();
         m_resolver.clear();
+
+        for (const auto& [name, id] : m_pluginWatches) {
+            m_watchService->unwatch(id);
+        }
+        m_pluginWatches.clear();
     }
 
 
@@ -379,17 +385,27 @@ public:
     /**
      * @brief Enable hot reload monitoring for plugins
      * @param pollInterval How often to check for file changes (milliseconds)
+     * @param settleTime How long a plugin file must stay unchanged before it
+     *        is reloaded, so libraries still being written by the linker are
+     *        not loaded half-finished
      */
-    void enableHotReload(std::chrono::milliseconds pollInterval = std::chrono::milliseconds(1000)) {
+    void enableHotReload(std::chrono::milliseconds pollInterval = std::chrono::milliseconds(1000),
+                         std::chrono::milliseconds settleTime = std::chrono::milliseconds(200)) {
         std::lock_guard<std::mutex> lock(m_mutex);
 
         if (m_hotReloadEnabled) {
             return;
         }
 
-        m_fileWatcher->setPollInterval(pollInterval);
-        m_fileWatcher->start();
+        m_hotReloadSettleTime = settleTime;
+        if (!m_watchService) {
+            m_watchService = ownWatchService();
+        }
+        m_watchService->requestPollInterval(pollInterval);
         m_hotReloadEnabled = true;
+        for (const auto& entry : m_plugins) {
+            watchPlugin(entry.first);
+        }
     }
 
     /**
@@ -402,10 +418,45 @@ public:
             return;
         }
 
-        m_fileWatcher->stop();
+        for (const auto& [name, id] : m_pluginWatches) {
+            m_watchService->unwatch(id);
+        }
+        m_pluginWatches.clear();
         m_hotReloadEnabled = false;
     }
 
+    /**
+     * @brief Watch plugin files through a shared watch service
+     * @param service Service that must outlive its use here, or nullptr to
+     *        go back to the manager's own watcher
+     *
+     * Application passes its FileWatchService so that hot reload shares the
+     * watcher thread with the other subsystems. Active watches move to the
+     * new service. The manager's own watcher is only created when hot
+     * reload is enabled without a shared service.
+     */
+    void setFileWatchService(FileWatchService* service) {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        FileWatchService* next = service;
+        if (!next && m_hotReloadEnabled) {
+            next = ownWatchService();
+        }
+        if (next == m_watchService) {
+            return;
+        }
+
+        for (const auto& [name, id] : m_pluginWatches) {
+            m_watchService->unwatch(id);
+        }
+        m_pluginWatches.clear();
+        m_watchService = next;
+        if (m_hotReloadEnabled) {
+            for (const auto& entry : m_plugins) {
+                watchPlugin(entry.first);
+            }
+        }
+    }
+
     /**
      * @brief Check if hot reload is enabled
      * @return true if hot reload file monitoring is active, false otherwise
@@ -648,6 +699,47 @@ private:
         }
     }
 
+    /**
+     * @brief Get the manager's own watch service, creating it on first use (must be called with lock held)
+     *
+     * Created lazily because a FileWatchService opens inotify/eventfd
+     * descriptors and starts a thread, which most applications never need.
+     */
+    FileWatchService* ownWatchService() {
+        if (!m_ownWatchService) {
+            m_ownWatchService = std::make_unique<FileWatchService>();
+        }
+        return m_ownWatchService.get();
+    }
+
+    /**
+     * @brief Subscribe to changes of a plugin's file (must be called with lock held)
+     */
+    void watchPlugin(const std::string& name) {
+        auto path = m_pluginPaths.find(name);
+        if (path == m_pluginPaths.end()) {
+            return;
+        }
+        unwatchPlugin(name);
+
+        FileWatchOptions options;
+        options.settleTime = m_hotReloadSettleTime;
+        m_pluginWatches[name] = m_watchService->watchFile(path->second, [this](const std::string& p, FileChangeType ct) {
+            onPluginFileChanged(p, ct);
+        }, options);
+    }
+
+    /**
+     * @brief Remove the hot reload subscription of a plugin (must be called with lock held)
+     */
+    void unwatchPlugin(const std::string& name) {
+        auto watch = m_pluginWatches.find(name);
+        if (watch != m_pluginWatches.end()) {
+            m_watchService->unwatch(watch->second);
+            m_pluginWatches.erase(watch);
+        }
+    }
+
     /**
      * @brief Callback for file watcher
      */
@@ -1,5 +1,7 @@
 #pragma once
 
+#include "FileWatchService.hpp"
+
 #include <any>
 #include <functional>
 #include <map>
@@ -9,6 +11,7 @@
 #include <string>
 #include <typeindex>
 #include <unordered_map>
+#include <vector>
 
 namespace mcf {
 
@@ -69,6 +72,14 @@ struct ResourceInfo {
      */
     std::string pluginId;
 
+    /**
+     * @brief Reloads the resource from its path for hot reload
+     *
+     * Set for resources created by ResourceManager::load(). Returns the new
+     * resource (as stored in #resource), or an empty std::any on failure.
+     */
+    std::function<std::any()> reloader;
+
     /**
      * @brief Construct a ResourceInfo object
      * @param res Type-erased resource as std::any
@@ -110,9 +121,16 @@ private:
     // Thread safety
     mutable std::mutex m_mutex;
 
+    // Hot reload; guarded by m_watchMutex, which is never held while waiting for a callback
+    mutable std::mutex m_watchMutex;
+    FileWatchService* m_watchService = nullptr;
+    FileWatchOptions m_watchOptions;
+    std::map<std::string, FileWatchId> m_watches;  // Resource path -> subscription
+
 public:
     ResourceManager() = default;
     ~ResourceManager() {
+        disableHotReload();
         clear();
     }
 
@@ -139,7 +157,7 @@ public:
      */
     template<typename T>
     std::shared_ptr<T> load(const std::string& path) {
-        std::lock_guard<std::mutex> lock(m_mutex);
+        std::unique_lock<std::mutex> lock(m_mutex);
 
         // Check if already loaded
         auto it = m_resources.find(path);
@@ -176,8 +194,14 @@ public:
         // Store in cache
         auto info = std::make_shared<ResourceInfo>(resource, path, typeIdx);
         info->referenceCount = 1;
+        info->reloader = [loader, path]() -> std::any {
+            auto reloaded = loader(path);
+            return reloaded ? std::any(reloaded) : std::any();
+        };
         m_resources[path] = info;
 
+        lock.unlock();
+        watchResource(path);
         return resource;
     }
 
@@ -404,6 +428,125 @@ public:
 
         return paths;
     }
+
+    /**
+     * @brief Reload resources when their files change
+     * @param service Watch service; it must outlive the watches (disableHotReload() or destruction)
+     * @param options Settle time and executor of the reloads
+     *
+     * Resources created by load() are watched, including those loaded
+     * later. On a change the loader runs again and get()/load() return the
+     * new object; shared pointers to the old one stay valid. If the loader
+     * fails or returns nullptr, the old resource is kept.
+     */
+    void enableHotReload(FileWatchService& service, FileWatchOptions options = FileWatchOptions()) {
+        disableHotReload();
+        {
+            std::lock_guard<std::mutex> lock(m_watchMutex);
+            m_watchService = &service;
+            m_watchOptions = options;
+        }
+
+        std::vector<std::string> paths;
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            for (const auto& [path, info] : m_resources) {
+                if (info->reloader) {
+                    paths.push_back(path);
+                }
+            }
+        }
+        for (const auto& path : paths) {
+            watchResource(path);
+        }
+    }
+
+    /**
+     * @brief Stop reloading resources on file changes
+     *
+     * Waits for a reload that is already running.
+     */
+    void disableHotReload() {
+        FileWatchService* service;
+        std::map<std::string, FileWatchId> watches;
+        {
+            std::lock_guard<std::mutex> lock(m_watchMutex);
+            service = m_watchService;
+            watches.swap(m_watches);
+            m_watchService = nullptr;
+        }
+        for (const auto& [path, id] : watches) {
+            service->unwatch(id, true);
+        }
+    }
+
+    /**
+     * @brief Check if hot reload is enabled
+     * @return true after enableHotReload() until disableHotReload()
+     */
+    bool isHotReloadEnabled() const {
+        std::lock_guard<std::mutex> lock(m_watchMutex);
+        return m_watchService != nullptr;
+    }
+
+private:
+    /**
+     * @brief Watch a resource file if hot reload is enabled
+     */
+    void watchResource(const std::string& path) {
+        std::lock_guard<std::mutex> lock(m_watchMutex);
+        if (!m_watchService || m_watches.count(path)) {
+            return;
+        }
+        m_watches[path] = m_watchService->watchFile(path, [this](const std::string& file, FileChangeType type) {
+            if (type != FileChangeType::Deleted) {
+                reloadResource(file);
+            }
+        }, m_watchOptions);
+    }
+
+    /**
+     * @brief Run the loader of a changed resource again and swap in the result
+     *
+     * Drops the watch of a resource that is no longer loaded.
+     */
+    void reloadResource(const std::string& path) {
+        std::shared_ptr<ResourceInfo> info;
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            auto it = m_resources.find(path);
+            if (it != m_resources.end() && it->second->reloader) {
+                info = it->second;
+            }
+        }
+
+        if (!info) {
+            std::lock_guard<std::mutex> lock(m_watchMutex);
+            auto watch = m_watches.find(path);
+            if (watch != m_watches.end()) {
+                m_watchService->unwatch(watch->second);
+                m_watches.erase(watch);
+            }
+            return;
+        }
+
+        // Load outside the lock; readers keep the old resource meanwhile
+        std::any reloaded;
+        try {
+            reloaded = info->reloader();
+        } catch (const std::exception&) {
+            return;
+        }
+        if (!reloaded.has_value()) {
+            return;
+        }
+
+        std::lock_guard<std::mutex> lock(m_mutex);
+        auto it = m_resources.find(path);
+        if (it != m_resources.end() && it->second == info) {
+            info->resource = std::move(reloaded);
+        }
+    }
 };
 
 /**
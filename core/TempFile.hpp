@@ -0,0 +1,109 @@
+/**
+ * @file TempFile.hpp
+ * @brief Uniquely named temporary files for atomic file replacement
+ *
+ * Writers that replace a file atomically write a temporary file next to it
+ * and rename it over the target. A fixed name such as "<path>.tmp" lets two
+ * concurrent writers of the same path interleave their data in one file and
+ * clobbers an unrelated file of that name. TempFile names the temporary
+ * file after the target, the process id and a per-process counter, and
+ * creates it exclusively, so every writer gets a file of its own.
+ */
+
+#pragma once
+
+#include <atomic>
+#include <cerrno>
+#include <cstdint>
+#include <string>
+
+#ifdef _WIN32
+#include <fcntl.h>
+#include <io.h>
+#include <process.h>
+#include <sys/stat.h>
+#else
+#include <fcntl.h>
+#include <unistd.h>
+#endif
+
+namespace mcf {
+
+/**
+ * @brief Creation of temporary files that are renamed over a target
+ */
+class TempFile {
+public:
+    /// Attempts before create() gives up on names taken by other files
+    static constexpr int MaxAttempts = 64;
+
+    /**
+     * @brief Get a temporary file name for a target no other writer of this process uses
+     * @param path Target path; the name is in the same directory
+     * @return "<path>.<pid>.<counter>.tmp"
+     *
+     * Names are unique within the process. Another process (or a stale file
+     * of an earlier one) may still hold the name, so open it exclusively.
+     */
+    static std::string uniquePath(const std::string& path) {
+        static std::atomic<uint64_t> counter{0};
+#ifdef _WIN32
+        long pid = static_cast<long>(_getpid());
+#else
+        long pid = static_cast<long>(::getpid());
+#endif
+        return path + "." + std::to_string(pid) + "." +
+               std::to_string(counter.fetch_add(1, std::memory_order_relaxed)) + ".tmp";
+    }
+
+    /**
+     * @brief Create a new, empty temporary file for a target
+     * @param path Target path; the file is created in the same directory
+     * @param temporary Receives the temporary file's path
+     * @param mode Permissions of the new file (before the umask)
+     * @return Descriptor open for writing, or -1 with errno set
+     *
+     * The file is created with O_EXCL under a name from uniquePath(); names
+     * that already exist are skipped.
+     */
+    static int create(const std::string& path, std::string& temporary, int mode = 0666) {
+        for (int attempt = 0; attempt < MaxAttempts; ++attempt) {
+            temporary = uniquePath(path);
+#ifdef _WIN32
+            (void)mode;
+            int fd = _open(temporary.c_str(), _O_WRONLY | _O_CREAT | _O_EXCL | _O_BINARY, _S_IREAD | _S_IWRITE);
+#else
+            int fd = ::open(temporary.c_str(), O_WRONLY | O_CREAT | O_EXCL | O_CLOEXEC, static_cast<mode_t>(mode));
+#endif
+            if (fd >= 0 || errno != EEXIST) {
+                return fd;
+            }
+        }
+        errno = EEXIST;
+        return -1;
+    }
+
+    /**
+     * @brief Create a new, empty temporary file and close it again
+     * @param path Target path
+     * @param temporary Receives the temporary file's path
+     * @return true if the file was created
+     *
+     * For writers that open files by name (streams, CopyFile()); the name
+     * stays reserved until the file is renamed or removed.
+     */
+    static bool reserve(const std::string& path, std::string& temporary) {
+        int fd = create(path, temporary);
+        if (fd < 0) {
+            return false;
+        }
+#ifdef _WIN32
+        _close(fd);
+#else
+        ::close(fd);
+#endif
+        return true;
+    }
+};
+
+} // namespace mcf
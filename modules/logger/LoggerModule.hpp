@@ -4,9 +4,13 @@
 #include "../../core/Logger.hpp"
 #include "../../core/ConfigurationManager.hpp"
 #include "../../core/Application.hpp"
+#include "../../core/FileWatchService.hpp"
 
+#include <map>
 #include <memory>
+#include <mutex>
 #include <string>
+#include <vector>
 
 namespace mcf {
 
@@ -46,6 +50,10 @@ namespace mcf {
  *     ]
  *   }
  * }
+ *
+ * If the application provides a FileWatchService, the files of "file" sinks
+ * are watched: when a tool such as logrotate moves, deletes or recreates a
+ * log file, the sink reopens it so that logging continues at the same path.
  */
 class LoggerModule : public ModuleBase {
 private:
@@ -53,6 +61,12 @@ private:
     std::vector<std::shared_ptr<Logger>> m_managed_loggers;
     bool m_watch_config;
 
+    // Log rotation; m_log_mutex guards the maps, which are touched by the watcher thread
+    FileWatchService* m_watch_service = nullptr;
+    std::map<std::string, FileWatchId> m_log_watches;
+    std::map<std::string, std::vector<std::weak_ptr<FileSink>>> m_log_sinks;
+    std::mutex m_log_mutex;
+
     /**
      * @brief Parse log level from JSON value
      */
@@ -184,12 +198,25 @@ private:
                 auto logger = configureLogger(loggerConfig);
                 if (logger) {
                     LoggerRegistry::instance().registerLogger(logger->getName(), logger);
-                    m_managed_loggers.push_back(logger);
+                    manage(logger);
                 }
             }
         }
     }
 
+    /**
+     * @brief Track a logger, replacing a managed logger of the same name
+     */
+    void manage(const std::shared_ptr<Logger>& logger) {
+        for (auto& managed : m_managed_loggers) {
+            if (managed->getName() == logger->getName()) {
+                managed = logger;
+                return;
+            }
+        }
+        m_managed_loggers.push_back(logger);
+    }
+
     /**
      * @brief Configuration change callback
      */
@@ -197,6 +224,99 @@ private:
         if (key.find("logging") == 0) {
             // Reload logging configuration
             loadConfiguration();
+            watchLogFiles();
+        }
+    }
+
+    /**
+     * @brief Watch the files of the managed file sinks for rotation
+     *
+     * Rebuilds the watched set from the current sinks: files no longer written
+     * by a managed logger are unwatched.
+     */
+    void watchLogFiles() {
+        if (!m_watch_service) {
+            return;
+        }
+
+        std::map<std::string, std::vector<std::weak_ptr<FileSink>>> current;
+        for (const auto& logger : m_managed_loggers) {
+            for (const auto& sink : logger->getSinks()) {
+                if (auto fileSink = std::dynamic_pointer_cast<FileSink>(sink)) {
+                    current[fileSink->getFilePath()].push_back(fileSink);
+                }
+            }
+        }
+
+        std::vector<FileWatchId> stale;
+        {
+            std::lock_guard<std::mutex> lock(m_log_mutex);
+            m_log_sinks.swap(current);
+            for (auto it = m_log_watches.begin(); it != m_log_watches.end();) {
+                if (m_log_sinks.count(it->first)) {
+                    ++it;
+                } else {
+                    stale.push_back(it->second);
+                    it = m_log_watches.erase(it);
+                }
+            }
+
+            for (const auto& entry : m_log_sinks) {
+                const std::string& path = entry.first;
+                if (m_log_watches.count(path)) {
+                    continue;
+                }
+                // Rotation only: the sinks' own writes neither wake the watcher nor get hashed
+                FileWatchOptions options;
+                options.mode = FileWatchMode::Presence;
+                m_log_watches[path] = m_watch_service->watchFile(path, [this](const std::string& file, FileChangeType type) {
+                    if (type != FileChangeType::Modified) {
+                        reopenLogFile(file);
+                    }
+                }, options);
+            }
+        }
+
+        // Outside m_log_mutex: waiting for a running reopen must not block it
+        for (FileWatchId id : stale) {
+            m_watch_service->unwatch(id, true);
+        }
+    }
+
+    /**
+     * @brief Reopen the sinks writing to a moved, deleted or recreated log file
+     */
+    void reopenLogFile(const std::string& path) {
+        std::vector<std::shared_ptr<FileSink>> sinks;
+        {
+            std::lock_guard<std::mutex> lock(m_log_mutex);
+            auto it = m_log_sinks.find(path);
+            if (it == m_log_sinks.end()) {
+                return;
+            }
+            for (const auto& sink : it->second) {
+                if (auto locked = sink.lock()) {
+                    sinks.push_back(locked);
+                }
+            }
+        }
+        for (const auto& sink : sinks) {
+            sink->reopen();
+        }
+    }
+
+    /**
+     * @brief Stop watching log files; waits for a running reopen
+     */
+    void unwatchLogFiles() {
+        std::map<std::string, FileWatchId> watches;
+        {
+            std::lock_guard<std::mutex> lock(m_log_mutex);
+            watches.swap(m_log_watches);
+            m_log_sinks.clear();
+        }
+        for (const auto& [path, id] : watches) {
+            m_watch_service->unwatch(id, true);
         }
     }
 
@@ -215,10 +335,12 @@ public:
         auto serviceLocator = app.getServiceLocator();
         if (serviceLocator) {
             m_config_manager = serviceLocator->resolve<ConfigurationManager>().get();
+            m_watch_service = serviceLocator->tryResolve<FileWatchService>().get();
         }
 
         // Load configuration
         loadConfiguration();
+        watchLogFiles();
 
         // Watch for configuration changes if enabled
         if (m_watch_config && m_config_manager) {
@@ -245,6 +367,8 @@ public:
         // Flush all loggers
         LoggerRegistry::instance().flushAll();
 
+        unwatchLogFiles();
+        m_watch_service = nullptr;
         m_managed_loggers.clear();
         m_config_manager = nullptr;
         m_initialized = false;
@@ -291,7 +415,8 @@ public:
         }
 
         LoggerRegistry::instance().registerLogger(name, logger);
-        m_managed_loggers.push_back(logger);
+        manage(logger);
+        watchLogFiles();
 
         return logger;
     }
@@ -301,6 +426,7 @@ public:
      */
     void reloadConfiguration() {
         loadConfiguration();
+        watchLogFiles();
     }
 
     /**
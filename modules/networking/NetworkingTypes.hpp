@@ -1,6 +1,8 @@
 #ifndef MCF_NETWORKING_TYPES_HPP
 #define MCF_NETWORKING_TYPES_HPP
 
+#include "../../core/MsgPack.hpp"
+
 #include <cstdint>
 #include <cstring>
 #include <string>
@@ -202,6 +204,20 @@ struct NetworkMessage {
     std::string toString() const {
         return std::string(data.begin(), data.end());
     }
+
+    // Create a message whose payload is the MessagePack encoding of a JSON value
+    static NetworkMessage fromJson(uint32_t id, const JsonValue& value) {
+        std::string encoded = MsgPack::encode(value);
+        NetworkMessage message(id);
+        message.data.assign(encoded.begin(), encoded.end());
+        message.dataSize = static_cast<uint32_t>(message.data.size());
+        return message;
+    }
+
+    // Decode a MessagePack payload (throws std::runtime_error if malformed)
+    JsonValue toJson() const {
+        return MsgPack::decode(std::string_view(reinterpret_cast<const char*>(data.data()), data.size()));
+    }
 };
 
 } // namespace mcf
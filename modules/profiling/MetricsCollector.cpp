@@ -1,4 +1,6 @@
 #include "MetricsCollector.hpp"
+#include "../../core/JsonWriter.hpp"
+#include "../../core/Ndjson.hpp"
 #include <sstream>
 #include <iomanip>
 #include <fstream>
@@ -231,35 +233,38 @@ void MetricsCollector::clear() {
 }
 
 std::string MetricsCollector::metricsToJson(const std::vector<MetricData>& metrics) const {
-    std::ostringstream oss;
-    oss << "{\n  \"metrics\": [\n";
+    JsonWriter writer(JsonWriter::Style::Pretty);
+    writer.reserve(64 + metrics.size() * 160);
 
-    for (size_t i = 0; i < metrics.size(); ++i) {
-        const auto& m = metrics[i];
+    writer.startObject();
+    writer.key("metrics").startArray();
 
-        oss << "    {\n";
-        oss << "      \"name\": \"" << m.name << "\",\n";
-        oss << "      \"type\": \"";
-        switch (m.type) {
-            case MetricType::Counter: oss << "counter"; break;
-            case MetricType::Gauge: oss << "gauge"; break;
-            case MetricType::Timing: oss << "timing"; break;
-            case MetricType::Histogram: oss << "histogram"; break;
-        }
-        oss << "\",\n";
-        oss << "      \"value\": " << std::fixed << std::setprecision(3) << m.value << ",\n";
-        oss << "      \"unit\": \"" << m.unit << "\",\n";
-        oss << "      \"category\": \"" << m.category << "\"\n";
-        oss << "    }";
-
-        if (i < metrics.size() - 1) {
-            oss << ",";
-        }
-        oss << "\n";
+    for (const auto& m : metrics) {
+        writeMetric(writer, m);
     }
 
-    oss << "  ]\n}\n";
-    return oss.str();
+    writer.endArray();
+    writer.endObject();
+
+    std::string json = writer.release();
+    json += '\n';
+    return json;
+}
+
+void MetricsCollector::writeMetric(JsonWriter& writer, const MetricData& metric) {
+    writer.startObject();
+    writer.key("name").string(metric.name);
+    writer.key("type");
+    switch (metric.type) {
+        case MetricType::Counter: writer.string("counter"); break;
+        case MetricType::Gauge: writer.string("gauge"); break;
+        case MetricType::Timing: writer.string("timing"); break;
+        case MetricType::Histogram: writer.string("histogram"); break;
+    }
+    writer.key("value").number(metric.value, 3);
+    writer.key("unit").string(metric.unit);
+    writer.key("category").string(metric.category);
+    writer.endObject();
 }
 
 std::string MetricsCollector::exportToJson() const {
@@ -291,6 +296,19 @@ std::string MetricsCollector::exportToCsv() const {
     return metricsToCsv(metrics);
 }
 
+std::string MetricsCollector::exportToNdjson() const {
+    auto metrics = getAllMetrics();
+
+    std::ostringstream oss;
+    NdjsonWriter writer(oss);
+    for (const auto& m : metrics) {
+        writeMetric(writer.json(), m);
+        writer.endRecord();
+    }
+    writer.flush();
+    return oss.str();
+}
+
 std::string MetricsCollector::exportStatisticsToJson() const {
     auto stats = getAllStatistics();
 
@@ -344,6 +362,18 @@ bool MetricsCollector::saveToFile(const std::string& filename, const std::string
         file << exportToJson();
     } else if (format == "csv") {
         file << exportToCsv();
+    } else if (format == "ndjson") {
+        // Streamed in batches rather than built as one string; any batch write can fail
+        NdjsonWriter writer(file);
+        try {
+            for (const auto& m : getAllMetrics()) {
+                writeMetric(writer.json(), m);
+                writer.endRecord();
+            }
+            writer.flush();
+        } catch (const std::exception&) {
+            return false;
+        }
     } else if (format == "stats") {
         file << exportStatisticsToJson();
     } else {
@@ -10,6 +10,8 @@
 
 namespace mcf {
 
+class JsonWriter;
+
 /**
  * @brief Thread-safe metrics collection engine
  *
@@ -122,6 +124,11 @@ public:
      */
     std::string exportToCsv() const;
 
+    /**
+     * @brief Export metrics as newline-delimited JSON (one metric per line)
+     */
+    std::string exportToNdjson() const;
+
     /**
      * @brief Export statistics to string
      */
@@ -153,6 +160,7 @@ private:
     void flushIfNeeded();
     std::string metricsToJson(const std::vector<MetricData>& metrics) const;
     std::string metricsToCsv(const std::vector<MetricData>& metrics) const;
+    static void writeMetric(JsonWriter& writer, const MetricData& metric);
 };
 
 } // namespace mcf
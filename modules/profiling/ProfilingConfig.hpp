@@ -41,7 +41,7 @@ struct ProfilingConfig {
     // Export settings
     bool autoExportEnabled = false;
     double autoExportIntervalSeconds = 60.0;
-    std::string exportFormat = "json";  // "json", "csv", "console"
+    std::string exportFormat = "json";  // "json", "ndjson", "csv", "console"
     std::string exportPath = "./metrics/";
 
     // Category filters (empty = all categories)
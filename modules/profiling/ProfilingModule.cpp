@@ -1,6 +1,7 @@
 #include "ProfilingModule.hpp"
 #include "../../core/Application.hpp"
 #include "../../core/ConfigurationManager.hpp"
+#include "../../core/JsonBinding.hpp"
 #include <iostream>
 #include <sstream>
 #include <iomanip>
@@ -8,6 +9,11 @@
 
 namespace mcf {
 
+// Members settable from the "profiling" config section
+MCF_JSON_FIELDS(ProfilingConfig, enabled, enableCounters, enableGauges, enableTimings,
+                timingThresholdMs, autoExportEnabled, autoExportIntervalSeconds, exportPath,
+                exportFormat, profileFrames)
+
 bool ProfilingModule::initialize(Application& app) {
     if (m_initialized) {
         return true;
@@ -122,47 +128,19 @@ void ProfilingModule::loadConfigFromJson() {
         return;
     }
 
-    // Load profiling configuration from JSON
-    if (m_configManager->has("profiling.enabled")) {
-        m_config.enabled = m_configManager->getBool("profiling.enabled");
-    }
-
-    if (m_configManager->has("profiling.enableCounters")) {
-        m_config.enableCounters = m_configManager->getBool("profiling.enableCounters");
-    }
-
-    if (m_configManager->has("profiling.enableGauges")) {
-        m_config.enableGauges = m_configManager->getBool("profiling.enableGauges");
-    }
-
-    if (m_configManager->has("profiling.enableTimings")) {
-        m_config.enableTimings = m_configManager->getBool("profiling.enableTimings");
-    }
-
-    if (m_configManager->has("profiling.timingThresholdMs")) {
-        // ConfigurationManager doesn't have getDouble, use getInt and cast
-        m_config.timingThresholdMs = static_cast<double>(m_configManager->getInt("profiling.timingThresholdMs"));
-    }
-
-    if (m_configManager->has("profiling.autoExportEnabled")) {
-        m_config.autoExportEnabled = m_configManager->getBool("profiling.autoExportEnabled");
-    }
-
-    if (m_configManager->has("profiling.autoExportIntervalSeconds")) {
-        // ConfigurationManager doesn't have getDouble, use getInt and cast
-        m_config.autoExportIntervalSeconds = static_cast<double>(m_configManager->getInt("profiling.autoExportIntervalSeconds"));
-    }
-
-    if (m_configManager->has("profiling.exportPath")) {
-        m_config.exportPath = m_configManager->getString("profiling.exportPath");
-    }
-
-    if (m_configManager->has("profiling.exportFormat")) {
-        m_config.exportFormat = m_configManager->getString("profiling.exportFormat");
+    if (!m_configManager->has("profiling")) {
+        return;
     }
 
-    if (m_configManager->has("profiling.profileFrames")) {
-        m_config.profileFrames = m_configManager->getBool("profiling.profileFrames");
+    // Bind the "profiling" section onto a copy of the config struct; this
+    // keeps fractional thresholds/intervals that getInt() used to truncate.
+    // A mistyped member leaves the current config untouched.
+    try {
+        ProfilingConfig config = m_config;
+        JsonBinding::fromValue(m_configManager->get("profiling"), config);
+        m_config = std::move(config);
+    } catch (const std::exception& e) {
+        std::cerr << "[ProfilingModule] Invalid profiling config: " << e.what() << "\n";
     }
 }
 
@@ -198,6 +176,8 @@ std::string ProfilingModule::generateExportFilename() const {
         oss << ".json";
     } else if (m_config.exportFormat == "csv") {
         oss << ".csv";
+    } else if (m_config.exportFormat == "ndjson") {
+        oss << ".ndjson";
     } else if (m_config.exportFormat == "stats") {
         oss << "_stats.json";
     }
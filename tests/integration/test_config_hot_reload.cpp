@@ -8,6 +8,7 @@
 
 #include "../../core/Application.hpp"
 #include "../../core/ConfigurationManager.hpp"
+#include "../../core/FileWatchService.hpp"
 #include "../../core/JsonParser.hpp"
 #include "../../external/catch_amalgamated.hpp"
 
@@ -120,8 +121,6 @@ TEST_CASE("ConfigurationManager - Key watching callbacks", "[integration][config
         REQUIRE(callback2Count == 1);
     }
 
-    // Section commented - requires unwatch() method not yet implemented
-    /*
     SECTION("Unwatch key stops callbacks") {
         std::atomic<int> callbackCount{0};
 
@@ -141,15 +140,26 @@ TEST_CASE("ConfigurationManager - Key watching callbacks", "[integration][config
         // Should still be 1 (no new callback)
         REQUIRE(callbackCount == 1);
     }
-    */
 
     fs::remove(testFile);
 }
 
-// Test case commented - requires startFileWatching() and stopFileWatching() not yet implemented
-/*
+// Poll until a condition holds or the timeout expires
+template<typename Predicate>
+bool waitUntil(Predicate predicate, std::chrono::milliseconds timeout = std::chrono::milliseconds(5000)) {
+    auto deadline = std::chrono::steady_clock::now() + timeout;
+    while (!predicate()) {
+        if (std::chrono::steady_clock::now() > deadline) {
+            return false;
+        }
+        std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    }
+    return true;
+}
+
 TEST_CASE("ConfigurationManager - File watching and auto-reload", "[integration][config][hot-reload]") {
     std::string testFile = (fs::temp_directory_path() / "mcf_test_config_hotreload.json").string();
+    std::string layerFile = (fs::temp_directory_path() / "mcf_test_config_hotreload_layer.json").string();
 
     writeConfigFile(testFile, R"({
         "runtime": {
@@ -158,6 +168,7 @@ TEST_CASE("ConfigurationManager - File watching and auto-reload", "[integration]
         }
     })");
 
+    FileWatchService service(std::chrono::milliseconds(50));
     ConfigurationManager config;
     REQUIRE(config.load(testFile));
 
@@ -173,15 +184,13 @@ TEST_CASE("ConfigurationManager - File watching and auto-reload", "[integration]
             }
         });
 
-        // Enable file watching with short interval
-        config.startFileWatching(std::chrono::milliseconds(100));
+        config.startFileWatching(service);
+        REQUIRE(config.isFileWatching());
+        REQUIRE(service.getWatchCount() == 1);
 
         // Initial value
         REQUIRE(config.getInt("runtime.timeout") == 5000);
 
-        // Wait for watcher to start
-        std::this_thread::sleep_for(std::chrono::milliseconds(150));
-
         // Modify file
         writeConfigFile(testFile, R"({
             "runtime": {
@@ -190,24 +199,22 @@ TEST_CASE("ConfigurationManager - File watching and auto-reload", "[integration]
             }
         })");
 
-        // Wait for file watcher to detect and reload
-        std::this_thread::sleep_for(std::chrono::milliseconds(300));
-
         // Configuration should be automatically reloaded
+        REQUIRE(waitUntil([&] { return newTimeout == 10000; }));
         REQUIRE(config.getInt("runtime.timeout") == 10000);
         REQUIRE(config.getBool("runtime.enabled") == false);
         REQUIRE(fileChanged);
-        REQUIRE(newTimeout == 10000);
 
-        config.unstartFileWatching();
+        config.stopFileWatching();
+        REQUIRE_FALSE(config.isFileWatching());
+        REQUIRE(service.getWatchCount() == 0);
     }
 
     SECTION("Stop watching stops auto-reload") {
-        config.startFileWatching(std::chrono::milliseconds(100));
-        std::this_thread::sleep_for(std::chrono::milliseconds(150));
+        config.startFileWatching(service);
 
         // Stop watching
-        config.unstartFileWatching();
+        config.stopFileWatching();
 
         // Modify file
         writeConfigFile(testFile, R"({
@@ -230,40 +237,57 @@ TEST_CASE("ConfigurationManager - File watching and auto-reload", "[integration]
             changeCount++;
         });
 
-        config.startFileWatching(std::chrono::milliseconds(100));
-        std::this_thread::sleep_for(std::chrono::milliseconds(150));
+        config.startFileWatching(service);
 
-        // First change
-        writeConfigFile(testFile, R"({
-            "runtime": {"timeout": 1000, "enabled": true}
-        })");
+        for (int timeout : {1000, 2000, 3000}) {
+            writeConfigFile(testFile, R"({
+                "runtime": {"timeout": )" + std::to_string(timeout) + R"(, "enabled": true}
+            })");
+            REQUIRE(waitUntil([&] { return config.getInt("runtime.timeout") == timeout; }));
+        }
 
-        std::this_thread::sleep_for(std::chrono::milliseconds(250));
+        REQUIRE(changeCount >= 1);
+        config.stopFileWatching();
+    }
 
-        // Second change
-        writeConfigFile(testFile, R"({
-            "runtime": {"timeout": 2000, "enabled": true}
-        })");
+    SECTION("Layer files are watched") {
+        writeConfigFile(layerFile, R"({"layer": {"retries": 7}})");
 
-        std::this_thread::sleep_for(std::chrono::milliseconds(250));
+        config.startFileWatching(service);
+        REQUIRE(config.loadLayer("override", ConfigPriority::Environment, layerFile));
+        REQUIRE(config.getInt("layer.retries") == 7);
+        REQUIRE(service.getWatchCount() == 2);
 
-        // Third change
-        writeConfigFile(testFile, R"({
-            "runtime": {"timeout": 3000, "enabled": true}
-        })");
+        writeConfigFile(layerFile, R"({"layer": {"retries": 8}})");
+        REQUIRE(waitUntil([&] { return config.getInt("layer.retries") == 8; }));
 
-        std::this_thread::sleep_for(std::chrono::milliseconds(250));
+        REQUIRE(config.removeLayer("override"));
+        REQUIRE(service.getWatchCount() == 1);
+        config.stopFileWatching();
+    }
 
-        // Should have detected at least some changes
-        REQUIRE(changeCount >= 1);
-        REQUIRE(config.getInt("runtime.timeout") == 3000);
+    SECTION("Stopping while a reload loads a layer does not deadlock") {
+        writeConfigFile(layerFile, R"({"layer": {"retries": 7}})");
+        std::atomic<bool> reloading{false};
+        std::atomic<bool> loaded{false};
+        config.watch("runtime.timeout", [&](const std::string&, const JsonValue&) {
+            reloading = true;
+            std::this_thread::sleep_for(std::chrono::milliseconds(100));  // Let stopFileWatching() start waiting
+            loaded = config.loadLayer("override", ConfigPriority::Environment, layerFile);
+        });
 
-        config.unstartFileWatching();
+        config.startFileWatching(service);
+        writeConfigFile(testFile, R"({"runtime": {"timeout": 6000, "enabled": true}})");
+        REQUIRE(waitUntil([&] { return reloading.load(); }));
+        config.stopFileWatching();
+        REQUIRE(loaded);
+        REQUIRE(service.getWatchCount() == 0);
     }
 
     fs::remove(testFile);
+    fs::remove(layerFile);
 }
-*/
+
 
 TEST_CASE("ConfigurationManager - Save and persistence", "[integration][config][save]") {
     std::string testFile = (fs::temp_directory_path() / "mcf_test_config_save.json").string();
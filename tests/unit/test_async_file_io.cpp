@@ -0,0 +1,447 @@
+/**
+ * @file test_async_file_io.cpp
+ * @brief Unit tests for AsyncFileIO using Catch2
+ */
+
+#include "../../core/AsyncFileIO.hpp"
+#include "../../core/Application.hpp"
+#include "../../external/catch_amalgamated.hpp"
+
+#include <atomic>
+#include <chrono>
+#include <filesystem>
+#include <fstream>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace mcf;
+namespace fs = std::filesystem;
+
+// Fresh directory under the temp directory, removed by the destructor
+struct TempDirectory {
+    fs::path path;
+
+    explicit TempDirectory(const std::string& name) : path(fs::temp_directory_path() / name) {
+        fs::remove_all(path);
+        fs::create_directories(path);
+    }
+
+    ~TempDirectory() {
+        std::error_code error;
+        fs::remove_all(path, error);
+    }
+
+    std::string file(const std::string& name) const {
+        return (path / name).string();
+    }
+};
+
+static std::string patternData(size_t size) {
+    std::string data(size, '\0');
+    for (size_t i = 0; i < size; ++i) {
+        data[i] = static_cast<char>((i * 131) >> 3);
+    }
+    return data;
+}
+
+static void writeFile(const std::string& path, const std::string& content) {
+    std::ofstream file(path, std::ios::binary | std::ios::trunc);
+    file << content;
+}
+
+static std::string readFile(const std::string& path) {
+    std::ifstream file(path, std::ios::binary);
+    return std::string(std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>());
+}
+
+// Every test runs on the fallback and, where the kernel allows it, on io_uring
+static AsyncIOBackend backendUnderTest() {
+    return GENERATE(AsyncIOBackend::ThreadPool, AsyncIOBackend::Auto);
+}
+
+// =============================================================================
+// Backends
+// =============================================================================
+
+TEST_CASE("AsyncFileIO - Backend selection", "[asyncio][core]") {
+    AsyncFileIO pooled(AsyncIOBackend::ThreadPool);
+    REQUIRE(pooled.getBackend() == AsyncIOBackend::ThreadPool);
+
+    AsyncFileIO automatic;
+    REQUIRE(automatic.getBackend() ==
+            (AsyncFileIO::isIoUringAvailable() ? AsyncIOBackend::IoUring : AsyncIOBackend::ThreadPool));
+
+    if (AsyncFileIO::isIoUringAvailable()) {
+        REQUIRE(AsyncFileIO(AsyncIOBackend::IoUring).getBackend() == AsyncIOBackend::IoUring);
+    } else {
+        REQUIRE_THROWS_AS(AsyncFileIO(AsyncIOBackend::IoUring), std::runtime_error);
+    }
+}
+
+// =============================================================================
+// Requests
+// =============================================================================
+
+TEST_CASE("AsyncFileIO - Open, write, sync, read and close", "[asyncio][core]") {
+    AsyncIOBackend backend = backendUnderTest();
+    TempDirectory directory("mcf_async_io_basic");
+    AsyncFileIO io(backend);
+
+    std::string path = directory.file("data.bin");
+    std::string data = patternData(100000);
+
+    AsyncIOResult opened = io.open(path, O_RDWR | O_CREAT | O_TRUNC).get();
+    REQUIRE(opened.ok());
+    int fd = static_cast<int>(opened.value);
+
+    AsyncIOResult written = io.write(fd, data.data(), data.size(), 0).get();
+    REQUIRE(written.ok());
+    REQUIRE(written.value == static_cast<int64_t>(data.size()));
+    REQUIRE(io.sync(fd, true).get().ok());
+    REQUIRE(io.sync(fd).get().ok());
+
+    std::string back(1000, '\0');
+    AsyncIOResult read = io.read(fd, &back[0], back.size(), 5000).get();
+    REQUIRE(read.ok());
+    REQUIRE(read.value == 1000);
+    REQUIRE(back == data.substr(5000, 1000));
+
+    // Reading at the end of the file returns 0 bytes
+    REQUIRE(io.read(fd, &back[0], back.size(), data.size()).get().value == 0);
+
+    REQUIRE(io.close(fd).get().ok());
+    REQUIRE(readFile(path) == data);
+}
+
+TEST_CASE("AsyncFileIO - Errors are reported as errno values", "[asyncio][core][error]") {
+    AsyncIOBackend backend = backendUnderTest();
+    TempDirectory directory("mcf_async_io_errors");
+    AsyncFileIO io(backend);
+
+    AsyncIOResult missing = io.open(directory.file("missing.txt"), O_RDONLY).get();
+    REQUIRE_FALSE(missing.ok());
+    REQUIRE(missing.error == ENOENT);
+
+    char buffer[16];
+    AsyncIOResult badRead = io.read(-1, buffer, sizeof(buffer), 0).get();
+    REQUIRE(badRead.error == EBADF);
+    REQUIRE(badRead.value == 0);
+
+    REQUIRE_THROWS_AS(io.readFile(directory.file("missing.txt")).get(), std::runtime_error);
+    REQUIRE_FALSE(io.writeFile(directory.file("missing/dir.txt"), "x").get());
+}
+
+TEST_CASE("AsyncFileIO - Batches complete through callbacks", "[asyncio][core]") {
+    AsyncIOBackend backend = backendUnderTest();
+    TempDirectory directory("mcf_async_io_batch");
+    std::string path = directory.file("blocks.bin");
+    std::string data = patternData(1024 * 1024);
+    writeFile(path, data);
+
+    // A small ring: the batch is larger than the queue and the in-flight limit
+    AsyncFileIO io(backend, 16);
+    int fd = static_cast<int>(io.open(path, O_RDONLY).get().value);
+    REQUIRE(fd >= 0);
+
+    constexpr size_t BlockSize = 4096;
+    size_t blockCount = data.size() / BlockSize;
+    std::vector<std::string> blocks(blockCount, std::string(BlockSize, '\0'));
+    std::atomic<size_t> completed{0};
+    std::atomic<size_t> mismatches{0};
+
+    std::vector<AsyncIORequest> batch;
+    for (size_t i = 0; i < blockCount; ++i) {
+        // Read the blocks in reverse order to exercise the offsets
+        size_t block = blockCount - 1 - i;
+        AsyncIORequest request;
+        request.operation = AsyncIOOperation::Read;
+        request.fd = fd;
+        request.buffer = &blocks[block][0];
+        request.size = BlockSize;
+        request.offset = block * BlockSize;
+        request.callback = [&, block](const AsyncIOResult& result) {
+            if (!result.ok() || blocks[block] != data.substr(block * BlockSize, BlockSize)) {
+                mismatches++;
+            }
+            completed++;
+        };
+        batch.push_back(std::move(request));
+    }
+    io.submit(std::move(batch));
+
+    auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(10);
+    while (completed < blockCount && std::chrono::steady_clock::now() < deadline) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+    REQUIRE(completed == blockCount);
+    REQUIRE(mismatches == 0);
+    REQUIRE(io.close(fd).get().ok());
+}
+
+TEST_CASE("AsyncFileIO - Callbacks can submit follow-up requests", "[asyncio][core]") {
+    AsyncIOBackend backend = backendUnderTest();
+    TempDirectory directory("mcf_async_io_chain");
+    std::string path = directory.file("chain.txt");
+    writeFile(path, "chained");
+
+    AsyncFileIO io(backend, 8);
+    std::promise<std::string> done;
+    auto buffer = std::make_shared<std::string>(7, '\0');
+
+    AsyncIORequest open;
+    open.operation = AsyncIOOperation::Open;
+    open.path = path;
+    open.flags = O_RDONLY;
+    open.callback = [&io, &done, buffer](const AsyncIOResult& opened) {
+        int fd = static_cast<int>(opened.value);
+        AsyncIORequest read;
+        read.operation = AsyncIOOperation::Read;
+        read.fd = fd;
+        read.buffer = &(*buffer)[0];
+        read.size = buffer->size();
+        read.callback = [&io, &done, buffer, fd](const AsyncIOResult&) {
+            AsyncIORequest close;
+            close.operation = AsyncIOOperation::Close;
+            close.fd = fd;
+            close.callback = [&done, buffer](const AsyncIOResult&) { done.set_value(*buffer); };
+            io.submit(std::move(close));
+        };
+        io.submit(std::move(read));
+    };
+    io.submit(std::move(open));
+
+    REQUIRE(done.get_future().get() == "chained");
+}
+
+// =============================================================================
+// Whole files
+// =============================================================================
+
+TEST_CASE("AsyncFileIO - Whole-file reads and writes", "[asyncio][core]") {
+    AsyncIOBackend backend = backendUnderTest();
+    TempDirectory directory("mcf_async_io_files");
+    AsyncFileIO io(backend);
+
+    std::string path = directory.file("large.bin");
+    std::string data = patternData(3 * 1024 * 1024 + 17);
+
+    SECTION("Round trip in every durability mode") {
+        for (Durability durability : {Durability::None, Durability::Data, Durability::Atomic}) {
+            REQUIRE(io.writeFile(path, data, durability).get());
+            REQUIRE(readFile(path) == data);
+            REQUIRE(io.readFile(path).get() == data);
+        }
+        for (const auto& entry : fs::directory_iterator(directory.path)) {
+            REQUIRE(entry.path().extension() != ".tmp");
+        }
+
+        REQUIRE(io.writeFile(path, "").get());
+        REQUIRE(io.readFile(path).get().empty());
+    }
+
+    SECTION("Concurrent atomic writes of one path use their own temporary files") {
+        writeFile(path + ".tmp", "not ours");
+        std::vector<std::future<bool>> writes;
+        for (char c : {'a', 'b', 'c', 'd', 'e', 'f', 'g', 'h'}) {
+            writes.push_back(io.writeFile(path, std::string(512 * 1024 + 3, c), Durability::Atomic));
+        }
+        for (auto& write : writes) {
+            REQUIRE(write.get());
+        }
+        std::string written = readFile(path);
+        REQUIRE(written.size() == 512 * 1024 + 3);
+        REQUIRE(written == std::string(written.size(), written[0]));
+        REQUIRE(readFile(path + ".tmp") == "not ours");
+    }
+
+    SECTION("Taken temporary names are skipped") {
+        std::string taken = TempFile::uniquePath(path);
+        std::string prefix = taken.substr(0, taken.rfind('.', taken.size() - 5) + 1);
+        uint64_t next = std::stoull(taken.substr(prefix.size())) + 1;
+        for (uint64_t i = next; i < next + 3; ++i) {
+            writeFile(prefix + std::to_string(i) + ".tmp", "taken");
+        }
+        REQUIRE(io.writeFile(path, "fresh", Durability::Atomic).get());
+        REQUIRE(readFile(path) == "fresh");
+        REQUIRE(readFile(prefix + std::to_string(next) + ".tmp") == "taken");
+    }
+
+#ifndef _WIN32
+    SECTION("Atomic writes keep the permissions of the replaced file") {
+        writeFile(path, "old");
+        fs::permissions(path, fs::perms::owner_read | fs::perms::owner_write);
+        REQUIRE(io.writeFile(path, "new", Durability::Atomic).get());
+        REQUIRE(readFile(path) == "new");
+        REQUIRE((fs::status(path).permissions() & fs::perms::all) ==
+                (fs::perms::owner_read | fs::perms::owner_write));
+    }
+#endif
+
+#ifdef __linux__
+    SECTION("Files that report no size are read to the end") {
+        REQUIRE(io.readFile("/proc/self/status").get().find("Name:") != std::string::npos);
+    }
+#endif
+
+    SECTION("Many files at once") {
+        std::vector<std::future<bool>> writes;
+        for (int i = 0; i < 64; ++i) {
+            writes.push_back(io.writeFile(directory.file("f" + std::to_string(i)), std::string(1000 + i, 'a' + i % 26)));
+        }
+        for (auto& write : writes) {
+            REQUIRE(write.get());
+        }
+
+        std::vector<std::future<std::string>> reads;
+        for (int i = 0; i < 64; ++i) {
+            reads.push_back(io.readFile(directory.file("f" + std::to_string(i))));
+        }
+        for (int i = 0; i < 64; ++i) {
+            REQUIRE(reads[i].get() == std::string(1000 + i, 'a' + i % 26));
+        }
+    }
+}
+
+// =============================================================================
+// Lifetime
+// =============================================================================
+
+TEST_CASE("AsyncFileIO - Shutdown waits for requests in flight", "[asyncio][core]") {
+    AsyncIOBackend backend = backendUnderTest();
+    TempDirectory directory("mcf_async_io_shutdown");
+    AsyncFileIO io(backend);
+
+    std::vector<std::future<bool>> writes;
+    for (int i = 0; i < 16; ++i) {
+        writes.push_back(io.writeFile(directory.file("s" + std::to_string(i)), patternData(256 * 1024)));
+    }
+    io.shutdown();
+    REQUIRE(io.getPendingCount() == 0);
+    for (auto& write : writes) {
+        REQUIRE(write.wait_for(std::chrono::seconds(0)) == std::future_status::ready);
+        REQUIRE(write.get());
+    }
+
+    REQUIRE_THROWS_AS(io.open(directory.file("late"), O_RDONLY), std::runtime_error);
+}
+
+TEST_CASE("AsyncFileIO - Registered by Application", "[asyncio][application]") {
+    ApplicationConfig config;
+    config.autoLoadPlugins = false;
+    Application app(config);
+    REQUIRE(app.getAsyncFileIO() != nullptr);
+
+    REQUIRE(app.initialize());
+    REQUIRE(app.getServiceLocator()->resolve<AsyncFileIO>().get() == app.getAsyncFileIO());
+    app.shutdown();
+}
+
+// =============================================================================
+// Benchmarks
+// =============================================================================
+
+TEST_CASE("AsyncFileIO - Benchmarks", "[asyncio][.benchmark]") {
+    TempDirectory directory("mcf_async_io_bench");
+    FileSystem fileSystem;
+    AsyncFileIO pooled(AsyncIOBackend::ThreadPool);
+    AsyncFileIO automatic;
+    std::string automaticName = automatic.getBackend() == AsyncIOBackend::IoUring ? "io_uring" : "thread pool";
+
+    // Throughput: many small files
+    std::vector<std::string> files;
+    for (int i = 0; i < 256; ++i) {
+        files.push_back(directory.file("small_" + std::to_string(i)));
+        writeFile(files.back(), patternData(16 * 1024));
+    }
+
+    BENCHMARK("Read 256 x 16 KB files, blocking") {
+        size_t total = 0;
+        for (const auto& file : files) {
+            total += fileSystem.readFile(file).size();
+        }
+        return total;
+    };
+
+    auto readAll = [&](AsyncFileIO& io) {
+        std::vector<std::future<std::string>> reads;
+        reads.reserve(files.size());
+        for (const auto& file : files) {
+            reads.push_back(io.readFile(file));
+        }
+        size_t total = 0;
+        for (auto& read : reads) {
+            total += read.get().size();
+        }
+        return total;
+    };
+    BENCHMARK("Read 256 x 16 KB files, thread pool") { return readAll(pooled); };
+    BENCHMARK("Read 256 x 16 KB files, " + automaticName) { return readAll(automatic); };
+
+    // Throughput: random 4 KB reads from one file
+    std::string large = directory.file("large.bin");
+    writeFile(large, patternData(64 * 1024 * 1024));
+    constexpr size_t BlockSize = 4096;
+    constexpr size_t ReadCount = 4096;
+    std::vector<uint64_t> offsets;
+    uint64_t state = 42;
+    for (size_t i = 0; i < ReadCount; ++i) {
+        state = state * 6364136223846793005ULL + 1442695040888963407ULL;
+        offsets.push_back(((state >> 33) % (64 * 1024 * 1024 / BlockSize)) * BlockSize);
+    }
+    std::vector<char> blocks(ReadCount * BlockSize);
+    int fd = ::open(large.c_str(), O_RDONLY);
+
+    BENCHMARK("4096 random 4 KB reads, blocking pread") {
+        size_t total = 0;
+        for (size_t i = 0; i < ReadCount; ++i) {
+            total += static_cast<size_t>(::pread(fd, &blocks[i * BlockSize], BlockSize, static_cast<off_t>(offsets[i])));
+        }
+        return total;
+    };
+
+    auto readBlocks = [&](AsyncFileIO& io) {
+        std::atomic<size_t> total{0};
+        std::atomic<size_t> completed{0};
+        std::vector<AsyncIORequest> batch(ReadCount);
+        for (size_t i = 0; i < ReadCount; ++i) {
+            batch[i].operation = AsyncIOOperation::Read;
+            batch[i].fd = fd;
+            batch[i].buffer = &blocks[i * BlockSize];
+            batch[i].size = BlockSize;
+            batch[i].offset = offsets[i];
+            batch[i].callback = [&](const AsyncIOResult& result) {
+                total += static_cast<size_t>(result.value);
+                completed++;
+            };
+        }
+        io.submit(std::move(batch));
+        while (completed < ReadCount) {
+            std::this_thread::yield();
+        }
+        return total.load();
+    };
+    BENCHMARK("4096 random 4 KB reads, thread pool") { return readBlocks(pooled); };
+    BENCHMARK("4096 random 4 KB reads, " + automaticName) { return readBlocks(automatic); };
+    ::close(fd);
+
+    // Latency: time the calling thread spends on a durable 4 MB write
+    std::string payload = patternData(4 * 1024 * 1024);
+    std::string target = directory.file("durable.bin");
+    WriteOptions durable;
+    durable.durability = Durability::Data;
+
+    BENCHMARK("Caller time of a synced 4 MB write, blocking") {
+        return fileSystem.writeFile(target, payload, durable);
+    };
+
+    std::vector<std::future<bool>> outstanding;
+    BENCHMARK("Caller time of a synced 4 MB write, " + automaticName) {
+        outstanding.push_back(automatic.writeFile(target, payload, Durability::Data));
+        return outstanding.size();
+    };
+    for (auto& write : outstanding) {
+        write.get();
+    }
+}
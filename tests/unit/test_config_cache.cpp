@@ -0,0 +1,175 @@
+#include <catch_amalgamated.hpp>
+#include "../../core/ConfigCache.hpp"
+#include "../../core/ConfigurationManager.hpp"
+
+#include <filesystem>
+#include <fstream>
+#include <string>
+
+using namespace mcf;
+namespace fs = std::filesystem;
+
+namespace {
+
+void writeText(const std::string& path, const std::string& text) {
+    std::ofstream file(path, std::ios::binary | std::ios::trunc);
+    file << text;
+}
+
+std::string readText(const std::string& path) {
+    std::ifstream file(path, std::ios::binary);
+    return std::string(std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>());
+}
+
+// Roughly 330 KB of service definitions
+std::string largeConfig() {
+    std::string json = "{\"services\": {";
+    for (int i = 0; i < 2000; ++i) {
+        if (i) json += ",";
+        json += "\"service" + std::to_string(i) + "\": {\"host\": \"10.0." + std::to_string(i % 256) +
+                ".1\", \"port\": " + std::to_string(8000 + i) +
+                ", \"weight\": 0.75, \"enabled\": true, \"tags\": [\"a\", \"b\", \"c\"],"
+                " \"limits\": {\"rps\": 1000, \"burst\": 50, \"timeout_ms\": 2500}}";
+    }
+    json += "}, \"logging\": {\"level\": \"info\"}}";
+    return json;
+}
+
+struct TempDir {
+    fs::path path = fs::temp_directory_path() / "mcf_test_config_cache";
+    TempDir() {
+        fs::remove_all(path);
+        fs::create_directories(path);
+    }
+    ~TempDir() { fs::remove_all(path); }
+};
+
+} // namespace
+
+TEST_CASE("ConfigCache - Images", "[ConfigCache]") {
+    TempDir dir;
+    std::string source = (dir.path / "app.json").string();
+    writeText(source, R"({"network": {"port": 8080, "ratio": 0.5, "hosts": ["a", "b"]}, "debug": false, "name": null})");
+
+    bool cached = true;
+    JsonValue first = ConfigCache::parseFile(source, &cached);
+    REQUIRE_FALSE(cached);
+    REQUIRE(fs::exists(ConfigCache::imagePath(source)));
+
+    SECTION("Unchanged sources are read from the image") {
+        JsonValue second = ConfigCache::parseFile(source, &cached);
+        REQUIRE(cached);
+        REQUIRE(JsonPatch::equals(first, second));
+        REQUIRE(second["network"]["port"].asInt() == 8080);
+        REQUIRE(second["network"]["ratio"].asFloat() == 0.5);
+    }
+
+    SECTION("Changed sources are parsed again") {
+        writeText(source, R"({"network": {"port": 9090}})");
+        JsonValue second = ConfigCache::parseFile(source, &cached);
+        REQUIRE_FALSE(cached);
+        REQUIRE(second["network"]["port"].asInt() == 9090);
+
+        // The rewritten image is used next time
+        ConfigCache::parseFile(source, &cached);
+        REQUIRE(cached);
+    }
+
+    SECTION("Same size and time with different contents are detected") {
+        auto time = fs::last_write_time(source);
+        std::string text = readText(source);
+        text.replace(text.find("8080"), 4, "8081");
+        writeText(source, text);
+        fs::last_write_time(source, time);
+
+        JsonValue second = ConfigCache::parseFile(source, &cached);
+        REQUIRE_FALSE(cached);
+        REQUIRE(second["network"]["port"].asInt() == 8081);
+    }
+
+    SECTION("Corrupt or truncated images fall back to the source") {
+        std::string image = readText(ConfigCache::imagePath(source));
+
+        std::string corrupt = image;
+        corrupt[corrupt.size() - 3] ^= 0x5a;
+        writeText(ConfigCache::imagePath(source), corrupt);
+        REQUIRE(JsonPatch::equals(ConfigCache::parseFile(source, &cached), first));
+        REQUIRE_FALSE(cached);
+
+        writeText(ConfigCache::imagePath(source), image.substr(0, image.size() / 2));
+        REQUIRE(JsonPatch::equals(ConfigCache::parseFile(source, &cached), first));
+        REQUIRE_FALSE(cached);
+
+        writeText(ConfigCache::imagePath(source), "MCFC");
+        REQUIRE(JsonPatch::equals(ConfigCache::parseFile(source, &cached), first));
+        REQUIRE_FALSE(cached);
+    }
+
+    SECTION("Invalid sources still fail") {
+        writeText(source, "{\"broken\": ");
+        REQUIRE_THROWS_AS(ConfigCache::parseFile(source), std::runtime_error);
+        REQUIRE_THROWS_AS(ConfigCache::parseFile((dir.path / "missing.json").string()), std::runtime_error);
+    }
+
+    SECTION("Invalidate") {
+        REQUIRE(ConfigCache::invalidate(source));
+        REQUIRE_FALSE(fs::exists(ConfigCache::imagePath(source)));
+        REQUIRE_FALSE(ConfigCache::invalidate(source));
+    }
+}
+
+TEST_CASE("ConfigCache - ConfigurationManager integration", "[ConfigCache]") {
+    TempDir dir;
+    std::string source = (dir.path / "app.json").string();
+    std::string layer = (dir.path / "defaults.json").string();
+    writeText(source, R"({"network": {"port": 8080}})");
+    writeText(layer, R"({"network": {"port": 1, "host": "localhost"}})");
+
+    SECTION("Disabled by default") {
+        ConfigurationManager config;
+        REQUIRE(config.load(source));
+        REQUIRE_FALSE(fs::exists(ConfigCache::imagePath(source)));
+    }
+
+    SECTION("Load, layers and reload use images") {
+        {
+            ConfigurationManager config;
+            config.setBinaryCache(true);
+            REQUIRE(config.loadLayer("defaults", ConfigPriority::Defaults, layer));
+            REQUIRE(config.load(source));
+        }
+        REQUIRE(fs::exists(ConfigCache::imagePath(source)));
+        REQUIRE(fs::exists(ConfigCache::imagePath(layer)));
+
+        ConfigurationManager config;
+        config.setBinaryCache(true);
+        REQUIRE(config.loadLayer("defaults", ConfigPriority::Defaults, layer));
+        REQUIRE(config.load(source));
+        REQUIRE(config.getInt("network.port") == 8080);
+        REQUIRE(config.getString("network.host") == "localhost");
+
+        writeText(source, R"({"network": {"port": 9090}})");
+        REQUIRE(config.reload());
+        REQUIRE(config.getInt("network.port") == 9090);
+    }
+}
+
+TEST_CASE("ConfigCache - Benchmark startup load", "[ConfigCache][.benchmark]") {
+    TempDir dir;
+    std::string source = (dir.path / "large.json").string();
+    writeText(source, largeConfig());
+    ConfigCache::parseFile(source);
+
+    BENCHMARK("JsonParser::parseFile (330 KB)") {
+        return JsonParser::parseFile(source);
+    };
+
+    BENCHMARK("ConfigCache::parseFile with current image (330 KB)") {
+        return ConfigCache::parseFile(source);
+    };
+
+    BENCHMARK("ConfigCache::hash (330 KB)") {
+        static const std::string text = largeConfig();
+        return ConfigCache::hash(text);
+    };
+}
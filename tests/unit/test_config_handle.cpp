@@ -0,0 +1,165 @@
+#include <catch_amalgamated.hpp>
+#include "../../core/ConfigurationManager.hpp"
+
+#include <atomic>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace mcf;
+
+namespace test_config_handle {
+
+struct PoolSettings {
+    int64_t size = 4;
+    std::string name = "default";
+};
+MCF_JSON_FIELDS(PoolSettings, size, name)
+
+} // namespace test_config_handle
+
+using test_config_handle::PoolSettings;
+
+TEST_CASE("ConfigHandle - Compiled key paths", "[ConfigHandle]") {
+    ConfigurationManager config;
+    config.set("network.limits.max_connections", JsonValue(64));
+
+    ConfigKeyPath path("network..limits.max_connections");
+    REQUIRE(path.parts() == std::vector<std::string>{"network", "limits", "max_connections"});
+    REQUIRE(config.get(path).asInt() == 64);
+    REQUIRE(config.get(ConfigKeyPath("network.limits.missing"), JsonValue(7)).asInt() == 7);
+    REQUIRE(config.get(ConfigKeyPath("network.limits.max_connections.deeper")).isNull());
+    REQUIRE(config.get(ConfigKeyPath("")).isObject());
+}
+
+TEST_CASE("ConfigHandle - Generation", "[ConfigHandle]") {
+    ConfigurationManager config;
+    uint64_t start = config.generation();
+
+    config.set("a", JsonValue(1));
+    REQUIRE(config.generation() > start);
+
+    uint64_t afterSet = config.generation();
+    config.remove("missing");
+    REQUIRE(config.generation() == afterSet);  // Nothing changed
+    config.remove("a");
+    REQUIRE(config.generation() > afterSet);
+
+    uint64_t afterRemove = config.generation();
+    REQUIRE(config.applyPatch(JsonPatch::fromJson(JsonParser::parse(R"([{"op": "add", "path": "/b", "value": 2}])"))));
+    REQUIRE(config.generation() > afterRemove);
+
+    uint64_t afterPatch = config.generation();
+    config.clear();
+    REQUIRE(config.generation() > afterPatch);
+}
+
+TEST_CASE("ConfigHandle - Typed values follow changes", "[ConfigHandle]") {
+    ConfigurationManager config;
+    config.set("network.max_connections", JsonValue(100));
+    config.set("network.host", JsonValue("localhost"));
+    config.set("network.ratio", JsonValue(0.5));
+
+    ConfigHandle<int> maxConnections = config.handle<int>("network.max_connections", 10);
+    ConfigHandle<std::string> host = config.handle<std::string>("network.host");
+    ConfigHandle<double> ratio = config.handle<double>("network.ratio");
+    ConfigHandle<bool> debug = config.handle<bool>("network.debug", true);
+
+    REQUIRE(maxConnections.valid());
+    REQUIRE(maxConnections.key() == "network.max_connections");
+    REQUIRE(maxConnections.get() == 100);
+    REQUIRE(*host == "localhost");
+    REQUIRE(ratio.get() == 0.5);
+    REQUIRE(debug.get());
+
+    config.set("network.max_connections", JsonValue(200));
+    config.set("network.host", JsonValue("example.org"));
+    config.set("network.debug", JsonValue(false));
+    REQUIRE(maxConnections.get() == 200);
+    REQUIRE(host.get() == "example.org");
+    REQUIRE_FALSE(debug.get());
+
+    SECTION("Copies share the cache") {
+        ConfigHandle<int> copy = maxConnections;
+        config.set("network.max_connections", JsonValue(300));
+        REQUIRE(copy.get() == 300);
+        REQUIRE(maxConnections.get() == 300);
+    }
+
+    SECTION("Missing keys and type mismatches fall back to the default") {
+        config.set("network.max_connections", JsonValue("many"));
+        REQUIRE(maxConnections.get() == 10);
+        config.remove("network.max_connections");
+        REQUIRE(maxConnections.get() == 10);
+        config.set("network", JsonValue(1));
+        REQUIRE(host.get().empty());
+    }
+
+    SECTION("Reflected structs") {
+        config.set("pool.size", JsonValue(16));
+        ConfigHandle<PoolSettings> pool = config.handle<PoolSettings>("pool");
+        REQUIRE(pool.get().size == 16);
+        REQUIRE(pool.get().name == "default");
+    }
+
+    SECTION("Unbound handle") {
+        ConfigHandle<int> unbound;
+        REQUIRE_FALSE(unbound.valid());
+    }
+}
+
+TEST_CASE("ConfigHandle - Concurrent readers and writers", "[ConfigHandle]") {
+    ConfigurationManager config;
+    config.set("counter", JsonValue(0));
+    ConfigHandle<int64_t> counter = config.handle<int64_t>("counter", -1);
+
+    std::atomic<bool> running{true};
+    std::atomic<bool> monotonic{true};
+    std::vector<std::thread> readers;
+    for (int i = 0; i < 4; ++i) {
+        readers.emplace_back([&] {
+            int64_t last = 0;
+            while (running.load()) {
+                int64_t value = counter.get();
+                if (value < last) monotonic = false;
+                last = value;
+            }
+        });
+    }
+
+    for (int64_t i = 1; i <= 2000; ++i) {
+        config.set("counter", JsonValue(i));
+    }
+    running = false;
+    for (auto& reader : readers) {
+        reader.join();
+    }
+
+    REQUIRE(monotonic.load());
+    REQUIRE(counter.get() == 2000);
+}
+
+TEST_CASE("ConfigHandle - Benchmark hot path reads", "[ConfigHandle][.benchmark]") {
+    ConfigurationManager config;
+    config.set("modules.network.limits.max_connections", JsonValue(128));
+    config.set("modules.network.host", JsonValue("localhost"));
+    ConfigHandle<int64_t> handle = config.handle<int64_t>("modules.network.limits.max_connections");
+    ConfigHandle<std::string> host = config.handle<std::string>("modules.network.host");
+    ConfigKeyPath path("modules.network.limits.max_connections");
+
+    BENCHMARK("getInt(dotted key)") {
+        return config.getInt("modules.network.limits.max_connections");
+    };
+
+    BENCHMARK("get(ConfigKeyPath)") {
+        return config.get(path).asInt();
+    };
+
+    BENCHMARK("ConfigHandle<int64_t>::get") {
+        return handle.get();
+    };
+
+    BENCHMARK("ConfigHandle<std::string>::get") {
+        return host.get();
+    };
+}
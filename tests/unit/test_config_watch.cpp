@@ -0,0 +1,331 @@
+#include <catch_amalgamated.hpp>
+#include "../../core/ConfigurationManager.hpp"
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <filesystem>
+#include <fstream>
+#include <map>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace mcf;
+namespace fs = std::filesystem;
+
+namespace {
+
+// Matched ids, suffixed with "^" if only an ancestor of the watched value changed
+std::vector<std::string> matches(const ConfigWatchIndex& index, const std::vector<std::string>& path) {
+    std::map<ConfigWatchId, bool> found;
+    index.match(path, [&](ConfigWatchId id, bool ancestorOnly) {
+        auto it = found.emplace(id, ancestorOnly).first;
+        it->second = it->second && ancestorOnly;
+    });
+    std::vector<std::string> result;
+    for (const auto& [id, ancestorOnly] : found) {
+        result.push_back(std::to_string(id) + (ancestorOnly ? "^" : ""));
+    }
+    return result;
+}
+
+} // namespace
+
+TEST_CASE("ConfigWatchIndex - Matching", "[ConfigWatch]") {
+    ConfigWatchIndex index;
+    index.add(1, {"network", "port"}, false);
+    index.add(2, {"network", "*"}, true);
+    index.add(3, {"services", "*", "port"}, true);
+    index.add(5, {"network"}, true);
+
+    SECTION("Exact and subtree matches") {
+        REQUIRE(matches(index, {"network", "port"}) == std::vector<std::string>{"1", "2", "5"});
+        REQUIRE(matches(index, {"network", "host"}) == std::vector<std::string>{"2", "5"});
+        REQUIRE(matches(index, {"network", "tls", "cert"}) == std::vector<std::string>{"2", "5"});
+        REQUIRE(matches(index, {"logging", "level"}).empty());
+    }
+
+    SECTION("Replacing an ancestor reaches the watches below it") {
+        REQUIRE(matches(index, {"network"}) == std::vector<std::string>{"1^", "2^", "5"});
+        REQUIRE(matches(index, {}) == std::vector<std::string>{"1^", "2^", "3^", "5^"});
+    }
+
+    SECTION("Wildcards") {
+        REQUIRE(matches(index, {"services", "api", "port"}) == std::vector<std::string>{"3"});
+        REQUIRE(matches(index, {"services", "api", "host"}).empty());
+
+        index.add(4, {"**", "enabled"}, true);
+        REQUIRE(matches(index, {"enabled"}) == std::vector<std::string>{"4"});
+        REQUIRE(matches(index, {"services", "api", "enabled"}) == std::vector<std::string>{"4"});
+        // Any replaced value might contain an "enabled" key
+        REQUIRE(matches(index, {"logging", "level"}) == std::vector<std::string>{"4^"});
+    }
+
+    SECTION("Literal patterns do not treat '*' as a wildcard") {
+        index.add(6, {"literal", "*"}, false);
+        REQUIRE(matches(index, {"literal", "x"}).empty());
+        REQUIRE(matches(index, {"literal", "*"}) == std::vector<std::string>{"6"});
+    }
+
+    SECTION("Remove") {
+        REQUIRE(index.remove(2, {"network", "*"}, true));
+        REQUIRE_FALSE(index.remove(2, {"network", "*"}, true));
+        REQUIRE(matches(index, {"network", "host"}) == std::vector<std::string>{"5"});
+    }
+
+    SECTION("Removing watches prunes their nodes") {
+        size_t nodes = index.nodeCount();
+        REQUIRE_FALSE(index.remove(7, {"missing", "key"}, false));
+        REQUIRE(index.nodeCount() == nodes);
+
+        for (ConfigWatchId id = 100; id < 200; ++id) {
+            index.add(id, {"session", std::to_string(id), "**"}, true);
+            REQUIRE(index.remove(id, {"session", std::to_string(id), "**"}, true));
+            REQUIRE(index.nodeCount() == nodes);
+        }
+
+        REQUIRE(index.remove(3, {"services", "*", "port"}, true));
+        REQUIRE(index.nodeCount() == nodes - 3);
+        REQUIRE(matches(index, {"network", "port"}) == std::vector<std::string>{"1", "2", "5"});
+    }
+}
+
+TEST_CASE("ConfigurationManager - Subtree watches", "[ConfigWatch]") {
+    ConfigurationManager config;
+    config.set("", JsonParser::parse(R"({
+        "network": {"host": "localhost", "port": 80, "tls": {"enabled": false}},
+        "services": {"api": {"port": 8080}, "web": {"port": 8081}},
+        "logging": {"level": "info"}
+    })"));
+
+    std::vector<ConfigChangeBatch> batches;
+    auto record = [&](const ConfigChangeBatch& batch) { batches.push_back(batch); };
+
+    SECTION("One batch per change with every matching path") {
+        config.watchTree("network.*", record);
+        config.setMany({{"network.host", JsonValue("example.com")},
+                        {"network.port", JsonValue(443)},
+                        {"network.tls.enabled", JsonValue(true)},
+                        {"logging.level", JsonValue("debug")}});
+
+        REQUIRE(batches.size() == 1);
+        REQUIRE(batches[0].pattern == "network.*");
+        REQUIRE(batches[0].paths ==
+                std::vector<std::string>{"network.host", "network.port", "network.tls.enabled"});
+        REQUIRE(batches[0].snapshot.getInt("network.port") == 443);
+    }
+
+    SECTION("Unrelated changes are not delivered") {
+        config.watchTree("network", record);
+        config.set("logging.level", JsonValue("debug"));
+        config.remove("services.web");
+        REQUIRE(batches.empty());
+
+        config.remove("network.tls");
+        REQUIRE(batches.size() == 1);
+        REQUIRE(batches[0].paths == std::vector<std::string>{"network.tls"});
+    }
+
+    SECTION("Single-part and any-depth wildcards") {
+        config.watchTree("services.*.port", record);
+        config.watchTree("**.enabled", record);
+        config.set("services.api.port", JsonValue(9000));
+        config.set("services.api.host", JsonValue("api"));
+        config.set("network.tls.enabled", JsonValue(true));
+
+        REQUIRE(batches.size() == 2);
+        REQUIRE(batches[0].pattern == "services.*.port");
+        REQUIRE(batches[0].paths == std::vector<std::string>{"services.api.port"});
+        REQUIRE(batches[1].pattern == "**.enabled");
+        REQUIRE(batches[1].paths == std::vector<std::string>{"network.tls.enabled"});
+    }
+
+    SECTION("Replacing an ancestor reports the replaced path") {
+        config.watchTree("network.tls", record);
+        config.set("network", JsonParser::parse(R"({"host": "h"})"));
+        REQUIRE(batches.size() == 1);
+        REQUIRE(batches[0].snapshot.has("network.tls") == false);
+    }
+
+    SECTION("Unwatch") {
+        ConfigWatchId id = config.watchTree("network", record);
+        REQUIRE(config.unwatch(id));
+        REQUIRE_FALSE(config.unwatch(id));
+        config.set("network.port", JsonValue(1));
+        REQUIRE(batches.empty());
+    }
+
+    SECTION("Callbacks may register and remove watches") {
+        ConfigWatchId id = 0;
+        id = config.watchTree("network", [&](const ConfigChangeBatch& batch) {
+            batches.push_back(batch);
+            config.unwatch(id);
+            config.watchTree("logging", record);
+        });
+        config.set("network.port", JsonValue(1));
+        config.set("network.port", JsonValue(2));
+        config.set("logging.level", JsonValue("warn"));
+
+        REQUIRE(batches.size() == 2);
+        REQUIRE(batches[1].pattern == "logging");
+    }
+}
+
+TEST_CASE("ConfigurationManager - Key watches", "[ConfigWatch]") {
+    ConfigurationManager config;
+    config.set("", JsonParser::parse(R"({"network": {"port": 80, "host": "a"}})"));
+
+    std::vector<std::string> changes;
+    config.watch("network.port", [&](const std::string& key, const JsonValue& value) {
+        changes.push_back(key + "=" + JsonWriter::write(value));
+    });
+
+    SECTION("Replacing a parent notifies only if the value changed") {
+        config.set("network", JsonParser::parse(R"({"port": 80, "host": "b"})"));
+        REQUIRE(changes.empty());
+
+        config.set("network", JsonParser::parse(R"({"port": 81})"));
+        REQUIRE(changes == std::vector<std::string>{"network.port=81"});
+    }
+
+    SECTION("Remove and clear notify with null") {
+        config.remove("network");
+        config.set("network.port", JsonValue(82));
+        config.clear();
+        REQUIRE(changes == std::vector<std::string>{"network.port=null", "network.port=82", "network.port=null"});
+    }
+
+    SECTION("Unwatch by id leaves other callbacks") {
+        int other = 0;
+        ConfigWatchId id = config.watch("network.port", [&](const std::string&, const JsonValue&) { other++; });
+        config.set("network.port", JsonValue(1));
+        REQUIRE(config.unwatch(id));
+        config.set("network.port", JsonValue(2));
+        REQUIRE(other == 1);
+        REQUIRE(changes.size() == 2);
+    }
+}
+
+TEST_CASE("ConfigurationManager - Overridden writes do not notify", "[ConfigWatch]") {
+    ConfigurationManager config;
+    config.setLayer("pinned", ConfigPriority::Runtime + 1, JsonParser::parse(R"({"network": {"port": 443}})"));
+
+    std::vector<std::string> changes;
+    config.watch("network.port", [&](const std::string& key, const JsonValue& value) {
+        changes.push_back(key + "=" + JsonWriter::write(value));
+    });
+    std::vector<std::vector<std::string>> batches;
+    config.watchTree("network", [&](const ConfigChangeBatch& batch) { batches.push_back(batch.paths); });
+
+    config.set("network.port", JsonValue(80));
+    config.setMany({{"network.port", JsonValue(81)}});
+    REQUIRE(config.applyPatch(JsonPatch::fromJson(
+        JsonParser::parse(R"([{"op": "replace", "path": "/network/port", "value": 82}])"))));
+    config.remove("network.port");
+    REQUIRE(changes.empty());
+    REQUIRE(batches.empty());
+    REQUIRE(config.getInt("network.port") == 443);
+
+    // Visible parts of the same writes are still reported
+    REQUIRE(config.applyPatch(JsonPatch::fromJson(JsonParser::parse(
+        R"([{"op": "add", "path": "/network", "value": {"port": 83, "host": "a"}}])"))));
+    REQUIRE(changes.empty());
+    REQUIRE(batches == std::vector<std::vector<std::string>>{{"network.host"}});
+
+    config.removeLayer("pinned");
+    REQUIRE(changes == std::vector<std::string>{"network.port=83"});
+}
+
+TEST_CASE("ConfigurationManager - Reload notifies once per watch", "[ConfigWatch]") {
+    std::string path = (fs::temp_directory_path() / "mcf_test_config_watch.json").string();
+    {
+        std::ofstream file(path);
+        file << R"({"network": {"host": "a", "port": 1}, "logging": {"level": "info"}})";
+    }
+
+    ConfigurationManager config;
+    REQUIRE(config.load(path));
+
+    std::vector<ConfigChangeBatch> batches;
+    config.watchTree("network", [&](const ConfigChangeBatch& batch) { batches.push_back(batch); });
+
+    {
+        std::ofstream file(path);
+        file << R"({"network": {"host": "b", "port": 2, "mtu": 1500}, "logging": {"level": "debug"}})";
+    }
+    REQUIRE(config.reload());
+
+    REQUIRE(batches.size() == 1);
+    REQUIRE(batches[0].paths == std::vector<std::string>{"network.host", "network.mtu", "network.port"});
+
+    REQUIRE(config.reload());
+    REQUIRE(batches.size() == 1);
+
+    fs::remove(path);
+}
+
+TEST_CASE("ConfigurationManager - Watches on a notification pool", "[ConfigWatch]") {
+    ThreadPool pool(1);
+    ConfigurationManager config;
+    config.setNotificationPool(&pool);
+
+    std::mutex mutex;
+    std::condition_variable delivered;
+    std::vector<std::thread::id> threads;
+    std::atomic<bool> readable{true};
+    config.watchTree("**", [&](const ConfigChangeBatch& batch) {
+        // The writer's lock is not held, so the callback may read the configuration
+        readable = readable && config.has(batch.paths.front());
+        std::lock_guard<std::mutex> lock(mutex);
+        threads.push_back(std::this_thread::get_id());
+        delivered.notify_all();
+    });
+
+    config.set("a", JsonValue(1));
+    config.set("b", JsonValue(2));
+
+    std::unique_lock<std::mutex> lock(mutex);
+    REQUIRE(delivered.wait_for(lock, std::chrono::seconds(5), [&] { return threads.size() == 2; }));
+    REQUIRE(threads[0] != std::this_thread::get_id());
+    REQUIRE(readable);
+    lock.unlock();
+
+    pool.shutdown(true);
+}
+
+TEST_CASE("ConfigurationManager - Benchmark watch dispatch", "[ConfigWatch][.benchmark]") {
+    ConfigurationManager config;
+    std::vector<std::pair<std::string, JsonValue>> values;
+    for (int s = 0; s < 100; ++s) {
+        for (int k = 0; k < 10; ++k) {
+            values.emplace_back("section" + std::to_string(s) + ".key" + std::to_string(k), JsonValue(k));
+        }
+    }
+    config.setMany(values);
+
+    std::atomic<int> calls{0};
+    for (int s = 0; s < 100; ++s) {
+        for (int k = 0; k < 10; ++k) {
+            config.watch("section" + std::to_string(s) + ".key" + std::to_string(k),
+                         [&](const std::string&, const JsonValue&) { calls++; });
+        }
+        config.watchTree("section" + std::to_string(s) + ".*", [&](const ConfigChangeBatch&) { calls++; });
+    }
+
+    int64_t counter = 0;
+    BENCHMARK("set with 1100 watches") {
+        config.set("section42.key7", JsonValue(++counter));
+        return calls.load();
+    };
+
+    BENCHMARK("setMany of one section with 1100 watches") {
+        std::vector<std::pair<std::string, JsonValue>> section;
+        for (int k = 0; k < 10; ++k) {
+            section.emplace_back("section7.key" + std::to_string(k), JsonValue(++counter));
+        }
+        config.setMany(section);
+        return calls.load();
+    };
+}
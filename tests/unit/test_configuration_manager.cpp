@@ -0,0 +1,652 @@
+#include <catch_amalgamated.hpp>
+#include "../../core/ConfigurationManager.hpp"
+
+#include <atomic>
+#include <chrono>
+#include <filesystem>
+#include <fstream>
+#include <map>
+#include <random>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+
+using namespace mcf;
+
+namespace {
+
+std::string compact(const JsonValue& value) {
+    return JsonWriter::write(value);
+}
+
+void fill(ConfigurationManager& config, size_t sections, size_t keysPerSection) {
+    std::vector<std::pair<std::string, JsonValue>> values;
+    for (size_t s = 0; s < sections; ++s) {
+        for (size_t k = 0; k < keysPerSection; ++k) {
+            values.emplace_back("section" + std::to_string(s) + ".key" + std::to_string(k),
+                                JsonValue(static_cast<int64_t>(k)));
+        }
+    }
+    config.setMany(values);
+}
+
+} // namespace
+
+TEST_CASE("ConfigurationManager - Mutable JsonValue is copy-on-write", "[ConfigurationManager]") {
+    JsonValue original = JsonParser::parse(R"({"a": {"b": [1, 2]}, "c": {"d": 1}})");
+    JsonValue copy = original;
+
+    JsonObject& root = copy.asMutableObject();
+    JsonValue& a = root["a"];
+    JsonObject& aObject = a.asMutableObject();
+    aObject["b"].asMutableArray().push_back(JsonValue(3));
+
+    REQUIRE(compact(original) == R"({"a":{"b":[1,2]},"c":{"d":1}})");
+    REQUIRE(compact(copy) == R"({"a":{"b":[1,2,3]},"c":{"d":1}})");
+    REQUIRE(&copy["c"].asObject() == &original["c"].asObject());  // Untouched subtree still shared
+
+    // Once unshared, further changes happen in place
+    REQUIRE(&copy.asMutableObject() == &root);
+    JsonValue number(1);
+    JsonValue object{JsonObject{}};
+    REQUIRE_THROWS_AS(number.asMutableObject(), std::runtime_error);
+    REQUIRE_THROWS_AS(object.asMutableArray(), std::runtime_error);
+}
+
+TEST_CASE("ConfigurationManager - Set and remove", "[ConfigurationManager]") {
+    ConfigurationManager config;
+
+    config.set("a.b.c", JsonValue(1));
+    config.set("a.b.d", JsonValue("x"));
+    config.set("a..e", JsonValue(true));
+    REQUIRE(compact(config.getAll()) == R"({"a":{"b":{"c":1,"d":"x"},"e":true}})");
+
+    SECTION("Non-object intermediates are replaced") {
+        config.set("a.e.f", JsonValue(2));
+        REQUIRE(config.getInt("a.e.f") == 2);
+    }
+
+    SECTION("Snapshots are not affected by later writes") {
+        JsonValue snapshot = config.getAll();
+        config.set("a.b.c", JsonValue(5));
+        config.remove("a.b.d");
+        REQUIRE(snapshot["a"]["b"]["c"].asInt() == 1);
+        REQUIRE(snapshot["a"]["b"].has("d"));
+        REQUIRE(compact(config.getAll()) == R"({"a":{"b":{"c":5},"e":true}})");
+    }
+
+    SECTION("Remove") {
+        config.remove("a.b.c");
+        config.remove("a.b.c.missing");
+        config.remove("a.missing");
+        config.remove("");
+        REQUIRE(compact(config.getAll()) == R"({"a":{"b":{"d":"x"},"e":true}})");
+    }
+
+    SECTION("Root") {
+        config.set("", JsonValue(JsonObject{{"z", JsonValue(1)}}));
+        REQUIRE(compact(config.getAll()) == R"({"z":1})");
+    }
+
+    config.save();
+}
+
+TEST_CASE("ConfigurationManager - setMany", "[ConfigurationManager]") {
+    ConfigurationManager config;
+    config.set("net.port", JsonValue(80));
+    config.set("net.host", JsonValue("a"));
+    config.set("log.level", JsonValue("info"));
+
+    std::map<std::string, int> calls;
+    std::map<std::string, JsonValue> values;
+    for (const char* key : {"net", "net.port", "net.host", "log.level", "log"}) {
+        config.watch(key, [&](const std::string& changed, const JsonValue& value) {
+            ++calls[changed];
+            values[changed] = value;
+        });
+    }
+
+    uint64_t generation = config.generation();
+    config.setMany({
+        {"net.port", JsonValue(81)},
+        {"net.port", JsonValue(82)},
+        {"net.timeout", JsonValue(5)},
+        {"extra.flag", JsonValue(true)},
+    });
+
+    REQUIRE(config.generation() == generation + 1);
+    REQUIRE(config.getInt("net.port") == 82);
+    REQUIRE(config.getInt("net.timeout") == 5);
+    REQUIRE(config.getBool("extra.flag"));
+    REQUIRE(config.isDirty());
+
+    // One coalesced notification per affected watched key, with final values
+    REQUIRE(calls == std::map<std::string, int>{{"net", 1}, {"net.port", 1}});
+    REQUIRE(values["net.port"].asInt() == 82);
+    REQUIRE(values["net"]["timeout"].asInt() == 5);
+
+    SECTION("Replacing a parent notifies changed children") {
+        calls.clear();
+        config.setMany({{"log", JsonValue("off")}});
+        REQUIRE(calls == std::map<std::string, int>{{"log", 1}, {"log.level", 1}});
+        REQUIRE(values["log.level"].isNull());
+    }
+
+    SECTION("Callbacks may read the configuration") {
+        int64_t seen = 0;
+        config.watch("net.timeout", [&](const std::string&, const JsonValue&) {
+            seen = config.getInt("net.timeout");
+        });
+        config.setMany({{"net.timeout", JsonValue(9)}});
+        REQUIRE(seen == 9);
+    }
+}
+
+TEST_CASE("ConfigurationManager - Snapshots", "[ConfigurationManager]") {
+    ConfigurationManager config;
+    config.set("net.port", JsonValue(80));
+    config.set("net.host", JsonValue("a"));
+
+    ConfigSnapshot snapshot = config.snapshot();
+    REQUIRE(snapshot.generation() == config.generation());
+    REQUIRE(snapshot.getInt("net.port") == 80);
+    REQUIRE(snapshot.getString("net..host") == "a");
+    REQUIRE(snapshot.has("net"));
+    REQUIRE_FALSE(snapshot.has("net.port.deeper"));
+    REQUIRE(snapshot.find("missing") == nullptr);
+    REQUIRE(snapshot.find(ConfigKeyPath("net.port"))->asInt() == 80);
+    REQUIRE(snapshot.get("missing", JsonValue(3)).asInt() == 3);
+    REQUIRE(snapshot.getBool("net.port", true));
+
+    std::shared_ptr<const JsonValue> root = snapshot.share();
+
+    config.set("net.port", JsonValue(81));
+    config.remove("net.host");
+    REQUIRE(config.snapshot().generation() > snapshot.generation());
+    REQUIRE(config.getInt("net.port") == 81);
+
+    // Published snapshots never change
+    REQUIRE(snapshot.getInt("net.port") == 80);
+    REQUIRE((*root)["net"]["host"].asString() == "a");
+
+    SECTION("Failed loads keep the published configuration") {
+        std::string missing = (std::filesystem::temp_directory_path() / "mcf_missing_config.json").string();
+        ConfigurationManager other;
+        other.setMany({{"a", JsonValue(1)}});
+        other.save(missing);
+        ConfigSnapshot before = other.snapshot();
+        std::filesystem::remove(missing);
+
+        REQUIRE_FALSE(other.load(missing));
+        REQUIRE(other.snapshot().generation() == before.generation());
+        REQUIRE(other.getInt("a") == 1);
+    }
+
+    SECTION("Callbacks may read the configuration during set") {
+        int64_t seen = 0;
+        config.watch("net.port", [&](const std::string&, const JsonValue&) {
+            seen = config.getInt("net.port");
+        });
+        config.set("net.port", JsonValue(82));
+        REQUIRE(seen == 82);
+    }
+}
+
+TEST_CASE("ConfigurationManager - Readers see consistent snapshots", "[ConfigurationManager]") {
+    ConfigurationManager config;
+    config.setMany({{"pair.a", JsonValue(0)}, {"pair.b", JsonValue(0)}});
+
+    std::atomic<bool> running{true};
+    std::atomic<bool> consistent{true};
+    std::vector<std::thread> readers;
+    for (int i = 0; i < 4; ++i) {
+        readers.emplace_back([&] {
+            while (running.load()) {
+                ConfigSnapshot snapshot = config.snapshot();
+                if (snapshot.getInt("pair.a") != snapshot.getInt("pair.b")) {
+                    consistent = false;
+                }
+            }
+        });
+    }
+
+    for (int64_t i = 1; i <= 2000; ++i) {
+        config.setMany({{"pair.a", JsonValue(i)}, {"pair.b", JsonValue(i)}});
+    }
+    running = false;
+    for (auto& reader : readers) {
+        reader.join();
+    }
+
+    REQUIRE(consistent.load());
+    REQUIRE(config.getInt("pair.b") == 2000);
+}
+
+TEST_CASE("ConfigurationManager - Layers", "[ConfigurationManager]") {
+    ConfigurationManager config;
+    config.setLayer("defaults", ConfigPriority::Defaults, JsonParser::parse(R"({
+        "net": {"port": 80, "host": "localhost", "tls": {"enabled": false}},
+        "log": {"level": "info"},
+        "plugins": ["a", "b"]
+    })"));
+    config.setLayer("production", ConfigPriority::Environment, JsonParser::parse(R"({
+        "net": {"host": "example.org", "tls": {"enabled": true}},
+        "plugins": ["c"]
+    })"));
+
+    REQUIRE(config.getLayerNames() == std::vector<std::string>{"defaults", "production"});
+    REQUIRE(compact(config.getAll()) ==
+            R"({"log":{"level":"info"},"net":{"host":"example.org","port":80,"tls":{"enabled":true}},"plugins":["c"]})");
+
+    SECTION("Runtime document overrides every standard layer") {
+        config.set("net.port", JsonValue(81));
+        REQUIRE(config.getInt("net.port") == 81);
+        REQUIRE(config.getString("net.host") == "example.org");
+
+        config.remove("net.port");
+        REQUIRE(config.getInt("net.port") == 80);
+        REQUIRE(compact(config.getLayer("defaults")["net"]["port"]) == "80");
+    }
+
+    SECTION("Non-object values hide lower layers") {
+        config.set("net", JsonValue("disabled"));
+        REQUIRE(config.getString("net") == "disabled");
+        REQUIRE_FALSE(config.has("net.port"));
+
+        config.set("net.port", JsonValue(1));  // Replaces the string in the runtime document
+        REQUIRE(compact(config.get("net")) == R"({"host":"example.org","port":1,"tls":{"enabled":true}})");
+    }
+
+    SECTION("Replacing and removing layers") {
+        std::map<std::string, int> calls;
+        for (const char* key : {"net.host", "net.port", "log.level"}) {
+            config.watch(key, [&](const std::string& changed, const JsonValue&) { ++calls[changed]; });
+        }
+
+        config.setLayer("production", ConfigPriority::Environment, JsonParser::parse(R"({
+            "net": {"host": "other.org", "tls": {"enabled": true}}
+        })"));
+        REQUIRE(config.getString("net.host") == "other.org");
+        REQUIRE(compact(config.get("plugins")) == R"(["a","b"])");
+        REQUIRE(calls == std::map<std::string, int>{{"net.host", 1}});
+
+        REQUIRE(config.removeLayer("production"));
+        REQUIRE_FALSE(config.removeLayer("production"));
+        REQUIRE(config.getString("net.host") == "localhost");
+        REQUIRE_FALSE(config.getBool("net.tls.enabled"));
+        REQUIRE(config.getLayer("production").isNull());
+    }
+
+    SECTION("Priority order, not insertion order, decides") {
+        config.setLayer("late-defaults", ConfigPriority::Defaults - 1, JsonParser::parse(R"({"net": {"port": 1}})"));
+        REQUIRE(config.getInt("net.port") == 80);
+        config.setLayer("late-defaults", ConfigPriority::Runtime + 1, JsonParser::parse(R"({"net": {"port": 1}})"));
+        config.set("net.port", JsonValue(2));
+        REQUIRE(config.getInt("net.port") == 1);
+    }
+
+    SECTION("Saving writes only the runtime document") {
+        std::string path = (std::filesystem::temp_directory_path() / "mcf_layers_runtime.json").string();
+        config.set("log.level", JsonValue("debug"));
+        REQUIRE(config.save(path));
+        REQUIRE(compact(JsonParser::parseFile(path)) == R"({"log":{"level":"debug"}})");
+        std::filesystem::remove(path);
+    }
+}
+
+TEST_CASE("ConfigurationManager - File layers and reload", "[ConfigurationManager]") {
+    auto dir = std::filesystem::temp_directory_path();
+    std::string base = (dir / "mcf_layers_base.json").string();
+    std::string env = (dir / "mcf_layers_env.json").string();
+    auto write = [](const std::string& path, const std::string& text) {
+        std::ofstream(path) << text;
+    };
+    write(base, R"({"db": {"host": "db", "pool": 4}})");
+    write(env, R"({"db": {"pool": 16}})");
+
+    ConfigurationManager config;
+    REQUIRE(config.loadLayer("base", ConfigPriority::Base, base));
+    REQUIRE(config.loadLayer("env", ConfigPriority::Environment, env));
+    REQUIRE_FALSE(config.loadLayer("missing", ConfigPriority::Base, (dir / "mcf_no_such_layer.json").string()));
+    REQUIRE(config.getInt("db.pool") == 16);
+
+    std::map<std::string, JsonValue> seen;
+    config.watch("db.pool", [&](const std::string& key, const JsonValue& value) { seen[key] = value; });
+
+    write(env, R"({"db": {"pool": 32}})");
+    REQUIRE(config.reload());
+    REQUIRE(config.getInt("db.pool") == 32);
+    REQUIRE(seen["db.pool"].asInt() == 32);
+
+    // The runtime document and the layers are swapped in as one change
+    std::string runtime = (dir / "mcf_layers_runtime_file.json").string();
+    write(runtime, R"({"db": {"user": "app"}})");
+    REQUIRE(config.load(runtime));
+    write(runtime, R"({"db": {"user": "admin"}})");
+    write(env, R"({"db": {"pool": 64}})");
+    std::vector<std::string> users;
+    config.watch("db", [&](const std::string&, const JsonValue& value) {
+        users.push_back(value["user"].asString() + "/" + std::to_string(value["pool"].asInt()));
+    });
+    uint64_t generation = config.generation();
+    REQUIRE(config.reload());
+    REQUIRE(config.generation() == generation + 1);
+    REQUIRE(users == std::vector<std::string>{"admin/64"});
+
+    std::filesystem::remove(env);
+    REQUIRE_FALSE(config.reload());
+    REQUIRE(config.getInt("db.pool") == 64);  // Unreadable layers keep their contents
+
+    std::filesystem::remove(base);
+    std::filesystem::remove(runtime);
+}
+
+TEST_CASE("ConfigurationManager - Failed reload keeps the configuration", "[ConfigurationManager]") {
+    std::string path = (std::filesystem::temp_directory_path() / "mcf_reload_invalid.json").string();
+    std::ofstream(path) << R"({"server": {"port": 8080}})";
+
+    ConfigurationManager config;
+    REQUIRE(config.load(path));
+    int notified = 0;
+    config.watch("server.port", [&](const std::string&, const JsonValue&) { ++notified; });
+
+    std::ofstream(path, std::ios::trunc) << "{ truncated";
+    uint64_t generation = config.generation();
+    REQUIRE_FALSE(config.reload());
+    REQUIRE_FALSE(config.load(path));
+    REQUIRE(config.getInt("server.port") == 8080);
+    REQUIRE(config.generation() == generation);
+    REQUIRE(notified == 0);
+
+    // The first load of an invalid file starts empty but remembers the path
+    ConfigurationManager fresh;
+    REQUIRE_FALSE(fresh.load(path));
+    REQUIRE(compact(fresh.getAll()) == "{}");
+    fresh.set("server.port", JsonValue(81));
+    REQUIRE(fresh.save());
+    REQUIRE(config.reload());
+    REQUIRE(config.getInt("server.port") == 81);
+    REQUIRE(notified == 1);
+
+    std::filesystem::remove(path);
+}
+
+#ifndef _WIN32
+TEST_CASE("ConfigurationManager - Save keeps the file permissions", "[ConfigurationManager]") {
+    namespace fs = std::filesystem;
+    std::string path = (fs::temp_directory_path() / "mcf_save_permissions.json").string();
+    std::ofstream(path, std::ios::trunc) << R"({"token": "old"})";
+    fs::permissions(path, fs::perms::owner_read | fs::perms::owner_write);
+
+    ConfigurationManager config;
+    REQUIRE(config.load(path));
+    config.set("token", JsonValue("new"));
+    REQUIRE(config.save());
+    REQUIRE(fs::status(path).permissions() == (fs::perms::owner_read | fs::perms::owner_write));
+
+    ConfigurationManager reloaded;
+    REQUIRE(reloaded.load(path));
+    REQUIRE(reloaded.getString("token") == "new");
+
+    fs::remove(path);
+}
+#endif
+
+#ifndef _WIN32
+TEST_CASE("ConfigurationManager - Environment variables layer", "[ConfigurationManager]") {
+    ConfigurationManager config;
+    config.setLayer("defaults", ConfigPriority::Defaults,
+                    JsonParser::parse(R"({"network": {"maxConnections": 10, "host": "a"}})"));
+
+    ::setenv("MCFTEST_NETWORK__MAXCONNECTIONS", "64", 1);
+    ::setenv("MCFTEST_NETWORK__HOST", "example.org", 1);
+    ::setenv("MCFTEST_NETWORK__RATIO", "0.25", 1);
+    ::setenv("MCFTEST_FEATURES__FAST", "true", 1);
+    ::setenv("MCFTEST_LIST", "[1, 2]", 1);
+    ::setenv("MCFTEST_VERSION", "1.2.3", 1);
+
+    REQUIRE(config.loadEnvironment("MCFTEST_") == 6);
+    REQUIRE(config.getInt("network.maxConnections") == 64);  // Matched case-insensitively
+    REQUIRE(config.getString("network.host") == "example.org");
+    REQUIRE(config.getFloat("network.ratio") == 0.25);
+    REQUIRE(config.getBool("features.fast"));
+    REQUIRE(config.get("list").size() == 2);
+    REQUIRE(config.getString("version") == "1.2.3");
+
+    config.set("network.host", JsonValue("runtime"));
+    REQUIRE(config.getString("network.host") == "runtime");
+
+    for (const char* name : {"MCFTEST_NETWORK__MAXCONNECTIONS", "MCFTEST_NETWORK__HOST", "MCFTEST_NETWORK__RATIO",
+                             "MCFTEST_FEATURES__FAST", "MCFTEST_LIST", "MCFTEST_VERSION"}) {
+        ::unsetenv(name);
+    }
+}
+#endif
+
+TEST_CASE("ConfigurationManager - Incremental merge matches full merge", "[ConfigurationManager]") {
+    // Random writes to random layers; the incrementally maintained view must
+    // equal the view of a manager that merges the final layers from scratch
+    std::mt19937 random(42);
+    const char* keys[] = {"a", "b", "c"};
+    auto randomKey = [&]() {
+        std::string key = keys[random() % 3];
+        size_t depth = random() % 3;
+        for (size_t d = 0; d < depth; ++d) {
+            key += std::string(".") + keys[random() % 3];
+        }
+        return key;
+    };
+    auto randomValue = [&]() {
+        switch (random() % 4) {
+            case 0: return JsonValue(static_cast<int64_t>(random() % 10));
+            case 1: return JsonValue(JsonObject{});
+            case 2: return JsonValue(JsonArray{JsonValue(1)});
+            default: return JsonValue(JsonObject{{"a", JsonValue(1)}});
+        }
+    };
+
+    ConfigurationManager incremental;
+    ConfigurationManager runtime;  // Mirrors the runtime document of incremental
+    std::vector<ConfigurationManager> layers(3);
+    const int priorities[] = {ConfigPriority::Defaults, ConfigPriority::Base, ConfigPriority::Environment};
+
+    for (int step = 0; step < 600; ++step) {
+        size_t target = random() % 4;
+        bool removing = random() % 4 == 0;
+        std::string key = randomKey();
+        JsonValue value = randomValue();
+
+        ConfigurationManager& document = target == 3 ? runtime : layers[target];
+        if (removing) {
+            document.remove(key);
+        } else {
+            document.set(key, value);
+        }
+
+        if (target == 3) {
+            if (removing) incremental.remove(key); else incremental.set(key, value);
+        } else {
+            incremental.setLayer("layer" + std::to_string(target), priorities[target], layers[target].getAll());
+        }
+
+        if (step % 50 == 49) {
+            ConfigurationManager full;
+            full.set("", runtime.getAll());
+            for (size_t l = 0; l < 3; ++l) {
+                full.setLayer("layer" + std::to_string(l), priorities[l], layers[l].getAll());
+            }
+            INFO("step " << step);
+            REQUIRE(compact(incremental.getAll()) == compact(full.getAll()));
+        }
+    }
+}
+
+TEST_CASE("ConfigurationManager - Auto-save", "[ConfigurationManager]") {
+    std::string path = (std::filesystem::temp_directory_path() / "mcf_test_config_autosave.json").string();
+    {
+        std::ofstream file(path);
+        file << R"({"counter": 0})";
+    }
+
+    auto savedCounter = [&]() {
+        try {
+            return JsonParser::parseFile(path)["counter"].asInt();
+        } catch (const std::exception&) {
+            return int64_t(-1);  // Never happens with atomic replacement
+        }
+    };
+    auto waitForCounter = [&](int64_t expected) {
+        for (int i = 0; i < 500 && savedCounter() != expected; ++i) {
+            std::this_thread::sleep_for(std::chrono::milliseconds(10));
+        }
+        return savedCounter();
+    };
+
+    SECTION("Changes are written in the background") {
+        ConfigurationManager config;
+        REQUIRE(config.load(path));
+        config.setAutoSave(true, std::chrono::milliseconds(20));
+
+        for (int i = 1; i <= 200; ++i) {
+            config.set("counter", JsonValue(i));
+        }
+        REQUIRE(waitForCounter(200) == 200);
+        for (int i = 0; i < 500 && config.isDirty(); ++i) {
+            std::this_thread::sleep_for(std::chrono::milliseconds(10));
+        }
+        REQUIRE_FALSE(config.isDirty());
+        for (const auto& entry : std::filesystem::directory_iterator(std::filesystem::temp_directory_path())) {
+            std::string name = entry.path().filename().string();
+            REQUIRE_FALSE((name.rfind("mcf_test_config_autosave.json.", 0) == 0 && entry.path().extension() == ".tmp"));
+        }
+
+        config.set("counter", JsonValue(201));
+        REQUIRE(waitForCounter(201) == 201);
+    }
+
+    SECTION("Pending changes are saved when enabling") {
+        ConfigurationManager config;
+        REQUIRE(config.load(path));
+        config.set("counter", JsonValue(7));
+        config.setAutoSave(true, std::chrono::milliseconds(10));
+        REQUIRE(waitForCounter(7) == 7);
+    }
+
+    SECTION("Disabling stops background saves; the destructor still saves") {
+        {
+            ConfigurationManager config;
+            REQUIRE(config.load(path));
+            config.setAutoSave(true, std::chrono::milliseconds(10));
+            config.setAutoSave(false);
+            config.set("counter", JsonValue(5));
+            std::this_thread::sleep_for(std::chrono::milliseconds(50));
+            REQUIRE(savedCounter() == 0);
+            REQUIRE(config.isDirty());
+        }
+        REQUIRE(savedCounter() == 5);
+    }
+
+    std::filesystem::remove(path);
+}
+
+TEST_CASE("ConfigurationManager - Benchmark runtime tuning writes", "[ConfigurationManager][.benchmark]") {
+    ConfigurationManager config;
+    fill(config, 100, 100);  // 10k keys
+
+    std::vector<std::pair<std::string, JsonValue>> tuning;
+    for (size_t i = 0; i < 1000; ++i) {
+        tuning.emplace_back("section" + std::to_string(i % 100) + ".key" + std::to_string(i % 37),
+                            JsonValue(static_cast<int64_t>(i)));
+    }
+
+    BENCHMARK("1000 x set() into 10k keys") {
+        for (const auto& [key, value] : tuning) {
+            config.set(key, value);
+        }
+        return config.generation();
+    };
+
+    BENCHMARK("setMany() of 1000 keys into 10k keys") {
+        config.setMany(tuning);
+        return config.generation();
+    };
+
+    std::string path = (std::filesystem::temp_directory_path() / "mcf_bench_config_autosave.json").string();
+    REQUIRE(config.save(path));
+
+    BENCHMARK("1000 x set() + save() into 10k keys") {
+        for (const auto& [key, value] : tuning) {
+            config.set(key, value);
+            config.save();
+        }
+        return config.generation();
+    };
+
+    config.setAutoSave(true, std::chrono::milliseconds(100));
+    BENCHMARK("1000 x set() with auto-save into 10k keys") {
+        for (const auto& [key, value] : tuning) {
+            config.set(key, value);
+        }
+        return config.generation();
+    };
+    config.setAutoSave(false);
+    config.save();
+    std::filesystem::remove(path);
+}
+
+TEST_CASE("ConfigurationManager - Benchmark reads", "[ConfigurationManager][.benchmark]") {
+    ConfigurationManager config;
+    fill(config, 100, 100);
+
+    BENCHMARK("getInt()") {
+        return config.getInt("section42.key17");
+    };
+
+    BENCHMARK("snapshot() + 4 x getInt()") {
+        ConfigSnapshot snapshot = config.snapshot();
+        return snapshot.getInt("section42.key17") + snapshot.getInt("section42.key18") +
+               snapshot.getInt("section43.key17") + snapshot.getInt("section43.key18");
+    };
+
+    std::atomic<bool> running{true};
+    std::thread writer([&] {
+        int64_t i = 0;
+        while (running.load()) {
+            config.set("section1.key1", JsonValue(++i));
+        }
+    });
+
+    BENCHMARK("getInt() while another thread writes") {
+        return config.getInt("section42.key17");
+    };
+
+    running = false;
+    writer.join();
+}
+
+TEST_CASE("ConfigurationManager - Benchmark layers", "[ConfigurationManager][.benchmark]") {
+    ConfigurationManager config;
+    std::vector<JsonValue> layers;
+    for (int l = 0; l < 4; ++l) {
+        ConfigurationManager builder;
+        fill(builder, 100, 25 * (l + 1));
+        layers.push_back(builder.getAll());
+        config.setLayer("layer" + std::to_string(l), l * 100, layers.back());
+    }
+
+    BENCHMARK("getInt() on the merged view of 4 layers") {
+        return config.getInt("section42.key17");
+    };
+
+    ConfigurationManager changed;
+    changed.set("", layers[1]);
+    changed.set("section7.key3", JsonValue(-1));
+    JsonValue variants[] = {layers[1], changed.getAll()};
+    int flip = 0;
+
+    BENCHMARK("setLayer() replacing a 5k-key layer that differs in one key") {
+        config.setLayer("layer1", 100, variants[++flip % 2]);
+        return config.generation();
+    };
+}
@@ -0,0 +1,317 @@
+/**
+ * @file test_file_watch_service.cpp
+ * @brief Unit tests for FileWatchService using Catch2
+ */
+
+#include "../../core/FileWatchService.hpp"
+#include "../../core/Application.hpp"
+#include "../../core/ResourceManager.hpp"
+#include "../../external/catch_amalgamated.hpp"
+
+#include <atomic>
+#include <chrono>
+#include <filesystem>
+#include <fstream>
+#include <mutex>
+#include <set>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace mcf;
+namespace fs = std::filesystem;
+
+// Fresh directory under the temp directory, removed by the destructor
+struct TempDirectory {
+    fs::path path;
+
+    explicit TempDirectory(const std::string& name) : path(fs::temp_directory_path() / name) {
+        fs::remove_all(path);
+        fs::create_directories(path);
+    }
+
+    ~TempDirectory() {
+        std::error_code error;
+        fs::remove_all(path, error);
+    }
+
+    std::string file(const std::string& name) const {
+        return (path / name).string();
+    }
+};
+
+static void writeFile(const std::string& path, const std::string& content) {
+    std::ofstream file(path, std::ios::trunc);
+    file << content;
+}
+
+static std::string readFile(const std::string& path) {
+    std::ifstream file(path);
+    return std::string(std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>());
+}
+
+// Poll until a condition holds or the timeout expires
+template<typename Predicate>
+static bool waitUntil(Predicate predicate, std::chrono::milliseconds timeout = std::chrono::milliseconds(5000)) {
+    auto deadline = std::chrono::steady_clock::now() + timeout;
+    while (!predicate()) {
+        if (std::chrono::steady_clock::now() > deadline) {
+            return false;
+        }
+        std::this_thread::sleep_for(std::chrono::milliseconds(5));
+    }
+    return true;
+}
+
+// Thread-safe list of reported paths
+struct Reports {
+    std::mutex mutex;
+    std::vector<std::string> paths;
+
+    FileChangeCallback callback() {
+        return [this](const std::string& path, FileChangeType) {
+            std::lock_guard<std::mutex> lock(mutex);
+            paths.push_back(fs::path(path).filename().string());
+        };
+    }
+
+    bool contains(const std::string& name) {
+        std::lock_guard<std::mutex> lock(mutex);
+        return std::find(paths.begin(), paths.end(), name) != paths.end();
+    }
+
+    size_t size() {
+        std::lock_guard<std::mutex> lock(mutex);
+        return paths.size();
+    }
+};
+
+// =============================================================================
+// Subscriptions
+// =============================================================================
+
+TEST_CASE("FileWatchService - Subscribers share one watch", "[filewatchservice][core]") {
+    TempDirectory directory("mcf_watch_service_shared");
+    std::string path = directory.file("shared.txt");
+    writeFile(path, "initial");
+
+    FileWatchService service(std::chrono::milliseconds(20));
+    Reports first;
+    Reports second;
+
+    FileWatchId firstId = service.watchFile(path, first.callback());
+    FileWatchId secondId = service.watchFile(path, second.callback());
+    REQUIRE(firstId != secondId);
+    REQUIRE(service.getSubscriptionCount() == 2);
+    REQUIRE(service.getWatchCount() == 1);
+
+    std::this_thread::sleep_for(std::chrono::milliseconds(50));
+    writeFile(path, "changed");
+    REQUIRE(waitUntil([&] { return first.size() > 0 && second.size() > 0; }));
+
+    SECTION("Removing one subscriber keeps the other") {
+        REQUIRE(service.unwatch(firstId));
+        REQUIRE_FALSE(service.unwatch(firstId));
+        REQUIRE(service.getSubscriptionCount() == 1);
+        REQUIRE(service.getWatchCount() == 1);
+
+        size_t before = second.size();
+        writeFile(path, "changed again");
+        REQUIRE(waitUntil([&] { return second.size() > before; }));
+    }
+
+    SECTION("Removing the last subscriber removes the watch") {
+        service.unwatch(firstId);
+        service.unwatch(secondId);
+        REQUIRE(service.getSubscriptionCount() == 0);
+        REQUIRE(service.getWatchCount() == 0);
+    }
+}
+
+TEST_CASE("FileWatchService - Directory filters per subscriber", "[filewatchservice][core]") {
+    TempDirectory directory("mcf_watch_service_filters");
+    FileWatchService service(std::chrono::milliseconds(20));
+    Reports json;
+    Reports all;
+
+    DirectoryWatchOptions jsonOnly;
+    jsonOnly.patterns = {"*.json"};
+    service.watchDirectory(directory.path.string(), json.callback(), jsonOnly);
+    service.watchDirectory(directory.path.string(), all.callback());
+    REQUIRE(service.getWatchCount() == 1);
+
+    std::this_thread::sleep_for(std::chrono::milliseconds(50));
+    writeFile(directory.file("settings.json"), "{}");
+    writeFile(directory.file("notes.txt"), "text");
+
+    REQUIRE(waitUntil([&] { return all.contains("settings.json") && all.contains("notes.txt"); }));
+    REQUIRE(waitUntil([&] { return json.contains("settings.json"); }));
+    REQUIRE_FALSE(json.contains("notes.txt"));
+}
+
+// =============================================================================
+// Delivery
+// =============================================================================
+
+TEST_CASE("FileWatchService - Delivery on an executor", "[filewatchservice][core]") {
+    TempDirectory directory("mcf_watch_service_executor");
+    std::string path = directory.file("pooled.txt");
+    writeFile(path, "initial");
+
+    ThreadPool pool(1);
+    std::thread::id poolThread = pool.submit([] { return std::this_thread::get_id(); }).get();
+
+    FileWatchService service(std::chrono::milliseconds(20));
+    std::mutex mutex;
+    std::set<std::thread::id> threads;
+    FileWatchOptions options;
+    options.executor = &pool;
+    service.watchFile(path, [&](const std::string&, FileChangeType) {
+        std::lock_guard<std::mutex> lock(mutex);
+        threads.insert(std::this_thread::get_id());
+    }, options);
+
+    std::this_thread::sleep_for(std::chrono::milliseconds(50));
+    writeFile(path, "changed");
+    REQUIRE(waitUntil([&] {
+        std::lock_guard<std::mutex> lock(mutex);
+        return !threads.empty();
+    }));
+
+    std::lock_guard<std::mutex> lock(mutex);
+    REQUIRE(threads == std::set<std::thread::id>{poolThread});
+}
+
+TEST_CASE("FileWatchService - Unwatch waits for a running callback", "[filewatchservice][core]") {
+    TempDirectory directory("mcf_watch_service_wait");
+    std::string path = directory.file("slow.txt");
+    writeFile(path, "initial");
+
+    FileWatchService service(std::chrono::milliseconds(20));
+    std::atomic<bool> started{false};
+    std::atomic<bool> finished{false};
+    FileWatchId id = service.watchFile(path, [&](const std::string&, FileChangeType) {
+        started = true;
+        std::this_thread::sleep_for(std::chrono::milliseconds(200));
+        finished = true;
+    });
+
+    std::this_thread::sleep_for(std::chrono::milliseconds(50));
+    writeFile(path, "changed");
+    REQUIRE(waitUntil([&] { return started.load(); }));
+
+    REQUIRE(service.unwatch(id, true));
+    REQUIRE(finished);
+}
+
+TEST_CASE("FileWatchService - Callbacks may subscribe while watches are registered", "[filewatchservice][core]") {
+    TempDirectory directory("mcf_watch_service_nested");
+    std::string trigger = directory.file("trigger.txt");
+    std::string later = directory.file("later.txt");
+    writeFile(trigger, "initial");
+    fs::create_directories(directory.path / "tree");
+    for (int i = 0; i < 200; ++i) {
+        writeFile(directory.file("tree/file" + std::to_string(i) + ".txt"), std::string(1024, 'x'));
+    }
+
+    FileWatchService service(std::chrono::milliseconds(20));
+    service.setContentHashing(true);
+    Reports nested;
+    std::atomic<bool> subscribed{false};
+    service.watchFile(trigger, [&](const std::string&, FileChangeType) {
+        if (!subscribed.exchange(true)) {
+            service.watchFile(later, nested.callback());
+        }
+    });
+
+    // Registering (listing and hashing) a tree on another thread meanwhile
+    std::thread registering([&] {
+        for (int i = 0; i < 5; ++i) {
+            FileWatchId id = service.watchDirectory((directory.path / "tree").string(), [](const std::string&, FileChangeType) {});
+            service.unwatch(id);
+        }
+    });
+
+    std::this_thread::sleep_for(std::chrono::milliseconds(50));
+    writeFile(trigger, "changed");
+    REQUIRE(waitUntil([&] { return subscribed.load(); }));
+    registering.join();
+
+    std::this_thread::sleep_for(std::chrono::milliseconds(50));
+    writeFile(later, "created");
+    REQUIRE(waitUntil([&] { return nested.contains("later.txt"); }));
+}
+
+TEST_CASE("FileWatchService - Unwatch drops queued deliveries", "[filewatchservice][core]") {
+    TempDirectory directory("mcf_watch_service_queued");
+    std::string path = directory.file("queued.txt");
+    writeFile(path, "initial");
+
+    // Occupy the only worker so that the delivery stays queued
+    ThreadPool pool(1);
+    std::atomic<bool> release{false};
+    pool.submit([&] {
+        while (!release) {
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        }
+    });
+
+    FileWatchService service(std::chrono::milliseconds(20));
+    std::atomic<int> calls{0};
+    FileWatchOptions options;
+    options.executor = &pool;
+    FileWatchId id = service.watchFile(path, [&](const std::string&, FileChangeType) { calls++; }, options);
+
+    std::this_thread::sleep_for(std::chrono::milliseconds(50));
+    writeFile(path, "changed");
+    REQUIRE(waitUntil([&] { return pool.getPendingTaskCount() > 0; }));
+
+    service.unwatch(id);
+    release = true;
+    REQUIRE(waitUntil([&] { return pool.getTasksCompleted() == pool.getTasksSubmitted(); }));
+    REQUIRE(calls == 0);
+}
+
+// =============================================================================
+// Subsystems
+// =============================================================================
+
+TEST_CASE("FileWatchService - ResourceManager hot reload", "[filewatchservice][hot-reload]") {
+    TempDirectory directory("mcf_watch_service_resources");
+    std::string path = directory.file("text.txt");
+    writeFile(path, "first");
+
+    FileWatchService service(std::chrono::milliseconds(20));
+    ResourceManager resources;
+    resources.registerLoader<std::string>([](const std::string& file) {
+        return std::make_shared<std::string>(readFile(file));
+    });
+
+    auto original = resources.load<std::string>(path);
+    REQUIRE(*original == "first");
+
+    resources.enableHotReload(service);
+    REQUIRE(resources.isHotReloadEnabled());
+    REQUIRE(service.getWatchCount() == 1);
+
+    std::this_thread::sleep_for(std::chrono::milliseconds(50));
+    writeFile(path, "second");
+    REQUIRE(waitUntil([&] { return *resources.get<std::string>(path) == "second"; }));
+    REQUIRE(*original == "first");
+    REQUIRE(resources.getReferenceCount(path) == 1);
+
+    resources.disableHotReload();
+    REQUIRE_FALSE(resources.isHotReloadEnabled());
+    REQUIRE(service.getWatchCount() == 0);
+}
+
+TEST_CASE("FileWatchService - Registered by Application", "[filewatchservice][application]") {
+    ApplicationConfig config;
+    config.autoLoadPlugins = false;
+    Application app(config);
+    REQUIRE(app.getFileWatchService() != nullptr);
+
+    REQUIRE(app.initialize());
+    REQUIRE(app.getServiceLocator()->resolve<FileWatchService>().get() == app.getFileWatchService());
+    app.shutdown();
+}
@@ -9,8 +9,14 @@
 #include <fstream>
 #include <thread>
 #include <chrono>
+#include <algorithm>
 #include <atomic>
 #include <filesystem>
+#include <condition_variable>
+#include <mutex>
+#include <set>
+#include <utility>
+#include <vector>
 
 using namespace mcf;
 
@@ -333,6 +339,489 @@ TEST_CASE("FileWatcher - Thread safety", "[filewatcher][core]") {
     }
 }
 
+// =============================================================================
+// Glob Matching Tests
+// =============================================================================
+
+TEST_CASE("Glob - Pattern matching", "[filewatcher][core]") {
+    SECTION("Wildcards stay within one path component") {
+        REQUIRE(matchGlob("*.so", "libfoo.so"));
+        REQUIRE_FALSE(matchGlob("*.so", "lib/libfoo.so"));
+        REQUIRE(matchGlob("lib?.so", "liba.so"));
+        REQUIRE_FALSE(matchGlob("lib?.so", "lib.so"));
+        REQUIRE(matchGlob("*", ""));
+    }
+
+    SECTION("Double star crosses directories") {
+        REQUIRE(matchGlob("src/**/*.cpp", "src/a.cpp"));
+        REQUIRE(matchGlob("src/**/*.cpp", "src/x/y/a.cpp"));
+        REQUIRE_FALSE(matchGlob("src/**/*.cpp", "include/a.cpp"));
+        REQUIRE(matchGlob("**", "any/thing"));
+    }
+
+    SECTION("Character classes") {
+        REQUIRE(matchGlob("v[0-9].json", "v7.json"));
+        REQUIRE_FALSE(matchGlob("v[0-9].json", "vx.json"));
+        REQUIRE(matchGlob("[!.]*", "visible"));
+        REQUIRE_FALSE(matchGlob("[!.]*", ".hidden"));
+        REQUIRE(matchGlob("[abc]", "b"));
+    }
+
+    SECTION("Many stars do not backtrack exponentially") {
+        std::string path(64, 'a');
+        auto begin = std::chrono::steady_clock::now();
+        REQUIRE_FALSE(matchGlob("*a*a*a*a*a*a*a*a*a*a*a*a*a*a*a*a*b", path));
+        REQUIRE_FALSE(matchGlob("**a**a**a**a**a**a**a**a**a**a**a**a**b", path + "/" + path));
+        REQUIRE(matchGlob("*a*a*a*a*a*a*a*a*a*a*a*a*a*a*a*a", path));
+        REQUIRE(std::chrono::steady_clock::now() - begin < std::chrono::seconds(1));
+    }
+}
+
+// =============================================================================
+// inotify Backend Tests
+// =============================================================================
+
+#ifdef __linux__
+namespace {
+
+struct RecordedChanges {
+    std::mutex mutex;
+    std::condition_variable changed;
+    std::vector<std::pair<std::string, FileChangeType>> events;
+
+    FileChangeCallback callback() {
+        return [this](const std::string& path, FileChangeType type) {
+            std::lock_guard<std::mutex> lock(mutex);
+            events.emplace_back(std::filesystem::path(path).filename().string(), type);
+            changed.notify_all();
+        };
+    }
+
+    bool waitFor(size_t count, std::chrono::milliseconds timeout = std::chrono::milliseconds(2000)) {
+        std::unique_lock<std::mutex> lock(mutex);
+        return changed.wait_for(lock, timeout, [&] { return events.size() >= count; });
+    }
+
+    // Writes may be seen as a creation followed by a modification, so look for the event itself
+    bool waitForEvent(const std::string& name, FileChangeType type,
+                      std::chrono::milliseconds timeout = std::chrono::milliseconds(2000)) {
+        std::unique_lock<std::mutex> lock(mutex);
+        return changed.wait_for(lock, timeout, [&] {
+            return std::find(events.begin(), events.end(), std::make_pair(name, type)) != events.end();
+        });
+    }
+
+    size_t size() {
+        std::lock_guard<std::mutex> lock(mutex);
+        return events.size();
+    }
+};
+
+void writeFile(const std::filesystem::path& path, const std::string& content) {
+    std::ofstream file(path, std::ios::trunc);
+    file << content;
+}
+
+} // namespace
+
+TEST_CASE("FileWatcher - inotify backend", "[filewatcher][core]") {
+    namespace fs = std::filesystem;
+    fs::path dir = fs::temp_directory_path() / "mcf_test_file_watcher_inotify";
+    fs::remove_all(dir);
+    fs::create_directories(dir);
+    fs::path file = dir / "config.json";
+    writeFile(file, "{}");
+
+    // A long poll interval: everything below must be event driven
+    FileWatcher watcher(std::chrono::milliseconds(10000));
+    REQUIRE(watcher.backend() == FileWatcherBackend::Inotify);
+
+    RecordedChanges changes;
+    watcher.addWatch(file.string(), changes.callback());
+    watcher.start();
+
+    SECTION("Modifications are delivered within milliseconds") {
+        auto begin = std::chrono::steady_clock::now();
+        writeFile(file, "{\"a\": 1}");
+        REQUIRE(changes.waitFor(1));
+        REQUIRE(std::chrono::steady_clock::now() - begin < std::chrono::milliseconds(1000));
+        REQUIRE(changes.events[0].second == FileChangeType::Modified);
+    }
+
+    SECTION("Atomic rename saves are one modification") {
+        writeFile(dir / "config.json.tmp", "{\"a\": 2}");
+        fs::rename(dir / "config.json.tmp", file);
+        REQUIRE(changes.waitFor(1));
+        std::this_thread::sleep_for(std::chrono::milliseconds(100));
+        REQUIRE(changes.size() == 1);
+        REQUIRE(changes.events[0] == std::make_pair(std::string("config.json"), FileChangeType::Modified));
+    }
+
+    SECTION("Deletion and re-creation") {
+        fs::remove(file);
+        REQUIRE(changes.waitFor(1));
+        writeFile(file, "{}");
+        REQUIRE(changes.waitFor(2));
+        REQUIRE(changes.events[0].second == FileChangeType::Deleted);
+        REQUIRE(changes.events[1].second == FileChangeType::Created);
+    }
+
+    SECTION("Other files in the directory are ignored") {
+        writeFile(dir / "other.json", "{}");
+        REQUIRE_FALSE(changes.waitFor(1, std::chrono::milliseconds(200)));
+    }
+
+    SECTION("Removed watches are silent") {
+        watcher.removeWatch(file.string());
+        writeFile(file, "{\"a\": 3}");
+        REQUIRE_FALSE(changes.waitFor(1, std::chrono::milliseconds(200)));
+    }
+
+    SECTION("Removing the directory reports deletion and falls back to polling") {
+        watcher.setPollInterval(std::chrono::milliseconds(20));
+        fs::remove_all(dir);
+        REQUIRE(changes.waitFor(1));
+        REQUIRE(changes.events[0].second == FileChangeType::Deleted);
+
+        fs::create_directories(dir);
+        writeFile(file, "{}");
+        REQUIRE(changes.waitFor(2));
+        REQUIRE(changes.events[1].second == FileChangeType::Created);
+
+        // Watched by the kernel again
+        watcher.setPollInterval(std::chrono::milliseconds(10000));
+        std::this_thread::sleep_for(std::chrono::milliseconds(50));
+        writeFile(file, "{\"a\": 4}");
+        REQUIRE(changes.waitFor(3));
+    }
+
+    watcher.stop();
+    fs::remove_all(dir);
+}
+
+TEST_CASE("FileWatcher - Polling backend", "[filewatcher][core]") {
+    namespace fs = std::filesystem;
+    fs::path file = fs::temp_directory_path() / "mcf_test_file_watcher_polling.txt";
+    writeFile(file, "a");
+
+    FileWatcher watcher(std::chrono::milliseconds(20), FileWatcherBackend::Polling);
+    REQUIRE(watcher.backend() == FileWatcherBackend::Polling);
+
+    RecordedChanges changes;
+    watcher.addWatch(file.string(), changes.callback());
+    watcher.start();
+
+    fs::remove(file);
+    REQUIRE(changes.waitFor(1));
+    REQUIRE(changes.events[0].second == FileChangeType::Deleted);
+    watcher.stop();
+}
+
+TEST_CASE("FileWatcher - Directory watches", "[filewatcher][core]") {
+    namespace fs = std::filesystem;
+    fs::path dir = fs::temp_directory_path() / "mcf_test_file_watcher_tree";
+    fs::remove_all(dir);
+    fs::create_directories(dir / "plugins" / "nested");
+    writeFile(dir / "plugins" / "existing.so", "old");
+
+    auto backend = GENERATE(FileWatcherBackend::Inotify, FileWatcherBackend::Polling);
+    FileWatcher watcher(std::chrono::milliseconds(20), backend);
+    RecordedChanges changes;
+
+    SECTION("Files anywhere in the tree are reported") {
+        REQUIRE(watcher.addDirectoryWatch(dir.string(), changes.callback()));
+        REQUIRE(watcher.isWatchingDirectory(dir.string()));
+        watcher.start();
+
+        writeFile(dir / "plugins" / "nested" / "a.so", "a");
+        REQUIRE(changes.waitForEvent("a.so", FileChangeType::Created));
+
+        writeFile(dir / "plugins" / "existing.so", "new contents");
+        REQUIRE(changes.waitForEvent("existing.so", FileChangeType::Modified));
+
+        fs::remove(dir / "plugins" / "nested" / "a.so");
+        REQUIRE(changes.waitForEvent("a.so", FileChangeType::Deleted));
+    }
+
+    SECTION("Subdirectories created later are watched") {
+        watcher.addDirectoryWatch(dir.string(), changes.callback());
+        watcher.start();
+
+        fs::create_directories(dir / "new" / "deeper");
+        writeFile(dir / "new" / "deeper" / "b.so", "b");
+        REQUIRE(changes.waitForEvent("b.so", FileChangeType::Created));
+
+        std::this_thread::sleep_for(std::chrono::milliseconds(50));
+        writeFile(dir / "new" / "deeper" / "b.so", "bb");
+        REQUIRE(changes.waitForEvent("b.so", FileChangeType::Modified));
+
+        fs::remove_all(dir / "new");
+        REQUIRE(changes.waitForEvent("b.so", FileChangeType::Deleted));
+    }
+
+    SECTION("Glob filters and non-recursive watches") {
+        DirectoryWatchOptions options;
+        options.patterns = {"*.so", "nested/*.cfg"};
+        watcher.addDirectoryWatch((dir / "plugins").string(), changes.callback(), options);
+        options.recursive = false;
+        options.patterns.clear();
+        RecordedChanges flat;
+        watcher.addDirectoryWatch(dir.string(), flat.callback(), options);
+        watcher.start();
+
+        writeFile(dir / "plugins" / "readme.txt", "ignored");
+        writeFile(dir / "plugins" / "other.cfg", "ignored");
+        writeFile(dir / "plugins" / "nested" / "c.so", "c");
+        writeFile(dir / "plugins" / "nested" / "c.cfg", "c");
+        writeFile(dir / "top.txt", "top");
+        REQUIRE(changes.waitFor(2));
+        REQUIRE(flat.waitFor(1));
+        std::this_thread::sleep_for(std::chrono::milliseconds(100));
+
+        // Without a settle time a write may also follow the creation as a modification
+        std::set<std::string> reported;
+        for (const auto& event : changes.events) {
+            reported.insert(event.first);
+        }
+        REQUIRE(reported == std::set<std::string>{"c.cfg", "c.so"});
+        REQUIRE(flat.events[0] == std::make_pair(std::string("top.txt"), FileChangeType::Created));
+        for (const auto& event : flat.events) {
+            REQUIRE(event.first == "top.txt");
+        }
+    }
+
+    SECTION("Bursts of writes settle into one notification") {
+        DirectoryWatchOptions options;
+        options.settleTime = std::chrono::milliseconds(150);
+        watcher.addDirectoryWatch(dir.string(), changes.callback(), options);
+        watcher.start();
+
+        fs::path library = dir / "plugins" / "linking.so";
+        std::string content;
+        for (int i = 0; i < 8; ++i) {
+            content += std::string(1024, static_cast<char>('a' + i));
+            writeFile(library, content);
+            std::this_thread::sleep_for(std::chrono::milliseconds(30));
+        }
+        auto written = std::chrono::steady_clock::now();
+
+        REQUIRE(changes.waitFor(1));
+        REQUIRE(std::chrono::steady_clock::now() - written >= std::chrono::milliseconds(100));
+        REQUIRE(fs::file_size(library) == content.size());
+        std::this_thread::sleep_for(std::chrono::milliseconds(300));
+        REQUIRE(changes.events == std::vector<std::pair<std::string, FileChangeType>>{
+                                      {"linking.so", FileChangeType::Created}});
+    }
+
+    SECTION("Removed directory watches are silent") {
+        watcher.addDirectoryWatch(dir.string(), changes.callback());
+        watcher.start();
+        watcher.removeDirectoryWatch(dir.string());
+        REQUIRE_FALSE(watcher.isWatchingDirectory(dir.string()));
+        writeFile(dir / "plugins" / "d.so", "d");
+        REQUIRE_FALSE(changes.waitFor(1, std::chrono::milliseconds(200)));
+    }
+
+    watcher.stop();
+    fs::remove_all(dir);
+}
+
+TEST_CASE("FileWatcher - Settle time for single files", "[filewatcher][core]") {
+    namespace fs = std::filesystem;
+    fs::path file = fs::temp_directory_path() / "mcf_test_file_watcher_settle.txt";
+    writeFile(file, "0");
+
+    FileWatcher watcher(std::chrono::milliseconds(20));
+    RecordedChanges changes;
+    watcher.addWatch(file.string(), changes.callback(), std::chrono::milliseconds(100));
+    watcher.start();
+
+    for (int i = 1; i <= 5; ++i) {
+        writeFile(file, std::to_string(i));
+        std::this_thread::sleep_for(std::chrono::milliseconds(20));
+    }
+    REQUIRE(changes.waitFor(1));
+    std::this_thread::sleep_for(std::chrono::milliseconds(250));
+    REQUIRE(changes.size() == 1);
+    REQUIRE(changes.events[0].second == FileChangeType::Modified);
+
+    watcher.stop();
+    fs::remove(file);
+}
+
+TEST_CASE("FileWatcher - Staggered polling", "[filewatcher][core]") {
+    namespace fs = std::filesystem;
+    fs::path dir = fs::temp_directory_path() / "mcf_test_file_watcher_staggered";
+    fs::remove_all(dir);
+    fs::create_directories(dir);
+
+    const int count = 2000;
+    FileWatcher watcher(std::chrono::milliseconds(400), FileWatcherBackend::Polling);
+    std::mutex mutex;
+    std::vector<std::chrono::steady_clock::time_point> times;
+    for (int i = 0; i < count; ++i) {
+        fs::path file = dir / ("file" + std::to_string(i) + ".txt");
+        writeFile(file, "a");
+        watcher.addWatch(file.string(), [&](const std::string&, FileChangeType) {
+            std::lock_guard<std::mutex> lock(mutex);
+            times.push_back(std::chrono::steady_clock::now());
+        });
+    }
+    watcher.start();
+    std::this_thread::sleep_for(std::chrono::milliseconds(50));
+
+    for (int i = 0; i < count; ++i) {
+        writeFile(dir / ("file" + std::to_string(i) + ".txt"), "bb");
+    }
+
+    // Every file is found within about one round...
+    auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(5);
+    while (std::chrono::steady_clock::now() < deadline) {
+        std::lock_guard<std::mutex> lock(mutex);
+        if (times.size() >= static_cast<size_t>(count)) {
+            break;
+        }
+    }
+    watcher.stop();
+    REQUIRE(times.size() >= static_cast<size_t>(count));  // A check during a write may add one
+
+    // ...but in batches spread over the interval instead of one burst
+    std::sort(times.begin(), times.end());
+    REQUIRE(times.back() - times.front() > std::chrono::milliseconds(150));
+
+    fs::remove_all(dir);
+}
+
+TEST_CASE("FileWatcher - Content hashing", "[filewatcher][core]") {
+    namespace fs = std::filesystem;
+    fs::path file = fs::temp_directory_path() / "mcf_test_file_watcher_hash.txt";
+    writeFile(file, "contents");
+
+    auto backend = GENERATE(FileWatcherBackend::Inotify, FileWatcherBackend::Polling);
+    FileWatcher watcher(std::chrono::milliseconds(20), backend);
+    watcher.setContentHashing(true);
+    REQUIRE(watcher.isContentHashing());
+
+    RecordedChanges changes;
+    watcher.addWatch(file.string(), changes.callback());
+    watcher.start();
+
+    // Touching or rewriting the same bytes is not a change
+    fs::last_write_time(file, fs::last_write_time(file) + std::chrono::seconds(5));
+    writeFile(file, "contents");
+    REQUIRE_FALSE(changes.waitFor(1, std::chrono::milliseconds(200)));
+
+    // Same size, different bytes
+    writeFile(file, "Contents");
+    REQUIRE(changes.waitFor(1));
+    REQUIRE(changes.events[0].second == FileChangeType::Modified);
+
+    fs::remove(file);
+    REQUIRE(changes.waitFor(2));
+    REQUIRE(changes.events[1].second == FileChangeType::Deleted);
+    watcher.stop();
+}
+
+TEST_CASE("FileWatcher - Presence watches", "[filewatcher][core]") {
+    namespace fs = std::filesystem;
+    fs::path dir = fs::temp_directory_path() / "mcf_test_file_watcher_presence";
+    fs::remove_all(dir);
+    fs::create_directories(dir);
+    fs::path file = dir / "app.log";
+    writeFile(file, "line 1\n");
+
+    auto backend = GENERATE(FileWatcherBackend::Inotify, FileWatcherBackend::Polling);
+    FileWatcher watcher(std::chrono::milliseconds(20), backend);
+    watcher.setContentHashing(true);
+
+    RecordedChanges changes;
+    watcher.addWatch(file.string(), changes.callback(), std::chrono::milliseconds(0), FileWatchMode::Presence);
+    watcher.start();
+
+    // Appends are not reported, even while another watch of the directory wants every change
+    RecordedChanges others;
+    watcher.addWatch((dir / "other.json").string(), others.callback());
+    {
+        std::ofstream log(file, std::ios::app);
+        log << "line 2\n";
+    }
+    REQUIRE_FALSE(changes.waitFor(1, std::chrono::milliseconds(200)));
+
+    // Rotation: the file is moved away and a new one appears in its place
+    fs::rename(file, dir / "app.log.1");
+    REQUIRE(changes.waitForEvent("app.log", FileChangeType::Deleted));
+    writeFile(file, "");
+    REQUIRE(changes.waitForEvent("app.log", FileChangeType::Created));
+
+    if (backend == FileWatcherBackend::Inotify) {
+        // A file renamed over the watched one replaces it
+        size_t before = changes.size();
+        writeFile(dir / "app.log.new", "");
+        fs::rename(dir / "app.log.new", file);
+        REQUIRE(changes.waitFor(before + 1));
+        REQUIRE(changes.events.back() == std::make_pair(std::string("app.log"), FileChangeType::Created));
+    }
+
+    watcher.stop();
+    fs::remove_all(dir);
+}
+
+TEST_CASE("FileWatcher - Benchmark change latency", "[.benchmark][filewatcher]") {
+    namespace fs = std::filesystem;
+    fs::path file = fs::temp_directory_path() / "mcf_bench_file_watcher.txt";
+    writeFile(file, "0");
+
+    for (auto backend : {FileWatcherBackend::Inotify, FileWatcherBackend::Polling}) {
+        FileWatcher watcher(std::chrono::milliseconds(100), backend);
+        RecordedChanges changes;
+        watcher.addWatch(file.string(), changes.callback());
+        watcher.start();
+        std::this_thread::sleep_for(std::chrono::milliseconds(50));
+
+        size_t expected = 0;
+        BENCHMARK(backend == FileWatcherBackend::Inotify ? "Write to callback (inotify)"
+                                                         : "Write to callback (polling, 100 ms)") {
+            writeFile(file, std::to_string(++expected));
+            return changes.waitFor(expected);
+        };
+        watcher.stop();
+    }
+    fs::remove(file);
+}
+TEST_CASE("FileWatcher - Benchmark large polled watch sets", "[.benchmark][filewatcher]") {
+    namespace fs = std::filesystem;
+    fs::path dir = fs::temp_directory_path() / "mcf_bench_file_watcher_polled";
+    fs::remove_all(dir);
+    fs::create_directories(dir);
+
+    const int count = 20000;
+    FileWatcher watcher(std::chrono::milliseconds(200), FileWatcherBackend::Polling);
+    watcher.setContentHashing(true);
+    RecordedChanges changes;
+    for (int i = 0; i < count; ++i) {
+        fs::path file = dir / ("file" + std::to_string(i));
+        writeFile(file, std::to_string(i));
+        watcher.addWatch(file.string(), changes.callback());
+    }
+    watcher.start();
+
+    size_t expected = 0;
+    BENCHMARK("Write to callback among 20000 polled files (200 ms)") {
+        writeFile(dir / ("file" + std::to_string(expected * 7919 % count)), "changed" + std::to_string(expected));
+        return changes.waitFor(++expected, std::chrono::seconds(5));
+    };
+
+    BENCHMARK("Touch without change among 20000 polled files") {
+        fs::path file = dir / ("file" + std::to_string(expected * 7919 % count));
+        fs::last_write_time(file, fs::file_time_type::clock::now());
+        return changes.waitFor(expected + 1, std::chrono::milliseconds(250));
+    };
+
+    watcher.stop();
+    fs::remove_all(dir);
+}
+#endif
+
 // =============================================================================
 // Performance Benchmarks
 // =============================================================================
@@ -7,6 +7,11 @@
 #include <catch_amalgamated.hpp>
 
 #include "../../core/FileSystem.hpp"
+#include <algorithm>
+#include <atomic>
+#include <cstring>
+#include <fstream>
+#include <set>
 #include <string>
 #include <vector>
 #include <thread>
@@ -474,6 +479,76 @@ TEST_CASE("FileSystem - Thread safety", "[filesystem][core][threading]") {
         REQUIRE(dirCount >= numThreads);
     }
 
+    SECTION("Concurrent creation of the same nested directory") {
+        std::string nested = fixture.getTestPath(Path::join("a", "b", "c", "d"));
+        std::vector<std::thread> threads;
+        std::atomic<int> failures{0};
+
+        for (int t = 0; t < numThreads; ++t) {
+            threads.emplace_back([&]() {
+                if (!fixture.fs.createDirectory(nested, true)) {
+                    failures++;
+                }
+            });
+        }
+        for (auto& thread : threads) {
+            thread.join();
+        }
+
+        REQUIRE(failures == 0);
+        REQUIRE(fixture.fs.isDirectory(nested));
+    }
+
+    SECTION("Concurrent readers see the whole file") {
+        std::string path = fixture.getTestPath("shared.bin");
+        std::string content(1024 * 1024 + 7, '\0');
+        for (size_t i = 0; i < content.size(); ++i) {
+            content[i] = static_cast<char>(i * 31);
+        }
+        REQUIRE(fixture.fs.writeFile(path, content));
+
+        std::vector<std::thread> threads;
+        std::atomic<int> mismatches{0};
+        for (int t = 0; t < numThreads; ++t) {
+            threads.emplace_back([&]() {
+                for (int i = 0; i < 10; ++i) {
+                    if (fixture.fs.readFile(path) != content) {
+                        mismatches++;
+                    }
+                    if (fixture.fs.readBinary(path).size() != content.size()) {
+                        mismatches++;
+                    }
+                }
+            });
+        }
+        for (auto& thread : threads) {
+            thread.join();
+        }
+
+        REQUIRE(mismatches == 0);
+    }
+
+    SECTION("Writers of the same path do not interleave") {
+        std::string path = fixture.getTestPath("contended.txt");
+        std::vector<std::thread> threads;
+
+        for (int t = 0; t < numThreads; ++t) {
+            threads.emplace_back([&fixture, &path, t]() {
+                std::string content(256 * 1024, static_cast<char>('a' + t));
+                for (int i = 0; i < 5; ++i) {
+                    fixture.fs.writeFile(path, content);
+                }
+            });
+        }
+        for (auto& thread : threads) {
+            thread.join();
+        }
+
+        std::string result = fixture.fs.readFile(path);
+        REQUIRE(result.size() == 256 * 1024);
+        REQUIRE(std::count(result.begin(), result.end(), result[0]) == static_cast<long>(result.size()));
+    }
+
     fixture.TearDown();
 }
 
@@ -503,6 +578,389 @@ TEST_CASE("FileSystem - Error handling", "[filesystem][core][error]") {
     fixture.TearDown();
 }
 
+TEST_CASE("FileSystem - Mapped files", "[filesystem][core][mmap]") {
+    FileSystemTestFixture fixture;
+    fixture.SetUp();
+    std::string path = fixture.getTestPath("mapped.txt");
+    fixture.fs.writeFile(path, "Hello, mapped world!");
+
+    SECTION("Read-only mapping views the contents") {
+        MappedFile file = fixture.fs.map(path);
+        REQUIRE(file.isOpen());
+        REQUIRE(file.mode() == MapMode::ReadOnly);
+        REQUIRE(file.path() == path);
+        REQUIRE(file.size() == 20);
+        REQUIRE(file.view() == "Hello, mapped world!");
+        REQUIRE(file.bytes()[0] == 'H');
+        REQUIRE_THROWS_AS(file.writableData(), std::runtime_error);
+    }
+
+    SECTION("Read-write mapping changes the file") {
+        {
+            MappedFile file = fixture.fs.map(path, MapMode::ReadWrite);
+            std::memcpy(file.writableData(), "Jello", 5);
+            REQUIRE(file.flush());
+        }
+        REQUIRE(fixture.fs.readFile(path) == "Jello, mapped world!");
+    }
+
+    SECTION("Hints and pre-faulting") {
+        MapOptions options;
+        options.advice = MapAdvice::Sequential;
+        options.populate = true;
+        MappedFile file = fixture.fs.map(path, MapMode::ReadOnly, options);
+        REQUIRE(file.view() == "Hello, mapped world!");
+        REQUIRE(file.advise(MapAdvice::Random, 3, 100));
+        REQUIRE(file.advise(MapAdvice::WillNeed));
+    }
+
+    SECTION("Empty file maps to an empty view") {
+        std::string empty = fixture.getTestPath("empty.txt");
+        fixture.fs.writeFile(empty, "");
+        MappedFile file = fixture.fs.map(empty);
+        REQUIRE(file.isOpen());
+        REQUIRE(file.empty());
+        REQUIRE(file.view().empty());
+        REQUIRE(file.flush());
+    }
+
+    SECTION("Move transfers the mapping") {
+        MappedFile first = fixture.fs.map(path);
+        MappedFile second(std::move(first));
+        REQUIRE_FALSE(first.isOpen());
+        REQUIRE(second.view() == "Hello, mapped world!");
+
+        MappedFile third;
+        third = std::move(second);
+        REQUIRE(third.view() == "Hello, mapped world!");
+        third.close();
+        REQUIRE_FALSE(third.isOpen());
+        REQUIRE(third.view().empty());
+    }
+
+    SECTION("Missing files and directories throw") {
+        REQUIRE_THROWS_AS(fixture.fs.map(fixture.getTestPath("missing.txt")), std::runtime_error);
+        REQUIRE_THROWS_AS(fixture.fs.map(fixture.testDir), std::runtime_error);
+    }
+
+    fixture.TearDown();
+}
+
+TEST_CASE("FileSystem - Copies and durable writes", "[filesystem][core][write]") {
+    FileSystemTestFixture fixture;
+    fixture.SetUp();
+
+    std::string source = fixture.getTestPath("source.bin");
+    std::string destination = fixture.getTestPath("copy.bin");
+
+    // Not a multiple of any buffer or page size
+    std::string large(3 * 1024 * 1024 + 1234, '\0');
+    for (size_t i = 0; i < large.size(); ++i) {
+        large[i] = static_cast<char>((i * 131) >> 3);
+    }
+
+    SECTION("Large and empty files are copied exactly") {
+        REQUIRE(fixture.fs.writeFile(source, large));
+        REQUIRE(fixture.fs.copyFile(source, destination));
+        REQUIRE(fixture.fs.readFile(destination) == large);
+
+        // Copying over a longer file truncates it
+        REQUIRE(fixture.fs.writeFile(source, ""));
+        REQUIRE(fixture.fs.copyFile(source, destination));
+        REQUIRE(fixture.fs.getFileSize(destination) == 0);
+    }
+
+    SECTION("Copies keep the source permissions") {
+#ifndef _WIN32
+        REQUIRE(fixture.fs.writeFile(source, "#!/bin/sh\n"));
+        REQUIRE(chmod(source.c_str(), 0750) == 0);
+        REQUIRE(fixture.fs.copyFile(source, destination));
+        struct stat st;
+        REQUIRE(stat(destination.c_str(), &st) == 0);
+        REQUIRE((st.st_mode & 0777) == 0750);
+#endif
+    }
+
+    SECTION("Copying onto itself fails and keeps the file") {
+        REQUIRE(fixture.fs.writeFile(source, "keep me"));
+        REQUIRE_FALSE(fixture.fs.copyFile(source, source));
+        REQUIRE(fixture.fs.readFile(source) == "keep me");
+        REQUIRE_FALSE(fixture.fs.copyFile(fixture.getTestPath("missing.bin"), destination));
+        REQUIRE_FALSE(fixture.fs.exists(destination));
+    }
+
+#ifdef __linux__
+    SECTION("Files that report no size are copied by reading them") {
+        REQUIRE(fixture.fs.copyFile("/proc/self/status", destination));
+        REQUIRE(fixture.fs.readFile(destination).find("Name:") != std::string::npos);
+    }
+#endif
+
+    SECTION("Every durability mode writes the same bytes") {
+        for (Durability durability : {Durability::None, Durability::Data, Durability::Atomic}) {
+            WriteOptions options;
+            options.durability = durability;
+            REQUIRE(fixture.fs.writeFile(destination, large, options));
+            REQUIRE(fixture.fs.readFile(destination) == large);
+
+            options.append = true;
+            REQUIRE(fixture.fs.writeFile(destination, "tail", options));
+            REQUIRE(fixture.fs.getFileSize(destination) == large.size() + 4);
+
+            REQUIRE(fixture.fs.copyFile(destination, source, durability));
+            REQUIRE(fixture.fs.readFile(source) == large + "tail");
+        }
+        REQUIRE(fixture.fs.find(fixture.testDir, "*.tmp").empty());
+    }
+
+    SECTION("Atomic writes replace the file and keep its permissions") {
+        REQUIRE(fixture.fs.writeFile(destination, "old"));
+#ifndef _WIN32
+        REQUIRE(chmod(destination.c_str(), 0600) == 0);
+#endif
+        std::string before = fixture.fs.readFile(destination);
+
+        WriteOptions options;
+        options.durability = Durability::Atomic;
+        REQUIRE(fixture.fs.writeLines(destination, {"new", "lines"}, options));
+        REQUIRE(fixture.fs.readLines(destination) == std::vector<std::string>{"new", "lines"});
+        REQUIRE(before == "old");
+#ifndef _WIN32
+        struct stat st;
+        REQUIRE(stat(destination.c_str(), &st) == 0);
+        REQUIRE((st.st_mode & 0777) == 0600);
+#endif
+
+        // A failed atomic write leaves the target alone
+        REQUIRE_FALSE(fixture.fs.writeFile(fixture.getTestPath(Path::join("missing", "file.txt")), "x", options));
+    }
+
+    SECTION("Concurrent atomic writers use their own temporary files") {
+        REQUIRE(fixture.fs.writeFile(destination + ".tmp", "not ours"));
+
+        WriteOptions options;
+        options.durability = Durability::Atomic;
+        std::vector<std::string> versions;
+        for (char c : {'a', 'b', 'c', 'd'}) {
+            versions.push_back(std::string(256 * 1024 + 17, c));
+        }
+        std::vector<std::thread> writers;
+        std::atomic<int> failures{0};
+        for (const auto& version : versions) {
+            writers.emplace_back([&, version]() {
+                FileSystem own;  // Separate instances do not share path locks
+                for (int i = 0; i < 20; ++i) {
+                    if (!own.writeFile(destination, version, options) || !own.copyFile(destination, source, Durability::Atomic)) {
+                        failures++;
+                    }
+                }
+            });
+        }
+        for (auto& writer : writers) {
+            writer.join();
+        }
+        REQUIRE(failures == 0);
+        REQUIRE(std::find(versions.begin(), versions.end(), fixture.fs.readFile(destination)) != versions.end());
+        REQUIRE(std::find(versions.begin(), versions.end(), fixture.fs.readFile(source)) != versions.end());
+
+        REQUIRE(fixture.fs.readFile(destination + ".tmp") == "not ours");
+        std::vector<std::string> leftovers = fixture.fs.find(fixture.testDir, "*.tmp");
+        REQUIRE(leftovers == std::vector<std::string>{destination + ".tmp"});
+    }
+
+    SECTION("Buffers are written back to back") {
+        std::vector<std::string> parts;
+        std::vector<std::string_view> buffers;
+        std::string expected;
+        // More buffers than one writev() call takes, some of them empty
+        for (int i = 0; i < 3000; ++i) {
+            parts.push_back(i % 7 == 0 ? std::string() : std::string(static_cast<size_t>(i % 50), char('a' + i % 26)));
+        }
+        parts.push_back(large);
+        for (const auto& part : parts) {
+            buffers.push_back(part);
+            expected += part;
+        }
+
+        REQUIRE(fixture.fs.writeBuffers(destination, buffers));
+        REQUIRE(fixture.fs.readFile(destination) == expected);
+
+        WriteOptions options;
+        options.append = true;
+        REQUIRE(fixture.fs.writeBuffers(destination, {"x", "", "yz"}, options));
+        REQUIRE(fixture.fs.readFile(destination) == expected + "xyz");
+        REQUIRE(fixture.fs.writeBuffers(destination, {}));
+        REQUIRE(fixture.fs.getFileSize(destination) == 0);
+    }
+
+    fixture.TearDown();
+}
+
+TEST_CASE("Glob - Compiled patterns", "[filesystem][glob]") {
+    SECTION("Literal, wildcard and any-depth segments") {
+        Glob glob("assets/**/*.png");
+        REQUIRE(glob.matches("assets/icon.png"));
+        REQUIRE(glob.matches("assets/ui/buttons/ok.png"));
+        REQUIRE_FALSE(glob.matches("assets/ui/ok.jpg"));
+        REQUIRE_FALSE(glob.matches("other/icon.png"));
+
+        REQUIRE(Glob("**").matches("a/b/c"));
+        REQUIRE(Glob("a/**").matches("a/b"));
+        REQUIRE(Glob("src/[a-c]?.cpp").matches("src/b1.cpp"));
+        REQUIRE_FALSE(Glob("src/[!a-c]?.cpp").matches("src/b1.cpp"));
+        REQUIRE(Glob("a**b").matches("a/x/b"));
+    }
+
+    SECTION("Brace sets expand into alternatives") {
+        Glob glob("textures/{ui,world/{day,night}}/*.{png,jpg}");
+        REQUIRE(glob.matches("textures/ui/a.png"));
+        REQUIRE(glob.matches("textures/world/night/b.jpg"));
+        REQUIRE_FALSE(glob.matches("textures/world/b.jpg"));
+        REQUIRE_FALSE(glob.matches("textures/ui/a.gif"));
+
+        REQUIRE(Glob("[{]x").matches("{x"));
+        REQUIRE(Glob("{unclosed").matches("{unclosed"));
+    }
+
+    SECTION("Subtrees that cannot match are pruned") {
+        Glob glob("textures/{ui,world}/*.png");
+        REQUIRE(glob.mayMatchBelow(""));
+        REQUIRE(glob.mayMatchBelow("textures"));
+        REQUIRE(glob.mayMatchBelow("textures/ui"));
+        REQUIRE_FALSE(glob.mayMatchBelow("textures/ui/deeper"));
+        REQUIRE_FALSE(glob.mayMatchBelow("shaders"));
+
+        Glob deep("data/**/*.json");
+        REQUIRE(deep.mayMatchBelow("data/a/b/c"));
+        REQUIRE_FALSE(deep.mayMatchBelow("logs"));
+    }
+
+    SECTION("Repeated any-depth segments do not backtrack exponentially") {
+        std::string path;
+        for (int i = 0; i < 40; ++i) {
+            path += "a/";
+        }
+        auto begin = std::chrono::steady_clock::now();
+        REQUIRE_FALSE(Glob("**/a/**/a/**/a/**/a/**/a/**/a/**/a/**/a/**/b").matches(path + "c"));
+        REQUIRE(Glob("**/a/**/a/**/a/**/a/**/a/**/a/**/a/**/a/**/b").matches(path + "b"));
+        REQUIRE(std::chrono::steady_clock::now() - begin < std::chrono::seconds(1));
+    }
+}
+
+// Creates dirs d0..d{dirs-1}, each with files f0.txt.. and one image.png, plus nested/deep/x.png
+static void createTree(FileSystemTestFixture& fixture, int dirs, int filesPerDir) {
+    for (int d = 0; d < dirs; ++d) {
+        std::string dir = fixture.getTestPath("d" + std::to_string(d));
+        fixture.fs.createDirectory(dir);
+        for (int f = 0; f < filesPerDir; ++f) {
+            fixture.fs.writeFile(Path::join(dir, "f" + std::to_string(f) + ".txt"), "x");
+        }
+        fixture.fs.writeFile(Path::join(dir, "image.png"), "png");
+    }
+    fixture.fs.createDirectory(fixture.getTestPath(Path::join("nested", "deep")), true);
+    fixture.fs.writeFile(fixture.getTestPath(Path::join("nested", "deep", "x.png")), "png");
+}
+
+TEST_CASE("FileSystem - Walk and glob", "[filesystem][core][walk]") {
+    FileSystemTestFixture fixture;
+    fixture.SetUp();
+    createTree(fixture, 5, 3);
+
+    auto collect = [&](const WalkOptions& options) {
+        std::set<std::string> seen;
+        REQUIRE(fixture.fs.walk(fixture.testDir, [&](const DirectoryEntry& entry) {
+            seen.insert(entry.relativePath);
+            return true;
+        }, options));
+        return seen;
+    };
+
+    SECTION("Walk reports every entry with its relative path and type") {
+        std::set<std::string> seen;
+        size_t directories = 0;
+        fixture.fs.walk(fixture.testDir, [&](const DirectoryEntry& entry) {
+            seen.insert(entry.relativePath);
+            if (entry.type == FileType::Directory) {
+                directories++;
+            }
+            REQUIRE(entry.path == Path::join(fixture.testDir, entry.relativePath));
+            return true;
+        });
+        // 5 dirs with 4 files each, nested, nested/deep and nested/deep/x.png
+        REQUIRE(seen.size() == 5 + 20 + 3);
+        REQUIRE(directories == 7);
+        REQUIRE(seen.count("nested/deep/x.png"));
+        REQUIRE(seen.size() == fixture.fs.listDirectory(fixture.testDir, true).size());
+    }
+
+    SECTION("Parallel walk reports the same entries") {
+        ThreadPool pool(4);
+        WalkOptions options;
+        options.pool = &pool;
+        WalkOptions sequential;
+        REQUIRE(collect(options) == collect(sequential));
+    }
+
+    SECTION("Non-recursive walk stays in the root") {
+        WalkOptions options;
+        options.recursive = false;
+        REQUIRE(collect(options).size() == 6);
+    }
+
+    SECTION("Visitor can stop the walk") {
+        ThreadPool pool(2);
+        WalkOptions options;
+        options.pool = &pool;
+        int visits = 0;
+        REQUIRE_FALSE(fixture.fs.walk(fixture.testDir, [&](const DirectoryEntry&) {
+            return ++visits < 3;
+        }, options));
+        REQUIRE(visits == 3);
+    }
+
+    SECTION("Glob matches relative paths") {
+        auto images = fixture.fs.glob(fixture.testDir, "**/*.png");
+        REQUIRE(images.size() == 6);
+        REQUIRE(std::is_sorted(images.begin(), images.end()));
+
+        auto some = fixture.fs.glob(fixture.testDir, "{d1,d3}/f[0-1].txt");
+        REQUIRE(some == std::vector<std::string>{
+            Path::join(fixture.testDir, "d1", "f0.txt"), Path::join(fixture.testDir, "d1", "f1.txt"),
+            Path::join(fixture.testDir, "d3", "f0.txt"), Path::join(fixture.testDir, "d3", "f1.txt")});
+
+        ThreadPool pool(3);
+        WalkOptions options;
+        options.pool = &pool;
+        // "**" also matches zero segments, so the directory itself is included
+        REQUIRE(fixture.fs.glob(fixture.testDir, "nested/**", options).size() == 3);
+    }
+
+    SECTION("Find matches names with glob syntax") {
+        REQUIRE(fixture.fs.find(fixture.testDir, "*.{png,txt}", true).size() == 21);
+        REQUIRE(fixture.fs.find(fixture.testDir, "d?", false).size() == 5);
+    }
+
+#ifndef _WIN32
+    SECTION("Followed symlink loops are visited once") {
+        std::string link = fixture.getTestPath(Path::join("nested", "deep", "loop"));
+        REQUIRE(symlink("../..", link.c_str()) == 0);
+
+        WalkOptions plain;
+        auto notFollowed = collect(plain);
+        REQUIRE(notFollowed.count("nested/deep/loop"));
+        REQUIRE_FALSE(notFollowed.count("nested/deep/loop/d0"));
+
+        WalkOptions follow;
+        follow.followSymlinks = true;
+        auto followed = collect(follow);
+        REQUIRE(followed.count("nested/deep/loop"));
+        REQUIRE_FALSE(followed.count("nested/deep/loop/nested"));
+    }
+#endif
+
+    fixture.TearDown();
+}
+
 TEST_CASE("FileSystem - Benchmark operations", "[filesystem][.benchmark]") {
     FileSystemTestFixture fixture;
     fixture.SetUp();
@@ -530,5 +988,106 @@ TEST_CASE("FileSystem - Benchmark operations", "[filesystem][.benchmark]") {
         return 0;
     };
 
+    std::string large = fixture.getTestPath("large.bin");
+    fixture.fs.writeFile(large, std::string(64 * 1024 * 1024, 'x'));
+
+    BENCHMARK("Read 64 MB file") {
+        return fixture.fs.readFile(large).size();
+    };
+
+    BENCHMARK("Map 64 MB file") {
+        // Touch one byte per page so the comparison includes faulting the data in
+        MappedFile file = fixture.fs.map(large);
+        size_t sum = 0;
+        for (size_t i = 0; i < file.size(); i += 4096) {
+            sum += static_cast<unsigned char>(file.data()[i]);
+        }
+        return sum;
+    };
+
+    // Copies: the old stream copy through user space vs. copyFile()
+    std::string copy = fixture.getTestPath("large_copy.bin");
+    BENCHMARK("Copy 64 MB file through streams") {
+        std::ifstream src(large, std::ios::binary);
+        std::ofstream dst(copy, std::ios::binary);
+        dst << src.rdbuf();
+        return dst.good();
+    };
+
+    BENCHMARK("Copy 64 MB file with copyFile()") {
+        return fixture.fs.copyFile(large, copy);
+    };
+
+    // Writing a file from several pieces: concatenating into an ofstream vs. one gather write
+    std::vector<std::string> pieces(64, std::string(1024 * 1024, 'p'));
+    BENCHMARK("Write 64 x 1 MB pieces through ofstream") {
+        std::ofstream file(copy, std::ios::binary);
+        for (const auto& piece : pieces) {
+            file.write(piece.data(), static_cast<std::streamsize>(piece.size()));
+        }
+        return file.good();
+    };
+
+    BENCHMARK("Write 64 x 1 MB pieces with writeBuffers()") {
+        return fixture.fs.writeBuffers(copy, std::vector<std::string_view>(pieces.begin(), pieces.end()));
+    };
+
+    WriteOptions durable;
+    durable.durability = Durability::Atomic;
+    BENCHMARK("Write 64 x 1 MB pieces atomically") {
+        return fixture.fs.writeBuffers(copy, std::vector<std::string_view>(pieces.begin(), pieces.end()), durable);
+    };
+
+    // Tree walks: listing and filtering everything vs. streaming, parallel and pruned walks
+    createTree(fixture, 200, 100);
+    ThreadPool pool(4);
+    WalkOptions parallel;
+    parallel.pool = &pool;
+
+    BENCHMARK("List 20k-file tree recursively") {
+        return fixture.fs.listDirectory(fixture.testDir, true).size();
+    };
+
+    BENCHMARK("Walk 20k-file tree") {
+        size_t count = 0;
+        fixture.fs.walk(fixture.testDir, [&](const DirectoryEntry&) { return ++count > 0; });
+        return count;
+    };
+
+    BENCHMARK("Walk 20k-file tree on a 4-thread pool") {
+        size_t count = 0;
+        fixture.fs.walk(fixture.testDir, [&](const DirectoryEntry&) { return ++count > 0; }, parallel);
+        return count;
+    };
+
+    BENCHMARK("Find *.png in 20k-file tree") {
+        return fixture.fs.find(fixture.testDir, "*.png", true).size();
+    };
+
+    BENCHMARK("Glob d1?/*.png in 20k-file tree (pruned)") {
+        return fixture.fs.glob(fixture.testDir, "d1?/*.png").size();
+    };
+
+    // Readers no longer queue behind each other: time per thread should stay flat as threads are added
+    std::string shared = fixture.getTestPath("shared_4mb.bin");
+    fixture.fs.writeFile(shared, std::string(4 * 1024 * 1024, 'r'));
+    for (int threadCount : {1, 2, 4, 8}) {
+        BENCHMARK("Read 4 MB file 16 times on each of " + std::to_string(threadCount) + " threads") {
+            std::vector<std::thread> threads;
+            std::atomic<size_t> total{0};
+            for (int t = 0; t < threadCount; ++t) {
+                threads.emplace_back([&]() {
+                    for (int i = 0; i < 16; ++i) {
+                        total += fixture.fs.readFile(shared).size();
+                    }
+                });
+            }
+            for (auto& thread : threads) {
+                thread.join();
+            }
+            return total.load();
+        };
+    }
+
     fixture.TearDown();
 }
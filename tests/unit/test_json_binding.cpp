@@ -0,0 +1,269 @@
+#include <catch_amalgamated.hpp>
+#include "../../core/JsonBinding.hpp"
+
+#include <cstdint>
+#include <map>
+#include <optional>
+#include <string>
+#include <vector>
+
+namespace test_binding {
+
+struct Limits {
+    int cpu = 1;
+    int64_t memory = 512;
+};
+MCF_JSON_FIELDS(Limits, cpu, memory)
+
+struct NetworkConfig {
+    uint16_t port = 8080;
+    int maxConnections = 100;
+    std::string host = "localhost";
+    bool tls = false;
+    double timeout = 1.5;
+    std::vector<std::string> peers;
+    std::optional<int> retries;
+    Limits limits;
+    std::map<std::string, int> weights;
+    mcf::JsonValue extra;
+};
+MCF_JSON_FIELDS(NetworkConfig, port, maxConnections, host, tls, timeout, peers, retries, limits,
+                weights, extra)
+
+// The documented maximum number of members; names whose seed search took
+// thousands of tries with the former, denser key table
+struct WideConfig {
+    int value00 = 0;
+    int value01 = 0;
+    int value02 = 0;
+    int value03 = 0;
+    int value04 = 0;
+    int value05 = 0;
+    int value06 = 0;
+    int value07 = 0;
+    int value08 = 0;
+    int value09 = 0;
+    int value10 = 0;
+    int value11 = 0;
+    int value12 = 0;
+    int value13 = 0;
+    int value14 = 0;
+    int value15 = 0;
+    int value16 = 0;
+    int value17 = 0;
+    int value18 = 0;
+    int value19 = 0;
+    int value20 = 0;
+    int value21 = 0;
+    int value22 = 0;
+    int value23 = 0;
+    int value24 = 0;
+    int value25 = 0;
+    int value26 = 0;
+    int value27 = 0;
+    int value28 = 0;
+    int value29 = 0;
+    int value30 = 0;
+    int value31 = 0;
+    int value32 = 0;
+    int value33 = 0;
+    int value34 = 0;
+    int value35 = 0;
+    int value36 = 0;
+    int value37 = 0;
+    int value38 = 0;
+    int value39 = 0;
+    int value40 = 0;
+    int value41 = 0;
+    int value42 = 0;
+    int value43 = 0;
+    int value44 = 0;
+    int value45 = 0;
+    int value46 = 0;
+    int value47 = 0;
+};
+MCF_JSON_FIELDS(WideConfig, value00, value01, value02, value03, value04, value05, value06, value07,
+                value08, value09, value10, value11, value12, value13, value14, value15, value16,
+                value17, value18, value19, value20, value21, value22, value23, value24, value25,
+                value26, value27, value28, value29, value30, value31, value32, value33, value34,
+                value35, value36, value37, value38, value39, value40, value41, value42, value43,
+                value44, value45, value46, value47)
+
+} // namespace test_binding
+
+using namespace mcf;
+using test_binding::Limits;
+using test_binding::NetworkConfig;
+
+namespace {
+
+const char* kNetworkJson = R"({
+    "port": 9000,
+    "host": "example\norg",
+    "tls": true,
+    "timeout": 2,
+    "unknown": {"deep": [1, {"x": "}"}], "more": null},
+    "peers": ["a", "b"],
+    "retries": 3,
+    "limits": {"cpu": 4},
+    "weights": {"x": 1, "y": 2},
+    "extra": {"k": [true, 1.5]}
+})";
+
+std::string makeServers(size_t count) {
+    std::string json = "[";
+    for (size_t i = 0; i < count; ++i) {
+        if (i > 0) json += ",";
+        json += "{\"port\":" + std::to_string(1000 + i % 50000) +
+                ",\"maxConnections\":" + std::to_string(i) +
+                ",\"host\":\"host-" + std::to_string(i) + "\"" +
+                ",\"tls\":" + (i % 2 ? "true" : "false") +
+                ",\"timeout\":0.25,\"peers\":[\"a\",\"b\"]" +
+                ",\"limits\":{\"cpu\":2,\"memory\":4096}}";
+    }
+    json += "]";
+    return json;
+}
+
+} // namespace
+
+TEST_CASE("JsonBinding - Perfect hash key table", "[JsonBinding]") {
+    constexpr auto& keys = JsonReflection<NetworkConfig>::keys;
+    static_assert(JsonReflection<NetworkConfig>::Count == 10);
+    static_assert(keys.find("port") == 0);
+    static_assert(keys.find("extra") == 9);
+    static_assert(keys.find("missing") == 10);
+
+    constexpr auto table = makeJsonKeyTable<4>({"alpha", "beta", "gamma", "delta"});
+    REQUIRE(table.find("gamma") == 2);
+    REQUIRE(table.find("gam") == 4);
+    REQUIRE(table.find("") == 4);
+
+    SECTION("The documented maximum of 48 members compiles") {
+        using test_binding::WideConfig;
+        constexpr auto& wide = JsonReflection<WideConfig>::keys;
+        static_assert(JsonReflection<WideConfig>::Count == 48);
+        static_assert(wide.find("value00") == 0);
+        static_assert(wide.find("value47") == 47);
+        static_assert(wide.find("missing") == 48);
+
+        auto config = JsonBinding::parse<WideConfig>(R"({"value01": 80, "value46": 1})");
+        REQUIRE(config.value01 == 80);
+        REQUIRE(config.value46 == 1);
+    }
+}
+
+TEST_CASE("JsonBinding - Parse into structs", "[JsonBinding]") {
+    NetworkConfig config = JsonBinding::parse<NetworkConfig>(kNetworkJson);
+
+    REQUIRE(config.port == 9000);
+    REQUIRE(config.maxConnections == 100);  // absent: default kept
+    REQUIRE(config.host == "example\norg");
+    REQUIRE(config.tls);
+    REQUIRE(config.timeout == 2.0);
+    REQUIRE(config.peers == std::vector<std::string>{"a", "b"});
+    REQUIRE(config.retries == 3);
+    REQUIRE(config.limits.cpu == 4);
+    REQUIRE(config.limits.memory == 512);
+    REQUIRE(config.weights.at("y") == 2);
+    REQUIRE(config.extra["k"][1].asFloat() == 1.5);
+
+    SECTION("Arrays of structs") {
+        auto servers = JsonBinding::parse<std::vector<NetworkConfig>>(makeServers(10));
+        REQUIRE(servers.size() == 10);
+        REQUIRE(servers[7].host == "host-7");
+        REQUIRE(servers[7].limits.memory == 4096);
+    }
+
+    SECTION("Null optional") {
+        auto parsed = JsonBinding::parse<NetworkConfig>(R"({"retries": null})");
+        REQUIRE_FALSE(parsed.retries.has_value());
+    }
+
+    SECTION("Keys with escapes") {
+        auto parsed = JsonBinding::parse<Limits>(R"({"cp\"u": 1, "cpu": 7, "mem\/ory": 9})");
+        REQUIRE(parsed.cpu == 7);
+        REQUIRE(parsed.memory == 512);
+    }
+}
+
+TEST_CASE("JsonBinding - Errors", "[JsonBinding]") {
+    REQUIRE_THROWS_AS(JsonBinding::parse<NetworkConfig>(R"({"port": "80"})"), std::runtime_error);
+    REQUIRE_THROWS_AS(JsonBinding::parse<NetworkConfig>(R"({"port": 70000})"), std::runtime_error);
+    REQUIRE_THROWS_AS(JsonBinding::parse<NetworkConfig>(R"({"port": -1})"), std::runtime_error);
+    REQUIRE_THROWS_AS(JsonBinding::parse<NetworkConfig>(R"({"maxConnections": 1.5})"), std::runtime_error);
+    REQUIRE_THROWS_AS(JsonBinding::parse<NetworkConfig>(R"({"tls": null})"), std::runtime_error);
+    REQUIRE_THROWS_AS(JsonBinding::parse<NetworkConfig>(R"({"peers": "a"})"), std::runtime_error);
+    REQUIRE_THROWS_AS(JsonBinding::parse<NetworkConfig>(R"({"port": 1)"), std::runtime_error);
+    REQUIRE_THROWS_AS(JsonBinding::parse<NetworkConfig>(R"({"unknown": [1, 2)"), std::runtime_error);
+    REQUIRE_THROWS_AS(JsonBinding::parse<NetworkConfig>("[]"), std::runtime_error);
+
+    try {
+        JsonBinding::parse<NetworkConfig>("{\n  \"port\": true\n}");
+        FAIL("Should have thrown");
+    } catch (const std::runtime_error& e) {
+        REQUIRE(std::string(e.what()).find("line 2") != std::string::npos);
+    }
+}
+
+TEST_CASE("JsonBinding - Writing and JsonValue conversion", "[JsonBinding]") {
+    NetworkConfig config = JsonBinding::parse<NetworkConfig>(kNetworkJson);
+
+    SECTION("Write then parse round trip") {
+        std::string json = JsonBinding::write(config);
+        NetworkConfig again = JsonBinding::parse<NetworkConfig>(json);
+        REQUIRE(JsonBinding::write(again) == json);
+        REQUIRE(json.find("\"retries\":3") != std::string::npos);
+    }
+
+    SECTION("Writes into an existing writer") {
+        JsonWriter writer(JsonWriter::Style::Pretty);
+        writer.startObject();
+        writer.key("network");
+        JsonBinding::write(writer, config.limits);
+        writer.endObject();
+        REQUIRE(JsonParser::parse(writer.str())["network"]["cpu"].asInt() == 4);
+    }
+
+    SECTION("fromValue matches parse") {
+        JsonValue tree = JsonParser::parse(kNetworkJson);
+        NetworkConfig fromTree = JsonBinding::fromValue<NetworkConfig>(tree);
+        REQUIRE(JsonBinding::write(fromTree) == JsonBinding::write(config));
+        REQUIRE_THROWS_AS(JsonBinding::fromValue<NetworkConfig>(JsonParser::parse(R"({"tls": 1})")),
+                          std::runtime_error);
+    }
+
+    SECTION("toValue builds an equivalent tree") {
+        JsonValue tree = JsonBinding::toValue(config);
+        REQUIRE(tree["limits"]["memory"].asInt() == 512);
+        REQUIRE(JsonWriter::write(tree) == JsonWriter::write(JsonParser::parse(JsonBinding::write(config))));
+    }
+}
+
+TEST_CASE("JsonBinding - Benchmark against hand-written access", "[JsonBinding][.benchmark]") {
+    std::string json = makeServers(20000);
+
+    BENCHMARK("JsonParser + manual field access") {
+        JsonValue tree = JsonParser::parse(json);
+        std::vector<NetworkConfig> servers;
+        servers.reserve(tree.size());
+        for (size_t i = 0; i < tree.size(); ++i) {
+            const JsonValue& item = tree[i];
+            NetworkConfig config;
+            if (item.has("port")) config.port = static_cast<uint16_t>(item["port"].asInt());
+            if (item.has("maxConnections")) config.maxConnections = static_cast<int>(item["maxConnections"].asInt());
+            if (item.has("host")) config.host = item["host"].asString();
+            if (item.has("tls")) config.tls = item["tls"].asBool();
+            if (item.has("timeout")) config.timeout = item["timeout"].asFloat();
+            for (const auto& peer : item["peers"].asArray()) config.peers.push_back(peer.asString());
+            config.limits.cpu = static_cast<int>(item["limits"]["cpu"].asInt());
+            config.limits.memory = item["limits"]["memory"].asInt();
+            servers.push_back(std::move(config));
+        }
+        return servers.size();
+    };
+
+    BENCHMARK("JsonBinding::parse") {
+        return JsonBinding::parse<std::vector<NetworkConfig>>(json).size();
+    };
+}
@@ -0,0 +1,207 @@
+#include <catch_amalgamated.hpp>
+#include "../../core/JsonDocument.hpp"
+#include "../../core/JsonParser.hpp"
+
+#include <atomic>
+#include <cstdlib>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <new>
+#include <string>
+
+using namespace mcf;
+
+// ============================================================================
+// Allocation accounting (used by the memory comparison benchmark)
+// ============================================================================
+
+namespace {
+std::atomic<size_t> g_allocatedBytes{0};
+std::atomic<size_t> g_allocationCount{0};
+}
+
+void* operator new(std::size_t size) {
+    g_allocatedBytes += size;
+    g_allocationCount++;
+    if (void* p = std::malloc(size ? size : 1)) return p;
+    throw std::bad_alloc();
+}
+
+void operator delete(void* p) noexcept { std::free(p); }
+void operator delete(void* p, std::size_t) noexcept { std::free(p); }
+
+namespace {
+
+/**
+ * @brief Generate an array of records with repeated keys
+ */
+std::string makeRecords(size_t count) {
+    std::string json = "[";
+    for (size_t i = 0; i < count; ++i) {
+        if (i > 0) json += ",";
+        json += "{\"id\":" + std::to_string(i) +
+                ",\"name\":\"record-" + std::to_string(i) + "\"" +
+                ",\"active\":" + (i % 2 ? "true" : "false") +
+                ",\"score\":" + std::to_string(i * 1.5) +
+                ",\"tags\":[\"a\",\"b\"],\"meta\":{\"owner\":\"ops\",\"rev\":3}}";
+    }
+    json += "]";
+    return json;
+}
+
+} // namespace
+
+TEST_CASE("JsonArena - Allocation", "[JsonDocument]") {
+    JsonArena arena(1024);
+
+    SECTION("Allocations are aligned and tracked") {
+        void* a = arena.allocate(3, 1);
+        void* b = arena.allocate(sizeof(double), alignof(double));
+        REQUIRE(a != nullptr);
+        REQUIRE(reinterpret_cast<uintptr_t>(b) % alignof(double) == 0);
+        REQUIRE(arena.bytesUsed() == 3 + sizeof(double));
+        REQUIRE(arena.bytesReserved() >= 1024);
+    }
+
+    SECTION("Large allocations get their own block") {
+        arena.allocate(10 * 1024);
+        REQUIRE(arena.bytesReserved() >= 10 * 1024);
+    }
+
+    SECTION("Reset releases everything") {
+        arena.allocate(100);
+        arena.reset();
+        REQUIRE(arena.bytesUsed() == 0);
+        REQUIRE(arena.bytesReserved() == 0);
+    }
+}
+
+TEST_CASE("JsonDocument - Parsing", "[JsonDocument]") {
+    SECTION("Scalars") {
+        REQUIRE(JsonDocument::parse("null").root().isNull());
+        REQUIRE(JsonDocument::parse("true").root().asBool() == true);
+        REQUIRE(JsonDocument::parse("-42").root().asInt() == -42);
+        REQUIRE(JsonDocument::parse("2.5").root().asFloat() == 2.5);
+        REQUIRE(JsonDocument::parse("\"a\\nb\"").root().asString() == "a\nb");
+    }
+
+    SECTION("Nested access") {
+        auto doc = JsonDocument::parse(R"({
+            "network": {"port": 8080, "hosts": ["a", "b", "c"]},
+            "debug": true
+        })");
+        const auto& root = doc.root();
+        REQUIRE(root.isObject());
+        REQUIRE(root["network"]["port"].asInt() == 8080);
+        REQUIRE(root["network"]["hosts"].size() == 3);
+        REQUIRE(root["network"]["hosts"][2].asString() == "c");
+        REQUIRE(root["debug"].asBool());
+        REQUIRE(root["missing"].isNull());
+        REQUIRE(root["network"]["hosts"][10].isNull());
+    }
+
+    SECTION("Duplicate keys keep the last value") {
+        auto doc = JsonDocument::parse(R"({"a": 1, "b": 2, "a": 3})");
+        REQUIRE(doc.root().size() == 2);
+        REQUIRE(doc.root()["a"].asInt() == 3);
+    }
+
+    SECTION("Large objects use sorted lookup") {
+        std::string json = "{";
+        for (int i = 0; i < 100; ++i) {
+            if (i > 0) json += ",";
+            json += "\"key" + std::to_string(99 - i) + "\":" + std::to_string(i);
+        }
+        json += "}";
+
+        auto doc = JsonDocument::parse(json);
+        REQUIRE(doc.root().size() == 100);
+        for (int i = 0; i < 100; ++i) {
+            REQUIRE(doc.root()["key" + std::to_string(99 - i)].asInt() == i);
+        }
+        REQUIRE_FALSE(doc.root().has("key100"));
+    }
+
+    SECTION("Keys are interned") {
+        auto doc = JsonDocument::parse(makeRecords(50));
+        REQUIRE(doc.internedKeyCount() == 8);
+        const auto& first = doc.root()[0];
+        const auto& second = doc.root()[1];
+        REQUIRE(first.membersBegin()->keyData == second.membersBegin()->keyData);
+    }
+
+    SECTION("Errors match JsonParser") {
+        REQUIRE_THROWS_AS(JsonDocument::parse(""), std::runtime_error);
+        REQUIRE_THROWS_AS(JsonDocument::parse("[1, 2"), std::runtime_error);
+        REQUIRE_THROWS_AS(JsonDocument::parse("{\"a\" 1}"), std::runtime_error);
+        REQUIRE_THROWS_AS(JsonDocument::parse("[tru]"), std::runtime_error);
+    }
+}
+
+TEST_CASE("JsonDocument - JsonValue interop", "[JsonDocument]") {
+    std::string json = makeRecords(20);
+    JsonValue expected = JsonParser::parse(json);
+
+    SECTION("Document converts to an identical JsonValue") {
+        auto doc = JsonDocument::parse(json);
+        REQUIRE(doc.toJsonValue().toString() == expected.toString());
+    }
+
+    SECTION("JsonValue converts to an equivalent document") {
+        auto doc = JsonDocument::fromJsonValue(expected);
+        REQUIRE(doc.root().size() == 20);
+        REQUIRE(doc.root()[5]["name"].asString() == "record-5");
+        REQUIRE(doc.toJsonValue().toString() == expected.toString());
+    }
+
+    SECTION("Documents are movable") {
+        auto doc = JsonDocument::parse(json);
+        JsonDocument moved = std::move(doc);
+        REQUIRE(moved.root()[3]["meta"]["owner"].asString() == "ops");
+    }
+
+    SECTION("Files are read or mapped") {
+        std::string large = makeRecords(4000);
+        REQUIRE(large.size() >= MappedFile::MinimumMapSize);
+        std::string path = (std::filesystem::temp_directory_path() / "mcf_json_document_file.json").string();
+        for (const std::string* content : {&json, &large}) {
+            { std::ofstream(path, std::ios::binary) << *content; }
+            std::string text = JsonParser::parse(*content).toString();
+            REQUIRE(JsonDocument::parseFile(path).toJsonValue().toString() == text);
+            REQUIRE(JsonDocument::parseMappedFile(path).toJsonValue().toString() == text);
+        }
+        std::filesystem::remove(path);
+    }
+}
+
+TEST_CASE("JsonDocument - Benchmark against JsonValue", "[JsonDocument][.benchmark]") {
+    std::string json = makeRecords(20000);
+
+    size_t bytesBefore = g_allocatedBytes.load();
+    size_t countBefore = g_allocationCount.load();
+    {
+        JsonValue value = JsonParser::parse(json);
+        size_t bytes = g_allocatedBytes.load() - bytesBefore;
+        size_t count = g_allocationCount.load() - countBefore;
+        std::cout << "JsonValue:    " << bytes / 1024 << " KiB in " << count << " allocations\n";
+    }
+
+    bytesBefore = g_allocatedBytes.load();
+    countBefore = g_allocationCount.load();
+    {
+        JsonDocument doc = JsonDocument::parse(json);
+        size_t bytes = g_allocatedBytes.load() - bytesBefore;
+        size_t count = g_allocationCount.load() - countBefore;
+        std::cout << "JsonDocument: " << bytes / 1024 << " KiB in " << count
+                  << " allocations (arena " << doc.memoryUsed() / 1024 << " KiB used)\n";
+    }
+
+    BENCHMARK("JsonParser::parse (JsonValue)") {
+        return JsonParser::parse(json).size();
+    };
+
+    BENCHMARK("JsonDocument::parse (arena)") {
+        return JsonDocument::parse(json).root().size();
+    };
+}
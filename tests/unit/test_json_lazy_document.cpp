@@ -0,0 +1,202 @@
+#include <catch_amalgamated.hpp>
+#include "../../core/JsonLazyDocument.hpp"
+
+#include <chrono>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <string>
+
+using namespace mcf;
+
+namespace {
+
+std::string makeLog(size_t entries) {
+    std::string json = "{\"entries\":[";
+    for (size_t i = 0; i < entries; ++i) {
+        if (i > 0) json += ",";
+        json += "{\"id\":" + std::to_string(i) +
+                ",\"message\":\"request \\\"" + std::to_string(i) + "\\\" handled\"" +
+                ",\"latency\":" + std::to_string(i % 100) + ".25" +
+                ",\"tags\":[\"a\",\"b\",{\"nested\":[1,2,3]}],\"ok\":true,\"parent\":null}";
+    }
+    json += "],\"summary\":{\"count\":" + std::to_string(entries) + ",\"version\":\"1.2\"}}";
+    return json;
+}
+
+} // namespace
+
+TEST_CASE("JsonLazyDocument - Access", "[JsonLazyDocument]") {
+    auto doc = JsonLazyDocument::parse(R"({
+        "name": "server",
+        "port": 8080,
+        "ratio": 0.5,
+        "debug": false,
+        "parent": null,
+        "tags": ["a", "b\nc", []],
+        "nested": {"deep": {"value": -3}},
+        "empty": {}
+    })");
+    JsonLazyValue root = doc.root();
+
+    REQUIRE(root.isObject());
+    REQUIRE(root.size() == 8);
+    REQUIRE(root["name"].asString() == "server");
+    REQUIRE(root["port"].isInt());
+    REQUIRE(root["port"].asInt() == 8080);
+    REQUIRE(root["ratio"].type() == JsonType::Float);
+    REQUIRE(root["ratio"].asFloat() == 0.5);
+    REQUIRE(root["debug"].isBool());
+    REQUIRE_FALSE(root["debug"].asBool(true));
+    REQUIRE(root["parent"].isNull());
+    REQUIRE(root["tags"].size() == 3);
+    REQUIRE(root["tags"][1].asString() == "b\nc");
+    REQUIRE(root["tags"][2].isArray());
+    REQUIRE(root["nested"]["deep"]["value"].asInt() == -3);
+    REQUIRE(root["empty"].size() == 0);
+
+    SECTION("Missing values") {
+        REQUIRE_FALSE(root.has("missing"));
+        REQUIRE_FALSE(root["missing"].exists());
+        REQUIRE(root["missing"].isNull());
+        REQUIRE(root["missing"]["deeper"].asInt(7) == 7);
+        REQUIRE_FALSE(root["tags"][3].exists());
+        REQUIRE(root["name"].asInt(5) == 5);
+    }
+
+    SECTION("Iteration") {
+        std::string keys;
+        for (auto it = root.membersBegin(); it != root.membersEnd(); ++it) {
+            keys += (*it).key.asString() + ",";
+        }
+        REQUIRE(keys == "name,port,ratio,debug,parent,tags,nested,empty,");
+
+        size_t count = 0;
+        for (JsonLazyValue tag : root["tags"]) {
+            (void)tag;
+            ++count;
+        }
+        REQUIRE(count == 3);
+    }
+
+    SECTION("Raw text and materialization") {
+        REQUIRE(root["nested"].rawJson() == R"({"deep": {"value": -3}})");
+        REQUIRE(root["tags"][1].rawJson() == R"("b\nc")");
+        REQUIRE(root["port"].rawJson() == "8080");
+        REQUIRE(root["nested"].toJsonValue()["deep"]["value"].asInt() == -3);
+        REQUIRE(root["tags"].toDocument().root()[size_t(1)].asString() == "b\nc");
+    }
+}
+
+TEST_CASE("JsonLazyDocument - Keys", "[JsonLazyDocument]") {
+    auto doc = JsonLazyDocument::parse(R"({"a": 1, "k\"ey": 2, "a\/b": 3, "a": 4})");
+    JsonLazyValue root = doc.root();
+
+    REQUIRE(root["a"].asInt() == 4);  // last duplicate wins, like JsonObject
+    REQUIRE(root["k\"ey"].asInt() == 2);
+    REQUIRE(root["a/b"].asInt() == 3);
+    REQUIRE_FALSE(root.has("k"));
+}
+
+TEST_CASE("JsonLazyDocument - Matches JsonParser", "[JsonLazyDocument]") {
+    std::string json = makeLog(200);
+    auto doc = JsonLazyDocument::parse(json);
+    JsonValue tree = JsonParser::parse(json);
+
+    REQUIRE(JsonWriter::write(doc.root().toJsonValue()) == JsonWriter::write(tree));
+    REQUIRE(doc.root()["entries"].size() == 200);
+    REQUIRE(doc.root()["entries"][size_t(150)]["message"].asString() ==
+            tree["entries"][150]["message"].asString());
+    REQUIRE(doc.root()["summary"]["count"].asInt() == 200);
+}
+
+TEST_CASE("JsonLazyDocument - Errors", "[JsonLazyDocument]") {
+    SECTION("Structure is validated up front") {
+        for (const char* bad : {"", "{", "[1, 2", "{\"a\" 1}", "{\"a\": 1,}", "[1 2]",
+                                "{1: 2}", "[1, }", "]", "{\"a\": 1]", "[@]"}) {
+            INFO(bad);
+            REQUIRE_THROWS_AS(JsonLazyDocument::parse(bad), std::runtime_error);
+        }
+    }
+
+    SECTION("Scalars are validated on access") {
+        auto doc = JsonLazyDocument::parse(R"({"ok": 1, "bad": 12abc, "lit": tru})");
+        REQUIRE(doc.root()["ok"].asInt() == 1);
+        REQUIRE_THROWS_AS(doc.root()["bad"].asInt(), std::runtime_error);
+        REQUIRE_THROWS_AS(doc.root()["lit"].asBool(), std::runtime_error);
+        REQUIRE_THROWS_AS(doc.root().toJsonValue(), std::runtime_error);
+    }
+
+    SECTION("Error position") {
+        try {
+            JsonLazyDocument::parse("{\n  \"a\": [1,\n  2}\n}");
+            FAIL("Should have thrown");
+        } catch (const std::runtime_error& e) {
+            REQUIRE(std::string(e.what()).find("line 3") != std::string::npos);
+        }
+    }
+}
+
+TEST_CASE("JsonLazyDocument - Input ownership", "[JsonLazyDocument]") {
+    SECTION("Borrowed view") {
+        std::string json = R"({"x": [10, 20]})";
+        auto doc = JsonLazyDocument::parseView(json);
+        REQUIRE(doc.root()["x"][size_t(1)].asInt() == 20);
+    }
+
+    SECTION("Values survive moving the document") {
+        auto doc = JsonLazyDocument::parse(R"({"s": "short"})");
+        JsonLazyValue value = doc.root()["s"];
+        JsonLazyDocument moved = std::move(doc);
+        REQUIRE(value.asString() == "short");
+        REQUIRE(moved.root()["s"].asString() == "short");
+    }
+
+    SECTION("File") {
+        std::string path = (std::filesystem::temp_directory_path() / "mcf_lazy_doc_test.json").string();
+        {
+            std::ofstream out(path);
+            out << makeLog(10);
+        }
+        auto doc = JsonLazyDocument::parseFile(path);
+        REQUIRE(doc.root()["entries"][size_t(9)]["id"].asInt() == 9);
+        std::filesystem::remove(path);
+        REQUIRE_THROWS_AS(JsonLazyDocument::parseFile(path), std::runtime_error);
+    }
+}
+
+TEST_CASE("JsonLazyDocument - Benchmark few fields of a large document", "[JsonLazyDocument][.benchmark]") {
+    std::string json = makeLog(250000);
+    std::cout << "Document size: " << json.size() / (1024 * 1024) << " MiB\n";
+
+    auto doc = JsonLazyDocument::parse(json);
+    std::cout << "Tape: " << doc.memoryUsage() / (1024 * 1024) << " MiB\n";
+
+    auto start = std::chrono::steady_clock::now();
+    int64_t count = doc.root()["summary"]["count"].asInt();
+    std::string version = doc.root()["summary"]["version"].asString();
+    auto elapsed = std::chrono::duration_cast<std::chrono::microseconds>(
+        std::chrono::steady_clock::now() - start);
+    std::cout << "Key access after indexing: " << elapsed.count() << " us\n";
+    REQUIRE(count == 250000);
+    REQUIRE(version == "1.2");
+
+    start = std::chrono::steady_clock::now();
+    std::string message = doc.root()["entries"][size_t(200000)]["message"].asString();
+    elapsed = std::chrono::duration_cast<std::chrono::microseconds>(
+        std::chrono::steady_clock::now() - start);
+    std::cout << "Array element 200000: " << elapsed.count() << " us\n";
+    REQUIRE(message == "request \"200000\" handled");
+
+    BENCHMARK("JsonParser::parse + access") {
+        return JsonParser::parse(json)["summary"]["count"].asInt();
+    };
+
+    BENCHMARK("JsonDocument::parse + access") {
+        return JsonDocument::parse(json).root()["summary"]["count"].asInt();
+    };
+
+    BENCHMARK("JsonLazyDocument::parseView + access") {
+        return JsonLazyDocument::parseView(json).root()["summary"]["count"].asInt();
+    };
+}
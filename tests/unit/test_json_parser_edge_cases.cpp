@@ -1,6 +1,8 @@
 #include <catch_amalgamated.hpp>
 #include "../../core/JsonParser.hpp"
 #include "../../core/JsonValue.hpp"
+#include <filesystem>
+#include <fstream>
 #include <limits>
 
 using namespace mcf;
@@ -311,12 +313,23 @@ TEST_CASE("JsonParser - Deeply nested structures", "[JsonParser][EdgeCases]") {
 }
 
 TEST_CASE("JsonParser - Unicode and special characters", "[JsonParser][EdgeCases]") {
-    // Note: JsonParser doesn't support \uXXXX Unicode escape sequences
-    // It only supports the basic escape sequences: \", \\, \/, \b, \f, \n, \r, \t
+    SECTION("Unicode escapes decode to UTF-8") {
+        REQUIRE(JsonParser::parse(R"("\u0041")").asString() == "A");
+        REQUIRE(JsonParser::parse(R"("\u00e9\u20AC")").asString() == "\xC3\xA9\xE2\x82\xAC");
+        REQUIRE(JsonParser::parse(R"("\u0000")").asString() == std::string(1, '\0'));
+    }
+
+    SECTION("Surrogate pairs decode to one code point") {
+        REQUIRE(JsonParser::parse(R"("\ud83d\ude00")").asString() == "\xF0\x9F\x98\x80");
+    }
 
-    SECTION("Invalid unicode escape - not supported") {
-        // Unicode escape sequences are not supported, should throw error
-        REQUIRE_THROWS_AS(JsonParser::parse(R"("\u0041")"), std::runtime_error);
+    SECTION("Invalid unicode escapes") {
+        REQUIRE_THROWS_AS(JsonParser::parse(R"("\u004")"), std::runtime_error);
+        REQUIRE_THROWS_AS(JsonParser::parse(R"("\u00zz")"), std::runtime_error);
+        REQUIRE_THROWS_AS(JsonParser::parse(R"("\ud83d")"), std::runtime_error);
+        REQUIRE_THROWS_AS(JsonParser::parse(R"("\ud83dx")"), std::runtime_error);
+        REQUIRE_THROWS_AS(JsonParser::parse(R"("\ud83d\u0041")"), std::runtime_error);
+        REQUIRE_THROWS_AS(JsonParser::parse(R"("\ude00")"), std::runtime_error);
     }
 
     SECTION("Special characters in string") {
@@ -464,3 +477,39 @@ TEST_CASE("JsonParser - Malformed structures", "[JsonParser][EdgeCases]") {
         REQUIRE(value.isString());
     }
 }
+
+TEST_CASE("JsonParser - Large files can be parsed from a mapping", "[JsonParser][EdgeCases]") {
+    std::string path = (std::filesystem::temp_directory_path() / "mcf_parser_mapped.json").string();
+
+    // Pad to exactly a page multiple so that any read past the end of the mapping would fault
+    std::string json = "[";
+    while (json.size() < MappedFile::MinimumMapSize * 2) {
+        json += "{\"id\":12345,\"name\":\"item\"},";
+    }
+    json += "1";
+    json.insert(json.size() - 1, std::string(4096 - (json.size() + 1) % 4096, ' '));
+    json += "]";
+    REQUIRE(json.size() % 4096 == 0);
+    {
+        std::ofstream out(path, std::ios::binary);
+        out << json;
+    }
+
+    JsonValue value = JsonParser::parseMappedFile(path);
+    REQUIRE(value.isArray());
+    REQUIRE(value.asArray().back().asInt() == 1);
+    REQUIRE(value.asArray().size() == JsonParser::parse(json).asArray().size());
+
+    // parseFile() reads the file instead and gets the same result
+    REQUIRE(JsonParser::parseFile(path).asArray().size() == value.asArray().size());
+
+    // An unterminated array ending exactly at the end of the mapping is an error, not an overread
+    {
+        std::ofstream out(path, std::ios::binary);
+        out << json.substr(0, json.size() - 1) << ' ';
+    }
+    REQUIRE_THROWS_AS(JsonParser::parseMappedFile(path), std::runtime_error);
+    REQUIRE_THROWS_AS(JsonParser::parseFile(path), std::runtime_error);
+
+    std::filesystem::remove(path);
+}
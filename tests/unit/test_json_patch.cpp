@@ -0,0 +1,231 @@
+#include <catch_amalgamated.hpp>
+#include "../../core/ConfigurationManager.hpp"
+#include "../../core/JsonPatch.hpp"
+
+#include <filesystem>
+#include <fstream>
+#include <map>
+#include <string>
+
+using namespace mcf;
+
+namespace {
+
+JsonValue json(const std::string& text) {
+    return JsonParser::parse(text);
+}
+
+std::string compact(const JsonValue& value) {
+    return JsonWriter::write(value);
+}
+
+JsonValue makeTree(size_t services, int version) {
+    JsonArray list;
+    for (size_t i = 0; i < services; ++i) {
+        JsonObject service;
+        service["name"] = JsonValue("svc-" + std::to_string(i));
+        service["port"] = JsonValue(static_cast<int64_t>(1000 + i));
+        service["replicas"] = JsonValue(static_cast<int64_t>(i % 7 == 0 ? version : 1));
+        list.push_back(JsonValue(std::move(service)));
+    }
+    JsonObject root;
+    root["services"] = JsonValue(std::move(list));
+    root["version"] = JsonValue(static_cast<int64_t>(version));
+    return JsonValue(std::move(root));
+}
+
+void writeFile(const std::string& path, const std::string& content) {
+    std::ofstream out(path);
+    out << content;
+}
+
+} // namespace
+
+TEST_CASE("JsonPatch - JSON Pointer", "[JsonPatch]") {
+    REQUIRE(JsonPointer::parse("").empty());
+    REQUIRE(JsonPointer::parse("/a~1b/~0c/") == std::vector<std::string>{"a/b", "~c", ""});
+    REQUIRE(JsonPointer::join({"a/b", "~c"}) == "/a~1b/~0c");
+    REQUIRE_THROWS_AS(JsonPointer::parse("a"), std::runtime_error);
+    REQUIRE_THROWS_AS(JsonPointer::parse("/a~2"), std::runtime_error);
+
+    JsonValue doc = json(R"({"list": [10, {"x": true}]})");
+    REQUIRE(JsonPointer::resolve(doc, JsonPointer::parse("/list/1/x"))->asBool());
+    REQUIRE(JsonPointer::resolve(doc, JsonPointer::parse("/list/01")) == nullptr);
+    REQUIRE(JsonPointer::resolve(doc, JsonPointer::parse("/list/2")) == nullptr);
+}
+
+TEST_CASE("JsonPatch - Diff", "[JsonPatch]") {
+    SECTION("Objects") {
+        JsonValue a = json(R"({"keep": 1, "gone": 2, "change": {"deep": "x"}, "type": 1})");
+        JsonValue b = json(R"({"keep": 1, "new": 3, "change": {"deep": "y"}, "type": 1.0})");
+        JsonPatch patch = JsonPatch::diff(a, b);
+
+        REQUIRE(compact(patch.toJson()) ==
+                R"([{"op":"replace","path":"/change/deep","value":"y"},)"
+                R"({"op":"remove","path":"/gone"},)"
+                R"({"op":"add","path":"/new","value":3},)"
+                R"({"op":"replace","path":"/type","value":1.0}])");
+    }
+
+    SECTION("Array insertions and deletions are single operations") {
+        JsonValue a = json("[1, 2, 3, 4, 5]");
+        REQUIRE(JsonPatch::diff(a, json("[0, 1, 2, 3, 4, 5]")).size() == 1);
+        REQUIRE(JsonPatch::diff(a, json("[1, 2, 4, 5]")).size() == 1);
+        REQUIRE(JsonPatch::diff(a, json("[1, 2, 9, 4, 5]")).size() == 1);
+        REQUIRE(JsonPatch::diff(a, json("[]")).size() == 5);
+    }
+
+    SECTION("Identical documents") {
+        JsonValue a = makeTree(50, 1);
+        REQUIRE(JsonPatch::diff(a, a).empty());
+        REQUIRE(JsonPatch::diff(a, makeTree(50, 1)).empty());
+    }
+
+    SECTION("Keys are escaped") {
+        JsonPatch patch = JsonPatch::diff(json(R"({"a/b": 1})"), json(R"({"a/b": 2})"));
+        REQUIRE(patch.operations()[0].path == "/a~1b");
+    }
+}
+
+TEST_CASE("JsonPatch - Apply", "[JsonPatch]") {
+    SECTION("Diff round trip") {
+        const char* pairs[][2] = {
+            {R"({"a": [1, 2, 3], "b": {"c": null}})", R"({"a": [3, 2, 1, 0], "b": {"d": [true]}})"},
+            {"[1, [2, [3]], 4]", "[[2, [3, 5]], 4]"},
+            {R"({"x": 1})", "[1]"},
+            {"[]", R"([{"k": "v"}, 2])"},
+        };
+        for (const auto& pair : pairs) {
+            JsonValue a = json(pair[0]);
+            JsonValue b = json(pair[1]);
+            REQUIRE(compact(JsonPatch::diff(a, b).apply(a)) == compact(b));
+        }
+
+        JsonValue big = makeTree(300, 1);
+        JsonValue changed = makeTree(300, 2);
+        REQUIRE(JsonPatch::equals(JsonPatch::diff(big, changed).apply(big), changed));
+    }
+
+    SECTION("RFC 6902 operations") {
+        JsonValue doc = json(R"({"foo": {"bar": "baz", "waldo": "fred"}, "qux": {"corge": "grault"}, "arr": [1, 2]})");
+        JsonPatch patch = JsonPatch::fromJson(json(R"([
+            {"op": "move", "from": "/foo/waldo", "path": "/qux/thud"},
+            {"op": "copy", "from": "/arr/0", "path": "/arr/-"},
+            {"op": "add", "path": "/arr/0", "value": 0},
+            {"op": "remove", "path": "/foo/bar"},
+            {"op": "replace", "path": "/qux/corge", "value": [1]},
+            {"op": "test", "path": "/arr", "value": [0, 1, 2, 1]}
+        ])"));
+        JsonValue result = patch.apply(doc);
+
+        REQUIRE(compact(result) ==
+                R"({"arr":[0,1,2,1],"foo":{},"qux":{"corge":[1],"thud":"fred"}})");
+        REQUIRE(compact(JsonPatch::fromJson(patch.toJson()).apply(doc)) == compact(result));
+    }
+
+    SECTION("Input is never modified") {
+        JsonValue doc = json(R"({"a": {"b": [1, 2]}})");
+        std::string before = compact(doc);
+        JsonPatch patch = JsonPatch::fromJson(json(R"([{"op": "add", "path": "/a/b/-", "value": 3}])"));
+        REQUIRE(compact(patch.apply(doc)) == R"({"a":{"b":[1,2,3]}})");
+        REQUIRE(compact(doc) == before);
+
+        JsonPatch failing = JsonPatch::fromJson(json(R"([
+            {"op": "remove", "path": "/a/b/0"},
+            {"op": "test", "path": "/a/b", "value": []}
+        ])"));
+        REQUIRE_THROWS_AS(failing.apply(doc), std::runtime_error);
+        REQUIRE(compact(doc) == before);
+    }
+
+    SECTION("Errors") {
+        JsonValue doc = json(R"({"a": [1]})");
+        for (const char* bad : {
+                 R"([{"op": "remove", "path": "/missing"}])",
+                 R"([{"op": "replace", "path": "/a/1", "value": 0}])",
+                 R"([{"op": "add", "path": "/a/5", "value": 0}])",
+                 R"([{"op": "add", "path": "/x/y", "value": 0}])",
+                 R"([{"op": "move", "from": "/a", "path": "/a/0"}])",
+                 R"([{"op": "remove", "path": ""}])"}) {
+            INFO(bad);
+            REQUIRE_THROWS_AS(JsonPatch::fromJson(json(bad)).apply(doc), std::runtime_error);
+        }
+        REQUIRE_THROWS_AS(JsonPatch::fromJson(json(R"([{"op": "jump", "path": "/a"}])")), std::runtime_error);
+        REQUIRE_THROWS_AS(JsonPatch::fromJson(json(R"([{"op": "add", "path": "/a"}])")), std::runtime_error);
+    }
+}
+
+TEST_CASE("JsonPatch - Configuration reload notifies changed keys", "[JsonPatch]") {
+    std::string path = (std::filesystem::temp_directory_path() / "mcf_patch_config.json").string();
+    writeFile(path, R"({"network": {"port": 80, "host": "a"}, "log": {"level": "info"}, "list": [1]})");
+
+    ConfigurationManager config;
+    REQUIRE(config.load(path));
+
+    std::map<std::string, int> calls;
+    std::map<std::string, JsonValue> values;
+    for (const char* key : {"network", "network.port", "network.host", "log.level", "list", "gone.key"}) {
+        config.watch(key, [&](const std::string& changed, const JsonValue& value) {
+            ++calls[changed];
+            values[changed] = value;
+        });
+    }
+
+    SECTION("Only changed keys fire") {
+        writeFile(path, R"({"network": {"port": 81, "host": "a"}, "log": {"level": "info"}, "list": [1]})");
+        REQUIRE(config.reload());
+        REQUIRE(calls == std::map<std::string, int>{{"network", 1}, {"network.port", 1}});
+        REQUIRE(values["network.port"].asInt() == 81);
+
+        calls.clear();
+        REQUIRE(config.reload());
+        REQUIRE(calls.empty());
+    }
+
+    SECTION("Replaced parents only notify children whose value changed") {
+        writeFile(path, R"({"network": {"port": 80, "host": "a"}, "log": "off", "list": [1]})");
+        REQUIRE(config.reload());
+        REQUIRE(calls == std::map<std::string, int>{{"log.level", 1}});
+        REQUIRE(values["log.level"].isNull());
+    }
+
+    SECTION("Patches from another node") {
+        ConfigurationManager remote;
+        remote.set("network.port", JsonValue(80));
+        remote.set("network.host", JsonValue("a"));
+        remote.set("log.level", JsonValue("debug"));
+        remote.set("list", JsonValue(JsonArray{JsonValue(1), JsonValue(2)}));
+
+        JsonPatch patch = config.diff(remote.getAll());
+        REQUIRE(patch.size() == 2);
+        REQUIRE(config.applyPatch(JsonPatch::fromJson(patch.toJson())));
+        REQUIRE(config.getString("log.level") == "debug");
+        REQUIRE(calls == std::map<std::string, int>{{"list", 1}, {"log.level", 1}});
+        REQUIRE(config.isDirty());
+
+        JsonPatch invalid = JsonPatch::fromJson(json(R"([{"op": "remove", "path": "/nope"}])"));
+        REQUIRE_FALSE(config.applyPatch(invalid));
+        REQUIRE(config.getString("log.level") == "debug");
+    }
+
+    config.save();  // Clears the dirty flag so the destructor does not recreate the file
+    std::filesystem::remove(path);
+}
+
+TEST_CASE("JsonPatch - Benchmark diff and apply", "[JsonPatch][.benchmark]") {
+    JsonValue before = makeTree(20000, 1);
+    JsonValue after = makeTree(20000, 2);
+    JsonPatch patch = JsonPatch::diff(before, after);
+
+    BENCHMARK("diff (20k services, 1/7 changed)") {
+        return JsonPatch::diff(before, after).size();
+    };
+
+    BENCHMARK("apply") {
+        return patch.apply(before).size();
+    };
+
+    BENCHMARK("full document compare via serialization") {
+        return JsonWriter::write(before) == JsonWriter::write(after);
+    };
+}
@@ -0,0 +1,326 @@
+#include <catch_amalgamated.hpp>
+#include "../../core/JsonParser.hpp"
+#include "../../core/JsonReader.hpp"
+
+#include <filesystem>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#ifndef _WIN32
+#include <fcntl.h>
+#include <unistd.h>
+#endif
+
+using namespace mcf;
+
+namespace {
+
+/**
+ * @brief Handler recording events as a compact token string
+ */
+class RecordingHandler : public JsonHandler {
+public:
+    std::string events;
+    std::string skipKey;
+    bool skipArrays = false;
+    int stopAfterInts = -1;
+
+    JsonReadAction onStartObject() override { events += "{"; return JsonReadAction::Continue; }
+    JsonReadAction onEndObject() override { events += "}"; return JsonReadAction::Continue; }
+    JsonReadAction onStartArray() override {
+        events += "[";
+        return skipArrays ? JsonReadAction::SkipValue : JsonReadAction::Continue;
+    }
+    JsonReadAction onEndArray() override { events += "]"; return JsonReadAction::Continue; }
+    JsonReadAction onKey(std::string_view key) override {
+        events += "k:" + std::string(key) + " ";
+        return key == skipKey ? JsonReadAction::SkipValue : JsonReadAction::Continue;
+    }
+    JsonReadAction onString(std::string_view value) override {
+        events += "s:" + std::string(value) + " ";
+        return JsonReadAction::Continue;
+    }
+    JsonReadAction onInt(int64_t value) override {
+        events += "i:" + std::to_string(value) + " ";
+        return --stopAfterInts == 0 ? JsonReadAction::Stop : JsonReadAction::Continue;
+    }
+    JsonReadAction onFloat(double value) override {
+        events += "f:" + std::to_string(value) + " ";
+        return JsonReadAction::Continue;
+    }
+    JsonReadAction onBool(bool value) override {
+        events += value ? "true " : "false ";
+        return JsonReadAction::Continue;
+    }
+    JsonReadAction onNull() override { events += "null "; return JsonReadAction::Continue; }
+};
+
+/**
+ * @brief Handler rebuilding a JsonValue (reference for comparisons)
+ */
+class BuildingHandler : public JsonHandler {
+public:
+    JsonValue root;
+
+    JsonReadAction onStartObject() override { return push(false); }
+    JsonReadAction onStartArray() override { return push(true); }
+    JsonReadAction onEndObject() override { return pop(); }
+    JsonReadAction onEndArray() override { return pop(); }
+    JsonReadAction onKey(std::string_view key) override {
+        m_key = std::string(key);
+        return JsonReadAction::Continue;
+    }
+    JsonReadAction onString(std::string_view value) override { return add(JsonValue(std::string(value))); }
+    JsonReadAction onInt(int64_t value) override { return add(JsonValue(value)); }
+    JsonReadAction onFloat(double value) override { return add(JsonValue(value)); }
+    JsonReadAction onBool(bool value) override { return add(JsonValue(value)); }
+    JsonReadAction onNull() override { return add(JsonValue(nullptr)); }
+
+private:
+    struct Frame {
+        std::string key;
+        bool isArray;
+        JsonArray array;
+        JsonObject object;
+    };
+
+    std::vector<Frame> m_stack;
+    std::string m_key;
+
+    JsonReadAction push(bool isArray) {
+        m_stack.push_back(Frame{m_key, isArray, {}, {}});
+        return JsonReadAction::Continue;
+    }
+
+    JsonReadAction pop() {
+        Frame frame = std::move(m_stack.back());
+        m_stack.pop_back();
+        m_key = frame.key;
+        return add(frame.isArray ? JsonValue(std::move(frame.array)) : JsonValue(std::move(frame.object)));
+    }
+
+    JsonReadAction add(JsonValue value) {
+        if (m_stack.empty()) {
+            root = std::move(value);
+        } else if (m_stack.back().isArray) {
+            m_stack.back().array.push_back(std::move(value));
+        } else {
+            m_stack.back().object.insert_or_assign(m_key, std::move(value));
+        }
+        return JsonReadAction::Continue;
+    }
+};
+
+std::string readEvents(const std::string& json, size_t chunkSize) {
+    RecordingHandler handler;
+    JsonReader reader(handler);
+    for (size_t pos = 0; pos < json.size(); pos += chunkSize) {
+        reader.feed(std::string_view(json).substr(pos, chunkSize));
+    }
+    reader.finish();
+    return handler.events;
+}
+
+std::string makeServices(size_t count) {
+    std::string json = "{\"services\": [";
+    for (size_t i = 0; i < count; ++i) {
+        if (i > 0) json += ", ";
+        json += "{\"id\": " + std::to_string(i) +
+                ", \"name\": \"svc\\t" + std::to_string(i) + "\"" +
+                ", \"enabled\": " + (i % 2 ? "true" : "false") +
+                ", \"weight\": " + std::to_string(i * 0.5) +
+                ", \"blob\": {\"data\": [1, 2, {\"x\": \"}]\\\"\"}], \"n\": null}}";
+    }
+    json += "], \"count\": " + std::to_string(count) + "}";
+    return json;
+}
+
+} // namespace
+
+TEST_CASE("JsonReader - Events", "[JsonReader]") {
+    SECTION("Nested document") {
+        std::string events = readEvents(R"({"a": [1, 2.5, "x"], "b": {"c": null, "d": true}})", 1024);
+        REQUIRE(events == "{k:a [i:1 f:2.500000 s:x ]k:b {k:c null k:d true }}");
+    }
+
+    SECTION("Scalar roots") {
+        REQUIRE(readEvents("42", 16) == "i:42 ");
+        REQUIRE(readEvents(" false ", 16) == "false ");
+        REQUIRE(readEvents("\"a\\\"b\"", 16) == "s:a\"b ");
+        REQUIRE(readEvents("[]", 16) == "[]");
+    }
+
+    SECTION("Every chunk size produces the same events") {
+        std::string json = R"({"key\\n": ["va\"lue", -12, 3e2, true, false, null, {}, []], "z": "\/"})";
+        std::string expected = readEvents(json, json.size());
+        for (size_t chunk = 1; chunk < json.size(); ++chunk) {
+            REQUIRE(readEvents(json, chunk) == expected);
+        }
+    }
+
+    SECTION("Unicode escapes split across chunks") {
+        std::string json = R"(["\u00e9\u20AC", "\ud83d\ude00!"])";
+        for (size_t chunk = 1; chunk <= json.size(); ++chunk) {
+            REQUIRE(readEvents(json, chunk) == "[s:\xC3\xA9\xE2\x82\xAC s:\xF0\x9F\x98\x80! ]");
+        }
+    }
+
+    SECTION("Matches JsonParser on a larger document") {
+        std::string json = makeServices(200);
+        for (size_t chunk : {7u, 64u, 4096u}) {
+            BuildingHandler handler;
+            JsonReader reader(handler);
+            for (size_t pos = 0; pos < json.size(); pos += chunk) {
+                reader.feed(std::string_view(json).substr(pos, chunk));
+            }
+            reader.finish();
+            REQUIRE(handler.root.toString() == JsonParser::parse(json).toString());
+        }
+    }
+}
+
+TEST_CASE("JsonReader - Skipping and stopping", "[JsonReader]") {
+    SECTION("Skip a member value") {
+        RecordingHandler handler;
+        handler.skipKey = "blob";
+        JsonReader reader(handler);
+        reader.feed(R"({"id": 1, "blob": {"x": ["}", {"y": 2}]}, "after": 3})");
+        reader.finish();
+        REQUIRE(handler.events == "{k:id i:1 k:blob k:after i:3 }");
+    }
+
+    SECTION("Skip a scalar member value") {
+        RecordingHandler handler;
+        handler.skipKey = "a";
+        JsonReader reader(handler);
+        reader.feed(R"({"a": "hidden", "b": 2})");
+        reader.finish();
+        REQUIRE(handler.events == "{k:a k:b i:2 }");
+    }
+
+    SECTION("Skip containers from onStartArray across chunks") {
+        RecordingHandler handler;
+        handler.skipArrays = true;
+        JsonReader reader(handler);
+        std::string json = R"({"a": [1, "]\\", [2]], "b": 3})";
+        for (char c : json) {
+            reader.feed(std::string_view(&c, 1));
+        }
+        reader.finish();
+        REQUIRE(handler.events == "{k:a [k:b i:3 }");
+    }
+
+    SECTION("Stop ends parsing early") {
+        RecordingHandler handler;
+        handler.stopAfterInts = 2;
+        JsonReader reader(handler);
+        reader.feed("[1, 2, 3, ");
+        reader.feed("this is not json");
+        reader.finish();
+        REQUIRE(reader.isStopped());
+        REQUIRE(handler.events == "[i:1 i:2 ");
+    }
+}
+
+TEST_CASE("JsonReader - Errors", "[JsonReader]") {
+    auto parse = [](const std::string& json) { return readEvents(json, 3); };
+
+    REQUIRE_THROWS_AS(parse(""), std::runtime_error);
+    REQUIRE_THROWS_AS(parse("[1, 2"), std::runtime_error);
+    REQUIRE_THROWS_AS(parse("{\"a\" 1}"), std::runtime_error);
+    REQUIRE_THROWS_AS(parse("[tru]"), std::runtime_error);
+    REQUIRE_THROWS_AS(parse("[12abc]"), std::runtime_error);
+    REQUIRE_THROWS_AS(parse("[1 2]"), std::runtime_error);
+    REQUIRE_THROWS_AS(parse("[1}"), std::runtime_error);
+    REQUIRE_THROWS_AS(parse("\"abc"), std::runtime_error);
+    REQUIRE_THROWS_AS(parse("\"\\x\""), std::runtime_error);
+    REQUIRE_THROWS_AS(parse("\"\\u12g4\""), std::runtime_error);
+    REQUIRE_THROWS_AS(parse("\"\\ud83d\""), std::runtime_error);
+    REQUIRE_THROWS_AS(parse("\"\\ud83d"), std::runtime_error);
+    REQUIRE_THROWS_AS(parse("{} {}"), std::runtime_error);
+
+    SECTION("Error reports the offset") {
+        try {
+            parse("[1, 2, ?]");
+            FAIL("Should have thrown");
+        } catch (const std::runtime_error& e) {
+            REQUIRE(std::string(e.what()).find("offset 7") != std::string::npos);
+        }
+    }
+
+    SECTION("Nesting depth is bounded") {
+        RecordingHandler handler;
+        JsonReader reader(handler, 8);
+        REQUIRE_THROWS_AS(reader.feed(std::string(9, '[')), std::runtime_error);
+    }
+}
+
+TEST_CASE("JsonReader - Input sources", "[JsonReader]") {
+    std::string json = makeServices(50);
+    std::string expected = JsonParser::parse(json).toString();
+    std::string path = (std::filesystem::temp_directory_path() / "mcf_json_reader_test.json").string();
+    {
+        std::ofstream out(path, std::ios::binary);
+        out << json;
+    }
+
+    SECTION("File") {
+        BuildingHandler handler;
+        JsonReader::readFile(path, handler, 100);
+        REQUIRE(handler.root.toString() == expected);
+    }
+
+    SECTION("Stream") {
+        std::istringstream in(json);
+        BuildingHandler handler;
+        JsonReader::readStream(in, handler, 33);
+        REQUIRE(handler.root.toString() == expected);
+    }
+
+#ifndef _WIN32
+    SECTION("File descriptor") {
+        int fd = ::open(path.c_str(), O_RDONLY);
+        REQUIRE(fd >= 0);
+        BuildingHandler handler;
+        JsonReader::readFd(fd, handler, 256);
+        ::close(fd);
+        REQUIRE(handler.root.toString() == expected);
+    }
+#endif
+
+    SECTION("Missing file") {
+        BuildingHandler handler;
+        REQUIRE_THROWS_AS(JsonReader::readFile("/nonexistent/mcf.json", handler), std::runtime_error);
+    }
+
+    std::filesystem::remove(path);
+}
+
+TEST_CASE("JsonReader - Benchmark streaming", "[JsonReader][.benchmark]") {
+    std::string json = makeServices(20000);
+
+    BENCHMARK("JsonParser::parse (DOM)") {
+        return JsonParser::parse(json).size();
+    };
+
+    BENCHMARK("JsonReader events, 64 KiB chunks") {
+        RecordingHandler handler;
+        JsonReader reader(handler);
+        for (size_t pos = 0; pos < json.size(); pos += JsonReader::DefaultBufferSize) {
+            reader.feed(std::string_view(json).substr(pos, JsonReader::DefaultBufferSize));
+        }
+        reader.finish();
+        return handler.events.size();
+    };
+
+    BENCHMARK("JsonReader skipping every blob") {
+        RecordingHandler handler;
+        handler.skipKey = "blob";
+        JsonReader reader(handler);
+        reader.feed(json);
+        reader.finish();
+        return handler.events.size();
+    };
+}
@@ -0,0 +1,207 @@
+#include <catch_amalgamated.hpp>
+#include "../../core/JsonParser.hpp"
+#include "../../core/JsonScanner.hpp"
+
+#include <random>
+#include <string>
+#include <vector>
+
+using namespace mcf;
+
+namespace {
+
+/**
+ * @brief Byte-at-a-time reference for JsonScanner::index
+ */
+std::vector<uint32_t> referenceIndex(const std::string& input) {
+    std::vector<uint32_t> result;
+    bool pendingEscape = false;
+    bool inString = false;
+    bool prevNonQuoteScalar = false;
+
+    for (size_t i = 0; i < input.size(); ++i) {
+        char c = input[i];
+        bool escaped = pendingEscape;
+        pendingEscape = !escaped && c == '\\';
+
+        bool isOp = c == '{' || c == '}' || c == '[' || c == ']' || c == ':' || c == ',';
+        bool isWs = c == ' ' || c == '\t' || c == '\n' || c == '\r';
+        bool isScalar = !isOp && !isWs;
+        bool quote = c == '"' && !escaped;
+
+        if (quote) inString = !inString;
+        bool stringTail = inString != quote;
+
+        bool structural = (isOp || (isScalar && !prevNonQuoteScalar)) && !stringTail;
+        if (structural) {
+            result.push_back(static_cast<uint32_t>(i));
+        }
+        prevNonQuoteScalar = isScalar && !quote;
+    }
+    return result;
+}
+
+/**
+ * @brief Generate a config-like JSON document of roughly the requested size
+ */
+std::string makeCorpus(size_t targetBytes) {
+    std::string json = "{\n  \"services\": [\n";
+    size_t i = 0;
+    while (json.size() < targetBytes) {
+        if (i > 0) json += ",\n";
+        json += "    {\"id\": " + std::to_string(i) +
+                ", \"name\": \"service-" + std::to_string(i) + "\"" +
+                ", \"enabled\": " + (i % 3 ? "true" : "false") +
+                ", \"weight\": " + std::to_string(i * 0.25) +
+                ", \"path\": \"C:\\\\data\\\\svc\\\\" + std::to_string(i) + "\"" +
+                ", \"tags\": [\"alpha\", \"beta\", \"gamma\"]" +
+                ", \"limits\": {\"cpu\": 2, \"memory\": 4096, \"ratio\": -1.5e-3}}";
+        ++i;
+    }
+    json += "\n  ]\n}\n";
+    return json;
+}
+
+} // namespace
+
+TEST_CASE("JsonScanner - Backend", "[JsonScanner]") {
+    std::string backend = JsonScanner::backend();
+    REQUIRE((backend == "avx2" || backend == "sse2" || backend == "scalar"));
+}
+
+TEST_CASE("JsonScanner - Classification", "[JsonScanner]") {
+    std::string block(64, 'x');
+    block[0] = '{';
+    block[1] = '[';
+    block[2] = ']';
+    block[3] = '}';
+    block[4] = ':';
+    block[5] = ',';
+    block[10] = ' ';
+    block[11] = '\t';
+    block[12] = '\n';
+    block[13] = '\r';
+    block[20] = '"';
+    block[63] = '\\';
+
+    JsonBlockMasks masks = JsonScanner::classify(block.data());
+    REQUIRE(masks.op == 0x3FULL);
+    REQUIRE(masks.whitespace == (0xFULL << 10));
+    REQUIRE(masks.quote == (1ULL << 20));
+    REQUIRE(masks.backslash == (1ULL << 63));
+}
+
+TEST_CASE("JsonScanner - Structural index", "[JsonScanner]") {
+    SECTION("Simple object") {
+        std::string json = R"({"a": [1, true], "b": null})";
+        std::vector<uint32_t> index;
+        JsonScanner::index(json, index);
+        REQUIRE(index == referenceIndex(json));
+        // { "a" : [ 1 , true ] , "b" : null }
+        REQUIRE(index.size() == 13);
+    }
+
+    SECTION("Operators inside strings are ignored") {
+        std::string json = R"(["{[:,]}", "\"{"])";
+        std::vector<uint32_t> index;
+        JsonScanner::index(json, index);
+        REQUIRE(index == std::vector<uint32_t>{0, 1, 9, 11, 16});
+    }
+
+    SECTION("Escapes crossing a block boundary") {
+        for (size_t offset = 50; offset < 80; ++offset) {
+            std::string json = "[\"" + std::string(offset, 'a') + "\\\\\\\\\\\"[\", 1]";
+            std::vector<uint32_t> index;
+            JsonScanner::index(json, index);
+            REQUIRE(index == referenceIndex(json));
+        }
+    }
+
+    SECTION("Randomized against reference") {
+        const char alphabet[] = "\"\\{}[]:, \na1-";
+        std::mt19937 rng(12345);
+        std::uniform_int_distribution<size_t> pick(0, sizeof(alphabet) - 2);
+        std::uniform_int_distribution<size_t> length(0, 300);
+
+        for (int round = 0; round < 2000; ++round) {
+            std::string input(length(rng), ' ');
+            for (auto& c : input) c = alphabet[pick(rng)];
+
+            std::vector<uint32_t> index;
+            JsonScanner::index(input, index);
+            REQUIRE(index == referenceIndex(input));
+        }
+    }
+}
+
+TEST_CASE("JsonScanner - Line and column", "[JsonScanner]") {
+    std::string text = "{\n  \"a\": 1,\n  bad\n}";
+    int line = 0;
+    int column = 0;
+    JsonScanner::lineColumn(text, text.find("bad"), line, column);
+    REQUIRE(line == 3);
+    REQUIRE(column == 3);
+}
+
+TEST_CASE("JsonParser - Two-stage parsing", "[JsonParser]") {
+    SECTION("Long strings with escapes across blocks") {
+        std::string body(200, 'x');
+        body[63] = '\\';
+        body.insert(64, "n");
+        std::string json = "\"" + body + "\"";
+        auto value = JsonParser::parse(json);
+        REQUIRE(value.isString());
+        REQUIRE(value.asString().size() == 200);
+        REQUIRE(value.asString()[63] == '\n');
+    }
+
+    SECTION("Integer overflow falls back to float") {
+        auto value = JsonParser::parse("123456789012345678901234567890");
+        REQUIRE(value.isFloat());
+        REQUIRE(value.asFloat() > 1e29);
+    }
+
+    SECTION("Garbage after scalar is rejected") {
+        REQUIRE_THROWS_AS(JsonParser::parse("[12abc]"), std::runtime_error);
+        REQUIRE_THROWS_AS(JsonParser::parse("[truex]"), std::runtime_error);
+        REQUIRE_THROWS_AS(JsonParser::parse("[1 2]"), std::runtime_error);
+        REQUIRE_THROWS_AS(JsonParser::parse("[1.]"), std::runtime_error);
+        REQUIRE_THROWS_AS(JsonParser::parse("[1e]"), std::runtime_error);
+    }
+
+    SECTION("Error reports line and column") {
+        try {
+            JsonParser::parse("{\n  \"a\": 1,\n  \"b\" 2\n}");
+            FAIL("Should have thrown");
+        } catch (const std::runtime_error& e) {
+            std::string msg = e.what();
+            REQUIRE(msg.find("line 3") != std::string::npos);
+            REQUIRE(msg.find("column 7") != std::string::npos);
+        }
+    }
+
+    SECTION("Corpus round trip") {
+        std::string json = makeCorpus(64 * 1024);
+        auto value = JsonParser::parse(json);
+        const auto& services = value["services"];
+        REQUIRE(services.isArray());
+        REQUIRE(services.size() > 100);
+        REQUIRE(services[7]["name"].asString() == "service-7");
+        REQUIRE(services[7]["path"].asString() == "C:\\data\\svc\\7");
+        REQUIRE(services[7]["limits"]["ratio"].asFloat() == Catch::Approx(-1.5e-3));
+    }
+}
+
+TEST_CASE("JsonParser - Benchmark parsing", "[JsonParser][.benchmark]") {
+    std::string json = makeCorpus(4 * 1024 * 1024);
+    std::vector<uint32_t> index;
+
+    BENCHMARK("JsonScanner::index 4 MB") {
+        JsonScanner::index(json, index);
+        return index.size();
+    };
+
+    BENCHMARK("JsonParser::parse 4 MB") {
+        return JsonParser::parse(json).size();
+    };
+}
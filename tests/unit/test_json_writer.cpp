@@ -0,0 +1,231 @@
+#include <catch_amalgamated.hpp>
+#include "../../core/JsonParser.hpp"
+#include "../../core/JsonWriter.hpp"
+
+#include <cmath>
+#include <filesystem>
+#include <fstream>
+#include <limits>
+#include <string>
+#include <thread>
+#include <vector>
+
+#ifndef _WIN32
+#include <fcntl.h>
+#include <unistd.h>
+#endif
+
+using namespace mcf;
+
+namespace {
+
+JsonValue makeConfig(size_t services) {
+    JsonArray list;
+    for (size_t i = 0; i < services; ++i) {
+        JsonObject service;
+        service["id"] = JsonValue(static_cast<int64_t>(i));
+        service["name"] = JsonValue("service \"" + std::to_string(i) + "\"\n");
+        service["enabled"] = JsonValue(i % 2 == 0);
+        service["weight"] = JsonValue(static_cast<double>(i) / 3.0);
+        service["tags"] = JsonValue(JsonArray{JsonValue("a"), JsonValue("b\\c")});
+        service["parent"] = JsonValue(nullptr);
+        list.push_back(JsonValue(std::move(service)));
+    }
+    JsonObject root;
+    root["services"] = JsonValue(std::move(list));
+    root["empty"] = JsonValue(JsonObject());
+    return JsonValue(std::move(root));
+}
+
+} // namespace
+
+TEST_CASE("JsonWriter - Compact output", "[JsonWriter]") {
+    JsonWriter writer;
+    writer.startObject();
+    writer.key("a").integer(1);
+    writer.key("b").startArray().boolean(true).null().string("x").endArray();
+    writer.key("c").startObject().endObject();
+    writer.endObject();
+
+    REQUIRE(writer.str() == R"({"a":1,"b":[true,null,"x"],"c":{}})");
+    REQUIRE(writer.depth() == 0);
+}
+
+TEST_CASE("JsonWriter - Pretty output", "[JsonWriter]") {
+    JsonWriter writer(JsonWriter::Style::Pretty, 2);
+    writer.startObject();
+    writer.key("list").startArray().integer(1).integer(2).endArray();
+    writer.key("empty").startArray().endArray();
+    writer.endObject();
+
+    REQUIRE(writer.str() ==
+            "{\n"
+            "  \"list\": [\n"
+            "    1,\n"
+            "    2\n"
+            "  ],\n"
+            "  \"empty\": []\n"
+            "}");
+}
+
+TEST_CASE("JsonWriter - Strings are escaped", "[JsonWriter]") {
+    std::string escaped;
+    JsonWriter::escape("quote\" backslash\\ tab\t nl\n cr\r bs\b ff\f plain", escaped);
+    REQUIRE(escaped == "quote\\\" backslash\\\\ tab\\t nl\\n cr\\r bs\\b ff\\f plain");
+
+    std::string raw = "a\"b\\c\nd\x01";
+    std::string json = JsonWriter::write(JsonValue(raw));
+    REQUIRE(JsonParser::parse(json).asString() == raw);
+
+    SECTION("Other control characters use \\u escapes") {
+        std::string control = std::string("\0\x01\x1f\x7f", 4);
+        std::string out;
+        JsonWriter::escape(control, out);
+        REQUIRE(out == "\\u0000\\u0001\\u001f\x7f");
+        REQUIRE(JsonParser::parse("\"" + out + "\"").asString() == control);
+    }
+}
+
+TEST_CASE("JsonWriter - Numbers", "[JsonWriter]") {
+    auto write = [](auto value) { return JsonWriter::write(JsonValue(value)); };
+
+    REQUIRE(write(int64_t(-9223372036854775807LL - 1)) == "-9223372036854775808");
+    REQUIRE(write(0.1) == "0.1");
+    REQUIRE(write(2.0) == "2.0");
+    REQUIRE(write(-1.5e-7) == "-1.5e-07");
+    REQUIRE(write(std::numeric_limits<double>::infinity()) == "null");
+    REQUIRE(write(std::nan("")) == "null");
+
+    SECTION("Shortest form round-trips") {
+        for (double value : {1.0 / 3.0, 123456.789, 1e300, 5e-324, -0.0001}) {
+            auto parsed = JsonParser::parse(write(value));
+            REQUIRE(parsed.isFloat());
+            REQUIRE(parsed.asFloat() == value);
+        }
+    }
+
+    SECTION("Fixed precision") {
+        JsonWriter writer;
+        writer.startArray().number(3.14159, 3).number(2.0, 1).endArray();
+        REQUIRE(writer.str() == "[3.142,2.0]");
+    }
+}
+
+TEST_CASE("JsonWriter - JsonValue round trip", "[JsonWriter]") {
+    JsonValue config = makeConfig(25);
+
+    for (auto style : {JsonWriter::Style::Compact, JsonWriter::Style::Pretty}) {
+        std::string json = JsonWriter::write(config, style);
+        JsonValue parsed = JsonParser::parse(json);
+        REQUIRE(JsonWriter::write(parsed) == JsonWriter::write(config));
+    }
+}
+
+TEST_CASE("JsonWriter - File output", "[JsonWriter]") {
+    JsonValue config = makeConfig(5000);
+    std::string path = (std::filesystem::temp_directory_path() / "mcf_json_writer_test.json").string();
+
+    SECTION("writeFile streams through the descriptor") {
+        REQUIRE(JsonWriter::writeFile(path, config));
+        JsonValue parsed = JsonParser::parseFile(path);
+        REQUIRE(parsed["services"].size() == 5000);
+        REQUIRE(parsed["services"][4999]["name"].asString() == "service \"4999\"\n");
+    }
+
+    SECTION("JsonParser::writeFile uses the writer") {
+        REQUIRE(JsonParser::writeFile(path, config));
+        REQUIRE(JsonWriter::write(JsonParser::parseFile(path)) == JsonWriter::write(config));
+    }
+
+#ifndef _WIN32
+    SECTION("Explicit descriptor") {
+        int fd = ::open(path.c_str(), O_WRONLY | O_CREAT | O_TRUNC, 0644);
+        REQUIRE(fd >= 0);
+        {
+            JsonWriter writer(fd, JsonWriter::Style::Compact);
+            writer.value(config);
+            writer.flush();
+            REQUIRE(writer.str().empty());
+        }
+        ::close(fd);
+        REQUIRE(JsonWriter::write(JsonParser::parseFile(path)) == JsonWriter::write(config));
+    }
+#endif
+
+    SECTION("writeFileAtomic replaces the file") {
+        REQUIRE(JsonWriter::writeFile(path, JsonValue("old")));
+        REQUIRE(JsonWriter::writeFileAtomic(path, config));
+        REQUIRE(JsonWriter::write(JsonParser::parseFile(path)) == JsonWriter::write(config));
+        for (const auto& entry : std::filesystem::directory_iterator(std::filesystem::temp_directory_path())) {
+            std::string name = entry.path().filename().string();
+            REQUIRE_FALSE((name.rfind("mcf_json_writer_test.json.", 0) == 0 && entry.path().extension() == ".tmp"));
+        }
+    }
+
+#ifndef _WIN32
+    SECTION("writeFileAtomic keeps the permissions of the replaced file") {
+        namespace fs = std::filesystem;
+        REQUIRE(JsonWriter::writeFile(path, JsonValue("secret")));
+        fs::permissions(path, fs::perms::owner_read | fs::perms::owner_write);
+        REQUIRE(JsonWriter::writeFileAtomic(path, config));
+        REQUIRE(fs::status(path).permissions() == (fs::perms::owner_read | fs::perms::owner_write));
+    }
+
+    SECTION("writeFileAtomic replaces the file a symbolic link points to") {
+        namespace fs = std::filesystem;
+        std::string link = path + ".link";
+        fs::remove(link);
+        REQUIRE(JsonWriter::writeFile(path, JsonValue("old")));
+        fs::create_symlink(path, link);
+        REQUIRE(JsonWriter::writeFileAtomic(link, config));
+        REQUIRE(fs::is_symlink(link));
+        REQUIRE(JsonWriter::write(JsonParser::parseFile(path)) == JsonWriter::write(config));
+        fs::remove(link);
+    }
+#endif
+
+    SECTION("Concurrent writeFileAtomic calls do not share a temporary file") {
+        { std::ofstream(path + ".tmp") << "not ours"; }
+        std::vector<std::thread> writers;
+        for (int t = 0; t < 4; ++t) {
+            writers.emplace_back([&, t]() {
+                JsonArray items(2000, JsonValue(t));
+                for (int i = 0; i < 10; ++i) {
+                    JsonWriter::writeFileAtomic(path, JsonValue(items));
+                }
+            });
+        }
+        for (auto& writer : writers) {
+            writer.join();
+        }
+        JsonValue written = JsonParser::parseFile(path);
+        REQUIRE(written.asArray().size() == 2000);
+        std::string other;
+        std::getline(std::ifstream(path + ".tmp"), other);
+        REQUIRE(other == "not ours");
+        std::filesystem::remove(path + ".tmp");
+    }
+
+    SECTION("Unwritable path") {
+        REQUIRE_FALSE(JsonWriter::writeFile("/nonexistent/dir/out.json", config));
+        REQUIRE_FALSE(JsonWriter::writeFileAtomic("/nonexistent/dir/out.json", config));
+    }
+
+    std::filesystem::remove(path);
+}
+
+TEST_CASE("JsonWriter - Benchmark against toString", "[JsonWriter][.benchmark]") {
+    JsonValue config = makeConfig(20000);
+
+    BENCHMARK("JsonValue::toString") {
+        return config.toString().size();
+    };
+
+    BENCHMARK("JsonWriter compact") {
+        return JsonWriter::write(config).size();
+    };
+
+    BENCHMARK("JsonWriter pretty") {
+        return JsonWriter::write(config, JsonWriter::Style::Pretty).size();
+    };
+}
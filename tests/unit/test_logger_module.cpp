@@ -5,6 +5,8 @@
 #include "../../core/JsonParser.hpp"
 #include <filesystem>
 #include <fstream>
+#include <chrono>
+#include <thread>
 
 using namespace mcf;
 
@@ -844,6 +846,38 @@ TEST_CASE("LoggerModule - Hot reload configuration", "[LoggerModule]") {
     }
 }
 
+TEST_CASE("LoggerModule - Log file watches follow the configuration", "[LoggerModule]") {
+    const std::string configPath = "test_log_watch_config.json";
+    auto writeConfig = [&](const std::string& logPath) {
+        std::ofstream file(configPath, std::ios::trunc);
+        file << R"({"logging": {"loggers": [{"name": "watched", "sinks": [)"
+             << R"({"type": "file", "path": ")" << logPath << R"(", "truncate": true}]}]}})";
+    };
+
+    std::filesystem::create_directories("test_log_watch");
+    writeConfig("test_log_watch/first.log");
+    ApplicationConfig appConfig;
+    appConfig.autoLoadPlugins = false;
+    appConfig.configFile = configPath;
+    Application app(appConfig);
+    app.addModule<LoggerModule>();
+    REQUIRE(app.initialize());
+
+    FileWatchService* service = app.getFileWatchService();
+    size_t subscriptions = service->getSubscriptionCount();
+
+    // Each reload moves the watch to the new file instead of adding one
+    for (const char* logPath : {"test_log_watch/second.log", "test_log_watch/third.log", "test_log_watch/first.log"}) {
+        writeConfig(logPath);
+        REQUIRE(app.getConfigurationManager()->reload());
+        REQUIRE(service->getSubscriptionCount() == subscriptions);
+    }
+
+    app.shutdown();
+    std::filesystem::remove(configPath);
+    std::filesystem::remove_all("test_log_watch");
+}
+
 TEST_CASE("LoggerModule - File sink error handling", "[LoggerModule]") {
     const std::string configPath = "test_file_sink_errors.json";
 
@@ -1088,3 +1122,41 @@ TEST_CASE("LoggerModule - Logger name conflicts", "[LoggerModule]") {
         std::filesystem::remove(configPath);
     }
 }
+
+TEST_CASE("LoggerModule - Reopens rotated log files", "[LoggerModule][hot-reload]") {
+    namespace fs = std::filesystem;
+    fs::path directory = fs::temp_directory_path() / "mcf_logger_module_rotation";
+    fs::remove_all(directory);
+    fs::create_directories(directory);
+    std::string logPath = (directory / "app.log").string();
+
+    ApplicationConfig config;
+    config.autoLoadPlugins = false;
+    Application app(config);
+    auto* module = app.addModule<LoggerModule>();
+    REQUIRE(app.initialize());
+
+    auto logger = module->createLogger("rotation_test", LogLevel::Info, false, true, logPath);
+    logger->info("before rotation");
+    logger->flush();
+    REQUIRE(fs::exists(logPath));
+
+    // Rotate like logrotate: move the file away, the sink must start a new one
+    fs::rename(logPath, logPath + ".1");
+    auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(5);
+    while (!fs::exists(logPath) && std::chrono::steady_clock::now() < deadline) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    }
+    REQUIRE(fs::exists(logPath));
+
+    logger->info("after rotation");
+    logger->flush();
+
+    std::ifstream current(logPath);
+    std::string content((std::istreambuf_iterator<char>(current)), std::istreambuf_iterator<char>());
+    REQUIRE(content.find("after rotation") != std::string::npos);
+    REQUIRE(content.find("before rotation") == std::string::npos);
+
+    app.shutdown();
+    fs::remove_all(directory);
+}
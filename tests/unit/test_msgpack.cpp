@@ -0,0 +1,221 @@
+#include <catch_amalgamated.hpp>
+#include "../../core/JsonParser.hpp"
+#include "../../core/JsonWriter.hpp"
+#include "../../core/MsgPack.hpp"
+#include "../../modules/networking/NetworkingTypes.hpp"
+
+#include <cmath>
+#include <iostream>
+#include <limits>
+#include <string>
+
+using namespace mcf;
+
+namespace {
+
+std::string bytes(std::initializer_list<int> values) {
+    std::string out;
+    for (int v : values) out += static_cast<char>(v);
+    return out;
+}
+
+JsonValue makeState(size_t records) {
+    JsonArray list;
+    for (size_t i = 0; i < records; ++i) {
+        JsonObject record;
+        record["id"] = JsonValue(static_cast<int64_t>(i * 977));
+        record["name"] = JsonValue("entity-" + std::to_string(i));
+        record["position"] = JsonValue(JsonArray{JsonValue(i * 0.1), JsonValue(-2.5), JsonValue(1e-9)});
+        record["alive"] = JsonValue(i % 3 != 0);
+        record["owner"] = JsonValue(nullptr);
+        list.push_back(JsonValue(std::move(record)));
+    }
+    JsonObject root;
+    root["entities"] = JsonValue(std::move(list));
+    root["version"] = JsonValue(int64_t(3));
+    return JsonValue(std::move(root));
+}
+
+/**
+ * @brief Handler counting events (and optionally skipping a key)
+ */
+class CountingHandler : public JsonHandler {
+public:
+    size_t scalars = 0;
+    size_t containers = 0;
+    std::string skipKey;
+
+    JsonReadAction onStartObject() override { ++containers; return JsonReadAction::Continue; }
+    JsonReadAction onStartArray() override { ++containers; return JsonReadAction::Continue; }
+    JsonReadAction onKey(std::string_view key) override {
+        return key == skipKey ? JsonReadAction::SkipValue : JsonReadAction::Continue;
+    }
+    JsonReadAction onString(std::string_view) override { ++scalars; return JsonReadAction::Continue; }
+    JsonReadAction onInt(int64_t) override { ++scalars; return JsonReadAction::Continue; }
+    JsonReadAction onFloat(double) override { ++scalars; return JsonReadAction::Continue; }
+    JsonReadAction onBool(bool) override { ++scalars; return JsonReadAction::Continue; }
+    JsonReadAction onNull() override { ++scalars; return JsonReadAction::Continue; }
+};
+
+} // namespace
+
+TEST_CASE("MsgPack - Encoding", "[MsgPack]") {
+    auto encode = [](const JsonValue& v) { return MsgPack::encode(v); };
+
+    REQUIRE(encode(JsonValue(nullptr)) == bytes({0xc0}));
+    REQUIRE(encode(JsonValue(true)) == bytes({0xc3}));
+    REQUIRE(encode(JsonValue(int64_t(5))) == bytes({0x05}));
+    REQUIRE(encode(JsonValue(int64_t(-1))) == bytes({0xff}));
+    REQUIRE(encode(JsonValue(int64_t(200))) == bytes({0xcc, 0xc8}));
+    REQUIRE(encode(JsonValue(int64_t(-200))) == bytes({0xd1, 0xff, 0x38}));
+    REQUIRE(encode(JsonValue(1.5)) == bytes({0xca, 0x3f, 0xc0, 0x00, 0x00}));
+    REQUIRE(encode(JsonValue(0.1)).size() == 9);
+    REQUIRE(encode(JsonValue("abc")) == bytes({0xa3, 'a', 'b', 'c'}));
+    REQUIRE(encode(JsonValue(JsonArray{JsonValue(int64_t(1))})) == bytes({0x91, 0x01}));
+    REQUIRE(encode(JsonValue(std::string(40, 'x'))).substr(0, 2) == bytes({0xd9, 40}));
+}
+
+TEST_CASE("MsgPack - Lossless round trip", "[MsgPack]") {
+    SECTION("Scalars at type boundaries") {
+        for (int64_t v : {int64_t(0), int64_t(127), int64_t(128), int64_t(-32), int64_t(-33),
+                          int64_t(65535), int64_t(65536), int64_t(4294967296LL),
+                          std::numeric_limits<int64_t>::max(), std::numeric_limits<int64_t>::min()}) {
+            JsonValue decoded = MsgPack::decode(MsgPack::encode(JsonValue(v)));
+            REQUIRE(decoded.isInt());
+            REQUIRE(decoded.asInt() == v);
+        }
+        for (double v : {0.0, -0.0, 2.0, 0.1, 1e300, -5e-324}) {
+            JsonValue decoded = MsgPack::decode(MsgPack::encode(JsonValue(v)));
+            REQUIRE(decoded.isFloat());
+            REQUIRE(decoded.asFloat() == v);
+            REQUIRE(std::signbit(decoded.asFloat()) == std::signbit(v));
+        }
+        std::string binary("a\0b\"\\\n", 6);
+        REQUIRE(MsgPack::decode(MsgPack::encode(JsonValue(binary))).asString() == binary);
+    }
+
+    SECTION("Nested document") {
+        JsonValue state = makeState(100);
+        JsonValue decoded = MsgPack::decode(MsgPack::encode(state));
+        REQUIRE(JsonWriter::write(decoded) == JsonWriter::write(state));
+    }
+
+    SECTION("Large containers and strings use wide headers") {
+        JsonArray arr(70000, JsonValue(int64_t(1)));
+        JsonObject obj;
+        obj[std::string(70000, 'k')] = JsonValue(std::move(arr));
+        JsonValue value(std::move(obj));
+        JsonValue decoded = MsgPack::decode(MsgPack::encode(value));
+        REQUIRE(decoded[std::string(70000, 'k')].size() == 70000);
+    }
+}
+
+TEST_CASE("MsgPack - Streaming", "[MsgPack]") {
+    SECTION("Writer builds documents incrementally") {
+        MsgPackWriter writer;
+        writer.startObject(2);
+        writer.key("id").integer(42);
+        writer.key("tags").startArray(2).string("a").boolean(false);
+        JsonValue decoded = MsgPack::decode(writer.str());
+        REQUIRE(decoded["id"].asInt() == 42);
+        REQUIRE(decoded["tags"][1].asBool() == false);
+    }
+
+    SECTION("Reader consumes back-to-back values") {
+        std::string stream;
+        for (int i = 0; i < 10; ++i) {
+            stream += MsgPack::encode(JsonValue(JsonArray{JsonValue(int64_t(i)), JsonValue("x")}));
+        }
+        MsgPackReader reader(stream);
+        int count = 0;
+        while (!reader.atEnd()) {
+            REQUIRE(reader.readValue()[0].asInt() == count);
+            ++count;
+        }
+        REQUIRE(count == 10);
+    }
+
+    SECTION("Events match the JSON text reader") {
+        JsonValue state = makeState(20);
+        std::string json = JsonWriter::write(state);
+
+        CountingHandler fromText;
+        JsonReader textReader(fromText);
+        textReader.feed(json);
+        textReader.finish();
+
+        CountingHandler fromBinary;
+        std::string encoded = MsgPack::encode(state);
+        MsgPackReader binaryReader(encoded);
+        REQUIRE(binaryReader.read(fromBinary));
+        REQUIRE(binaryReader.atEnd());
+
+        REQUIRE(fromBinary.scalars == fromText.scalars);
+        REQUIRE(fromBinary.containers == fromText.containers);
+    }
+
+    SECTION("Skipped members are not decoded") {
+        CountingHandler handler;
+        handler.skipKey = "entities";
+        std::string encoded = MsgPack::encode(makeState(20));
+        MsgPackReader reader(encoded);
+        REQUIRE(reader.read(handler));
+        REQUIRE(reader.atEnd());
+        REQUIRE(handler.scalars == 1);  // "version"
+    }
+}
+
+TEST_CASE("MsgPack - Malformed input", "[MsgPack]") {
+    REQUIRE_THROWS_AS(MsgPack::decode(""), std::runtime_error);
+    REQUIRE_THROWS_AS(MsgPack::decode(bytes({0xcd, 0x01})), std::runtime_error);
+    REQUIRE_THROWS_AS(MsgPack::decode(bytes({0xa5, 'a'})), std::runtime_error);
+    REQUIRE_THROWS_AS(MsgPack::decode(bytes({0x92, 0x01})), std::runtime_error);
+    REQUIRE_THROWS_AS(MsgPack::decode(bytes({0x81, 0x01, 0x02})), std::runtime_error);
+    REQUIRE_THROWS_AS(MsgPack::decode(bytes({0xc1})), std::runtime_error);
+    REQUIRE_THROWS_AS(MsgPack::decode(bytes({0x01, 0x02})), std::runtime_error);
+
+    SECTION("Hostile counts do not allocate") {
+        REQUIRE_THROWS_AS(MsgPack::decode(bytes({0xdd, 0xff, 0xff, 0xff, 0xff})), std::runtime_error);
+    }
+
+    SECTION("Nesting depth is bounded") {
+        std::string deep(5000, static_cast<char>(0x91));
+        deep += static_cast<char>(0xc0);
+        REQUIRE_THROWS_AS(MsgPack::decode(deep), std::runtime_error);
+    }
+}
+
+TEST_CASE("MsgPack - NetworkMessage payload codec", "[MsgPack]") {
+    JsonValue payload = makeState(3);
+    NetworkMessage message = NetworkMessage::fromJson(7, payload);
+    REQUIRE(message.dataSize == message.data.size());
+
+    NetworkMessage received;
+    REQUIRE(NetworkMessage::deserialize(message.serialize(), received));
+    REQUIRE(received.messageId == 7);
+    REQUIRE(JsonWriter::write(received.toJson()) == JsonWriter::write(payload));
+}
+
+TEST_CASE("MsgPack - Benchmark against JSON text", "[MsgPack][.benchmark]") {
+    JsonValue state = makeState(20000);
+    std::string json = JsonWriter::write(state);
+    std::string binary = MsgPack::encode(state);
+    std::cout << "JSON text: " << json.size() / 1024 << " KiB, MessagePack: "
+              << binary.size() / 1024 << " KiB\n";
+
+    BENCHMARK("JsonWriter::write") {
+        return JsonWriter::write(state).size();
+    };
+
+    BENCHMARK("MsgPack::encode") {
+        return MsgPack::encode(state).size();
+    };
+
+    BENCHMARK("JsonParser::parse") {
+        return JsonParser::parse(json).size();
+    };
+
+    BENCHMARK("MsgPack::decode") {
+        return MsgPack::decode(binary).size();
+    };
+}
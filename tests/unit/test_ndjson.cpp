@@ -0,0 +1,232 @@
+#include <catch_amalgamated.hpp>
+#include "../../core/Ndjson.hpp"
+
+#include <filesystem>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#ifndef _WIN32
+#include <fcntl.h>
+#include <unistd.h>
+#endif
+
+using namespace mcf;
+
+namespace {
+
+std::string makeEvents(size_t count) {
+    std::ostringstream out;
+    NdjsonWriter writer(out, 4096);
+    for (size_t i = 0; i < count; ++i) {
+        writer.json().startObject()
+            .key("seq").integer(static_cast<int64_t>(i))
+            .key("event").string("tick \"" + std::to_string(i) + "\"")
+            .key("values").startArray().number(i * 0.5).boolean(i % 2 == 0).null().endArray()
+            .endObject();
+        writer.endRecord();
+    }
+    writer.flush();
+    return out.str();
+}
+
+std::vector<int64_t> readSequence(NdjsonReader& reader) {
+    std::vector<int64_t> seq;
+    JsonValue record;
+    while (reader.next(record)) {
+        seq.push_back(record["seq"].asInt());
+    }
+    return seq;
+}
+
+bool isSequential(const std::vector<int64_t>& seq, size_t count) {
+    if (seq.size() != count) return false;
+    for (size_t i = 0; i < count; ++i) {
+        if (seq[i] != static_cast<int64_t>(i)) return false;
+    }
+    return true;
+}
+
+} // namespace
+
+TEST_CASE("Ndjson - Writer", "[Ndjson]") {
+    std::ostringstream out;
+    {
+        NdjsonWriter writer(out);
+        writer.write(JsonParser::parse(R"({"a": [1, 2], "b": "x\ny"})"));
+        writer.write(JsonValue(int64_t(3)));
+        REQUIRE(writer.recordCount() == 2);
+        REQUIRE(out.str().empty());  // still buffered
+    }
+    REQUIRE(out.str() == "{\"a\":[1,2],\"b\":\"x\\ny\"}\n3\n");
+
+    SECTION("Batches are written once full") {
+        std::ostringstream batched;
+        NdjsonWriter writer(batched, 64);
+        for (int i = 0; i < 10; ++i) {
+            writer.write(JsonValue("record " + std::to_string(i)));
+        }
+        REQUIRE_FALSE(batched.str().empty());
+        REQUIRE(batched.str().size() < 10 * 11);
+        writer.flush();
+        REQUIRE(batched.str().size() == 10 * 11);
+    }
+
+    SECTION("Records must be complete") {
+        std::ostringstream partial;
+        NdjsonWriter writer(partial);
+        writer.json().startObject();
+        REQUIRE_THROWS_AS(writer.endRecord(), std::runtime_error);
+    }
+}
+
+TEST_CASE("Ndjson - Reader", "[Ndjson]") {
+    std::string data = makeEvents(1000);
+    NdjsonReader::Options small;
+    small.batchBytes = 1000;
+
+    SECTION("In-place buffer, serial") {
+        NdjsonReader reader(data, nullptr, small);
+        REQUIRE(isSequential(readSequence(reader), 1000));
+    }
+
+    SECTION("In-place buffer, parallel, order preserved") {
+        ThreadPool pool(4);
+        NdjsonReader reader(data, &pool, small);
+        REQUIRE(isSequential(readSequence(reader), 1000));
+    }
+
+    SECTION("Stream, parallel, bounded read-ahead") {
+        ThreadPool pool(4);
+        std::istringstream in(data);
+        NdjsonReader::Options options = small;
+        options.maxInFlight = 2;
+        NdjsonReader reader(in, &pool, options);
+        REQUIRE(isSequential(readSequence(reader), 1000));
+    }
+
+    SECTION("Record contents") {
+        std::istringstream in(data);
+        NdjsonReader reader(in);
+        JsonValue record;
+        REQUIRE(reader.next(record));
+        REQUIRE(reader.next(record));
+        REQUIRE(record["event"].asString() == "tick \"1\"");
+        REQUIRE(record["values"][0].asFloat() == 0.5);
+        REQUIRE(reader.lineNumber() == 2);
+    }
+}
+
+TEST_CASE("Ndjson - Line handling", "[Ndjson]") {
+    SECTION("Blank lines, CRLF and a missing final newline") {
+        std::string data = "{\"seq\":0}\r\n\n   \n{\"seq\":1}\r\n{\"seq\":2}";
+        NdjsonReader reader(data);
+        REQUIRE(isSequential(readSequence(reader), 3));
+        REQUIRE(reader.lineNumber() == 5);
+    }
+
+    SECTION("Lines longer than a batch") {
+        std::string big(10000, 'x');
+        std::string data = "{\"seq\":0,\"pad\":\"" + big + "\"}\n{\"seq\":1}\n{\"seq\":2,\"pad\":\"" + big + "\"}";
+        NdjsonReader::Options tiny;
+        tiny.batchBytes = 16;
+
+        std::istringstream in(data);
+        NdjsonReader streamReader(in, nullptr, tiny);
+        REQUIRE(isSequential(readSequence(streamReader), 3));
+
+        NdjsonReader bufferReader(data, nullptr, tiny);
+        REQUIRE(isSequential(readSequence(bufferReader), 3));
+    }
+
+    SECTION("Empty input") {
+        std::istringstream in("");
+        NdjsonReader reader(in);
+        JsonValue record;
+        REQUIRE_FALSE(reader.next(record));
+    }
+}
+
+TEST_CASE("Ndjson - Errors", "[Ndjson]") {
+    std::string data = makeEvents(50);
+    data.insert(data.find("{\"seq\":40"), "{\"seq\": oops}\n");
+
+    ThreadPool pool(2);
+    NdjsonReader::Options small;
+    small.batchBytes = 200;
+    NdjsonReader reader(data, &pool, small);
+
+    JsonValue record;
+    size_t delivered = 0;
+    try {
+        while (reader.next(record)) ++delivered;
+        FAIL("Should have thrown");
+    } catch (const std::runtime_error& e) {
+        REQUIRE(std::string(e.what()).find("line 41") != std::string::npos);
+    }
+    REQUIRE(delivered == 40);
+}
+
+TEST_CASE("Ndjson - Callback and file helpers", "[Ndjson]") {
+    std::string path = (std::filesystem::temp_directory_path() / "mcf_ndjson_test.ndjson").string();
+    {
+        std::ofstream out(path, std::ios::binary);
+        out << makeEvents(300);
+    }
+
+    ThreadPool pool(2);
+    std::vector<int64_t> seq;
+    size_t count = NdjsonReader::readFile(path, [&](JsonValue& record) {
+        seq.push_back(record["seq"].asInt());
+        return true;
+    }, &pool);
+    REQUIRE(count == 300);
+    REQUIRE(isSequential(seq, 300));
+
+    SECTION("Callback can stop early") {
+        size_t seen = NdjsonReader::readFile(path, [](JsonValue& record) {
+            return record["seq"].asInt() < 9;
+        }, &pool);
+        REQUIRE(seen == 10);
+    }
+
+#ifndef _WIN32
+    SECTION("Descriptor writer") {
+        int fd = ::open(path.c_str(), O_WRONLY | O_CREAT | O_TRUNC, 0644);
+        REQUIRE(fd >= 0);
+        {
+            NdjsonWriter writer(fd);
+            for (int i = 0; i < 5000; ++i) {
+                writer.write(JsonParser::parse("{\"seq\":" + std::to_string(i) + "}"));
+            }
+        }
+        ::close(fd);
+
+        std::vector<int64_t> written;
+        NdjsonReader::readFile(path, [&](JsonValue& record) {
+            written.push_back(record["seq"].asInt());
+            return true;
+        });
+        REQUIRE(isSequential(written, 5000));
+    }
+#endif
+
+    std::filesystem::remove(path);
+    REQUIRE_THROWS_AS(NdjsonReader::readFile(path, [](JsonValue&) { return true; }), std::runtime_error);
+}
+
+TEST_CASE("Ndjson - Benchmark serial vs parallel", "[Ndjson][.benchmark]") {
+    std::string data = makeEvents(200000);
+    ThreadPool pool;
+
+    BENCHMARK("Serial") {
+        NdjsonReader reader(data);
+        return readSequence(reader).size();
+    };
+
+    BENCHMARK("Parallel (ThreadPool)") {
+        NdjsonReader reader(data, &pool);
+        return readSequence(reader).size();
+    };
+}